@@ -0,0 +1,92 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/array.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+
+#include "benchmark.hpp"
+
+using namespace std;
+using namespace dynd;
+
+static const intptr_t arith_size = 1 << 20;
+
+template<class T>
+static nd::array make_values(intptr_t size, int offset)
+{
+    nd::array result = nd::empty(size, ndt::make_strided_dim(ndt::make_type<T>()));
+    T *data = reinterpret_cast<T *>(result.get_readwrite_originptr());
+    for (intptr_t i = 0; i < size; ++i) {
+        data[i] = static_cast<T>((i + offset) % 100 + 1);
+    }
+    return result;
+}
+
+enum arith_op_t {
+    arith_add,
+    arith_subtract,
+    arith_multiply,
+    arith_divide
+};
+
+template<class T>
+static void binary_arithmetic(bench::state& st, arith_op_t op)
+{
+    nd::array a = make_values<T>(arith_size, 0), b = make_values<T>(arith_size, 7);
+    while (st.keep_running()) {
+        nd::array result;
+        switch (op) {
+            case arith_add:
+                result = (a + b).eval();
+                break;
+            case arith_subtract:
+                result = (a - b).eval();
+                break;
+            case arith_multiply:
+                result = (a * b).eval();
+                break;
+            case arith_divide:
+                result = (a / b).eval();
+                break;
+        }
+        bench::do_not_optimize(result.get_readonly_originptr());
+    }
+    st.set_items_processed(arith_size);
+    st.set_bytes_processed(3 * arith_size * sizeof(T));
+}
+
+DYND_BENCHMARK(arithmetic_add_int32) {
+    binary_arithmetic<int32_t>(st, arith_add);
+}
+
+DYND_BENCHMARK(arithmetic_add_float64) {
+    binary_arithmetic<double>(st, arith_add);
+}
+
+DYND_BENCHMARK(arithmetic_subtract_int64) {
+    binary_arithmetic<int64_t>(st, arith_subtract);
+}
+
+DYND_BENCHMARK(arithmetic_multiply_float32) {
+    binary_arithmetic<float>(st, arith_multiply);
+}
+
+DYND_BENCHMARK(arithmetic_divide_float64) {
+    binary_arithmetic<double>(st, arith_divide);
+}
+
+DYND_BENCHMARK(arithmetic_add_broadcast_float64) {
+    // A 1024x1024 array plus a row
+    nd::array b = make_values<double>(1024, 3);
+    intptr_t shape[2] = {1024, 1024};
+    nd::array a = nd::make_strided_array(ndt::make_type<double>(), 2, shape);
+    a.val_assign(b);
+    while (st.keep_running()) {
+        nd::array result = (a + b).eval();
+        bench::do_not_optimize(result.get_readonly_originptr());
+    }
+    st.set_items_processed(arith_size);
+    st.set_bytes_processed(2 * arith_size * sizeof(double));
+}
@@ -0,0 +1,270 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/array.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/types/byteswap_type.hpp>
+#include <dynd/gfunc/call_callable.hpp>
+
+#include "benchmark.hpp"
+
+using namespace std;
+using namespace dynd;
+
+static const intptr_t assign_size = 1 << 20;
+
+/** Makes a one-dimensional array of `size` elements cycling through 0 to 99 */
+template<class T>
+static nd::array make_arange(intptr_t size)
+{
+    nd::array result = nd::empty(size, ndt::make_strided_dim(ndt::make_type<T>()));
+    T *data = reinterpret_cast<T *>(result.get_readwrite_originptr());
+    for (intptr_t i = 0; i < size; ++i) {
+        data[i] = static_cast<T>(i % 100);
+    }
+    return result;
+}
+
+template<class Dst, class Src>
+static void assign_contiguous(bench::state& st)
+{
+    nd::array src = make_arange<Src>(assign_size);
+    nd::array dst = nd::empty(assign_size, ndt::make_strided_dim(ndt::make_type<Dst>()));
+    while (st.keep_running()) {
+        dst.val_assign(src);
+    }
+    st.set_items_processed(assign_size);
+    st.set_bytes_processed(assign_size * (sizeof(Dst) + sizeof(Src)));
+}
+
+template<class Dst, class Src>
+static void assign_strided(bench::state& st)
+{
+    // Every other element of both source and destination
+    nd::array src = make_arange<Src>(2 * assign_size)(irange().by(2));
+    nd::array dst = nd::empty(2 * assign_size,
+                    ndt::make_strided_dim(ndt::make_type<Dst>()))(irange().by(2));
+    while (st.keep_running()) {
+        dst.val_assign(src);
+    }
+    st.set_items_processed(assign_size);
+    st.set_bytes_processed(assign_size * (sizeof(Dst) + sizeof(Src)));
+}
+
+template<class Dst, class Src>
+static void assign_reversed(bench::state& st)
+{
+    nd::array src = make_arange<Src>(assign_size)(irange().by(-1));
+    nd::array dst = nd::empty(assign_size, ndt::make_strided_dim(ndt::make_type<Dst>()));
+    while (st.keep_running()) {
+        dst.val_assign(src);
+    }
+    st.set_items_processed(assign_size);
+    st.set_bytes_processed(assign_size * (sizeof(Dst) + sizeof(Src)));
+}
+
+DYND_BENCHMARK(assign_int32_to_int32_contiguous) {
+    assign_contiguous<int32_t, int32_t>(st);
+}
+
+DYND_BENCHMARK(assign_int32_to_float64_contiguous) {
+    assign_contiguous<double, int32_t>(st);
+}
+
+DYND_BENCHMARK(assign_float64_to_float32_contiguous) {
+    assign_contiguous<float, double>(st);
+}
+
+DYND_BENCHMARK(assign_float64_to_int32_contiguous) {
+    assign_contiguous<int32_t, double>(st);
+}
+
+DYND_BENCHMARK(assign_int64_to_int8_contiguous) {
+    assign_contiguous<int8_t, int64_t>(st);
+}
+
+DYND_BENCHMARK(assign_float32_to_float16_contiguous) {
+    assign_contiguous<dynd_float16, float>(st);
+}
+
+DYND_BENCHMARK(assign_float16_to_float32_contiguous) {
+    assign_contiguous<float, dynd_float16>(st);
+}
+
+DYND_BENCHMARK(assign_float16_to_float64_contiguous) {
+    assign_contiguous<double, dynd_float16>(st);
+}
+
+DYND_BENCHMARK(assign_int32_to_int32_strided) {
+    assign_strided<int32_t, int32_t>(st);
+}
+
+DYND_BENCHMARK(assign_int32_to_float64_strided) {
+    assign_strided<double, int32_t>(st);
+}
+
+DYND_BENCHMARK(assign_float64_to_int32_strided) {
+    assign_strided<int32_t, double>(st);
+}
+
+DYND_BENCHMARK(assign_float64_to_float64_reversed) {
+    assign_reversed<double, double>(st);
+}
+
+template<class Dst, class Src>
+static void assign_from_byteswapped(bench::state& st)
+{
+    // Reinterprets the values as having non-native byte order
+    nd::array src = make_arange<Src>(assign_size).view_scalars(ndt::make_byteswap<Src>());
+    nd::array dst = nd::empty(assign_size, ndt::make_strided_dim(ndt::make_type<Dst>()));
+    while (st.keep_running()) {
+        dst.val_assign(src);
+    }
+    st.set_items_processed(assign_size);
+    st.set_bytes_processed(assign_size * (sizeof(Dst) + sizeof(Src)));
+}
+
+DYND_BENCHMARK(byteswap_int32_to_int32_contiguous) {
+    assign_from_byteswapped<int32_t, int32_t>(st);
+}
+
+DYND_BENCHMARK(byteswap_float64_to_float64_contiguous) {
+    assign_from_byteswapped<double, double>(st);
+}
+
+DYND_BENCHMARK(byteswap_int32_to_float64_contiguous) {
+    assign_from_byteswapped<double, int32_t>(st);
+}
+
+/** Assigns a C-order matrix to an F-order one, which is a transpose in memory */
+template<class T>
+static void assign_transposed(bench::state& st)
+{
+    intptr_t shape[2] = {2048, 2048};
+    int f_order[2] = {0, 1};
+    nd::array src = nd::make_strided_array(ndt::make_type<T>(), 2, shape);
+    nd::array dst = nd::make_strided_array(ndt::make_type<T>(), 2, shape,
+                    nd::read_access_flag|nd::write_access_flag, f_order);
+    memset(src.get_readwrite_originptr(), 0, shape[0] * shape[1] * sizeof(T));
+    while (st.keep_running()) {
+        dst.val_assign(src);
+    }
+    st.set_items_processed(shape[0] * shape[1]);
+    st.set_bytes_processed(2 * shape[0] * shape[1] * sizeof(T));
+}
+
+DYND_BENCHMARK(assign_float64_transposed) {
+    assign_transposed<double>(st);
+}
+
+DYND_BENCHMARK(assign_int8_transposed) {
+    assign_transposed<int8_t>(st);
+}
+
+DYND_BENCHMARK(assign_int8_chained_conversion) {
+    // Two conversions, buffered between each other
+    nd::array src = make_arange<int8_t>(assign_size).ucast<int16_t>().ucast<int32_t>();
+    nd::array dst = nd::empty(assign_size, ndt::make_strided_dim(ndt::make_type<int32_t>()));
+    while (st.keep_running()) {
+        dst.val_assign(src);
+    }
+    st.set_items_processed(assign_size);
+    st.set_bytes_processed(assign_size * (sizeof(int32_t) + sizeof(int8_t)));
+}
+
+DYND_BENCHMARK(struct_assign_reordered) {
+    // Reordered fields, with a run of int32 fields and one conversion
+    ndt::type src_tp("{a: int32, b: int32, c: int32, d: int32, x: float32, y: float64}");
+    ndt::type dst_tp("{x: float64, y: float64, a: int32, b: int32, c: int32, d: int32}");
+    nd::array src = nd::empty(assign_size, ndt::make_strided_dim(src_tp));
+    src.vals() = 1;
+    nd::array dst = nd::empty(assign_size, ndt::make_strided_dim(dst_tp));
+    while (st.keep_running()) {
+        dst.val_assign(src);
+    }
+    st.set_items_processed(assign_size);
+    st.set_bytes_processed(assign_size * (src_tp.get_data_size() + dst_tp.get_data_size()));
+}
+
+DYND_BENCHMARK(var_dim_copy_float64) {
+    // Many short rows, each of which needs allocating in the destination
+    nd::array rows = nd::empty("4096 * 16 * float64");
+    rows.vals() = 1.5;
+    nd::array src = nd::empty("4096 * var * float64");
+    src.val_assign(rows);
+    while (st.keep_running()) {
+        nd::array dst = nd::empty("4096 * var * float64");
+        dst.val_assign(src);
+    }
+    st.set_items_processed(4096 * 16);
+    st.set_bytes_processed(2 * 4096 * 16 * sizeof(double));
+}
+
+DYND_BENCHMARK(cast_int32_to_float64_eval) {
+    nd::array src = make_arange<int32_t>(assign_size);
+    while (st.keep_running()) {
+        nd::array result = src.ucast<double>().eval();
+        bench::do_not_optimize(result.get_readonly_originptr());
+    }
+    st.set_items_processed(assign_size);
+    st.set_bytes_processed(assign_size * (sizeof(int32_t) + sizeof(double)));
+}
+
+static const intptr_t string_size = 1 << 16;
+
+/** Makes an array of strings of the numbers 0 to 99 */
+static nd::array make_number_strings()
+{
+    nd::array result = nd::empty(string_size, ndt::make_strided_dim(ndt::make_string()));
+    result.val_assign(make_arange<int32_t>(string_size));
+    return result;
+}
+
+DYND_BENCHMARK(cast_int32_to_string) {
+    nd::array src = make_arange<int32_t>(string_size);
+    while (st.keep_running()) {
+        nd::array dst = nd::empty(string_size, ndt::make_strided_dim(ndt::make_string()));
+        dst.val_assign(src);
+    }
+    st.set_items_processed(string_size);
+}
+
+DYND_BENCHMARK(cast_string_to_int32) {
+    nd::array src = make_number_strings();
+    nd::array dst = nd::empty(string_size, ndt::make_strided_dim(ndt::make_type<int32_t>()));
+    while (st.keep_running()) {
+        dst.val_assign(src);
+    }
+    st.set_items_processed(string_size);
+}
+
+DYND_BENCHMARK(cast_string_to_float64) {
+    nd::array src = make_number_strings();
+    nd::array dst = nd::empty(string_size, ndt::make_strided_dim(ndt::make_type<double>()));
+    while (st.keep_running()) {
+        dst.val_assign(src);
+    }
+    st.set_items_processed(string_size);
+}
+
+DYND_BENCHMARK(string_find) {
+    nd::array src = make_number_strings();
+    nd::array sub = nd::array("99").ucast(ndt::make_string()).eval();
+    while (st.keep_running()) {
+        nd::array result = src.f("find", sub).eval();
+        bench::do_not_optimize(result.get_readonly_originptr());
+    }
+    st.set_items_processed(string_size);
+}
+
+DYND_BENCHMARK(string_copy) {
+    nd::array src = make_number_strings();
+    while (st.keep_running()) {
+        nd::array dst = nd::empty(string_size, ndt::make_strided_dim(ndt::make_string()));
+        dst.val_assign(src);
+    }
+    st.set_items_processed(string_size);
+}
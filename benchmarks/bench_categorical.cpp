@@ -0,0 +1,76 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <sstream>
+
+#include <dynd/array.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+#include <dynd/types/categorical_type.hpp>
+#include <dynd/types/string_type.hpp>
+
+#include "benchmark.hpp"
+
+using namespace std;
+using namespace dynd;
+
+static const intptr_t category_values = 100000, category_count = 100;
+
+/** Makes an array of strings with category_count distinct values */
+static nd::array make_category_strings()
+{
+    nd::array result = nd::empty(category_values, ndt::make_strided_dim(ndt::make_string()));
+    for (intptr_t i = 0; i < category_values; ++i) {
+        stringstream ss;
+        ss << "category " << (i * 7919) % category_count;
+        result(i).val_assign(ss.str());
+    }
+    return result;
+}
+
+DYND_BENCHMARK(factor_categorical_strings) {
+    nd::array values = make_category_strings();
+    while (st.keep_running()) {
+        ndt::type tp = ndt::factor_categorical(values);
+        bench::do_not_optimize(tp.extended());
+    }
+    st.set_items_processed(category_values);
+}
+
+DYND_BENCHMARK(factor_categorical_int32) {
+    nd::array values = nd::empty(category_values, ndt::make_strided_dim(ndt::make_type<int32_t>()));
+    int32_t *data = reinterpret_cast<int32_t *>(values.get_readwrite_originptr());
+    for (intptr_t i = 0; i < category_values; ++i) {
+        data[i] = (int32_t)((i * 7919) % category_count);
+    }
+    while (st.keep_running()) {
+        ndt::type tp = ndt::factor_categorical(values);
+        bench::do_not_optimize(tp.extended());
+    }
+    st.set_items_processed(category_values);
+}
+
+DYND_BENCHMARK(categorical_assign_from_strings) {
+    nd::array values = make_category_strings();
+    ndt::type tp = ndt::factor_categorical(values);
+    nd::array dst = nd::empty(category_values, ndt::make_strided_dim(tp));
+    while (st.keep_running()) {
+        dst.val_assign(values);
+    }
+    st.set_items_processed(category_values);
+}
+
+DYND_BENCHMARK(groupby_strings) {
+    nd::array by = make_category_strings();
+    nd::array data = nd::empty(category_values, ndt::make_strided_dim(ndt::make_type<double>()));
+    double *ptr = reinterpret_cast<double *>(data.get_readwrite_originptr());
+    for (intptr_t i = 0; i < category_values; ++i) {
+        ptr[i] = i * 0.5;
+    }
+    while (st.keep_running()) {
+        nd::array g = nd::groupby(data, by).eval();
+        bench::do_not_optimize(g.get_readonly_originptr());
+    }
+    st.set_items_processed(category_values);
+}
@@ -0,0 +1,48 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstring>
+
+#include <dynd/type.hpp>
+#include <dynd/types/datashape_parser.hpp>
+
+#include "benchmark.hpp"
+
+using namespace std;
+using namespace dynd;
+
+static void parse_datashape(bench::state& st, const char *ds)
+{
+    size_t len = strlen(ds);
+    while (st.keep_running()) {
+        ndt::type tp(ds, ds + len);
+        bench::do_not_optimize(tp.extended());
+    }
+    st.set_items_processed(1);
+    st.set_bytes_processed(len);
+}
+
+DYND_BENCHMARK(datashape_parse_builtin) {
+    parse_datashape(st, "float64");
+}
+
+DYND_BENCHMARK(datashape_parse_dims) {
+    parse_datashape(st, "strided * 3 * var * int32");
+}
+
+static const char *bench_struct_datashape = "strided * {id: int64, name: string, when: datetime,"
+                " tags: var * string, pos: 3 * float32,"
+                " inner: {a: int8, b: string[16], c: date}}";
+
+DYND_BENCHMARK(datashape_parse_struct) {
+    parse_datashape(st, bench_struct_datashape);
+}
+
+DYND_BENCHMARK(datashape_parse_struct_uncached) {
+    // The parser by itself, with the datashape cache disabled
+    set_datashape_cache_capacity(0);
+    parse_datashape(st, bench_struct_datashape);
+    set_datashape_cache_capacity(1024);
+}
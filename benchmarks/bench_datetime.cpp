@@ -0,0 +1,181 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/array.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+#include <dynd/types/date_type.hpp>
+#include <dynd/types/datetime_type.hpp>
+#include <dynd/types/busdate_type.hpp>
+#include <dynd/types/date_util.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/gfunc/call_callable.hpp>
+#include <dynd/json_formatter.hpp>
+
+#include "benchmark.hpp"
+
+using namespace std;
+using namespace dynd;
+
+static const intptr_t datetime_size = 1 << 20;
+
+/** Makes a one-dimensional array of dates spread over 1900 to 2100 */
+static nd::array make_dates(intptr_t size)
+{
+    nd::array result = nd::empty(size, ndt::make_strided_dim(ndt::make_date()));
+    int32_t *data = reinterpret_cast<int32_t *>(result.get_readwrite_originptr());
+    for (intptr_t i = 0; i < size; ++i) {
+        data[i] = static_cast<int32_t>(-25567 + (i * 7919) % 73049);
+    }
+    return result;
+}
+
+static void date_property(bench::state& st, const char *name)
+{
+    nd::array a = make_dates(datetime_size);
+    while (st.keep_running()) {
+        nd::array result = a.p(name).eval();
+        bench::do_not_optimize(result.get_readonly_originptr());
+    }
+    st.set_items_processed(datetime_size);
+}
+
+DYND_BENCHMARK(date_year) {
+    date_property(st, "year");
+}
+
+DYND_BENCHMARK(date_day) {
+    date_property(st, "day");
+}
+
+DYND_BENCHMARK(date_weekday) {
+    nd::array a = make_dates(datetime_size);
+    while (st.keep_running()) {
+        nd::array result = a.f("weekday").eval();
+        bench::do_not_optimize(result.get_readonly_originptr());
+    }
+    st.set_items_processed(datetime_size);
+}
+
+DYND_BENCHMARK(date_add_days) {
+    nd::array a = make_dates(datetime_size);
+    while (st.keep_running()) {
+        nd::array result = (a + 30).eval();
+        bench::do_not_optimize(result.get_readonly_originptr());
+    }
+    st.set_items_processed(datetime_size);
+}
+
+DYND_BENCHMARK(datetime_month) {
+    nd::array a = nd::empty(datetime_size, ndt::make_strided_dim(ndt::make_datetime(tz_utc)));
+    int64_t *data = reinterpret_cast<int64_t *>(a.get_readwrite_originptr());
+    for (intptr_t i = 0; i < datetime_size; ++i) {
+        data[i] = (-25567 + (i * 7919) % 73049) * DYND_TICKS_PER_DAY + (i * 104729) % DYND_TICKS_PER_DAY;
+    }
+    while (st.keep_running()) {
+        nd::array result = a.p("month").eval();
+        bench::do_not_optimize(result.get_readonly_originptr());
+    }
+    st.set_items_processed(datetime_size);
+}
+
+/** Formats the dates of make_dates, with a time for datetimes */
+static nd::array make_date_strings(intptr_t size, bool with_time)
+{
+    nd::array dates = make_dates(size);
+    const int32_t *data = reinterpret_cast<const int32_t *>(dates.get_readonly_originptr());
+    nd::array result = nd::empty(size, ndt::make_strided_dim(ndt::make_string()));
+    for (intptr_t i = 0; i < size; ++i) {
+        date_ymd ymd;
+        ymd.set_from_days(data[i]);
+        string s = ymd.to_str();
+        if (with_time) {
+            s += "T12:34:56.789";
+        }
+        result(i).vals() = s;
+    }
+    return result;
+}
+
+DYND_BENCHMARK(date_parse_iso8601) {
+    nd::array a = make_date_strings(datetime_size, false);
+    while (st.keep_running()) {
+        nd::array result = a.ucast(ndt::make_date()).eval();
+        bench::do_not_optimize(result.get_readonly_originptr());
+    }
+    st.set_items_processed(datetime_size);
+}
+
+DYND_BENCHMARK(datetime_parse_iso8601) {
+    nd::array a = make_date_strings(datetime_size, true);
+    while (st.keep_running()) {
+        nd::array result = a.ucast(ndt::make_datetime(tz_abstract)).eval();
+        bench::do_not_optimize(result.get_readonly_originptr());
+    }
+    st.set_items_processed(datetime_size);
+}
+
+DYND_BENCHMARK(date_strftime) {
+    nd::array a = make_dates(datetime_size);
+    while (st.keep_running()) {
+        nd::array result = a.f("strftime", "%d/%m/%Y day %j").eval();
+        bench::do_not_optimize(result.get_readonly_originptr());
+    }
+    st.set_items_processed(datetime_size);
+}
+
+DYND_BENCHMARK(date_format_json) {
+    nd::array a = make_dates(datetime_size);
+    while (st.keep_running()) {
+        nd::array result = format_json(a);
+        bench::do_not_optimize(result.get_readonly_originptr());
+    }
+    st.set_items_processed(datetime_size);
+}
+
+/** A weekday calendar with ten years of holidays, a couple a month */
+static ndt::type make_bench_busdate()
+{
+    vector<int32_t> holidays;
+    for (int32_t i = 0; i < 240; ++i) {
+        holidays.push_back(14975 + i * 15);
+    }
+    return ndt::make_busdate(busdate_roll_following, NULL,
+                    nd::array(holidays).view_scalars(ndt::make_date()));
+}
+
+DYND_BENCHMARK(busday_offset) {
+    nd::array a = make_dates(datetime_size);
+    ndt::type bd = make_bench_busdate();
+    while (st.keep_running()) {
+        nd::array result = nd::busday_offset(a, 3, bd).eval();
+        bench::do_not_optimize(result.get_readonly_originptr());
+    }
+    st.set_items_processed(datetime_size);
+}
+
+DYND_BENCHMARK(busday_count) {
+    nd::array a = make_dates(datetime_size);
+    ndt::type bd = make_bench_busdate();
+    nd::array b = (a + 45).eval();
+    while (st.keep_running()) {
+        nd::array result = nd::busday_count(a, b, bd).eval();
+        bench::do_not_optimize(result.get_readonly_originptr());
+    }
+    st.set_items_processed(datetime_size);
+}
+
+DYND_BENCHMARK(datetime_tz_convert) {
+    // Minutely in order, like a time series
+    nd::array a = nd::empty(datetime_size, ndt::make_strided_dim(ndt::make_datetime(tz_utc)));
+    int64_t *data = reinterpret_cast<int64_t *>(a.get_readwrite_originptr());
+    for (intptr_t i = 0; i < datetime_size; ++i) {
+        data[i] = 16000 * DYND_TICKS_PER_DAY + i * 600000000LL;
+    }
+    while (st.keep_running()) {
+        nd::array result = nd::tz_convert(a, "America/New_York").eval();
+        bench::do_not_optimize(result.get_readonly_originptr());
+    }
+    st.set_items_processed(datetime_size);
+}
@@ -0,0 +1,75 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <sstream>
+
+#include <dynd/array.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/json_formatter.hpp>
+
+#include "benchmark.hpp"
+
+using namespace std;
+using namespace dynd;
+
+static const intptr_t json_records = 10000;
+
+static const char *record_type = "var * {id: int32, name: string, score: float64, ok: bool}";
+
+/** Makes a JSON list of records matching record_type */
+static string make_json_records()
+{
+    stringstream ss;
+    ss << "[";
+    for (intptr_t i = 0; i < json_records; ++i) {
+        if (i != 0) {
+            ss << ",\n";
+        }
+        ss << "{\"id\": " << i << ", \"name\": \"record number " << i
+           << "\", \"score\": " << (i % 1000) * 0.125 << ", \"ok\": "
+           << ((i % 3) ? "true" : "false") << "}";
+    }
+    ss << "]";
+    return ss.str();
+}
+
+DYND_BENCHMARK(parse_json_records) {
+    string json = make_json_records();
+    ndt::type tp(record_type);
+    while (st.keep_running()) {
+        nd::array result = parse_json(tp, json);
+        bench::do_not_optimize(result.get_readonly_originptr());
+    }
+    st.set_items_processed(json_records);
+    st.set_bytes_processed(json.size());
+}
+
+DYND_BENCHMARK(parse_json_float64_list) {
+    stringstream ss;
+    ss << "[";
+    for (intptr_t i = 0; i < 100000; ++i) {
+        ss << (i != 0 ? ", " : "") << i * 0.001;
+    }
+    ss << "]";
+    string json = ss.str();
+    ndt::type tp("var * float64");
+    while (st.keep_running()) {
+        nd::array result = parse_json(tp, json);
+        bench::do_not_optimize(result.get_readonly_originptr());
+    }
+    st.set_items_processed(100000);
+    st.set_bytes_processed(json.size());
+}
+
+DYND_BENCHMARK(format_json_records) {
+    string json = make_json_records();
+    nd::array a = parse_json(ndt::type(record_type), json);
+    while (st.keep_running()) {
+        nd::array result = format_json(a);
+        bench::do_not_optimize(result.get_readonly_originptr());
+    }
+    st.set_items_processed(json_records);
+    st.set_bytes_processed(format_json(a).as<string>().size());
+}
@@ -0,0 +1,69 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/array.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+#include <dynd/kernels/reduction_kernels.hpp>
+#include <dynd/kernels/lift_reduction_ckernel_deferred.hpp>
+#include <dynd/types/ckernel_deferred_type.hpp>
+
+#include "benchmark.hpp"
+
+using namespace std;
+using namespace dynd;
+
+static const intptr_t reduce_rows = 1024, reduce_cols = 1024;
+
+/**
+ * Sums a 1024x1024 float32 array over the flagged axes,
+ * with the ckernel lifted and instantiated once outside the loop.
+ */
+static void lifted_sum(bench::state& st, bool reduce_axis0, bool reduce_axis1)
+{
+    nd::array reduction_kernel = nd::empty(ndt::make_ckernel_deferred());
+    kernels::make_builtin_sum_reduction_ckernel_deferred(
+                    reinterpret_cast<ckernel_deferred *>(reduction_kernel.get_readwrite_originptr()),
+                    float32_type_id);
+    ckernel_deferred ckd;
+    bool reduction_dimflags[2] = {reduce_axis0, reduce_axis1};
+    lift_reduction_ckernel_deferred(&ckd, reduction_kernel,
+                    ndt::type("strided * strided * float32"), nd::array(), false,
+                    2, reduction_dimflags, true, true, false, nd::array(0.f));
+
+    intptr_t shape[2] = {reduce_rows, reduce_cols};
+    nd::array a = nd::make_strided_array(ndt::make_type<float>(), 2, shape);
+    float *data = reinterpret_cast<float *>(a.get_readwrite_originptr());
+    for (intptr_t i = 0; i < reduce_rows * reduce_cols; ++i) {
+        data[i] = (float)(i % 17);
+    }
+    nd::array b;
+    if (reduce_axis0 && reduce_axis1) {
+        b = nd::empty(ndt::make_type<float>());
+    } else {
+        b = nd::empty(reduce_axis0 ? reduce_cols : reduce_rows,
+                        ndt::make_strided_dim(ndt::make_type<float>()));
+    }
+
+    assignment_ckernel_builder ckb;
+    const char *dynd_metadata[2] = {b.get_ndo_meta(), a.get_ndo_meta()};
+    ckd.instantiate_func(ckd.data_ptr, &ckb, 0, dynd_metadata, kernel_request_single);
+    while (st.keep_running()) {
+        ckb(b.get_readwrite_originptr(), a.get_readonly_originptr());
+    }
+    st.set_items_processed(reduce_rows * reduce_cols);
+    st.set_bytes_processed(reduce_rows * reduce_cols * sizeof(float));
+}
+
+DYND_BENCHMARK(lifted_sum_float32_axis0) {
+    lifted_sum(st, true, false);
+}
+
+DYND_BENCHMARK(lifted_sum_float32_axis1) {
+    lifted_sum(st, false, true);
+}
+
+DYND_BENCHMARK(lifted_sum_float32_all) {
+    lifted_sum(st, true, true);
+}
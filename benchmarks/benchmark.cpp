@@ -0,0 +1,196 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+# define NOMINMAX
+# include <Windows.h>
+#else
+# include <sys/time.h>
+#endif
+
+#include "benchmark.hpp"
+
+using namespace std;
+using namespace dynd;
+
+static double get_seconds()
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+#endif
+}
+
+bench::state::state(uint64_t max_iterations)
+    : m_max_iterations(max_iterations), m_iterations(0),
+        m_start_time(0), m_end_time(0), m_items(0), m_bytes(0)
+{
+}
+
+void bench::state::start_timer()
+{
+    m_start_time = get_seconds();
+}
+
+void bench::state::stop_timer()
+{
+    m_end_time = get_seconds();
+}
+
+namespace {
+    struct benchmark_entry {
+        string name;
+        bench::benchmark_function_t func;
+
+        bool operator<(const benchmark_entry& rhs) const {
+            return name < rhs.name;
+        }
+    };
+
+    // Constructed on first use, since registration happens
+    // during static initialization
+    vector<benchmark_entry>& get_registry() {
+        static vector<benchmark_entry> registry;
+        return registry;
+    }
+} // anonymous namespace
+
+bench::registrar::registrar(const char *name, benchmark_function_t func)
+{
+    benchmark_entry e;
+    e.name = name;
+    e.func = func;
+    get_registry().push_back(e);
+}
+
+void bench::do_not_optimize(const void *ptr)
+{
+    static volatile const void *sink;
+    sink = ptr;
+}
+
+/** Formats a rate like "12.3 M/s" */
+static string format_rate(double per_second, const char *unit)
+{
+    static const char *prefixes[] = {"", "k", "M", "G", "T"};
+    int prefix = 0;
+    while (per_second >= 1000 && prefix < 4) {
+        per_second /= 1000;
+        ++prefix;
+    }
+    stringstream ss;
+    ss << fixed << setprecision(per_second < 10 ? 2 : 1) << per_second
+       << " " << prefixes[prefix] << unit << "/s";
+    return ss.str();
+}
+
+/**
+ * Runs the benchmark with an increasing number of iterations until
+ * one run takes at least min_time seconds.
+ */
+static void run_benchmark(const benchmark_entry& e, double min_time, bool csv)
+{
+    uint64_t iterations = 1;
+    for (;;) {
+        bench::state st(iterations);
+        e.func(st);
+        double elapsed = st.get_elapsed_seconds();
+        if (elapsed >= min_time || iterations >= 1000000000ULL) {
+            double per_iter = elapsed / st.get_iterations();
+            double items = st.get_items_processed() / per_iter;
+            double bytes = st.get_bytes_processed() / per_iter;
+            if (csv) {
+                cout << e.name << "," << st.get_iterations() << ","
+                     << per_iter * 1e9 << "," << items << "," << bytes << endl;
+            } else {
+                cout << left << setw(48) << e.name << right
+                     << setw(12) << st.get_iterations()
+                     << setw(16) << fixed << setprecision(1) << per_iter * 1e9
+                     << setw(16) << (st.get_items_processed() ? format_rate(items, "") : "-")
+                     << setw(16) << (st.get_bytes_processed() ? format_rate(bytes, "B") : "-")
+                     << endl;
+            }
+            return;
+        }
+        // Aim a bit past the minimum time, based on this run
+        double scale = elapsed > 0 ? 1.4 * min_time / elapsed : 10;
+        uint64_t next = (uint64_t)(iterations * std::min(scale, 10.0));
+        iterations = std::max(next, iterations + 1);
+    }
+}
+
+static void print_usage(const char *argv0)
+{
+    cout << "Usage: " << argv0 << " [--min-time=SECONDS] [--csv] [--list] [FILTER...]\n";
+    cout << "Runs the benchmarks whose names contain any of the filters,\n";
+    cout << "or all of them when no filter is given.\n";
+}
+
+int main(int argc, char **argv)
+{
+    double min_time = 0.5;
+    bool csv = false, list_only = false;
+    vector<string> filters;
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--min-time=", 11) == 0) {
+            min_time = atof(argv[i] + 11);
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else if (strcmp(argv[i], "--list") == 0) {
+            list_only = true;
+        } else if (argv[i][0] == '-') {
+            print_usage(argv[0]);
+            return 1;
+        } else {
+            filters.push_back(argv[i]);
+        }
+    }
+
+    vector<benchmark_entry> benchmarks = get_registry();
+    sort(benchmarks.begin(), benchmarks.end());
+    if (csv) {
+        cout << "benchmark,iterations,ns_per_iteration,items_per_second,bytes_per_second" << endl;
+    } else if (!list_only) {
+        cout << left << setw(48) << "benchmark" << right << setw(12) << "iterations"
+             << setw(16) << "ns/iteration" << setw(16) << "items/s"
+             << setw(16) << "bytes/s" << endl;
+    }
+    for (size_t i = 0; i < benchmarks.size(); ++i) {
+        const benchmark_entry& e = benchmarks[i];
+        bool selected = filters.empty();
+        for (size_t j = 0; j < filters.size() && !selected; ++j) {
+            selected = (e.name.find(filters[j]) != string::npos);
+        }
+        if (!selected) {
+            continue;
+        }
+        if (list_only) {
+            cout << e.name << endl;
+            continue;
+        }
+        try {
+            run_benchmark(e, min_time, csv);
+        } catch (const exception& ex) {
+            cout << e.name << ": error: " << ex.what() << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
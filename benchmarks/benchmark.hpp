@@ -0,0 +1,105 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__BENCHMARK_HPP_
+#define _DYND__BENCHMARK_HPP_
+
+#include <string>
+
+#include <dynd/config.hpp>
+
+namespace dynd { namespace bench {
+
+/**
+ * The state passed to a benchmark function. The function does its
+ * setup, then runs the code being measured in a loop
+ *
+ *     while (st.keep_running()) {
+ *         ...
+ *     }
+ *
+ * and finally reports how much work one pass of the loop does
+ * with set_items_processed and set_bytes_processed. Only the
+ * time spent in the loop is measured.
+ */
+class state {
+    uint64_t m_max_iterations, m_iterations;
+    double m_start_time, m_end_time;
+    int64_t m_items, m_bytes;
+public:
+    explicit state(uint64_t max_iterations);
+
+    /**
+     * Returns true while the loop should run another pass,
+     * starting the timer on the first call and stopping
+     * it on the last.
+     */
+    inline bool keep_running() {
+        if (m_iterations == 0) {
+            start_timer();
+        } else if (m_iterations == m_max_iterations) {
+            stop_timer();
+            return false;
+        }
+        ++m_iterations;
+        return true;
+    }
+
+    /** The number of elements processed by one pass of the loop */
+    inline void set_items_processed(int64_t items) {
+        m_items = items;
+    }
+
+    /** The number of bytes read and written by one pass of the loop */
+    inline void set_bytes_processed(int64_t bytes) {
+        m_bytes = bytes;
+    }
+
+    inline uint64_t get_iterations() const {
+        return m_iterations;
+    }
+    inline double get_elapsed_seconds() const {
+        return m_end_time - m_start_time;
+    }
+    inline int64_t get_items_processed() const {
+        return m_items;
+    }
+    inline int64_t get_bytes_processed() const {
+        return m_bytes;
+    }
+
+private:
+    void start_timer();
+    void stop_timer();
+};
+
+typedef void (*benchmark_function_t)(state& st);
+
+/**
+ * Adds a benchmark to the list run by the benchmark driver.
+ * Use the DYND_BENCHMARK macro instead of calling this directly.
+ */
+struct registrar {
+    registrar(const char *name, benchmark_function_t func);
+};
+
+/**
+ * Keeps the compiler from optimizing away
+ * a computation whose result is unused.
+ */
+void do_not_optimize(const void *ptr);
+
+}} // namespace dynd::bench
+
+/**
+ * Defines and registers a benchmark function, whose
+ * body has a `dynd::bench::state& st` parameter.
+ */
+#define DYND_BENCHMARK(name) \
+    static void name(::dynd::bench::state& st); \
+    static ::dynd::bench::registrar name##_registrar(#name, &name); \
+    static void name(::dynd::bench::state& st)
+
+#endif // _DYND__BENCHMARK_HPP_
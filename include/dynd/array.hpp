@@ -17,6 +17,7 @@
 #include <dynd/shortvector.hpp>
 #include <dynd/irange.hpp>
 #include <dynd/memblock/array_memory_block.hpp>
+#include <dynd/memblock/memmap_memory_block.hpp>
 
 namespace dynd { namespace nd {
 
@@ -1266,19 +1267,48 @@ array empty_like(const array& rhs);
  * \param end  If provided, the end of where to memory map. Uses
  *             Python semantics for out of bounds and negative values.
  * \param access  The access permissions with which to open the file.
+ * \param advice  A hint about how the mapped memory will be accessed.
  */
 array memmap(const std::string& filename,
     intptr_t begin = 0,
     intptr_t end = std::numeric_limits<intptr_t>::max(),
-    uint32_t access = default_access_flags);
+    uint32_t access = default_access_flags,
+    memmap_advice_t advice = memmap_advice_normal);
+
+/**
+ * Memory-maps a file as an array of the given dynd type, viewing
+ * the file's bytes directly.
+ *
+ * The type must have fixed-size data without references to other
+ * memory, like builtin types, fixedstrings, cstructs and fixed
+ * dimensions. If it starts with a strided dimension, as in
+ * "strided * {x: int32, y: float64}", the size of that dimension
+ * is the number of whole elements in the file after 'offset',
+ * which must be an exact multiple of the element size. Otherwise
+ * the file must have at least the type's data size after 'offset'.
+ * The mapped data must be aligned as the type requires.
+ *
+ * \param filename  The name of the file to memory map.
+ * \param tp  The dynd type of the data in the file.
+ * \param offset  The position in the file where the data starts. Uses
+ *                Python semantics for out of bounds and negative values.
+ * \param access  The access permissions with which to open the file.
+ * \param advice  A hint about how the mapped memory will be accessed.
+ */
+array memmap(const std::string& filename,
+    const ndt::type& tp,
+    intptr_t offset = 0,
+    uint32_t access = default_access_flags,
+    memmap_advice_t advice = memmap_advice_normal);
 
 /**
  * Performs a binary search of the first dimension of the array, which
- * should be sorted. The data/metadata must correspond to the type n.get_type().at(0).
+ * should be sorted. The metadata/data must correspond to the type n.get_type().at(0).
+ * To look up many values at once, see nd::searchsorted in sort.hpp.
  *
  * \returns  The index of the found element, or -1 if not found.
  */
-intptr_t binary_search(const array& n, const char *data, const char *metadata);
+intptr_t binary_search(const array& n, const char *metadata, const char *data);
 
 array groupby(const array& data_values, const array& by,
                 const ndt::type& groups = ndt::type());
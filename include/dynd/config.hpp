@@ -193,6 +193,37 @@ namespace dynd {
  */
 #define DYND_UNUSED(x)
 
+/**
+ * Preprocessor macro for hinting that the memory at an
+ * address will be read soon.
+ */
+#if defined(__GNUC__)
+# define DYND_PREFETCH(ptr) __builtin_prefetch(ptr)
+#else
+# define DYND_PREFETCH(ptr)
+#endif
+
+/**
+ * Preprocessor macros for compiling a function for a particular
+ * instruction set, so kernel tables can hold variants for several
+ * of them and pick one at runtime with get_cpu_isa() from
+ * <dynd/cpu_features.hpp>. A function marked this way must only be
+ * called after checking the CPU supports it. The shared loop bodies
+ * are marked DYND_FORCE_INLINE so they get compiled into each variant.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(__CUDACC__) && \
+                (defined(__x86_64__) || defined(__i386__))
+# define DYND_USE_TARGET_ATTRIBUTES
+# define DYND_TARGET_SSE4_2 __attribute__((target("sse4.2,popcnt")))
+# define DYND_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+# define DYND_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512vl,avx2,fma,f16c")))
+# define DYND_FORCE_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+# define DYND_FORCE_INLINE __forceinline
+#else
+# define DYND_FORCE_INLINE inline
+#endif
+
 #ifdef DYND_USE_STDINT
 #include <stdint.h>
 #else
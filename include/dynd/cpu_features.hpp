@@ -0,0 +1,102 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__CPU_FEATURES_HPP_
+#define _DYND__CPU_FEATURES_HPP_
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+
+/**
+ * Instruction set features of the CPU, as bit flags. A feature
+ * which needs operating system support, like the AVX registers,
+ * is only reported when the operating system saves that state.
+ */
+enum cpu_feature_t {
+    cpu_feature_sse2 = 0x0001,
+    cpu_feature_ssse3 = 0x0002,
+    cpu_feature_sse4_1 = 0x0004,
+    cpu_feature_sse4_2 = 0x0008,
+    cpu_feature_popcnt = 0x0010,
+    cpu_feature_avx = 0x0020,
+    cpu_feature_avx2 = 0x0040,
+    cpu_feature_fma = 0x0080,
+    cpu_feature_f16c = 0x0100,
+    cpu_feature_avx512f = 0x0200,
+    cpu_feature_avx512bw = 0x0400,
+    cpu_feature_avx512vl = 0x0800
+};
+
+/**
+ * The instruction set levels that kernel tables may have variants
+ * for, in increasing order. Each level includes the features of
+ * the levels before it.
+ */
+enum cpu_isa_t {
+    // The target the library was compiled for
+    cpu_isa_baseline,
+    // SSE4.2 and POPCNT
+    cpu_isa_sse4_2,
+    // AVX2, FMA and F16C
+    cpu_isa_avx2,
+    // AVX-512 F, BW and VL
+    cpu_isa_avx512,
+    cpu_isa_count
+};
+
+/**
+ * Returns the cpu_feature_t flags of the CPU
+ * the process is running on.
+ */
+uint32_t get_cpu_features();
+
+/**
+ * Returns true if the CPU has all the features in `features`,
+ * a combination of cpu_feature_t flags.
+ */
+inline bool has_cpu_features(uint32_t features) {
+    return (get_cpu_features() & features) == features;
+}
+
+/**
+ * Returns the instruction set level used to pick kernel variants.
+ * This is the highest level the CPU supports and the library was
+ * compiled with variants for, capped by the DYND_CPU_ISA environment
+ * variable ("baseline", "sse4.2", "avx2" or "avx512") when it is set.
+ * It is determined once, the first time it is needed.
+ */
+cpu_isa_t get_cpu_isa();
+
+/**
+ * Returns the name of an instruction set level, matching
+ * the values accepted in DYND_CPU_ISA.
+ */
+const char *get_cpu_isa_name(cpu_isa_t isa);
+
+/**
+ * Picks the variant for the highest instruction set level up to
+ * `isa` from an array of cpu_isa_count variants indexed by cpu_isa_t.
+ * NULL entries are variants which weren't compiled, the baseline
+ * entry must always be present.
+ *
+ * Kernel tables call this once per process, with get_cpu_isa(), like
+ *
+ *     static const table_t *table = select_cpu_isa_variant(table_variants, get_cpu_isa());
+ */
+template<class T>
+inline T select_cpu_isa_variant(const T *variants, cpu_isa_t isa)
+{
+    for (int i = isa; i > cpu_isa_baseline; --i) {
+        if (variants[i] != NULL) {
+            return variants[i];
+        }
+    }
+    return variants[cpu_isa_baseline];
+}
+
+} // namespace dynd
+
+#endif // _DYND__CPU_FEATURES_HPP_
@@ -11,6 +11,10 @@
 
 namespace dynd {
 
+namespace nd {
+    class array;
+} // namespace nd
+
 struct dim_iter;
 
 enum dim_iter_flags {
@@ -132,6 +136,29 @@ void make_buffered_strided_dim_iter(
     const memory_block_ptr& ref, intptr_t buffer_max_mem = 65536,
     const eval::eval_context *ectx = &eval::default_eval_context);
 
+/**
+ * Creates a dim_iter over the outermost dimension of an array, which
+ * provides the elements evaluated to their canonical type. When the
+ * array contains expression types, the elements are evaluated a chunk
+ * at a time into one reusable buffer, instead of materializing the
+ * whole result like nd::array::eval() does. This keeps the memory use
+ * bounded and the evaluated data in cache for the consumer.
+ *
+ * The data of a chunk is only valid until the next call to `next`
+ * or `seek`.
+ *
+ * \param out_di  An uninitialized dim_iter object. The function
+ *                populates it assuming it is filled with garbage.
+ * \param a  The array to iterate over. Its outermost dimension
+ *           must be a strided_dim or fixed_dim.
+ * \param buffer_max_mem  The maximum amount of memory to use for the temporary buffer.
+ * \param ectx  The evaluation context.
+ */
+void make_eval_dim_iter(
+    dim_iter *out_di, const nd::array& a,
+    intptr_t buffer_max_mem = 65536,
+    const eval::eval_context *ectx = &eval::default_eval_context);
+
 /**
  * Makes an iterator which is empty.
  *
@@ -9,15 +9,43 @@
 #include <dynd/config.hpp>
 #include <dynd/typed_data_assign.hpp>
 
-namespace dynd { namespace eval {
+namespace dynd {
+
+class ckernel_profile;
+
+namespace eval {
 
 struct eval_context {
     assign_error_mode default_assign_error_mode;
     assign_error_mode default_cuda_device_to_device_assign_error_mode;
+    /**
+     * When not NULL, every assignment ckernel created with this
+     * context is wrapped in a profiling ckernel reporting to this
+     * profile. See <dynd/kernels/ckernel_profile.hpp>.
+     */
+    ckernel_profile *profile;
+    /**
+     * The target size in bytes of the temporary buffer in
+     * buffered strided kernels, like the ones chaining expression
+     * types. The number of elements buffered at a time is chosen
+     * from this and the element size, so the buffer and the
+     * data passing through it stay in the L1 cache.
+     */
+    size_t buffer_max_mem;
+    /**
+     * When true, kernels parsing strings as dates or datetimes
+     * pick the format from the first string they parse, instead
+     * of trying the fixed ISO 8601 format for every string. If it
+     * was ISO 8601, any later string in another format is an error,
+     * otherwise the remaining strings skip the ISO 8601 fast path.
+     */
+    bool lock_date_format;
 
     DYND_CONSTEXPR eval_context()
         : default_assign_error_mode(assign_error_fractional),
-            default_cuda_device_to_device_assign_error_mode(assign_error_none)
+            default_cuda_device_to_device_assign_error_mode(assign_error_none),
+            profile(NULL), buffer_max_mem(8192),
+            lock_date_format(false)
     {
     }
 };
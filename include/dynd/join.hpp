@@ -0,0 +1,68 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__JOIN_HPP_
+#define _DYND__JOIN_HPP_
+
+#include <string>
+
+#include <dynd/array.hpp>
+#include <dynd/eval/eval_context.hpp>
+
+namespace dynd {
+
+enum join_kind_t {
+    // Only the rows whose keys appear in both inputs
+    inner_join,
+    // Every row of the left input, with the right fields zero-filled
+    // (0 for numbers, "" for strings) when there is no match
+    left_join
+};
+
+namespace nd {
+
+/**
+ * Joins two one-dimensional arrays of struct or cstruct elements on
+ * the values of one or more key fields. The result is a strided array
+ * of cstruct, whose fields are the key fields, followed by the other
+ * fields of `left`, followed by the other fields of `right`. Rows are
+ * produced in the order of `left`, and matching rows of `right` are
+ * produced in their original order.
+ *
+ * When both inputs are already sorted by their keys, as by `nd::sort`,
+ * a merge join is used. Otherwise the right input is placed in a hash
+ * table partitioned by the high bits of the key hash, and probed with
+ * the left rows.
+ *
+ * The key fields must have the same types in both inputs, and the
+ * non-key field names must not overlap.
+ *
+ * \param left  The left input, a one-dimensional array of structs.
+ * \param right  The right input, a one-dimensional array of structs.
+ * \param key_count  The number of key fields.
+ * \param key_names  The names of the key fields.
+ * \param kind  Whether to do an inner or a left join.
+ * \param ectx  DyND evaluation context.
+ */
+array join(const array& left, const array& right,
+                size_t key_count, const std::string *key_names,
+                join_kind_t kind = inner_join,
+                const eval::eval_context *ectx = &eval::default_eval_context);
+
+/**
+ * Joins two one-dimensional arrays of structs on a single key field.
+ */
+inline array join(const array& left, const array& right,
+                const std::string& key_name, join_kind_t kind = inner_join,
+                const eval::eval_context *ectx = &eval::default_eval_context)
+{
+    return join(left, right, 1, &key_name, kind, ectx);
+}
+
+} // namespace nd
+
+} // namespace dynd
+
+#endif // _DYND__JOIN_HPP_
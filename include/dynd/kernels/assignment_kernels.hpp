@@ -13,11 +13,23 @@
 #include <dynd/typed_data_assign.hpp>
 #include <dynd/types/type_id.hpp>
 
-/** The number of elements buffered when chaining expressions */
-#define DYND_BUFFER_CHUNK_SIZE ((size_t)128)
-
 namespace dynd {
 
+/**
+ * Returns the number of elements to process at a time through
+ * a temporary buffer, for elements of size `element_size`. This
+ * fills about `ectx->buffer_max_mem` bytes, and is at least one.
+ */
+inline size_t get_buffer_element_count(size_t element_size, const eval::eval_context *ectx)
+{
+    size_t buffer_max_mem = (ectx != NULL) ? ectx->buffer_max_mem
+                                           : eval::default_eval_context.buffer_max_mem;
+    if (element_size == 0 || element_size >= buffer_max_mem) {
+        return 1;
+    }
+    return buffer_max_mem / element_size;
+}
+
 /** Typedef for a unary operation on a single element */
 typedef void (*unary_single_operation_t)(char *dst, const char *src,
                 ckernel_prefix *extra);
@@ -183,6 +195,33 @@ struct strided_assign_kernel_extra {
     static void destruct(ckernel_prefix *extra);
 };
 
+/**
+ * Assignment kernel + destructor for two strided dimensions
+ * at once, which visits the elements in tiles of
+ * block_size0 x block_size1. This keeps the accesses of both src
+ * and dst within a few cache lines and pages when their axis
+ * orders differ, as in a transpose. Dimension 1 is the inner
+ * loop within a tile, and either can be the array's first
+ * dimension. This requires that the child kernel be created with
+ * the kernel_request_strided type of kernel.
+ */
+struct blocked_assign_kernel_extra {
+    typedef blocked_assign_kernel_extra extra_type;
+
+    ckernel_prefix base;
+    intptr_t size0, size1;
+    intptr_t dst_stride0, src_stride0;
+    intptr_t dst_stride1, src_stride1;
+    intptr_t block_size0, block_size1;
+
+    static void single(char *dst, const char *src,
+                    ckernel_prefix *extra);
+    static void strided(char *dst, intptr_t dst_stride,
+                    const char *src, intptr_t src_stride,
+                    size_t count, ckernel_prefix *extra);
+    static void destruct(ckernel_prefix *extra);
+};
+
 #ifdef DYND_CUDA
 /**
  * Creates an assignment kernel for one data value from the
@@ -0,0 +1,43 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__BUSDATE_KERNELS_HPP_
+#define _DYND__BUSDATE_KERNELS_HPP_
+
+#include <dynd/kernels/expr_kernel_generator.hpp>
+#include <dynd/types/busdate_type.hpp>
+
+namespace dynd {
+
+/**
+ * Makes a kernel generator which offsets dates by a number of
+ * business days in the calendar of a busdate type, rolling dates
+ * which aren't business days first with the type's roll policy.
+ *
+ * (date, int32) -> date
+ */
+expr_kernel_generator *make_busday_offset_kernelgen(const ndt::type& busdate_tp);
+
+/**
+ * Makes a kernel generator which counts the business days in the
+ * calendar of a busdate type from the first date, inclusive, to the
+ * second date, exclusive. The count is negative if the second date
+ * is earlier. If either date is NA, the count is DYND_DATE_NA.
+ *
+ * (date, date) -> int32
+ */
+expr_kernel_generator *make_busday_count_kernelgen(const ndt::type& busdate_tp);
+
+/**
+ * Makes a kernel generator which checks whether dates are business
+ * days in the calendar of a busdate type.
+ *
+ * (date) -> bool
+ */
+expr_kernel_generator *make_is_busday_kernelgen(const ndt::type& busdate_tp);
+
+} // namespace dynd
+
+#endif // _DYND__BUSDATE_KERNELS_HPP_
@@ -59,6 +59,24 @@ size_t make_pairwise_byteswap_assignment_function(
                 intptr_t data_size, intptr_t data_alignment,
                 kernel_request_t kernreq);
 
+/**
+ * Returns true if make_byteswap_convert_assignment_kernel
+ * supports the pair of types.
+ */
+bool has_byteswap_convert_assignment_kernel(type_id_t dst_type_id, type_id_t src_type_id);
+
+/**
+ * Creates an assignment kernel which byteswaps a value of
+ * the built-in type `src_type_id` and converts it to the built-in
+ * type `dst_type_id` in one pass, without error checking. This
+ * is for reading non-native byte order data like network-order
+ * files, the integer and float32/float64 types are supported.
+ */
+size_t make_byteswap_convert_assignment_kernel(
+                ckernel_builder *out, size_t offset_out,
+                type_id_t dst_type_id, type_id_t src_type_id,
+                kernel_request_t kernreq);
+
 } // namespace dynd
 
 #endif // _DYND__BYTESWAP_KERNELS_HPP_
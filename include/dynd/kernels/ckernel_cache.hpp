@@ -0,0 +1,160 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__CKERNEL_CACHE_HPP_
+#define _DYND__CKERNEL_CACHE_HPP_
+
+#include <dynd/types/type_id.hpp>
+#include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/kernels/comparison_kernels.hpp>
+#include <dynd/eval/eval_context.hpp>
+
+namespace dynd {
+
+namespace ndt {
+    class type;
+} // namespace ndt
+
+/**
+ * The counters of the process-wide ckernel cache.
+ */
+struct ckernel_cache_stats {
+    /** Requests served by a cached ckernel */
+    uint64_t hits;
+    /** Requests which had to instantiate a new ckernel */
+    uint64_t misses;
+    /** Requests for types the cache can't hold, which always instantiate */
+    uint64_t bypasses;
+    /** Cached ckernels freed to stay within the capacity */
+    uint64_t evictions;
+    /** The number of ckernels presently in the cache */
+    size_t size;
+};
+
+/**
+ * Returns a snapshot of the process-wide ckernel cache counters.
+ */
+ckernel_cache_stats get_ckernel_cache_stats();
+
+/**
+ * Frees all the ckernels presently in the cache,
+ * and resets its counters to zero.
+ */
+void clear_ckernel_cache();
+
+/**
+ * Sets how many idle ckernels the cache keeps, freeing the
+ * least recently used ones beyond that. A capacity of zero
+ * disables the cache. The default capacity is 256.
+ */
+void set_ckernel_cache_capacity(size_t capacity);
+
+namespace detail {
+    struct ckernel_cache_entry;
+} // namespace detail
+
+/**
+ * A ckernel taken from the process-wide cache of instantiated
+ * ckernels, which is returned to the cache on destruction.
+ *
+ * The cache is keyed by the types, the kernel request, the error
+ * mode or comparison type, the evaluation context, and the bytes of
+ * the metadata. Each cached ckernel is instantiated against the
+ * cache's own copy of the metadata, so pointers into the metadata
+ * stay valid for any caller whose metadata has the same bytes. Types
+ * whose metadata refers to memory blocks (strings, var dims, pointers)
+ * bypass the cache, because their metadata identifies the data.
+ * So do evaluation contexts with a profile or with lock_date_format,
+ * whose ckernels keep results from each call in their data.
+ *
+ * A ckernel is only ever held by one of these objects at a time, so
+ * ckernels with state in their data, like buffered kernels, are safe
+ * to use from several threads.
+ */
+class cached_ckernel {
+    detail::ckernel_cache_entry *m_entry;
+
+    // Non-copyable
+    cached_ckernel(const cached_ckernel&);
+    cached_ckernel& operator=(const cached_ckernel&);
+protected:
+    cached_ckernel()
+        : m_entry(NULL)
+    {
+    }
+
+    void acquire_assignment(const ndt::type& dst_tp, const char *dst_metadata,
+                    const ndt::type& src_tp, const char *src_metadata,
+                    kernel_request_t kernreq, assign_error_mode errmode,
+                    const eval::eval_context *ectx);
+
+    void acquire_comparison(const ndt::type& src0_tp, const char *src0_metadata,
+                    const ndt::type& src1_tp, const char *src1_metadata,
+                    comparison_type_t comptype,
+                    const eval::eval_context *ectx);
+public:
+    ~cached_ckernel();
+
+    /** The root of the ckernel tree */
+    ckernel_prefix *get() const;
+};
+
+/**
+ * A cached single or strided assignment ckernel, the
+ * cached equivalent of make_assignment_kernel.
+ */
+class cached_assignment_ckernel : public cached_ckernel {
+public:
+    cached_assignment_ckernel(const ndt::type& dst_tp, const char *dst_metadata,
+                    const ndt::type& src_tp, const char *src_metadata,
+                    kernel_request_t kernreq, assign_error_mode errmode,
+                    const eval::eval_context *ectx)
+    {
+        acquire_assignment(dst_tp, dst_metadata, src_tp, src_metadata,
+                        kernreq, errmode, ectx);
+    }
+
+    /** Calls the ckernel, which must be a kernel_request_single one */
+    inline void operator()(char *dst, const char *src) const {
+        ckernel_prefix *kdp = get();
+        unary_single_operation_t fn = kdp->get_function<unary_single_operation_t>();
+        fn(dst, src, kdp);
+    }
+
+    /** Calls the ckernel, which must be a kernel_request_strided one */
+    inline void operator()(char *dst, intptr_t dst_stride,
+                const char *src, intptr_t src_stride, size_t count) const {
+        ckernel_prefix *kdp = get();
+        unary_strided_operation_t fn = kdp->get_function<unary_strided_operation_t>();
+        fn(dst, dst_stride, src, src_stride, count, kdp);
+    }
+};
+
+/**
+ * A cached comparison ckernel, the cached
+ * equivalent of make_comparison_kernel.
+ */
+class cached_comparison_ckernel : public cached_ckernel {
+public:
+    cached_comparison_ckernel(const ndt::type& src0_tp, const char *src0_metadata,
+                    const ndt::type& src1_tp, const char *src1_metadata,
+                    comparison_type_t comptype,
+                    const eval::eval_context *ectx)
+    {
+        acquire_comparison(src0_tp, src0_metadata, src1_tp, src1_metadata,
+                        comptype, ectx);
+    }
+
+    /** Calls the comparison ckernel */
+    inline bool operator()(const char *src0, const char *src1) const {
+        ckernel_prefix *kdp = get();
+        binary_single_predicate_t fn = kdp->get_function<binary_single_predicate_t>();
+        return fn(src0, src1, kdp) != 0;
+    }
+};
+
+} // namespace dynd
+
+#endif // _DYND__CKERNEL_CACHE_HPP_
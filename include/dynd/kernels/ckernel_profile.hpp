@@ -0,0 +1,112 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__CKERNEL_PROFILE_HPP_
+#define _DYND__CKERNEL_PROFILE_HPP_
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <dynd/kernels/ckernel_builder.hpp>
+#include <dynd/type.hpp>
+
+namespace dynd {
+
+/**
+ * One node of a ckernel profile, corresponding to one
+ * ckernel in a ckernel tree. The counters of a node include
+ * the time spent in its children.
+ */
+struct ckernel_profile_node {
+    /** The kernel's types, like "string -> int32" */
+    std::string name;
+    /** The number of times the ckernel function was called */
+    uint64_t calls;
+    /** The number of elements processed, one per single call */
+    uint64_t elements;
+    /**
+     * The time spent in the ckernel, in CPU cycles where a cycle
+     * counter is available, and in nanoseconds otherwise.
+     */
+    uint64_t cycles;
+    std::vector<ckernel_profile_node *> children;
+
+    ckernel_profile_node()
+        : calls(0), elements(0), cycles(0)
+    {
+    }
+
+    /** The cycles spent in this node excluding its children */
+    uint64_t get_self_cycles() const;
+};
+
+namespace detail {
+    struct ckernel_profile_data;
+} // namespace detail
+
+/**
+ * Collects per-ckernel call counts, element counts, and timings.
+ * Profiling is enabled by pointing the `profile` field of an
+ * eval_context at one of these, which makes make_assignment_kernel
+ * wrap every ckernel it creates, including all the child ckernels,
+ * in a timing ckernel. For example,
+ *
+ *     ckernel_profile prof;
+ *     eval::eval_context ectx;
+ *     ectx.profile = &prof;
+ *     b.val_assign(a, assign_error_default, &ectx);
+ *     prof.dump(cout);
+ *
+ * shows each stage of the assignment with its totals. The counters
+ * are not synchronized, so a profiled ckernel should only be called
+ * from one thread at a time. Profiled ckernels are never cached.
+ */
+class ckernel_profile {
+    detail::ckernel_profile_data *m_data;
+
+    // Non-copyable
+    ckernel_profile(const ckernel_profile&);
+    ckernel_profile& operator=(const ckernel_profile&);
+public:
+    ckernel_profile();
+    ~ckernel_profile();
+
+    /** The number of top level ckernels profiled so far */
+    size_t get_root_count() const;
+
+    /** The root node of the i-th top level ckernel */
+    const ckernel_profile_node& get_root(size_t i) const;
+
+    /** Sets all the counters to zero, keeping the ckernel trees */
+    void reset();
+
+    /**
+     * Removes all the ckernel trees. Ckernels created before this
+     * continue to work, but no longer report to this profile.
+     */
+    void clear();
+
+    /** Prints the ckernel trees with the totals of each node */
+    void dump(std::ostream& o) const;
+
+    /**
+     * Used during ckernel construction, places a profiling ckernel
+     * at `offset_out` with a new node named `name` under the ckernel
+     * currently being constructed. The ckernel being profiled must
+     * be placed at the returned offset. Call end_kernel afterwards,
+     * passing the value returned in `out_parent`.
+     */
+    size_t begin_kernel(ckernel_builder *out, size_t offset_out,
+                    kernel_request_t kernreq, const std::string& name,
+                    ckernel_profile_node **out_parent);
+
+    /** Finishes the construction started by begin_kernel */
+    void end_kernel(ckernel_profile_node *parent);
+};
+
+} // namespace dynd
+
+#endif // _DYND__CKERNEL_PROFILE_HPP_
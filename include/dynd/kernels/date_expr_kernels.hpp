@@ -14,6 +14,51 @@ namespace dynd {
 expr_kernel_generator *make_strftime_kernelgen(const std::string& format);
 expr_kernel_generator *make_replace_kernelgen(int32_t year, int32_t month, int32_t day);
 
+namespace kernels {
+    /**
+     * Date plus a number of days kernel, where NA stays NA. A result
+     * which doesn't fit in int32 is NA.
+     *
+     * (date, int32) -> date
+     */
+    struct date_add_days_kernel {
+        static void single(char *dst, const char * const *src,
+                    ckernel_prefix *extra);
+        static void strided(char *dst, intptr_t dst_stride,
+                    const char * const *src, const intptr_t *src_stride,
+                    size_t count, ckernel_prefix *extra);
+    };
+
+    /**
+     * Date minus a number of days kernel, where NA stays NA. A result
+     * which doesn't fit in int32 is NA.
+     *
+     * (date, int32) -> date
+     */
+    struct date_subtract_days_kernel {
+        static void single(char *dst, const char * const *src,
+                    ckernel_prefix *extra);
+        static void strided(char *dst, intptr_t dst_stride,
+                    const char * const *src, const intptr_t *src_stride,
+                    size_t count, ckernel_prefix *extra);
+    };
+
+    /**
+     * Date minus date kernel, giving the number of days between them.
+     * If either date is NA, or the difference doesn't fit in int32,
+     * the result is DYND_DATE_NA.
+     *
+     * (date, date) -> int32
+     */
+    struct date_difference_kernel {
+        static void single(char *dst, const char * const *src,
+                    ckernel_prefix *extra);
+        static void strided(char *dst, intptr_t dst_stride,
+                    const char * const *src, const intptr_t *src_stride,
+                    size_t count, ckernel_prefix *extra);
+    };
+} // namespace kernels
+
 } // namespace dynd
 
 #endif // _DYND__DATE_EXPR_KERNELS_HPP_
@@ -0,0 +1,33 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__DATETIME_TZ_KERNELS_HPP_
+#define _DYND__DATETIME_TZ_KERNELS_HPP_
+
+#include <dynd/kernels/expr_kernel_generator.hpp>
+#include <dynd/types/tzdata.hpp>
+
+namespace dynd {
+
+/**
+ * Makes a kernel generator which converts UTC datetimes to the
+ * wall clock time of a time zone.
+ *
+ * (datetime[tz='UTC']) -> datetime
+ */
+expr_kernel_generator *make_tz_convert_kernelgen(const tz_transitions& tz);
+
+/**
+ * Makes a kernel generator which converts wall clock datetimes in
+ * a time zone to UTC. Local times which are ambiguous or skipped
+ * use the UTC offset from before the transition.
+ *
+ * (datetime) -> datetime[tz='UTC']
+ */
+expr_kernel_generator *make_tz_localize_kernelgen(const tz_transitions& tz);
+
+} // namespace dynd
+
+#endif // _DYND__DATETIME_TZ_KERNELS_HPP_
@@ -0,0 +1,135 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__HASH_KERNELS_HPP_
+#define _DYND__HASH_KERNELS_HPP_
+
+#include <dynd/types/type_id.hpp>
+#include <dynd/kernels/ckernel_builder.hpp>
+#include <dynd/eval/eval_context.hpp>
+#include <dynd/string_encodings.hpp>
+
+namespace dynd {
+
+namespace ndt {
+    class type;
+} // namespace ndt
+
+/**
+ * Hashes one value. Values which are equal according to the
+ * `comparison_type_equal` kernel of the type produce the same hash.
+ */
+typedef uint64_t (*hash_single_operation_t)(const char *src,
+                        ckernel_prefix *extra);
+
+/**
+ * See the ckernel_builder class documentation
+ * for details about how kernels can be built and
+ * used.
+ *
+ * This kernel type is for kernels which hash
+ * a single type/metadata value.
+ */
+class hash_ckernel_builder : public ckernel_builder {
+public:
+    hash_ckernel_builder()
+        : ckernel_builder()
+    {
+    }
+
+    inline hash_single_operation_t get_function() const {
+        return get()->get_function<hash_single_operation_t>();
+    }
+
+    /** Calls the function to do the hash */
+    inline uint64_t operator()(const char *src) const {
+        ckernel_prefix *kdp = get();
+        hash_single_operation_t fn = kdp->get_function<hash_single_operation_t>();
+        return fn(src, kdp);
+    }
+};
+
+/**
+ * Mixes the bits of a 64-bit value, so that every input bit
+ * affects every output bit. This is the finalizer of MurmurHash3.
+ */
+inline uint64_t hash_mix(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * Hashes a run of bytes.
+ */
+uint64_t hash_bytes(const char *data, size_t size);
+
+/**
+ * Creates a hash kernel for one type/metadata. This adds the
+ * kernel at the 'out_offset' position in 'out's data, as part
+ * of a hierarchy matching the type's hierarchy.
+ *
+ * \param out  The hierarchical hash kernel being constructed.
+ * \param offset_out  The offset within 'out'.
+ * \param tp  The dynd type to hash.
+ * \param metadata  Metadata for the data to hash.
+ * \param ectx  DyND evaluation context.
+ *
+ * \returns  The offset within 'out' immediately after the
+ *           created kernel.
+ */
+size_t make_hash_kernel(
+                ckernel_builder *out, size_t offset_out,
+                const ndt::type& tp, const char *metadata,
+                const eval::eval_context *ectx);
+
+/**
+ * Creates a hash kernel for a builtin type.
+ */
+size_t make_builtin_type_hash_kernel(
+                ckernel_builder *out, size_t offset_out,
+                type_id_t type_id);
+
+/**
+ * Creates a hash kernel which hashes `data_size` bytes
+ * of the data, for types whose values compare equal
+ * exactly when their bytes do.
+ */
+size_t make_fixed_bytes_hash_kernel(
+                ckernel_builder *out, size_t offset_out,
+                size_t data_size);
+
+/**
+ * Creates a hash kernel for a fixedstring. For the single byte
+ * encodings only the bytes before the first NUL are hashed,
+ * matching the fixedstring equality comparison.
+ */
+size_t make_fixedstring_hash_kernel(
+                ckernel_builder *out, size_t offset_out,
+                size_t string_size, string_encoding_t encoding);
+
+/**
+ * Creates a hash kernel for the bytes pointed to by
+ * a string or bytes value.
+ */
+size_t make_blockref_bytes_hash_kernel(
+                ckernel_builder *out, size_t offset_out);
+
+/**
+ * Creates a hash kernel for a struct or cstruct, which
+ * combines the hashes of its fields.
+ */
+size_t make_struct_hash_kernel(
+                ckernel_builder *out, size_t offset_out,
+                const ndt::type& src_tp, const char *src_metadata,
+                const eval::eval_context *ectx);
+
+} // namespace dynd
+
+#endif // _DYND__HASH_KERNELS_HPP_
@@ -0,0 +1,39 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__OFFSET_DIM_ASSIGNMENT_KERNELS_HPP_
+#define _DYND__OFFSET_DIM_ASSIGNMENT_KERNELS_HPP_
+
+#include <dynd/type.hpp>
+#include <dynd/kernels/assignment_kernels.hpp>
+
+namespace dynd {
+
+/**
+ * Makes a kernel which assigns to an offset_dim, whose rows already
+ * have their sizes. The source may be an offset_dim, var_dim,
+ * strided_dim or fixed_dim, or have fewer dimensions, to be broadcast.
+ */
+size_t make_to_offset_dim_assignment_kernel(
+                ckernel_builder *out, size_t offset_out,
+                const ndt::type& dst_offset_dim_tp, const char *dst_metadata,
+                const ndt::type& src_tp, const char *src_metadata,
+                kernel_request_t kernreq, assign_error_mode errmode,
+                const eval::eval_context *ectx);
+
+/**
+ * Makes a kernel which assigns from an offset_dim to a var_dim,
+ * strided_dim or fixed_dim.
+ */
+size_t make_from_offset_dim_assignment_kernel(
+                ckernel_builder *out, size_t offset_out,
+                const ndt::type& dst_tp, const char *dst_metadata,
+                const ndt::type& src_offset_dim_tp, const char *src_metadata,
+                kernel_request_t kernreq, assign_error_mode errmode,
+                const eval::eval_context *ectx);
+
+} // namespace dynd
+
+#endif // _DYND__OFFSET_DIM_ASSIGNMENT_KERNELS_HPP_
@@ -48,6 +48,27 @@ size_t make_broadcast_to_struct_assignment_kernel(
                 kernel_request_t kernreq, assign_error_mode errmode,
                 const eval::eval_context *ectx);
 
+/**
+ * Returns true if the assignment is between the array-of-structs and the
+ * columnar struct-of-arrays layouts of the same data. One side is a
+ * one-dimensional strided_dim or fixed_dim array of structs, and the other
+ * is a struct with a same-named field for each of its fields, each holding
+ * one more dimension than the field it matches.
+ */
+bool is_columnar_struct_assignment(const ndt::type& dst_tp, const ndt::type& src_tp);
+
+/**
+ * Gets a kernel which assigns between the array-of-structs and the columnar
+ * layouts of struct data, one column at a time with the fields' strided
+ * kernels. Requires is_columnar_struct_assignment(dst_tp, src_tp).
+ */
+size_t make_columnar_struct_assignment_kernel(
+                ckernel_builder *out_ckb, size_t ckb_offset,
+                const ndt::type& dst_tp, const char *dst_metadata,
+                const ndt::type& src_tp, const char *src_metadata,
+                kernel_request_t kernreq, assign_error_mode errmode,
+                const eval::eval_context *ectx);
+
 } // namespace dynd
 
 #endif // _DYND__STRUCT_ASSIGNMENT_KERNELS_HPP_
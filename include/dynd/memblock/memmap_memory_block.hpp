@@ -13,6 +13,23 @@
 
 namespace dynd {
 
+/**
+ * Hints to the operating system about how the mapped memory
+ * will be accessed. These are passed to madvise, and are
+ * ignored on platforms without it.
+ */
+enum memmap_advice_t {
+    // No particular access pattern
+    memmap_advice_normal,
+    // Read through from front to back, pages may be read ahead
+    // aggressively and dropped soon after
+    memmap_advice_sequential,
+    // Random lookups, read ahead would be wasted
+    memmap_advice_random,
+    // The whole mapping will be needed soon, start reading it in
+    memmap_advice_willneed
+};
+
 /**
  * Creates a memory block of a memory-mapped file.
  *
@@ -30,10 +47,12 @@ namespace dynd {
  *             (default end of the file). This value may be
  *             negative, in which case it is interpreted as an offset from the
  *             end of the file.
+ * \param advice  A hint about how the memory will be accessed.
  */
 memory_block_ptr make_memmap_memory_block(const std::string& filename,
     uint32_t access, char **out_pointer, intptr_t *out_size,
-    intptr_t begin = 0, intptr_t end = std::numeric_limits<intptr_t>::max());
+    intptr_t begin = 0, intptr_t end = std::numeric_limits<intptr_t>::max(),
+    memmap_advice_t advice = memmap_advice_normal);
 
 void memmap_memory_block_debug_print(const memory_block_data *memblock, std::ostream& o, const std::string& indent);
 
@@ -0,0 +1,154 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__SORT_HPP_
+#define _DYND__SORT_HPP_
+
+#include <dynd/array.hpp>
+#include <dynd/eval/eval_context.hpp>
+
+namespace dynd {
+
+/**
+ * Sorts a strided run of `count` elements of type `tp` in place,
+ * using the same ordering as `comparison_type_sorting_less` (NaNs
+ * are placed at the end).
+ *
+ * Builtin integer, boolean and floating point types are sorted with
+ * an LSD radix sort, other types use a merge sort driven by the
+ * type's comparison ckernel. The elements are moved bytewise, so
+ * blockref types like strings must keep pointing into memory owned
+ * by the same array.
+ *
+ * \param tp  The type of the elements. Must have a fixed data size.
+ * \param metadata  The metadata for `tp`.
+ * \param data  Pointer to the first element.
+ * \param stride  The stride between elements.
+ * \param count  The number of elements.
+ * \param ectx  DyND evaluation context.
+ */
+void strided_sort(const ndt::type& tp, const char *metadata,
+                char *data, intptr_t stride, intptr_t count,
+                const eval::eval_context *ectx = &eval::default_eval_context);
+
+/**
+ * Computes the permutation which sorts a strided run of `count`
+ * elements of type `tp`. The sort is stable, and uses the same
+ * ordering as `comparison_type_sorting_less`.
+ *
+ * \param tp  The type of the elements.
+ * \param metadata  The metadata for `tp`.
+ * \param data  Pointer to the first element.
+ * \param stride  The stride between elements.
+ * \param count  The number of elements.
+ * \param out_perm  An array of `count` indices, which is filled with
+ *                  the sorting permutation.
+ * \param ectx  DyND evaluation context.
+ */
+void strided_argsort(const ndt::type& tp, const char *metadata,
+                const char *data, intptr_t stride, intptr_t count,
+                intptr_t *out_perm,
+                const eval::eval_context *ectx = &eval::default_eval_context);
+
+/**
+ * Which insertion point searchsorted returns when the needle
+ * compares equal to elements of the sorted array.
+ */
+enum searchsorted_side_t {
+    // The index of the first element which is not less than the needle
+    searchsorted_left,
+    // The index of the first element which is greater than the needle
+    searchsorted_right
+};
+
+/**
+ * For each of `needle_count` needles, finds the index at which it
+ * would be inserted into the sorted strided run to keep it sorted,
+ * using the ordering of `comparison_type_sorting_less`. The needles
+ * must have the same type as the sorted elements.
+ *
+ * Builtin types use a branchless search of the keys, other types
+ * use a single comparison ckernel built for the whole batch.
+ *
+ * \param tp  The type of the sorted elements and the needles.
+ * \param sorted_metadata  The metadata for the sorted elements.
+ * \param sorted_data  Pointer to the first sorted element.
+ * \param sorted_stride  The stride between sorted elements.
+ * \param sorted_count  The number of sorted elements.
+ * \param needle_metadata  The metadata for the needles.
+ * \param needle_data  Pointer to the first needle.
+ * \param needle_stride  The stride between needles.
+ * \param needle_count  The number of needles.
+ * \param side  Whether to return the left or right insertion point.
+ * \param out  An array of `needle_count` indices to fill.
+ * \param ectx  DyND evaluation context.
+ */
+void strided_searchsorted(const ndt::type& tp,
+                const char *sorted_metadata, const char *sorted_data,
+                intptr_t sorted_stride, intptr_t sorted_count,
+                const char *needle_metadata, const char *needle_data,
+                intptr_t needle_stride, intptr_t needle_count,
+                searchsorted_side_t side, intptr_t *out,
+                const eval::eval_context *ectx = &eval::default_eval_context);
+
+namespace nd {
+
+/**
+ * Returns a sorted copy of the array along the specified axis.
+ *
+ * \param a  The array to sort.
+ * \param axis  The axis along which to sort. Negative values
+ *              count from the end, so the default sorts along
+ *              the last dimension.
+ * \param ectx  DyND evaluation context.
+ */
+array sort(const array& a, intptr_t axis = -1,
+                const eval::eval_context *ectx = &eval::default_eval_context);
+
+/**
+ * Sorts a writable array in place along the specified axis.
+ * Every dimension up to and including `axis` must be strided
+ * or var, and the dimensions after `axis` must be strided.
+ *
+ * \param a  The array to sort. Must be writable.
+ * \param axis  The axis along which to sort.
+ * \param ectx  DyND evaluation context.
+ */
+void sort_inplace(const array& a, intptr_t axis = -1,
+                const eval::eval_context *ectx = &eval::default_eval_context);
+
+/**
+ * Returns the indices which would sort the array along the
+ * specified axis, as a strided array of intptr with the same shape.
+ * The sort is stable.
+ *
+ * \param a  The array whose sorting permutation is computed.
+ * \param axis  The axis along which to sort.
+ * \param ectx  DyND evaluation context.
+ */
+array argsort(const array& a, intptr_t axis = -1,
+                const eval::eval_context *ectx = &eval::default_eval_context);
+
+/**
+ * Finds the insertion points of all the needles in a one-dimensional
+ * sorted array, returning a strided array of intptr with the shape of
+ * `needles`. Unlike `binary_search`, which looks up one value per
+ * call, the comparison is set up once for the whole batch.
+ *
+ * \param sorted  A one-dimensional array sorted as by `nd::sort`.
+ * \param needles  The values to look up. They are converted to the
+ *                 element type of `sorted` if necessary.
+ * \param side  Whether to return the left or right insertion point.
+ * \param ectx  DyND evaluation context.
+ */
+array searchsorted(const array& sorted, const array& needles,
+                searchsorted_side_t side = searchsorted_left,
+                const eval::eval_context *ectx = &eval::default_eval_context);
+
+} // namespace nd
+
+} // namespace dynd
+
+#endif // _DYND__SORT_HPP_
@@ -479,6 +479,21 @@ public:
                     comparison_type_t comptype,
                     const eval::eval_context *ectx) const;
 
+    /**
+     * Creates a hash kernel for one data value of this type with
+     * the given metadata. This adds the kernel at the 'out_offset'
+     * position in 'out's data, as part of a hierarchy matching the
+     * type's hierarchy. Values which compare equal with
+     * comparison_type_equal must produce the same hash.
+     *
+     * \returns  The offset at the end of 'out' after adding this
+     *           kernel.
+     */
+    virtual size_t make_hash_kernel(
+                    ckernel_builder *out, size_t offset_out,
+                    const char *metadata,
+                    const eval::eval_context *ectx) const;
+
     /**
      * Call the callback on each element of the array with given data/metadata along the leading
      * dimension. For array dimensions, the type provided is the same each call, but for
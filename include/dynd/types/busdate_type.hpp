@@ -37,7 +37,7 @@ class busdate_type : public base_type {
     int m_busdays_in_weekmask;
     /**
      * If non-NULL, a one-dimensional contiguous array of day unit date_type
-     * which has no duplicates or holidays falling on a weekend.
+     * which is sorted, and has no NA, duplicates or holidays falling on a weekend.
      */
     nd::array m_holidays;
 
@@ -62,6 +62,17 @@ public:
         return m_holidays;
     }
 
+    /** The number of holidays, which don't include any weekend days */
+    intptr_t get_holiday_count() const {
+        return m_holidays.is_empty() ? 0 : m_holidays.get_dim_size();
+    }
+
+    /** The holidays as sorted days after 1970-01-01, get_holiday_count() of them */
+    const int32_t *get_holiday_days() const {
+        return m_holidays.is_empty() ? NULL :
+                        reinterpret_cast<const int32_t *>(m_holidays.get_readonly_originptr());
+    }
+
     bool is_default_workweek() const {
         return m_workweek[0] && m_workweek[1] && m_workweek[2] && m_workweek[3] &&
                 m_workweek[4] && !m_workweek[5] && !m_workweek[6];
@@ -95,6 +106,50 @@ namespace ndt {
     }
 } // namespace ndt
 
+namespace nd {
+    /**
+     * Offsets dates by a number of business days, in the calendar of
+     * a busdate type. Dates which aren't business days are first rolled
+     * to one using the type's roll policy. NA dates stay NA.
+     *
+     * \param dates  An array of dates, or values convertible to dates.
+     * \param offsets  An array of business day counts, broadcast
+     *                 against the dates.
+     * \param busdate_tp  The busdate type whose weekmask, holidays and
+     *                    roll policy to use.
+     *
+     * \returns  A deferred expression array of dates.
+     */
+    nd::array busday_offset(const nd::array& dates, const nd::array& offsets,
+                    const ndt::type& busdate_tp = ndt::make_busdate());
+
+    /**
+     * Counts the business days from each begin date, inclusive, to the
+     * corresponding end date, exclusive, in the calendar of a busdate type.
+     * When the end date is earlier, the count is negative, and it includes
+     * the begin date but not the end date.
+     *
+     * If either date is NA, the count is DYND_DATE_NA (INT32_MIN), the
+     * same NA value as the difference of two dates. It is not a real
+     * count, so filter it out before summing or otherwise combining
+     * counts.
+     *
+     * \returns  A deferred expression array of int32, with DYND_DATE_NA
+     *           as the NA count.
+     */
+    nd::array busday_count(const nd::array& begin_dates, const nd::array& end_dates,
+                    const ndt::type& busdate_tp = ndt::make_busdate());
+
+    /**
+     * Checks whether dates are business days in the calendar of a busdate
+     * type. NA dates are not business days.
+     *
+     * \returns  A deferred expression array of bool.
+     */
+    nd::array is_busday(const nd::array& dates,
+                    const ndt::type& busdate_tp = ndt::make_busdate());
+} // namespace nd
+
 } // namespace dynd
 
 #endif // _DYND__BUSDATE_TYPE_HPP_
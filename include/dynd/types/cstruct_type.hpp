@@ -133,6 +133,11 @@ public:
                     comparison_type_t comptype,
                     const eval::eval_context *ectx) const;
 
+    size_t make_hash_kernel(
+                    ckernel_builder *out, size_t offset_out,
+                    const char *metadata,
+                    const eval::eval_context *ectx) const;
+
     void foreach_leading(char *data, const char *metadata, foreach_fn_t callback, void *callback_data) const;
 
     void get_dynamic_type_properties(
@@ -268,6 +273,19 @@ namespace ndt {
         return ndt::make_cstruct(7, field_types, field_names);
     }
 
+    /**
+     * Makes the columnar (struct-of-arrays) layout of a one-dimensional array
+     * of structs. The result is a cstruct with the same field names, whose
+     * fields are each a contiguous fixed_dim column of the field's values.
+     * Fields of the resulting array, accessed with p("name"), are
+     * column arrays, and assignment to and from the array-of-structs
+     * layout converts between the two.
+     *
+     * \param dim_size  The number of elements in each column.
+     * \param struct_tp  The struct type of the array-of-structs elements.
+     */
+    ndt::type make_columnar_cstruct(intptr_t dim_size, const ndt::type& struct_tp);
+
     /**
      * \brief Checks whether a set of offsets can be used for cstruct.
      *
@@ -17,6 +17,10 @@ namespace dynd {
  *
  * The string buffer should be encoded with UTF-8.
  *
+ * Parsed types are kept in a process-wide cache keyed by the datashape
+ * text, so parsing the same datashape again returns the same type
+ * without parsing it.
+ *
  * \param datashape_begin  The start of the buffer containing the datashape.
  * \param datashape_end    The end of the buffer containing the datashape.
  */
@@ -38,6 +42,40 @@ inline ndt::type type_from_datashape(const char (&datashape)[N])
     return type_from_datashape(datashape, datashape + N - 1);
 }
 
+/**
+ * The counters of the process-wide datashape cache.
+ */
+struct datashape_cache_stats {
+    /** Datashapes served by a cached type */
+    uint64_t hits;
+    /** Datashapes which had to be parsed */
+    uint64_t misses;
+    /** Datashapes too long to cache, which are always parsed */
+    uint64_t bypasses;
+    /** Cached types freed to stay within the capacity */
+    uint64_t evictions;
+    /** The number of types presently in the cache */
+    size_t size;
+};
+
+/**
+ * Returns a snapshot of the process-wide datashape cache counters.
+ */
+datashape_cache_stats get_datashape_cache_stats();
+
+/**
+ * Frees all the types presently in the datashape cache,
+ * and resets its counters to zero.
+ */
+void clear_datashape_cache();
+
+/**
+ * Sets how many parsed types the datashape cache keeps, freeing
+ * the least recently used ones beyond that. A capacity of zero
+ * disables the cache. The default capacity is 1024.
+ */
+void set_datashape_cache_capacity(size_t capacity);
+
 } // namespace dynd
 
 #endif // _DYND__DATASHAPE_PARSER_HPP_
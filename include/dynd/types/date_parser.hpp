@@ -39,6 +39,21 @@ enum date_parser_ambiguous_t {
 bool string_to_date(const char *begin, const char *end, date_ymd &out_ymd,
                     date_parser_ambiguous_t ambig=date_parser_ambiguous_disallow);
 
+/**
+ * The state of a kernel which parses a column of strings as dates or
+ * datetimes, with respect to eval_context::lock_date_format.
+ */
+enum date_parser_lock_t {
+    // Try the fixed ISO 8601 format first, then the general parser
+    date_parser_unlocked,
+    // Locking was requested, and no string has been parsed yet
+    date_parser_detecting,
+    // The first string was fixed ISO 8601, so all the rest must be
+    date_parser_locked_iso8601,
+    // The first string needed the general parser, so skip the fixed format
+    date_parser_locked_general
+};
+
 namespace parse {
 
     /**
@@ -58,6 +73,39 @@ namespace parse {
     bool parse_date(const char *&begin, const char *end, date_ymd &out_ymd,
                     date_parser_ambiguous_t ambig);
 
+    /**
+     * Parses a date in the fixed ISO 8601 format "YYYY-MM-DD", which must
+     * be the whole buffer. This is the fast path for columns of ISO 8601
+     * dates, which checks all the digits and separators at once instead of
+     * trying formats one by one. On false, use string_to_date instead,
+     * which produces the same date for every string this accepts.
+     *
+     * \param begin  The start of the UTF-8 buffer to parse.
+     * \param end  One past the last character of the buffer to parse.
+     * \param out_days  If true is returned, the date as days after 1970-01-01.
+     *
+     * \returns  True if the buffer is a valid date in this format.
+     */
+    bool parse_iso8601_fixed_date(const char *begin, const char *end, int32_t &out_days);
+
+    /**
+     * Parses a datetime in the fixed ISO 8601 format
+     * "YYYY-MM-DDTHH:MM[:SS[.fffffff]][Z]", which must be the whole buffer,
+     * with 'T' or ' ' between the date and the time. This is the fast path
+     * for columns of ISO 8601 datetimes. On false, use the general datetime
+     * parser instead.
+     *
+     * \param begin  The start of the UTF-8 buffer to parse.
+     * \param end  One past the last character of the buffer to parse.
+     * \param out_ticks  If true is returned, the datetime as ticks after
+     *                   1970-01-01T00:00, ignoring any "Z".
+     * \param out_utc  If true is returned, whether the string ended with "Z".
+     *
+     * \returns  True if the buffer is a valid datetime in this format.
+     */
+    bool parse_iso8601_fixed_datetime(const char *begin, const char *end,
+                    int64_t &out_ticks, bool &out_utc);
+
 } // namespace parse
 
 } // namespace dynd
@@ -54,6 +54,11 @@ public:
                     comparison_type_t comptype,
                     const eval::eval_context *ectx) const;
 
+    size_t make_hash_kernel(
+                    ckernel_builder *out, size_t offset_out,
+                    const char *metadata,
+                    const eval::eval_context *ectx) const;
+
     void get_dynamic_type_properties(const std::pair<std::string, gfunc::callable> **out_properties, size_t *out_count) const;
     void get_dynamic_type_functions(const std::pair<std::string, gfunc::callable> **out_functions, size_t *out_count) const;
     void get_dynamic_array_properties(
@@ -74,13 +74,7 @@ struct date_ymd {
      * 0 is Monday, 6 is Sunday.
      */
     inline int get_weekday() const {
-        int days = to_days();
-        // January 5, 1970 is Monday
-        int weekday = (days - 4) % 7;
-        if (weekday < 0) {
-            weekday += 7;
-        }
-        return weekday;
+        return days_to_weekday(to_days());
     }
 
     /**
@@ -101,6 +95,54 @@ struct date_ymd {
      */
     static int32_t to_days(int year, int month, int day);
 
+    /**
+     * Converts a days offset from January 1, 1970 into a year, month and day,
+     * using the Neri-Schneider algorithm. It has no branches or table lookups,
+     * so loops which call it can be vectorized.
+     *
+     * The days must be in [-731204468, 342537355], from -2000000-03-01 to
+     * 939805-06-05, which includes every year a date_ymd can hold. Other
+     * values, including NA, wrap around in the unsigned arithmetic and
+     * give a meaningless date rather than undefined behavior.
+     */
+    static inline void days_to_ymd(int32_t days, int32_t& out_year,
+                    int32_t& out_month, int32_t& out_day)
+    {
+        // Shift the days to count from March 1 of a year 2000000 years
+        // before 0000, a multiple of 400 years, so everything is unsigned.
+        // The addition is unsigned so out of range days wrap instead of
+        // overflowing, and 4 * n + 3 below fits in 32 bits for the range
+        // documented above.
+        uint32_t n = static_cast<uint32_t>(days) + 731204468u;
+        uint32_t n1 = 4 * n + 3;
+        uint32_t century = n1 / 146097;
+        uint32_t n2 = ((n1 % 146097) | 3);
+        uint64_t p2 = 2939745ULL * n2;
+        uint32_t year_of_century = static_cast<uint32_t>(p2 >> 32);
+        uint32_t day_of_year = static_cast<uint32_t>(p2) / 2939745 / 4;
+        uint32_t n3 = 2141 * day_of_year + 197913;
+        uint32_t month = n3 >> 16;
+        uint32_t day = (n3 & 0xffff) / 2141;
+        // Days from January 1 on are in the next year
+        uint32_t jan_or_feb = day_of_year >= 306;
+        out_year = static_cast<int32_t>(100 * century + year_of_century + jan_or_feb) - 2000000;
+        out_month = static_cast<int32_t>(jan_or_feb ? month - 12 : month);
+        out_day = static_cast<int32_t>(day + 1);
+    }
+
+    /**
+     * Converts a days offset from January 1, 1970 into the
+     * 0-based day of the week, where 0 is Monday, 6 is Sunday.
+     */
+    static inline int32_t days_to_weekday(int32_t days)
+    {
+        // Shift the days by 2^31 to be unsigned, x = days + 2^31. Since
+        // 2^31 == 2 (mod 7), x + 1 == days + 3 (mod 7), and January 1, 1970
+        // (days == 0) is Thursday, weekday 3, so x + 1 is the weekday (mod 7)
+        uint32_t r = (static_cast<uint32_t>(days) ^ 0x80000000u) % 7 + 1;
+        return static_cast<int32_t>(r == 7 ? 0 : r);
+    }
+
     /**
      * Converts the ymd into a days offset from January 1, 1970.
      */
@@ -116,6 +158,37 @@ struct date_ymd {
      */
     static std::string to_str(int year, int month, int day);
 
+    /**
+     * Writes the ISO 8601 string of to_str into a buffer of
+     * at least 13 characters, without allocating a string.
+     *
+     * \returns  The number of characters written, which is
+     *            zero if the ymd is invalid.
+     */
+    static size_t to_str(int year, int month, int day, char *out);
+
+    /**
+     * Writes the ISO 8601 string for a 1970 epoch days offset into
+     * a buffer of at least 13 characters, or "NA" for DYND_DATE_NA.
+     * This is the formatting used for printing dates.
+     *
+     * \returns  The number of characters written.
+     */
+    static inline size_t days_to_str(int32_t days, char *out) {
+        if (days != DYND_DATE_NA) {
+            int32_t y, m, d;
+            days_to_ymd(days, y, m, d);
+            // The same year as set_from_days stores in a date_ymd
+            size_t size = to_str(static_cast<int16_t>(y), m, d, out);
+            if (size != 0) {
+                return size;
+            }
+        }
+        out[0] = 'N';
+        out[1] = 'A';
+        return 2;
+    }
+
     /**
      * Converts the ymd into an ISO 8601 string, or "" if it
      * is invalid. For years from 0001 to 9999, uses "####-##-##",
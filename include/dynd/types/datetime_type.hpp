@@ -7,6 +7,7 @@
 #define _DYND__DATETIME_TYPE_HPP_
 
 #include <dynd/type.hpp>
+#include <dynd/array.hpp>
 #include <dynd/typed_data_assign.hpp>
 #include <dynd/types/view_type.hpp>
 #include <dynd/string_encodings.hpp>
@@ -96,6 +97,36 @@ namespace ndt {
     }
 } // namespace ndt
 
+namespace nd {
+    /**
+     * Converts UTC datetimes to the wall clock time of a named time
+     * zone from the IANA time zone database, like "America/New_York".
+     * NA datetimes stay NA.
+     *
+     * \param utc_datetimes  An array of UTC datetimes, or values
+     *                       convertible to them.
+     * \param tz_name  The name of the time zone.
+     *
+     * \returns  A deferred expression array of datetimes with no
+     *           time zone.
+     */
+    nd::array tz_convert(const nd::array& utc_datetimes, const std::string& tz_name);
+
+    /**
+     * Converts wall clock datetimes in a named time zone to UTC. A wall
+     * clock time which occurs twice, when the clocks go back, or never,
+     * when they go forward, uses the UTC offset from before the change.
+     * NA datetimes stay NA.
+     *
+     * \param local_datetimes  An array of datetimes with no time zone,
+     *                         or values convertible to them.
+     * \param tz_name  The name of the time zone.
+     *
+     * \returns  A deferred expression array of UTC datetimes.
+     */
+    nd::array tz_localize(const nd::array& local_datetimes, const std::string& tz_name);
+} // namespace nd
+
 } // namespace dynd
 
 #endif // _DYND__DATETIME_TYPE_HPP_
@@ -66,6 +66,11 @@ public:
                     comparison_type_t comptype,
                     const eval::eval_context *ectx) const;
 
+    size_t make_hash_kernel(
+                    ckernel_builder *out, size_t offset_out,
+                    const char *metadata,
+                    const eval::eval_context *ectx) const;
+
     void make_string_iter(dim_iter *out_di, string_encoding_t encoding,
             const char *metadata, const char *data,
             const memory_block_ptr& ref,
@@ -0,0 +1,137 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__OFFSET_DIM_TYPE_HPP_
+#define _DYND__OFFSET_DIM_TYPE_HPP_
+
+#include <dynd/type.hpp>
+#include <dynd/types/base_uniform_dim_type.hpp>
+
+namespace dynd {
+
+namespace nd {
+    class array;
+} // namespace nd
+
+/**
+ * The offset_dim type stores a ragged dimension the way Arrow lists
+ * do, as one contiguous buffer of values plus an array of offsets into
+ * it. The data of each element is an int64 offset, the index of its first
+ * value, and the index one past its last value is the next int64 after it.
+ * An array of N rows therefore needs N+1 offsets, and a dimension which
+ * holds the rows of an offset_dim must always leave the offsets in place,
+ * which is why such arrays are created with nd::make_offset_dim_array.
+ */
+struct offset_dim_type_metadata {
+    /**
+     * A reference to the memory block which contains the values.
+     */
+    memory_block_data *blockref;
+    /** The start of the values, which the offsets index into */
+    char *values;
+    intptr_t stride;
+};
+
+class offset_dim_type : public base_uniform_dim_type {
+public:
+    offset_dim_type(const ndt::type& element_tp);
+
+    virtual ~offset_dim_type();
+
+    void print_data(std::ostream& o, const char *metadata, const char *data) const;
+
+    void print_type(std::ostream& o) const;
+
+    bool is_expression() const;
+    bool is_unique_data_owner(const char *metadata) const;
+    void transform_child_types(type_transform_fn_t transform_fn, void *extra,
+                    ndt::type& out_transformed_tp, bool& out_was_transformed) const;
+    ndt::type get_canonical_type() const;
+    bool is_strided() const;
+    void process_strided(const char *metadata, const char *data,
+                    ndt::type& out_dt, const char *&out_origin,
+                    intptr_t& out_stride, intptr_t& out_dim_size) const;
+
+    ndt::type apply_linear_index(intptr_t nindices, const irange *indices,
+                size_t current_i, const ndt::type& root_tp, bool leading_dimension) const;
+    intptr_t apply_linear_index(intptr_t nindices, const irange *indices, const char *metadata,
+                    const ndt::type& result_tp, char *out_metadata,
+                    memory_block_data *embedded_reference,
+                    size_t current_i, const ndt::type& root_tp,
+                    bool leading_dimension, char **inout_data,
+                    memory_block_data **inout_dataref) const;
+    ndt::type at_single(intptr_t i0, const char **inout_metadata, const char **inout_data) const;
+
+    ndt::type get_type_at_dimension(char **inout_metadata, intptr_t i, intptr_t total_ndim = 0) const;
+
+    intptr_t get_dim_size(const char *metadata, const char *data) const;
+    void get_shape(intptr_t ndim, intptr_t i, intptr_t *out_shape, const char *metadata, const char *data) const;
+    void get_strides(size_t i, intptr_t *out_strides, const char *metadata) const;
+
+    axis_order_classification_t classify_axis_order(const char *metadata) const;
+
+    bool is_lossless_assignment(const ndt::type& dst_tp, const ndt::type& src_tp) const;
+
+    bool operator==(const base_type& rhs) const;
+
+    void metadata_default_construct(char *metadata, intptr_t ndim, const intptr_t* shape) const;
+    void metadata_copy_construct(char *dst_metadata, const char *src_metadata, memory_block_data *embedded_reference) const;
+    void metadata_reset_buffers(char *metadata) const;
+    void metadata_finalize_buffers(char *metadata) const;
+    void metadata_destruct(char *metadata) const;
+    void metadata_debug_print(const char *metadata, std::ostream& o, const std::string& indent) const;
+    size_t metadata_copy_construct_onedim(char *dst_metadata, const char *src_metadata,
+                    memory_block_data *embedded_reference) const;
+
+    size_t get_iterdata_size(intptr_t ndim) const;
+    size_t iterdata_construct(iterdata_common *iterdata, const char **inout_metadata, intptr_t ndim, const intptr_t* shape, ndt::type& out_uniform_tp) const;
+    size_t iterdata_destruct(iterdata_common *iterdata, intptr_t ndim) const;
+
+    size_t make_assignment_kernel(
+                    ckernel_builder *out, size_t offset_out,
+                    const ndt::type& dst_tp, const char *dst_metadata,
+                    const ndt::type& src_tp, const char *src_metadata,
+                    kernel_request_t kernreq, assign_error_mode errmode,
+                    const eval::eval_context *ectx) const;
+
+    void foreach_leading(char *data, const char *metadata, foreach_fn_t callback, void *callback_data) const;
+};
+
+namespace ndt {
+    inline type make_offset_dim(const type& element_tp) {
+        return type(new offset_dim_type(element_tp), false);
+    }
+} // namespace ndt
+
+namespace nd {
+    /**
+     * Makes a one-dimensional array of ragged rows, with type
+     * "strided * offset * T", which views the provided buffers
+     * without copying them. This is how data from an Arrow-style
+     * list, or a memory-mapped file, is viewed.
+     *
+     * \param offsets  A contiguous one-dimensional int64 array of N+1
+     *                 nondecreasing offsets into `values`.
+     * \param values  A one-dimensional array of the values of all the rows.
+     */
+    nd::array make_offset_dim_array(const nd::array& offsets, const nd::array& values);
+
+    /**
+     * Copies a one-dimensional array of rows, such as a "strided * var * T"
+     * array, into a new "strided * offset * T" array with contiguous values.
+     */
+    nd::array make_offset_dim_array(const nd::array& rows);
+
+    /**
+     * Returns the values buffer of a "strided * offset * T" array, as a
+     * one-dimensional strided array. For arrays made by
+     * make_offset_dim_array, this is all the rows' values in order.
+     */
+    nd::array get_offset_dim_values(const nd::array& a);
+} // namespace nd
+
+} // namespace dynd
+
+#endif // _DYND__OFFSET_DIM_TYPE_HPP_
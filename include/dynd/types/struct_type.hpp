@@ -103,6 +103,11 @@ public:
                     comparison_type_t comptype,
                     const eval::eval_context *ectx) const;
 
+    size_t make_hash_kernel(
+                    ckernel_builder *out, size_t offset_out,
+                    const char *metadata,
+                    const eval::eval_context *ectx) const;
+
     void foreach_leading(char *data, const char *metadata, foreach_fn_t callback, void *callback_data) const;
 
     void get_dynamic_type_properties(const std::pair<std::string, gfunc::callable> **out_properties, size_t *out_count) const;
@@ -0,0 +1,97 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__TZDATA_HPP_
+#define _DYND__TZDATA_HPP_
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+
+/**
+ * The UTC offsets of a named time zone from the IANA time zone
+ * database, as a table of the instants at which they change.
+ * Tables are loaded with get_tz_transitions, which keeps every
+ * zone it loads for the life of the process.
+ *
+ * All times are ticks (100 nanoseconds) since 1970-01-01T00:00.
+ */
+class tz_transitions {
+    std::string m_name;
+    // The UTC times at which the offset changes, sorted
+    std::vector<int64_t> m_utc_transitions;
+    // The same transitions as local wall clock times, where the offset
+    // changes when converting from local time. This is the later of the
+    // two wall clock readings, so ambiguous and skipped local times use
+    // the offset from before the transition.
+    std::vector<int64_t> m_local_transitions;
+    // The UTC offsets, where m_offsets[i] is in effect before
+    // transition i, and m_offsets.back() after the last one
+    std::vector<int64_t> m_offsets;
+
+public:
+    /**
+     * Builds the table of a zone from the contents of its TZif file.
+     * Times after the last transition in the file follow the POSIX
+     * TZ rule in its footer, if it has one.
+     */
+    tz_transitions(const std::string& name, const char *tzif_begin, const char *tzif_end);
+
+    inline const std::string& get_name() const {
+        return m_name;
+    }
+
+    inline size_t get_transition_count() const {
+        return m_utc_transitions.size();
+    }
+
+    inline const int64_t *get_utc_transitions() const {
+        return m_utc_transitions.empty() ? NULL : &m_utc_transitions[0];
+    }
+
+    inline const int64_t *get_local_transitions() const {
+        return m_local_transitions.empty() ? NULL : &m_local_transitions[0];
+    }
+
+    /** get_transition_count() + 1 offsets in ticks, see m_offsets */
+    inline const int64_t *get_offsets() const {
+        return &m_offsets[0];
+    }
+
+    /** Converts a UTC time to the local wall clock time */
+    inline int64_t utc_to_local(int64_t utc) const {
+        size_t i = std::upper_bound(m_utc_transitions.begin(), m_utc_transitions.end(), utc) -
+                        m_utc_transitions.begin();
+        return utc + m_offsets[i];
+    }
+
+    /**
+     * Converts a local wall clock time to UTC. A local time which occurs
+     * twice when the clocks go back, or is skipped when they go forward,
+     * uses the offset from before the transition.
+     */
+    inline int64_t local_to_utc(int64_t local) const {
+        size_t i = std::upper_bound(m_local_transitions.begin(), m_local_transitions.end(), local) -
+                        m_local_transitions.begin();
+        return local - m_offsets[i];
+    }
+};
+
+/**
+ * Returns the transition table of a named IANA time zone, such as
+ * "America/New_York", loading it from the time zone database on the
+ * first request. The database is the directory in the TZDIR environment
+ * variable, or /usr/share/zoneinfo. The table stays cached for the life
+ * of the process, so the reference is always valid.
+ */
+const tz_transitions& get_tz_transitions(const std::string& name);
+
+} // namespace dynd
+
+#endif // _DYND__TZDATA_HPP_
@@ -0,0 +1,52 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__UNIQUE_HPP_
+#define _DYND__UNIQUE_HPP_
+
+#include <dynd/array.hpp>
+#include <dynd/eval/eval_context.hpp>
+
+namespace dynd { namespace nd {
+
+/**
+ * Returns the distinct values of a one-dimensional array, in the
+ * order they first appear. Values are deduplicated with a hash table
+ * built from the type's hash and equality kernels, so this is O(n)
+ * and the input doesn't need to be sorted. Values which don't compare
+ * equal to themselves, like NaN, are each kept.
+ *
+ * \param a  A one-dimensional array.
+ * \param ectx  DyND evaluation context.
+ */
+array unique(const array& a,
+                const eval::eval_context *ectx = &eval::default_eval_context);
+
+/**
+ * Counts how many times each distinct value of a one-dimensional
+ * array appears. Returns a strided array of {value: T, count: intptr}
+ * cstructs, in the order the values first appear.
+ *
+ * \param a  A one-dimensional array.
+ * \param ectx  DyND evaluation context.
+ */
+array value_counts(const array& a,
+                const eval::eval_context *ectx = &eval::default_eval_context);
+
+/**
+ * Tests whether each element of the one-dimensional array `a` is
+ * one of `values`, returning a strided array of bool. The values are
+ * converted to the element type of `a` if necessary.
+ *
+ * \param a  A one-dimensional array.
+ * \param values  A one-dimensional array of the values to look for.
+ * \param ectx  DyND evaluation context.
+ */
+array isin(const array& a, const array& values,
+                const eval::eval_context *ectx = &eval::default_eval_context);
+
+}} // namespace dynd::nd
+
+#endif // _DYND__UNIQUE_HPP_
@@ -7,6 +7,7 @@
 
 #include <dynd/array.hpp>
 #include <dynd/array_iter.hpp>
+#include <dynd/cpu_features.hpp>
 #include <dynd/type_promotion.hpp>
 #include <dynd/kernels/expr_kernel_generator.hpp>
 #include <dynd/kernels/elwise_expr_kernels.hpp>
@@ -16,6 +17,7 @@
 #include <dynd/types/expr_type.hpp>
 #include <dynd/types/string_type.hpp>
 #include <dynd/kernels/string_algorithm_kernels.hpp>
+#include <dynd/kernels/date_expr_kernels.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -38,32 +40,64 @@ namespace {
         }
     };
 
+    /**
+     * The loop of the strided binary kernel, which is compiled into
+     * each instruction set variant. The contiguous case is separate
+     * so the compiler can vectorize it.
+     */
     template<class OP>
-    struct binary_strided_kernel {
-        static void func(char *dst, intptr_t dst_stride,
-                        const char * const *src, const intptr_t *src_stride,
-                        size_t count, ckernel_prefix *DYND_UNUSED(extra))
-        {
-            typedef typename OP::type T;
-            const char *src0 = src[0], *src1 = src[1];
-            intptr_t src0_stride = src_stride[0], src1_stride = src_stride[1];
-
+    DYND_FORCE_INLINE void binary_strided_loop(char *dst, intptr_t dst_stride,
+                    const char * const *src, const intptr_t *src_stride,
+                    size_t count)
+    {
+        typedef typename OP::type T;
+        const char *src0 = src[0], *src1 = src[1];
+        intptr_t src0_stride = src_stride[0], src1_stride = src_stride[1];
+
+        if (dst_stride == sizeof(T) && src0_stride == sizeof(T) && src1_stride == sizeof(T)) {
+            T *dst_typed = reinterpret_cast<T *>(dst);
+            const T *src0_typed = reinterpret_cast<const T *>(src0);
+            const T *src1_typed = reinterpret_cast<const T *>(src1);
             for (size_t i = 0; i != count; ++i) {
-                T s0, s1, r;
-                s0 = *reinterpret_cast<const T *>(src0);
-                s1 = *reinterpret_cast<const T *>(src1);
+                dst_typed[i] = OP::operate(src0_typed[i], src1_typed[i]);
+            }
+            return;
+        }
 
-                r = OP::operate(s0, s1);
+        for (size_t i = 0; i != count; ++i) {
+            T s0, s1, r;
+            s0 = *reinterpret_cast<const T *>(src0);
+            s1 = *reinterpret_cast<const T *>(src1);
 
-                *reinterpret_cast<T *>(dst) = r;
+            r = OP::operate(s0, s1);
 
-                dst += dst_stride;
-                src0 += src0_stride;
-                src1 += src1_stride;
-            }
+            *reinterpret_cast<T *>(dst) = r;
+
+            dst += dst_stride;
+            src0 += src0_stride;
+            src1 += src1_stride;
         }
+    }
+
+#define DYND_BINARY_STRIDED_KERNEL(name, target) \
+    template<class OP> \
+    struct name { \
+        target static void func(char *dst, intptr_t dst_stride, \
+                        const char * const *src, const intptr_t *src_stride, \
+                        size_t count, ckernel_prefix *DYND_UNUSED(extra)) \
+        { \
+            binary_strided_loop<OP>(dst, dst_stride, src, src_stride, count); \
+        } \
     };
 
+    DYND_BINARY_STRIDED_KERNEL(binary_strided_kernel, )
+#ifdef DYND_USE_TARGET_ATTRIBUTES
+    DYND_BINARY_STRIDED_KERNEL(binary_strided_kernel_sse4_2, DYND_TARGET_SSE4_2)
+    DYND_BINARY_STRIDED_KERNEL(binary_strided_kernel_avx2, DYND_TARGET_AVX2)
+    DYND_BINARY_STRIDED_KERNEL(binary_strided_kernel_avx512, DYND_TARGET_AVX512)
+#endif
+#undef DYND_BINARY_STRIDED_KERNEL
+
     template<class extra_type>
     class arithmetic_op_kernel_generator : public expr_kernel_generator {
         ndt::type m_rdt, m_op1dt, m_op2dt;
@@ -200,15 +234,60 @@ namespace {
     {&binary_single_kernel<operation<dynd_complex<double> > >::func, &binary_strided_kernel<operation<dynd_complex<double> > >::func} \
     }
 
+// Instruction set variants of the strided kernels, indexed by cpu_isa_t.
+// Only the types which benefit from vectorization have them.
+#ifdef DYND_USE_TARGET_ATTRIBUTES
+#define DYND_BUILTIN_DTYPE_BINARY_OP_ISA_TABLE(operation, kernel) { \
+    &kernel<operation<int32_t> >::func, \
+    &kernel<operation<int64_t> >::func, \
+    NULL, \
+    &kernel<operation<uint32_t> >::func, \
+    &kernel<operation<uint64_t> >::func, \
+    NULL, \
+    &kernel<operation<float> >::func, \
+    &kernel<operation<double> >::func, \
+    NULL, NULL, NULL \
+    }
+
 #define DYND_BUILTIN_DTYPE_BINARY_OP_TABLE_DEFS(operation) \
     static const expr_operation_pair operation##_table[11] = \
-                DYND_BUILTIN_DTYPE_BINARY_OP_TABLE(operation);
+                DYND_BUILTIN_DTYPE_BINARY_OP_TABLE(operation); \
+    static const expr_strided_operation_t operation##_isa_table[cpu_isa_count][11] = { \
+                {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL}, \
+                DYND_BUILTIN_DTYPE_BINARY_OP_ISA_TABLE(operation, binary_strided_kernel_sse4_2), \
+                DYND_BUILTIN_DTYPE_BINARY_OP_ISA_TABLE(operation, binary_strided_kernel_avx2), \
+                DYND_BUILTIN_DTYPE_BINARY_OP_ISA_TABLE(operation, binary_strided_kernel_avx512)};
+#else
+#define DYND_BUILTIN_DTYPE_BINARY_OP_TABLE_DEFS(operation) \
+    static const expr_operation_pair operation##_table[11] = \
+                DYND_BUILTIN_DTYPE_BINARY_OP_TABLE(operation); \
+    static const expr_strided_operation_t (*const operation##_isa_table)[11] = NULL;
+#endif
 
 DYND_BUILTIN_DTYPE_BINARY_OP_TABLE_DEFS(addition);
 DYND_BUILTIN_DTYPE_BINARY_OP_TABLE_DEFS(subtraction);
 DYND_BUILTIN_DTYPE_BINARY_OP_TABLE_DEFS(multiplication);
 DYND_BUILTIN_DTYPE_BINARY_OP_TABLE_DEFS(division);
 
+/**
+ * Gets the kernels for an operation from its tables, with the
+ * strided kernel for the instruction set picked by get_cpu_isa().
+ */
+static expr_operation_pair get_operation_pair(const expr_operation_pair *table,
+                const expr_strided_operation_t (*isa_table)[11], int table_index)
+{
+    expr_operation_pair result = table[table_index];
+    if (isa_table != NULL) {
+        expr_strided_operation_t variants[cpu_isa_count];
+        variants[cpu_isa_baseline] = result.strided;
+        for (int i = cpu_isa_baseline + 1; i < cpu_isa_count; ++i) {
+            variants[i] = isa_table[i][table_index];
+        }
+        result.strided = select_cpu_isa_variant(variants, get_cpu_isa());
+    }
+    return result;
+}
+
 // These operators are declared in nd::array.hpp
 
 // Get the table index by compressing the type_id's we do implement
@@ -223,6 +302,26 @@ static int compress_builtin_type_id[builtin_type_id_count] = {
                 9, 10, // complex<float32>, complex<float64>
                 -1};
 
+/** Whether the type is a builtin integer, to add to or subtract from a date */
+static inline bool is_days_operand_type(const ndt::type& tp)
+{
+    return tp.is_builtin() && (tp.get_kind() == int_kind || tp.get_kind() == uint_kind);
+}
+
+/**
+ * Converts a days operand to int32. This evaluates the conversion,
+ * because the elementwise expression can't combine an operand
+ * which is itself a conversion expression.
+ */
+static nd::array as_days_operand(const nd::array& n)
+{
+    if (n.get_dtype() == ndt::make_type<int32_t>()) {
+        return n;
+    } else {
+        return n.ucast(ndt::make_type<int32_t>()).eval();
+    }
+}
+
 template<class KD>
 nd::array apply_binary_operator(const nd::array *ops,
                 const ndt::type& rdt, const ndt::type& op1dt, const ndt::type& op2dt,
@@ -272,11 +371,11 @@ nd::array nd::operator+(const nd::array& op1, const nd::array& op2)
     expr_operation_pair func_ptr;
     ndt::type op1dt = op1.get_dtype().value_type();
     ndt::type op2dt = op2.get_dtype().value_type();
-    if (op1dt.is_builtin() && op1dt.is_builtin()) {
+    if (op1dt.is_builtin() && op2dt.is_builtin()) {
         ndt::type rdt = promote_types_arithmetic(op1dt, op2dt);
         int table_index = compress_builtin_type_id[rdt.get_type_id()];
         if (table_index >= 0) {
-            func_ptr = addition_table[table_index];
+            func_ptr = get_operation_pair(addition_table, addition_isa_table, table_index);
         } else {
             func_ptr.single = NULL;
             func_ptr.strided = NULL;
@@ -291,6 +390,17 @@ nd::array nd::operator+(const nd::array& op1, const nd::array& op2)
         // The signature is (string, string) -> string, so we don't use the original types
         // NOTE: Using a different name for string concatenation in the generated expression
         return apply_binary_operator<kernels::string_concatenation_kernel>(ops, rdt, rdt, rdt, func_ptr, "string_concat");
+    } else if ((op1dt.get_type_id() == date_type_id && is_days_operand_type(op2dt)) ||
+                    (is_days_operand_type(op1dt) && op2dt.get_type_id() == date_type_id)) {
+        if (op1dt.get_type_id() != date_type_id) {
+            swap(ops[0], ops[1]);
+        }
+        ops[1] = as_days_operand(ops[1]);
+        func_ptr.single = &kernels::date_add_days_kernel::single;
+        func_ptr.strided = &kernels::date_add_days_kernel::strided;
+        // The signature is (date, int32) -> date
+        return apply_binary_operator<ckernel_prefix>(ops, ndt::make_date(), ndt::make_date(),
+                        ndt::make_type<int32_t>(), func_ptr, "date_add_days");
     } else {
         stringstream ss;
         ss << "Addition is not supported for dynd types ";
@@ -305,12 +415,26 @@ nd::array nd::operator-(const nd::array& op1, const nd::array& op2)
     expr_operation_pair func_ptr;
     ndt::type op1dt = op1.get_dtype().value_type();
     ndt::type op2dt = op2.get_dtype().value_type();
-    if (op1dt.is_builtin() && op1dt.is_builtin()) {
+    if (op1dt.is_builtin() && op2dt.is_builtin()) {
         rdt = promote_types_arithmetic(op1dt, op2dt);
         int table_index = compress_builtin_type_id[rdt.get_type_id()];
         if (table_index >= 0) {
-            func_ptr = subtraction_table[table_index];
+            func_ptr = get_operation_pair(subtraction_table, subtraction_isa_table, table_index);
         }
+    } else if (op1dt.get_type_id() == date_type_id && op2dt.get_type_id() == date_type_id) {
+        func_ptr.single = &kernels::date_difference_kernel::single;
+        func_ptr.strided = &kernels::date_difference_kernel::strided;
+        // The signature is (date, date) -> int32
+        nd::array ops[2] = {op1, op2};
+        return apply_binary_operator<ckernel_prefix>(ops, ndt::make_type<int32_t>(), ndt::make_date(),
+                        ndt::make_date(), func_ptr, "date_difference");
+    } else if (op1dt.get_type_id() == date_type_id && is_days_operand_type(op2dt)) {
+        func_ptr.single = &kernels::date_subtract_days_kernel::single;
+        func_ptr.strided = &kernels::date_subtract_days_kernel::strided;
+        // The signature is (date, int32) -> date
+        nd::array ops[2] = {op1, as_days_operand(op2)};
+        return apply_binary_operator<ckernel_prefix>(ops, ndt::make_date(), ndt::make_date(),
+                        ndt::make_type<int32_t>(), func_ptr, "date_subtract_days");
     }
 
     nd::array ops[2] = {op1, op2};
@@ -323,11 +447,11 @@ nd::array nd::operator*(const nd::array& op1, const nd::array& op2)
     expr_operation_pair func_ptr;
     ndt::type op1dt = op1.get_dtype().value_type();
     ndt::type op2dt = op2.get_dtype().value_type();
-    if (op1dt.is_builtin() && op1dt.is_builtin()) {
+    if (op1dt.is_builtin() && op2dt.is_builtin()) {
         rdt = promote_types_arithmetic(op1dt, op2dt);
         int table_index = compress_builtin_type_id[rdt.get_type_id()];
         if (table_index >= 0) {
-            func_ptr = multiplication_table[table_index];
+            func_ptr = get_operation_pair(multiplication_table, multiplication_isa_table, table_index);
         }
     }
 
@@ -341,11 +465,11 @@ nd::array nd::operator/(const nd::array& op1, const nd::array& op2)
     expr_operation_pair func_ptr;
     ndt::type op1dt = op1.get_dtype().value_type();
     ndt::type op2dt = op2.get_dtype().value_type();
-    if (op1dt.is_builtin() && op1dt.is_builtin()) {
+    if (op1dt.is_builtin() && op2dt.is_builtin()) {
         rdt = promote_types_arithmetic(op1dt, op2dt);
         int table_index = compress_builtin_type_id[rdt.get_type_id()];
         if (table_index >= 0) {
-            func_ptr = division_table[table_index];
+            func_ptr = get_operation_pair(division_table, division_isa_table, table_index);
         }
     }
 
@@ -20,6 +20,7 @@
 #include <dynd/types/cuda_device_type.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
 #include <dynd/kernels/comparison_kernels.hpp>
+#include <dynd/kernels/ckernel_cache.hpp>
 #include <dynd/exceptions.hpp>
 #include <dynd/gfunc/callable.hpp>
 #include <dynd/gfunc/call_callable.hpp>
@@ -958,8 +959,7 @@ nd::array nd::array::to_cuda_device() const
 
 bool nd::array::op_sorting_less(const array& rhs) const
 {
-    comparison_ckernel_builder k;
-    make_comparison_kernel(&k, 0, get_type(), get_ndo_meta(),
+    cached_comparison_ckernel k(get_type(), get_ndo_meta(),
                     rhs.get_type(), rhs.get_ndo_meta(),
                     comparison_type_sorting_less,
                     &eval::default_eval_context);
@@ -968,8 +968,7 @@ bool nd::array::op_sorting_less(const array& rhs) const
 
 bool nd::array::operator<(const array& rhs) const
 {
-    comparison_ckernel_builder k;
-    make_comparison_kernel(&k, 0, get_type(), get_ndo_meta(),
+    cached_comparison_ckernel k(get_type(), get_ndo_meta(),
                     rhs.get_type(), rhs.get_ndo_meta(),
                     comparison_type_less,
                     &eval::default_eval_context);
@@ -978,8 +977,7 @@ bool nd::array::operator<(const array& rhs) const
 
 bool nd::array::operator<=(const array& rhs) const
 {
-    comparison_ckernel_builder k;
-    make_comparison_kernel(&k, 0, get_type(), get_ndo_meta(),
+    cached_comparison_ckernel k(get_type(), get_ndo_meta(),
                     rhs.get_type(), rhs.get_ndo_meta(),
                     comparison_type_less_equal,
                     &eval::default_eval_context);
@@ -988,8 +986,7 @@ bool nd::array::operator<=(const array& rhs) const
 
 bool nd::array::operator==(const array& rhs) const
 {
-    comparison_ckernel_builder k;
-    make_comparison_kernel(&k, 0, get_type(), get_ndo_meta(),
+    cached_comparison_ckernel k(get_type(), get_ndo_meta(),
                     rhs.get_type(), rhs.get_ndo_meta(),
                     comparison_type_equal,
                     &eval::default_eval_context);
@@ -998,8 +995,7 @@ bool nd::array::operator==(const array& rhs) const
 
 bool nd::array::operator!=(const array& rhs) const
 {
-    comparison_ckernel_builder k;
-    make_comparison_kernel(&k, 0, get_type(), get_ndo_meta(),
+    cached_comparison_ckernel k(get_type(), get_ndo_meta(),
                     rhs.get_type(), rhs.get_ndo_meta(),
                     comparison_type_not_equal,
                     &eval::default_eval_context);
@@ -1008,8 +1004,7 @@ bool nd::array::operator!=(const array& rhs) const
 
 bool nd::array::operator>=(const array& rhs) const
 {
-    comparison_ckernel_builder k;
-    make_comparison_kernel(&k, 0, get_type(), get_ndo_meta(),
+    cached_comparison_ckernel k(get_type(), get_ndo_meta(),
                     rhs.get_type(), rhs.get_ndo_meta(),
                     comparison_type_greater_equal,
                     &eval::default_eval_context);
@@ -1018,8 +1013,7 @@ bool nd::array::operator>=(const array& rhs) const
 
 bool nd::array::operator>(const array& rhs) const
 {
-    comparison_ckernel_builder k;
-    make_comparison_kernel(&k, 0, get_type(), get_ndo_meta(),
+    cached_comparison_ckernel k(get_type(), get_ndo_meta(),
                     rhs.get_type(), rhs.get_ndo_meta(),
                     comparison_type_greater,
                     &eval::default_eval_context);
@@ -1033,9 +1027,7 @@ bool nd::array::equals_exact(const array& rhs) const
     } else if (get_type() != rhs.get_type()) {
         return false;
     } else if (get_ndim() == 0) {
-        comparison_ckernel_builder k;
-        make_comparison_kernel(&k, 0,
-                        get_type(), get_ndo_meta(),
+        cached_comparison_ckernel k(get_type(), get_ndo_meta(),
                         rhs.get_type(), rhs.get_ndo_meta(),
                         comparison_type_equal, &eval::default_eval_context);
         return k(get_readonly_originptr(), rhs.get_readonly_originptr());
@@ -1051,8 +1043,7 @@ bool nd::array::equals_exact(const array& rhs) const
         try {
             array_iter<0,2> iter(*this, rhs);
             if (!iter.empty()) {
-                comparison_ckernel_builder k;
-                make_comparison_kernel(&k, 0,
+                cached_comparison_ckernel k(
                                 iter.get_uniform_dtype<0>(), iter.metadata<0>(),
                                 iter.get_uniform_dtype<1>(), iter.metadata<1>(),
                                 comparison_type_not_equal, &eval::default_eval_context);
@@ -1519,7 +1510,8 @@ nd::array nd::empty_like(const nd::array& rhs)
 nd::array nd::memmap(const std::string& filename,
     intptr_t begin,
     intptr_t end,
-    uint32_t access)
+    uint32_t access,
+    memmap_advice_t advice)
 {
     if (access == 0) {
         access = nd::default_access_flags;
@@ -1529,7 +1521,7 @@ nd::array nd::memmap(const std::string& filename,
     intptr_t mm_size = 0;
     // Create a memory mapped memblock of the file
     memory_block_ptr mm = make_memmap_memory_block(
-        filename, access, &mm_ptr, &mm_size, begin, end);
+        filename, access, &mm_ptr, &mm_size, begin, end, advice);
     // Create a bytes array referring to the data.
     ndt::type dt = ndt::make_bytes(1);
     char *data_ptr = 0;
@@ -1552,6 +1544,80 @@ nd::array nd::memmap(const std::string& filename,
     return result;
 }
 
+nd::array nd::memmap(const std::string& filename,
+    const ndt::type& tp,
+    intptr_t offset,
+    uint32_t access,
+    memmap_advice_t advice)
+{
+    if (access == 0) {
+        access = nd::default_access_flags;
+    }
+    if ((tp.get_flags() & (type_flag_blockref|type_flag_destructor)) != 0) {
+        stringstream ss;
+        ss << "cannot memory map dynd type " << tp << ", its data refers to other memory";
+        throw runtime_error(ss.str());
+    }
+    // A leading strided dimension takes its size from the file
+    bool size_from_file = (tp.get_type_id() == strided_dim_type_id);
+    const ndt::type& fixed_tp = size_from_file ?
+                static_cast<const strided_dim_type *>(tp.extended())->get_element_type() : tp;
+    if (fixed_tp.get_data_size() == 0) {
+        stringstream ss;
+        ss << "cannot memory map dynd type " << tp << ", ";
+        if (size_from_file) {
+            ss << "only its first dimension may be strided";
+        } else {
+            ss << "its data size is not fixed";
+        }
+        throw runtime_error(ss.str());
+    }
+
+    char *mm_ptr = NULL;
+    intptr_t mm_size = 0;
+    memory_block_ptr mm = make_memmap_memory_block(
+        filename, access, &mm_ptr, &mm_size, offset,
+        std::numeric_limits<intptr_t>::max(), advice);
+
+    intptr_t data_size = (intptr_t)fixed_tp.get_data_size();
+    intptr_t dim_size = 0;
+    if (size_from_file) {
+        dim_size = mm_size / data_size;
+        if (dim_size * data_size != mm_size) {
+            stringstream ss;
+            ss << "cannot memory map " << mm_size << " bytes of file \"" << filename
+               << "\" as dynd type " << tp << ", it is not a multiple of the "
+               << data_size << " byte element size";
+            throw runtime_error(ss.str());
+        }
+    } else if (mm_size < data_size) {
+        stringstream ss;
+        ss << "cannot memory map " << mm_size << " bytes of file \"" << filename
+           << "\" as dynd type " << tp << ", which needs " << data_size << " bytes";
+        throw runtime_error(ss.str());
+    }
+    if (!offset_is_aligned(reinterpret_cast<size_t>(mm_ptr), tp.get_data_alignment())) {
+        stringstream ss;
+        ss << "cannot memory map file \"" << filename << "\" as dynd type " << tp
+           << ", the data at offset " << offset << " is not aligned to "
+           << tp.get_data_alignment() << " bytes";
+        throw runtime_error(ss.str());
+    }
+
+    // Create an array whose data points into the memory map
+    nd::array result(make_array_memory_block(tp.get_metadata_size()));
+    array_preamble *ndo = result.get_ndo();
+    ndo->m_type = ndt::type(tp).release();
+    ndo->m_data_pointer = mm_ptr;
+    ndo->m_data_reference = mm.release();
+    ndo->m_flags = access;
+    if (!tp.is_builtin()) {
+        tp.extended()->metadata_default_construct(result.get_ndo_meta(),
+                        size_from_file ? 1 : 0, &dim_size);
+    }
+    return result;
+}
+
 intptr_t nd::binary_search(const nd::array& n, const char *metadata, const char *data)
 {
     if (n.get_ndim() == 0) {
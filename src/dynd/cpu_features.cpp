@@ -0,0 +1,155 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstdlib>
+#include <cstring>
+
+#include <dynd/cpu_features.hpp>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+# include <intrin.h>
+# define DYND_HAS_CPUID
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+# include <cpuid.h>
+# define DYND_HAS_CPUID
+#endif
+
+using namespace std;
+using namespace dynd;
+
+#ifdef DYND_HAS_CPUID
+static void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t *regs)
+{
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuidex(r, (int)leaf, (int)subleaf);
+    for (int i = 0; i < 4; ++i) {
+        regs[i] = (uint32_t)r[i];
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+/** Reads XCR0, the register state the operating system saves */
+static uint64_t read_xcr0()
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t eax, edx;
+    __asm__ ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((uint64_t)edx << 32) | eax;
+#endif
+}
+
+static uint32_t detect_cpu_features()
+{
+    uint32_t regs[4], features = 0;
+    cpuid(0, 0, regs);
+    uint32_t max_leaf = regs[0];
+    if (max_leaf < 1) {
+        return 0;
+    }
+
+    cpuid(1, 0, regs);
+    uint32_t ecx1 = regs[2], edx1 = regs[3];
+    if (edx1 & (1u << 26)) features |= cpu_feature_sse2;
+    if (ecx1 & (1u << 9)) features |= cpu_feature_ssse3;
+    if (ecx1 & (1u << 19)) features |= cpu_feature_sse4_1;
+    if (ecx1 & (1u << 20)) features |= cpu_feature_sse4_2;
+    if (ecx1 & (1u << 23)) features |= cpu_feature_popcnt;
+
+    // The AVX features are only usable if the OS saves the YMM/ZMM registers
+    bool osxsave = (ecx1 & (1u << 27)) != 0;
+    uint64_t xcr0 = osxsave ? read_xcr0() : 0;
+    bool ymm_saved = (xcr0 & 0x6) == 0x6;
+    bool zmm_saved = (xcr0 & 0xe6) == 0xe6;
+    if (ymm_saved) {
+        if (ecx1 & (1u << 28)) features |= cpu_feature_avx;
+        if (ecx1 & (1u << 12)) features |= cpu_feature_fma;
+        if (ecx1 & (1u << 29)) features |= cpu_feature_f16c;
+    }
+    if (max_leaf >= 7) {
+        cpuid(7, 0, regs);
+        uint32_t ebx7 = regs[1];
+        if (ymm_saved && (ebx7 & (1u << 5))) features |= cpu_feature_avx2;
+        if (zmm_saved) {
+            if (ebx7 & (1u << 16)) features |= cpu_feature_avx512f;
+            if (ebx7 & (1u << 30)) features |= cpu_feature_avx512bw;
+            if (ebx7 & (1u << 31)) features |= cpu_feature_avx512vl;
+        }
+    }
+    return features;
+}
+#else
+static uint32_t detect_cpu_features()
+{
+    return 0;
+}
+#endif
+
+uint32_t dynd::get_cpu_features()
+{
+    static uint32_t features = detect_cpu_features();
+    return features;
+}
+
+const char *dynd::get_cpu_isa_name(cpu_isa_t isa)
+{
+    switch (isa) {
+        case cpu_isa_baseline:
+            return "baseline";
+        case cpu_isa_sse4_2:
+            return "sse4.2";
+        case cpu_isa_avx2:
+            return "avx2";
+        case cpu_isa_avx512:
+            return "avx512";
+        default:
+            return "<invalid cpu isa>";
+    }
+}
+
+static cpu_isa_t detect_cpu_isa()
+{
+#ifdef DYND_USE_TARGET_ATTRIBUTES
+    static const uint32_t isa_features[cpu_isa_count] = {
+        0,
+        cpu_feature_sse4_2 | cpu_feature_popcnt,
+        cpu_feature_sse4_2 | cpu_feature_popcnt | cpu_feature_avx |
+                        cpu_feature_avx2 | cpu_feature_fma | cpu_feature_f16c,
+        cpu_feature_sse4_2 | cpu_feature_popcnt | cpu_feature_avx |
+                        cpu_feature_avx2 | cpu_feature_fma | cpu_feature_f16c |
+                        cpu_feature_avx512f | cpu_feature_avx512bw | cpu_feature_avx512vl};
+    int isa = cpu_isa_baseline;
+    while (isa + 1 < cpu_isa_count && has_cpu_features(isa_features[isa + 1])) {
+        ++isa;
+    }
+
+    // Allow capping the level, for testing and working around problems
+    const char *cap = getenv("DYND_CPU_ISA");
+    if (cap != NULL) {
+        for (int i = cpu_isa_baseline; i < cpu_isa_count; ++i) {
+            if (strcmp(cap, get_cpu_isa_name((cpu_isa_t)i)) == 0) {
+                if (i < isa) {
+                    isa = i;
+                }
+                break;
+            }
+        }
+    }
+    return (cpu_isa_t)isa;
+#else
+    // Without target attributes, only the baseline variants are compiled
+    return cpu_isa_baseline;
+#endif
+}
+
+cpu_isa_t dynd::get_cpu_isa()
+{
+    static cpu_isa_t isa = detect_cpu_isa();
+    return isa;
+}
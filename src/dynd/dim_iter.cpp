@@ -6,6 +6,7 @@
 #include <dynd/dim_iter.hpp>
 #include <dynd/array.hpp>
 #include <dynd/types/strided_dim_type.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
 
 using namespace std;
@@ -96,13 +97,15 @@ static void buffered_strided_dim_iter_destructor(dim_iter *self)
 {
     // Free the reference of the element type
     base_type_xdecref(self->eltype);
+    // Free the ckernel which copies data to the buffer
+    delete reinterpret_cast<ckernel_builder *>(self->custom[4]);
     // Free the reference owning the temporary buffer
-    memory_block_data *memblock = reinterpret_cast<memory_block_data *>(self->custom[2]);
+    memory_block_data *memblock = reinterpret_cast<memory_block_data *>(self->custom[5]);
     if (memblock != NULL) {
         memory_block_decref(memblock);
     }
     // Free the reference owning the data
-    memblock = reinterpret_cast<memory_block_data *>(self->custom[3]);
+    memblock = reinterpret_cast<memory_block_data *>(self->custom[6]);
     if (memblock != NULL) {
         memory_block_decref(memblock);
     }
@@ -174,15 +177,19 @@ void dynd::make_buffered_strided_dim_iter(
     }
     // Allocate the temporary buffer
     intptr_t buffer_elcount = buffer_max_mem;
-    intptr_t buffer_data_size = mem_tp.get_data_size();
+    intptr_t buffer_data_size = val_tp.get_data_size();
     intptr_t buffer_ndim = mem_tp.get_ndim() + 1;
     dimvector buffer_shape(buffer_ndim);
-    if (!mem_tp.is_builtin()) {
-        // Get the shape from mem_tp/mem_meta
+    if (buffer_ndim > 1) {
+        // Get the shape from mem_tp/mem_meta, the buffer holds val_tp elements of that shape
         mem_tp.extended()->get_shape(buffer_ndim - 1, 0, buffer_shape.get() + 1, mem_meta, NULL);
-        buffer_data_size = mem_tp.extended()->get_default_data_size(buffer_ndim - 1, buffer_shape.get() + 1);
+        buffer_data_size = val_tp.extended()->get_default_data_size(buffer_ndim - 1, buffer_shape.get() + 1);
     }
     buffer_elcount /= buffer_data_size;
+    if (buffer_elcount < 1) {
+        // Always buffer at least one element
+        buffer_elcount = 1;
+    }
     if (buffer_elcount >= size) {
         buffer_elcount = size;
     }
@@ -242,3 +249,42 @@ void dynd::make_buffered_strided_dim_iter(
         out_di->custom[6] = 0;
     }
 }
+
+void dynd::make_eval_dim_iter(
+    dim_iter *out_di, const nd::array& a,
+    intptr_t buffer_max_mem, const eval::eval_context *ectx)
+{
+    const ndt::type& tp = a.get_type();
+    const char *meta = a.get_ndo_meta();
+    ndt::type el_tp;
+    const char *el_meta, *data_ptr;
+    intptr_t size, stride;
+    switch (tp.get_type_id()) {
+        case strided_dim_type_id: {
+            const strided_dim_type_metadata *md = reinterpret_cast<const strided_dim_type_metadata *>(meta);
+            el_tp = static_cast<const strided_dim_type *>(tp.extended())->get_element_type();
+            el_meta = meta + sizeof(strided_dim_type_metadata);
+            size = md->size;
+            stride = md->stride;
+            break;
+        }
+        case fixed_dim_type_id: {
+            const fixed_dim_type *fad = static_cast<const fixed_dim_type *>(tp.extended());
+            el_tp = fad->get_element_type();
+            el_meta = meta;
+            size = (intptr_t)fad->get_fixed_dim_size();
+            stride = fad->get_fixed_stride();
+            break;
+        }
+        default: {
+            stringstream ss;
+            ss << "make_eval_dim_iter: cannot iterate over the outer dimension of type " << tp;
+            throw runtime_error(ss.str());
+        }
+    }
+    data_ptr = a.get_readonly_originptr();
+
+    make_buffered_strided_dim_iter(out_di, el_tp.get_canonical_type(),
+        el_tp, el_meta, data_ptr, size, stride, a.get_data_memblock(),
+        buffer_max_mem, ectx);
+}
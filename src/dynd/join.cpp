@@ -0,0 +1,380 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <vector>
+#include <string>
+
+#include <dynd/join.hpp>
+#include <dynd/shortvector.hpp>
+#include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/kernels/comparison_kernels.hpp>
+#include <dynd/kernels/hash_kernels.hpp>
+#include <dynd/types/base_struct_type.hpp>
+#include <dynd/types/cstruct_type.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+    /** One input of a join, a one-dimensional run of struct elements */
+    struct join_input {
+        nd::array arr;
+        ndt::type el_tp;
+        const base_struct_type *sd;
+        char *el_metadata;
+        const char *data;
+        intptr_t stride, count;
+        const size_t *data_offsets;
+        vector<intptr_t> key_fields;
+
+        inline const char *row(intptr_t i) const {
+            return data + i * stride;
+        }
+        inline const char *field(intptr_t i, intptr_t f) const {
+            return data + i * stride + data_offsets[f];
+        }
+        inline const ndt::type& field_type(intptr_t f) const {
+            return sd->get_field_types()[f];
+        }
+        inline const char *field_metadata(intptr_t f) const {
+            return el_metadata + sd->get_metadata_offsets()[f];
+        }
+    };
+
+    static void init_join_input(join_input& in, const nd::array& a, const char *side,
+                    size_t key_count, const std::string *key_names,
+                    const eval::eval_context *ectx)
+    {
+        in.arr = a.eval(ectx);
+        const ndt::type& tp = in.arr.get_type();
+        if (in.arr.get_ndim() != 1 || (in.arr.get_dtype().get_type_id() != struct_type_id &&
+                        in.arr.get_dtype().get_type_id() != cstruct_type_id)) {
+            stringstream ss;
+            ss << "dynd join requires one-dimensional arrays of structs, the "
+               << side << " input has type " << a.get_type();
+            throw runtime_error(ss.str());
+        }
+        tp.extended()->process_strided(in.arr.get_ndo_meta(), in.arr.get_readonly_originptr(),
+                        in.el_tp, in.data, in.stride, in.count);
+        in.el_metadata = const_cast<char *>(in.arr.get_ndo_meta());
+        tp.get_type_at_dimension(&in.el_metadata, 1);
+        in.sd = static_cast<const base_struct_type *>(in.el_tp.extended());
+        in.data_offsets = in.sd->get_data_offsets(in.el_metadata);
+        in.key_fields.resize(key_count);
+        for (size_t k = 0; k < key_count; ++k) {
+            intptr_t f = in.sd->get_field_index(key_names[k]);
+            if (f < 0) {
+                stringstream ss;
+                ss << "dynd join key field \"" << key_names[k] << "\" is not in the "
+                   << side << " input type " << in.el_tp;
+                throw runtime_error(ss.str());
+            }
+            in.key_fields[k] = f;
+        }
+    }
+
+    /**
+     * Comparison kernels between the key fields of the two inputs,
+     * built once for the whole join.
+     */
+    class join_key_comparer {
+        const join_input& m_left;
+        const join_input& m_right;
+        size_t m_key_count;
+        // left < right, right < left, and left == right for each key
+        mutable shortvector<comparison_ckernel_builder> m_lr, m_rl, m_eq;
+        // left < left and right < right, for checking the sort order
+        mutable shortvector<comparison_ckernel_builder> m_ll, m_rr;
+    public:
+        join_key_comparer(const join_input& left, const join_input& right,
+                        const eval::eval_context *ectx)
+            : m_left(left), m_right(right), m_key_count(left.key_fields.size()),
+                m_lr(m_key_count), m_rl(m_key_count), m_eq(m_key_count),
+                m_ll(m_key_count), m_rr(m_key_count)
+        {
+            for (size_t k = 0; k < m_key_count; ++k) {
+                intptr_t lf = left.key_fields[k], rf = right.key_fields[k];
+                const ndt::type& ltp = left.field_type(lf);
+                const ndt::type& rtp = right.field_type(rf);
+                if (ltp != rtp) {
+                    stringstream ss;
+                    ss << "dynd join key field \"" << left.sd->get_field_names()[lf]
+                       << "\" has type " << ltp << " in the left input, but "
+                       << rtp << " in the right input";
+                    throw runtime_error(ss.str());
+                }
+                const char *lmeta = left.field_metadata(lf), *rmeta = right.field_metadata(rf);
+                make_comparison_kernel(&m_lr[k], 0, ltp, lmeta, rtp, rmeta,
+                                comparison_type_sorting_less, ectx);
+                make_comparison_kernel(&m_rl[k], 0, rtp, rmeta, ltp, lmeta,
+                                comparison_type_sorting_less, ectx);
+                make_comparison_kernel(&m_eq[k], 0, ltp, lmeta, rtp, rmeta,
+                                comparison_type_equal, ectx);
+                make_comparison_kernel(&m_ll[k], 0, ltp, lmeta, ltp, lmeta,
+                                comparison_type_sorting_less, ectx);
+                make_comparison_kernel(&m_rr[k], 0, rtp, rmeta, rtp, rmeta,
+                                comparison_type_sorting_less, ectx);
+            }
+        }
+
+        /** Lexicographic three-way comparison of left row i and right row j */
+        int compare(intptr_t i, intptr_t j) const {
+            for (size_t k = 0; k < m_key_count; ++k) {
+                const char *l = m_left.field(i, m_left.key_fields[k]);
+                const char *r = m_right.field(j, m_right.key_fields[k]);
+                if (m_lr[k](l, r)) {
+                    return -1;
+                } else if (m_rl[k](r, l)) {
+                    return 1;
+                }
+            }
+            return 0;
+        }
+
+        bool equal(intptr_t i, intptr_t j) const {
+            for (size_t k = 0; k < m_key_count; ++k) {
+                if (!m_eq[k](m_left.field(i, m_left.key_fields[k]),
+                                m_right.field(j, m_right.key_fields[k]))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /** Whether the keys of one input are in nondecreasing order */
+        bool is_sorted(bool right) const {
+            const join_input& in = right ? m_right : m_left;
+            shortvector<comparison_ckernel_builder>& less = right ? m_rr : m_ll;
+            for (intptr_t i = 1; i < in.count; ++i) {
+                for (size_t k = 0; k < m_key_count; ++k) {
+                    const char *prev = in.field(i - 1, in.key_fields[k]);
+                    const char *cur = in.field(i, in.key_fields[k]);
+                    if (less[k](cur, prev)) {
+                        return false;
+                    } else if (less[k](prev, cur)) {
+                        break;
+                    }
+                }
+            }
+            return true;
+        }
+    };
+
+    class join_key_hasher {
+        const join_input& m_in;
+        shortvector<hash_ckernel_builder> m_k;
+    public:
+        join_key_hasher(const join_input& in, const eval::eval_context *ectx)
+            : m_in(in), m_k(in.key_fields.size())
+        {
+            for (size_t k = 0; k < in.key_fields.size(); ++k) {
+                intptr_t f = in.key_fields[k];
+                make_hash_kernel(&m_k[k], 0, in.field_type(f), in.field_metadata(f), ectx);
+            }
+        }
+
+        uint64_t operator()(intptr_t i) const {
+            uint64_t h = 0;
+            for (size_t k = 0; k < m_in.key_fields.size(); ++k) {
+                h = hash_mix(h + m_k[k](m_in.field(i, m_in.key_fields[k])));
+            }
+            return h;
+        }
+    };
+
+    /**
+     * Hash join, building on the right input. The table is partitioned
+     * by the high bits of the hash, with the entries of each bucket
+     * stored contiguously (a counting sort by bucket), so probing a
+     * bucket scans one short run of memory instead of chasing pointers.
+     */
+    static void hash_join(const join_input& left, const join_input& right,
+                    const join_key_comparer& cmp, join_kind_t kind,
+                    vector<intptr_t>& out_left, vector<intptr_t>& out_right,
+                    const eval::eval_context *ectx)
+    {
+        join_key_hasher lhash(left, ectx), rhash(right, ectx);
+        intptr_t n = right.count;
+        int bucket_bits = 0;
+        while ((intptr_t(1) << bucket_bits) < n) {
+            ++bucket_bits;
+        }
+        intptr_t bucket_count = intptr_t(1) << bucket_bits;
+        int shift = 64 - bucket_bits;
+
+        vector<uint64_t> hashes(n);
+        vector<intptr_t> bucket_start(bucket_count + 1, 0);
+        for (intptr_t j = 0; j < n; ++j) {
+            hashes[j] = rhash(j);
+            if (bucket_bits > 0) {
+                ++bucket_start[(hashes[j] >> shift) + 1];
+            } else {
+                ++bucket_start[1];
+            }
+        }
+        for (intptr_t b = 0; b < bucket_count; ++b) {
+            bucket_start[b + 1] += bucket_start[b];
+        }
+        // Stable scatter, so each bucket lists its rows in order
+        vector<uint64_t> entry_hash(n);
+        vector<intptr_t> entry_row(n), fill(bucket_start.begin(), bucket_start.end() - 1);
+        for (intptr_t j = 0; j < n; ++j) {
+            intptr_t b = (bucket_bits > 0) ? (intptr_t)(hashes[j] >> shift) : 0;
+            intptr_t pos = fill[b]++;
+            entry_hash[pos] = hashes[j];
+            entry_row[pos] = j;
+        }
+
+        for (intptr_t i = 0; i < left.count; ++i) {
+            bool matched = false;
+            if (n > 0) {
+                uint64_t h = lhash(i);
+                intptr_t b = (bucket_bits > 0) ? (intptr_t)(h >> shift) : 0;
+                for (intptr_t pos = bucket_start[b], end = bucket_start[b + 1]; pos < end; ++pos) {
+                    if (entry_hash[pos] == h && cmp.equal(i, entry_row[pos])) {
+                        out_left.push_back(i);
+                        out_right.push_back(entry_row[pos]);
+                        matched = true;
+                    }
+                }
+            }
+            if (!matched && kind == left_join) {
+                out_left.push_back(i);
+                out_right.push_back(-1);
+            }
+        }
+    }
+
+    /** Merge join of two inputs which are sorted by their keys */
+    static void merge_join(const join_input& left, const join_input& right,
+                    const join_key_comparer& cmp, join_kind_t kind,
+                    vector<intptr_t>& out_left, vector<intptr_t>& out_right)
+    {
+        intptr_t i = 0, j = 0, nl = left.count, nr = right.count;
+        while (i < nl && j < nr) {
+            int c = cmp.compare(i, j);
+            if (c > 0) {
+                ++j;
+            } else if (c < 0 || !cmp.equal(i, j)) {
+                // Keys which sort together but aren't equal (NaN) never match
+                if (kind == left_join) {
+                    out_left.push_back(i);
+                    out_right.push_back(-1);
+                }
+                ++i;
+            } else {
+                intptr_t j_end = j + 1;
+                while (j_end < nr && cmp.compare(i, j_end) == 0) {
+                    ++j_end;
+                }
+                do {
+                    for (intptr_t jj = j; jj < j_end; ++jj) {
+                        out_left.push_back(i);
+                        out_right.push_back(jj);
+                    }
+                    ++i;
+                } while (i < nl && cmp.compare(i, j) == 0);
+                j = j_end;
+            }
+        }
+        if (kind == left_join) {
+            for (; i < nl; ++i) {
+                out_left.push_back(i);
+                out_right.push_back(-1);
+            }
+        }
+    }
+} // anonymous namespace
+
+nd::array nd::join(const nd::array& left, const nd::array& right,
+                size_t key_count, const std::string *key_names,
+                join_kind_t kind, const eval::eval_context *ectx)
+{
+    if (key_count == 0) {
+        throw runtime_error("dynd join requires at least one key field");
+    }
+    join_input lin, rin;
+    init_join_input(lin, left, "left", key_count, key_names, ectx);
+    init_join_input(rin, right, "right", key_count, key_names, ectx);
+    join_key_comparer cmp(lin, rin, ectx);
+
+    // Produce the matching (left row, right row) pairs, with -1
+    // standing in for a missing right row
+    vector<intptr_t> out_left, out_right;
+    if (cmp.is_sorted(false) && cmp.is_sorted(true)) {
+        merge_join(lin, rin, cmp, kind, out_left, out_right);
+    } else {
+        hash_join(lin, rin, cmp, kind, out_left, out_right, ectx);
+    }
+
+    // The result fields are the keys, then the left fields, then the right fields
+    vector<ndt::type> field_types;
+    vector<string> field_names;
+    // For each result field, its source field and whether it's from the right
+    vector<intptr_t> src_field;
+    vector<bool> src_right;
+    vector<bool> lkey(lin.sd->get_field_count(), false), rkey(rin.sd->get_field_count(), false);
+    for (size_t k = 0; k < key_count; ++k) {
+        lkey[lin.key_fields[k]] = true;
+        rkey[rin.key_fields[k]] = true;
+        field_types.push_back(lin.field_type(lin.key_fields[k]));
+        field_names.push_back(key_names[k]);
+        src_field.push_back(lin.key_fields[k]);
+        src_right.push_back(false);
+    }
+    for (int side = 0; side < 2; ++side) {
+        const join_input& in = side ? rin : lin;
+        const vector<bool>& is_key = side ? rkey : lkey;
+        for (size_t f = 0; f < in.sd->get_field_count(); ++f) {
+            if (is_key[f]) {
+                continue;
+            }
+            const string& name = in.sd->get_field_names()[f];
+            if (find(field_names.begin(), field_names.end(), name) != field_names.end()) {
+                stringstream ss;
+                ss << "dynd join inputs both have a non-key field named \"" << name << "\"";
+                throw runtime_error(ss.str());
+            }
+            field_types.push_back(in.field_type(f));
+            field_names.push_back(name);
+            src_field.push_back(f);
+            src_right.push_back(side != 0);
+        }
+    }
+
+    ndt::type row_tp = ndt::make_cstruct(field_types.size(), &field_types[0], &field_names[0]);
+    intptr_t out_count = (intptr_t)out_left.size();
+    nd::array result = nd::empty(out_count, ndt::make_strided_dim(row_tp));
+    const strided_dim_type_metadata *out_md =
+                    reinterpret_cast<const strided_dim_type_metadata *>(result.get_ndo_meta());
+    const char *row_metadata = result.get_ndo_meta() + sizeof(strided_dim_type_metadata);
+    const cstruct_type *cd = static_cast<const cstruct_type *>(row_tp.extended());
+    const size_t *out_offsets = cd->get_data_offsets();
+    const size_t *out_metadata_offsets = cd->get_metadata_offsets();
+    char *out_data = result.get_readwrite_originptr();
+
+    // Copy the rows column by column, with one assignment kernel per field
+    size_t field_count = field_types.size();
+    assignment_ckernel_builder k;
+    for (size_t f = 0; f < field_count; ++f) {
+        const join_input& in = src_right[f] ? rin : lin;
+        const vector<intptr_t>& rows = src_right[f] ? out_right : out_left;
+        k.reset();
+        make_assignment_kernel(&k, 0, field_types[f], row_metadata + out_metadata_offsets[f],
+                        field_types[f], in.field_metadata(src_field[f]),
+                        kernel_request_single, assign_error_none, ectx);
+        size_t field_size = field_types[f].get_data_size();
+        char *dst = out_data + out_offsets[f];
+        for (intptr_t r = 0; r < out_count; ++r, dst += out_md->stride) {
+            if (rows[r] >= 0) {
+                k(dst, in.field(rows[r], src_field[f]));
+            } else {
+                memset(dst, 0, field_size);
+            }
+        }
+    }
+    return result;
+}
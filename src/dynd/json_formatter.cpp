@@ -4,6 +4,7 @@
 //
 
 #include <dynd/json_formatter.hpp>
+#include <dynd/dim_iter.hpp>
 #include <dynd/types/string_type.hpp>
 #include <dynd/types/json_type.hpp>
 #include <dynd/types/date_type.hpp>
@@ -11,6 +12,7 @@
 #include <dynd/types/strided_dim_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/types/var_dim_type.hpp>
+#include <dynd/types/offset_dim_type.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -175,14 +177,13 @@ static void format_json_string(output_data& out, const ndt::type& dt, const char
     }
 }
 
-static void format_json_datetime(output_data& out, const ndt::type& dt, const char *metadata, const char *data)
+static void format_json_datetime(output_data& out, const ndt::type& dt, const char *DYND_UNUSED(metadata), const char *data)
 {
     switch (dt.get_type_id()) {
         case date_type_id: {
-            stringstream ss;
-            dt.print_data(ss, metadata, data);
-            string s = ss.str();
-            format_json_encoded_string(out, s.data(), s.data() + s.size(), string_encoding_ascii);
+            char buf[13];
+            size_t size = date_ymd::days_to_str(*reinterpret_cast<const int32_t *>(data), buf);
+            format_json_encoded_string(out, buf, buf + size, string_encoding_ascii);
             break;
         }
         default: {
@@ -261,6 +262,22 @@ static void format_json_uniform_dim(output_data& out, const ndt::type& dt, const
             }
             break;
         }
+        case offset_dim_type_id: {
+            const offset_dim_type *odt = static_cast<const offset_dim_type *>(dt.extended());
+            const offset_dim_type_metadata *md = reinterpret_cast<const offset_dim_type_metadata *>(metadata);
+            const int64_t *d = reinterpret_cast<const int64_t *>(data);
+            ndt::type element_tp = odt->get_element_type();
+            intptr_t size = static_cast<intptr_t>(d[1] - d[0]), stride = md->stride;
+            const char *begin = md->values + d[0] * stride;
+            metadata += sizeof(offset_dim_type_metadata);
+            for (intptr_t i = 0; i < size; ++i) {
+                ::format_json(out, element_tp, metadata, begin + i * stride);
+                if (i != size - 1) {
+                    out.write(',');
+                }
+            }
+            break;
+        }
         default: {
             stringstream ss;
             ss << "Formatting dynd type " << dt << " as JSON is not implemented yet";
@@ -316,6 +333,24 @@ nd::array dynd::format_json(const nd::array& n)
 
     if (!n.get_type().is_expression()) {
         ::format_json(out, n.get_type(), n.get_ndo_meta(), n.get_readonly_originptr());
+    } else if (n.get_type().get_type_id() == strided_dim_type_id ||
+                    n.get_type().get_type_id() == fixed_dim_type_id) {
+        // Evaluate the outer dimension a chunk at a time
+        dim_iter it;
+        make_eval_dim_iter(&it, n);
+        ndt::type el_tp(it.eltype, true);
+        bool first = true;
+        out.write('[');
+        while (it.vtable->next(&it)) {
+            for (intptr_t i = 0; i < it.data_elcount; ++i) {
+                if (!first) {
+                    out.write(',');
+                }
+                ::format_json(out, el_tp, it.elmeta, it.data_ptr + i * it.data_stride);
+                first = false;
+            }
+        }
+        out.write(']');
     } else {
         nd::array tmp = n.eval();
         ::format_json(out, tmp.get_type(), tmp.get_ndo_meta(), tmp.get_readonly_originptr());
@@ -3,9 +3,19 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <algorithm>
+#include <cmath>
+
 #include <dynd/type.hpp>
+#include <dynd/cpu_features.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/kernels/ckernel_profile.hpp>
 #include "single_assigner_builtin.hpp"
+#include "single_assigner_builtin_range_check.hpp"
+
+#ifdef DYND_USE_TARGET_ATTRIBUTES
+# include <immintrin.h>
+#endif
 
 using namespace std;
 using namespace dynd;
@@ -97,6 +107,36 @@ static void unaligned_copy_strided(char *dst, intptr_t dst_stride,
     }
 }
 
+namespace {
+    /**
+     * Wraps the ckernel constructed during its lifetime in
+     * a profiling ckernel, when the context asks for it.
+     */
+    class profile_kernel_scope {
+        ckernel_profile *m_profile;
+        ckernel_profile_node *m_parent;
+    public:
+        profile_kernel_scope(ckernel_builder *out, size_t& offset_out,
+                        const ndt::type& dst_tp, const ndt::type& src_tp,
+                        kernel_request_t kernreq, const eval::eval_context *ectx)
+            : m_profile(ectx != NULL ? ectx->profile : NULL), m_parent(NULL)
+        {
+            if (m_profile != NULL) {
+                stringstream ss;
+                ss << src_tp << " -> " << dst_tp;
+                offset_out = m_profile->begin_kernel(out, offset_out, kernreq,
+                                ss.str(), &m_parent);
+            }
+        }
+
+        ~profile_kernel_scope() {
+            if (m_profile != NULL) {
+                m_profile->end_kernel(m_parent);
+            }
+        }
+    };
+} // anonymous namespace
+
 size_t dynd::make_assignment_kernel(
                 ckernel_builder *out, size_t offset_out,
                 const ndt::type& dst_tp, const char *dst_metadata,
@@ -107,6 +147,7 @@ size_t dynd::make_assignment_kernel(
     if (errmode == assign_error_default && ectx != NULL) {
         errmode = ectx->default_assign_error_mode;
     }
+    profile_kernel_scope profile_scope(out, offset_out, dst_tp, src_tp, kernreq, ectx);
 
     if (dst_tp.is_builtin()) {
         if (src_tp.is_builtin()) {
@@ -309,13 +350,75 @@ static unary_single_operation_t assign_table_single_kernel[builtin_type_id_count
 };
 
 namespace {
-    template<typename dst_type, typename src_type, assign_error_mode errmode>
-    struct multiple_assignment_builtin {
-        static void strided_assign(
-                        char *dst, intptr_t dst_stride,
-                        const char *src, intptr_t src_stride,
-                        size_t count, ckernel_prefix *DYND_UNUSED(extra))
-        {
+    /**
+     * The loop of the assign_error_none strided assignment, which
+     * is compiled into each instruction set variant below. The
+     * contiguous case is separate so the compiler can vectorize it.
+     */
+    template<typename dst_type, typename src_type>
+    DYND_FORCE_INLINE void strided_assign_none_loop(
+                    char *dst, intptr_t dst_stride,
+                    const char *src, intptr_t src_stride, size_t count)
+    {
+        if (dst_stride == (intptr_t)sizeof(dst_type) && src_stride == (intptr_t)sizeof(src_type)) {
+            dst_type *dst_typed = reinterpret_cast<dst_type *>(dst);
+            const src_type *src_typed = reinterpret_cast<const src_type *>(src);
+            for (size_t i = 0; i != count; ++i) {
+                single_assigner_builtin<dst_type, src_type, assign_error_none>::assign(
+                                dst_typed + i, src_typed + i, NULL);
+            }
+        } else {
+            for (size_t i = 0; i != count; ++i, dst += dst_stride, src += src_stride) {
+                single_assigner_builtin<dst_type, src_type, assign_error_none>::assign(
+                                reinterpret_cast<dst_type *>(dst),
+                                reinterpret_cast<const src_type *>(src),
+                                NULL);
+            }
+        }
+    }
+
+    /** The number of elements range checked at once by the checked loop */
+    const size_t checked_assign_block_size = 256;
+
+    /**
+     * The loop of the error checking strided assignment. In the
+     * contiguous case, it checks a block of values at a time with
+     * a branch-free predicate the compiler can vectorize, and does
+     * the assign_error_none assignment with `none_kernel` when they're
+     * all in range. Blocks with a value out of range go through the
+     * scalar checked assignment, so they raise the same errors.
+     */
+    template<typename dst_type, typename src_type, assign_error_mode errmode, class none_kernel>
+    DYND_FORCE_INLINE void strided_assign_checked_loop(
+                    char *dst, intptr_t dst_stride,
+                    const char *src, intptr_t src_stride, size_t count)
+    {
+        typedef single_assigner_builtin_range_check<dst_type, src_type, errmode> range_check;
+        if (range_check::vectorizable && dst_stride == (intptr_t)sizeof(dst_type) &&
+                        src_stride == (intptr_t)sizeof(src_type)) {
+            dst_type *dst_typed = reinterpret_cast<dst_type *>(dst);
+            const src_type *src_typed = reinterpret_cast<const src_type *>(src);
+            while (count > 0) {
+                size_t block_size = count < checked_assign_block_size ? count : checked_assign_block_size;
+                int all_in_range = 1;
+                for (size_t i = 0; i != block_size; ++i) {
+                    all_in_range &= (int)range_check::in_range(src_typed[i]);
+                }
+                if (all_in_range) {
+                    none_kernel::strided_assign(reinterpret_cast<char *>(dst_typed), sizeof(dst_type),
+                                    reinterpret_cast<const char *>(src_typed), sizeof(src_type),
+                                    block_size, NULL);
+                } else {
+                    for (size_t i = 0; i != block_size; ++i) {
+                        single_assigner_builtin<dst_type, src_type, errmode>::assign(
+                                        dst_typed + i, src_typed + i, NULL);
+                    }
+                }
+                dst_typed += block_size;
+                src_typed += block_size;
+                count -= block_size;
+            }
+        } else {
             for (size_t i = 0; i != count; ++i, dst += dst_stride, src += src_stride) {
                 single_assigner_builtin<dst_type, src_type, errmode>::assign(
                                 reinterpret_cast<dst_type *>(dst),
@@ -323,78 +426,408 @@ namespace {
                                 NULL);
             }
         }
-    };
+    }
+
     template<typename dst_type, typename src_type>
-    struct multiple_assignment_builtin<dst_type, src_type, assign_error_none> {
-         DYND_CUDA_HOST_DEVICE static void strided_assign(
+    struct strided_assign_none_baseline {
+        static void strided_assign(
+                        char *dst, intptr_t dst_stride,
+                        const char *src, intptr_t src_stride,
+                        size_t count, ckernel_prefix *DYND_UNUSED(extra))
+        {
+            strided_assign_none_loop<dst_type, src_type>(dst, dst_stride,
+                            src, src_stride, count);
+        }
+    };
+
+    template<typename dst_type, typename src_type, assign_error_mode errmode>
+    struct strided_assign_checked_baseline {
+        static void strided_assign(
                         char *dst, intptr_t dst_stride,
                         const char *src, intptr_t src_stride,
                         size_t count, ckernel_prefix *DYND_UNUSED(extra))
         {
+            strided_assign_checked_loop<dst_type, src_type, errmode,
+                            strided_assign_none_baseline<dst_type, src_type> >(
+                            dst, dst_stride, src, src_stride, count);
+        }
+    };
+
+    // The checked variants only differ from the baseline ones when the
+    // range check is vectorizable, otherwise they reuse the baseline kernel
+#define DYND_STRIDED_ASSIGN_VARIANT(isa, target) \
+    template<typename dst_type, typename src_type> \
+    struct strided_assign_none_##isa { \
+        target static void strided_assign( \
+                        char *dst, intptr_t dst_stride, \
+                        const char *src, intptr_t src_stride, \
+                        size_t count, ckernel_prefix *DYND_UNUSED(extra)) \
+        { \
+            strided_assign_none_loop<dst_type, src_type>(dst, dst_stride, \
+                            src, src_stride, count); \
+        } \
+    }; \
+    template<typename dst_type, typename src_type, assign_error_mode errmode, \
+                    bool vectorizable = single_assigner_builtin_range_check< \
+                                    dst_type, src_type, errmode>::vectorizable> \
+    struct strided_assign_checked_##isa \
+        : public strided_assign_checked_baseline<dst_type, src_type, errmode> { \
+    }; \
+    template<typename dst_type, typename src_type, assign_error_mode errmode> \
+    struct strided_assign_checked_##isa<dst_type, src_type, errmode, true> { \
+        target static void strided_assign( \
+                        char *dst, intptr_t dst_stride, \
+                        const char *src, intptr_t src_stride, \
+                        size_t count, ckernel_prefix *DYND_UNUSED(extra)) \
+        { \
+            strided_assign_checked_loop<dst_type, src_type, errmode, \
+                            strided_assign_none_##isa<dst_type, src_type> >( \
+                            dst, dst_stride, src, src_stride, count); \
+        } \
+    };
+
+#ifdef DYND_USE_TARGET_ATTRIBUTES
+    DYND_STRIDED_ASSIGN_VARIANT(sse4_2, DYND_TARGET_SSE4_2)
+    DYND_STRIDED_ASSIGN_VARIANT(avx2, DYND_TARGET_AVX2)
+    DYND_STRIDED_ASSIGN_VARIANT(avx512, DYND_TARGET_AVX512)
+#endif
+#undef DYND_STRIDED_ASSIGN_VARIANT
+
+    /**
+     * Tables for converting float16 to float32 bits with two lookups
+     * and an add, from "Fast Half Float Conversions" by Jeroen van der
+     * Zijp. The float32 bits are
+     *
+     *     mantissa[offset[h >> 10] + (h & 0x3ff)] + exponent[h >> 10]
+     */
+    struct halfbits_to_float_tables {
+        uint32_t mantissa[2048];
+        uint32_t exponent[64];
+        uint16_t offset[64];
+
+        halfbits_to_float_tables() {
+            // Subnormal float16 values become normalized float32 values
+            mantissa[0] = 0;
+            for (uint32_t i = 1; i != 1024; ++i) {
+                uint32_t m = i << 13, e = 0;
+                while ((m & 0x00800000u) == 0) {
+                    e -= 0x00800000u;
+                    m <<= 1;
+                }
+                mantissa[i] = (m & ~0x00800000u) | (e + 0x38800000u);
+            }
+            for (uint32_t i = 1024; i != 2048; ++i) {
+                mantissa[i] = 0x38000000u + ((i - 1024) << 13);
+            }
+            // Biased by the 0x38000000 in the mantissa table, the max
+            // exponent becomes the float32 inf/NaN exponent
+            for (uint32_t i = 0; i != 32; ++i) {
+                exponent[i] = i << 23;
+                exponent[i + 32] = 0x80000000u + (i << 23);
+                offset[i] = offset[i + 32] = 1024;
+            }
+            exponent[0] = 0;
+            exponent[31] = 0x47800000u;
+            exponent[32] = 0x80000000u;
+            exponent[63] = 0xc7800000u;
+            offset[0] = offset[32] = 0;
+        }
+    };
+
+    static const halfbits_to_float_tables& get_halfbits_to_float_tables()
+    {
+        static halfbits_to_float_tables tables;
+        return tables;
+    }
+
+    /**
+     * Converts float32 bits to float16 bits, rounding to nearest even
+     * without branching on the error mode. NaNs stay NaNs, with the
+     * quiet bit set like the F16C instructions do.
+     */
+    DYND_FORCE_INLINE uint16_t floatbits_to_halfbits_rtne(uint32_t f)
+    {
+        uint32_t sign = f & 0x80000000u;
+        f ^= sign;
+        uint32_t h;
+        if (f >= 0x47800000u) {
+            // Too big becomes inf, NaN becomes a quiet NaN
+            h = f > 0x7f800000u ? (0x7e00u | ((f >> 13) & 0x3ffu)) : 0x7c00u;
+        } else if (f < 0x38800000u) {
+            // Subnormal results, letting a float32 add do the rounding
+            union { uint32_t bits; float f; } conv, magic;
+            magic.bits = 0x3f000000u;
+            conv.bits = f;
+            conv.f += magic.f;
+            h = conv.bits - magic.bits;
+        } else {
+            // Rebias the exponent and round to nearest even
+            uint32_t mant_odd = (f >> 13) & 1u;
+            f += 0xc8000fffu + mant_odd;
+            h = f >> 13;
+        }
+        return static_cast<uint16_t>(h | (sign >> 16));
+    }
+
+    /**
+     * Converts a float64 to float32 rounding to odd, so that a
+     * following round to nearest float16 doesn't round twice.
+     */
+    DYND_FORCE_INLINE float double_to_float_round_to_odd(double d)
+    {
+        union { float f; uint32_t bits; } conv;
+        conv.f = static_cast<float>(d);
+        double back = conv.f;
+        if (back != d && d == d) {
+            if (fabs(back) > fabs(d)) {
+                --conv.bits;
+            }
+            conv.bits |= 1u;
+        }
+        return conv.f;
+    }
+
+    DYND_FORCE_INLINE uint16_t real_to_halfbits_soft(float s)
+    {
+        union { float f; uint32_t bits; } conv;
+        conv.f = s;
+        return floatbits_to_halfbits_rtne(conv.bits);
+    }
+
+    DYND_FORCE_INLINE uint16_t real_to_halfbits_soft(double s)
+    {
+        return real_to_halfbits_soft(double_to_float_round_to_odd(s));
+    }
+
+    template<typename real_type>
+    DYND_FORCE_INLINE void float16_to_real_soft(
+                    char *dst, intptr_t dst_stride,
+                    const char *src, intptr_t src_stride, size_t count)
+    {
+        const halfbits_to_float_tables& t = get_halfbits_to_float_tables();
+        union { uint32_t bits; float f; } conv;
+        for (size_t i = 0; i != count; ++i, dst += dst_stride, src += src_stride) {
+            uint16_t h = *reinterpret_cast<const uint16_t *>(src);
+            conv.bits = t.mantissa[t.offset[h >> 10] + (h & 0x3ffu)] + t.exponent[h >> 10];
+            *reinterpret_cast<real_type *>(dst) = conv.f;
+        }
+    }
+
+    template<typename real_type>
+    DYND_FORCE_INLINE void real_to_float16_soft(
+                    char *dst, intptr_t dst_stride,
+                    const char *src, intptr_t src_stride, size_t count)
+    {
+        if (dst_stride == (intptr_t)sizeof(uint16_t) && src_stride == (intptr_t)sizeof(real_type)) {
+            uint16_t *dst_bits = reinterpret_cast<uint16_t *>(dst);
+            const real_type *src_typed = reinterpret_cast<const real_type *>(src);
+            for (size_t i = 0; i != count; ++i) {
+                dst_bits[i] = real_to_halfbits_soft(src_typed[i]);
+            }
+        } else {
             for (size_t i = 0; i != count; ++i, dst += dst_stride, src += src_stride) {
-                single_assigner_builtin<dst_type, src_type, assign_error_none>::assign(
-                                reinterpret_cast<dst_type *>(dst),
-                                reinterpret_cast<const src_type *>(src),
-                                NULL);
+                *reinterpret_cast<uint16_t *>(dst) =
+                                real_to_halfbits_soft(*reinterpret_cast<const real_type *>(src));
+            }
+        }
+    }
+
+#ifdef DYND_USE_TARGET_ATTRIBUTES
+    // The F16C conversions, eight values at a time
+
+    DYND_TARGET_AVX2 inline void store_f16c_floats(float *dst, __m256 v)
+    {
+        _mm256_storeu_ps(dst, v);
+    }
+
+    DYND_TARGET_AVX2 inline void store_f16c_floats(double *dst, __m256 v)
+    {
+        _mm256_storeu_pd(dst, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+        _mm256_storeu_pd(dst + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+    }
+
+    DYND_TARGET_AVX2 inline __m256 load_f16c_floats(const float *src)
+    {
+        return _mm256_loadu_ps(src);
+    }
+
+    DYND_TARGET_AVX2 inline __m256 load_f16c_floats(const double *src)
+    {
+        float tmp[8];
+        for (int i = 0; i != 8; ++i) {
+            tmp[i] = double_to_float_round_to_odd(src[i]);
+        }
+        return _mm256_loadu_ps(tmp);
+    }
+
+    DYND_TARGET_AVX2 inline uint16_t real_to_halfbits_f16c(float s)
+    {
+        return _cvtss_sh(s, _MM_FROUND_TO_NEAREST_INT);
+    }
+
+    DYND_TARGET_AVX2 inline uint16_t real_to_halfbits_f16c(double s)
+    {
+        return _cvtss_sh(double_to_float_round_to_odd(s), _MM_FROUND_TO_NEAREST_INT);
+    }
+
+    template<typename real_type>
+    DYND_TARGET_AVX2 void float16_to_real_f16c(
+                    char *dst, intptr_t dst_stride,
+                    const char *src, intptr_t src_stride, size_t count)
+    {
+        if (dst_stride == (intptr_t)sizeof(real_type) && src_stride == (intptr_t)sizeof(uint16_t)) {
+            real_type *dst_typed = reinterpret_cast<real_type *>(dst);
+            const uint16_t *src_bits = reinterpret_cast<const uint16_t *>(src);
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                store_f16c_floats(dst_typed + i, _mm256_cvtph_ps(
+                                _mm_loadu_si128(reinterpret_cast<const __m128i *>(src_bits + i))));
+            }
+            for (; i != count; ++i) {
+                dst_typed[i] = _cvtsh_ss(src_bits[i]);
+            }
+        } else {
+            for (size_t i = 0; i != count; ++i, dst += dst_stride, src += src_stride) {
+                *reinterpret_cast<real_type *>(dst) = _cvtsh_ss(*reinterpret_cast<const uint16_t *>(src));
+            }
+        }
+    }
+
+    template<typename real_type>
+    DYND_TARGET_AVX2 void real_to_float16_f16c(
+                    char *dst, intptr_t dst_stride,
+                    const char *src, intptr_t src_stride, size_t count)
+    {
+        if (dst_stride == (intptr_t)sizeof(uint16_t) && src_stride == (intptr_t)sizeof(real_type)) {
+            uint16_t *dst_bits = reinterpret_cast<uint16_t *>(dst);
+            const real_type *src_typed = reinterpret_cast<const real_type *>(src);
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst_bits + i),
+                                _mm256_cvtps_ph(load_f16c_floats(src_typed + i), _MM_FROUND_TO_NEAREST_INT));
+            }
+            for (; i != count; ++i) {
+                dst_bits[i] = real_to_halfbits_f16c(src_typed[i]);
+            }
+        } else {
+            for (size_t i = 0; i != count; ++i, dst += dst_stride, src += src_stride) {
+                *reinterpret_cast<uint16_t *>(dst) =
+                                real_to_halfbits_f16c(*reinterpret_cast<const real_type *>(src));
             }
         }
+    }
+#endif
+
+    // The float16 <-> float32/float64 conversions replace the generic loops,
+    // which call the scalar float16 routines once per element. Through the
+    // range checks, the checked kernels use them for values in range too.
+#define DYND_FLOAT16_STRIDED_ASSIGN(isa, target, dst_type, src_type, loop) \
+    template<> \
+    struct strided_assign_none_##isa<dst_type, src_type> { \
+        target static void strided_assign( \
+                        char *dst, intptr_t dst_stride, \
+                        const char *src, intptr_t src_stride, \
+                        size_t count, ckernel_prefix *DYND_UNUSED(extra)) \
+        { \
+            loop(dst, dst_stride, src, src_stride, count); \
+        } \
     };
+#define DYND_FLOAT16_STRIDED_ASSIGN_VARIANT(isa, target, to_real, from_real) \
+    DYND_FLOAT16_STRIDED_ASSIGN(isa, target, float, dynd_float16, to_real<float>) \
+    DYND_FLOAT16_STRIDED_ASSIGN(isa, target, double, dynd_float16, to_real<double>) \
+    DYND_FLOAT16_STRIDED_ASSIGN(isa, target, dynd_float16, float, from_real<float>) \
+    DYND_FLOAT16_STRIDED_ASSIGN(isa, target, dynd_float16, double, from_real<double>)
+
+    DYND_FLOAT16_STRIDED_ASSIGN_VARIANT(baseline, , float16_to_real_soft, real_to_float16_soft)
+#ifdef DYND_USE_TARGET_ATTRIBUTES
+    DYND_FLOAT16_STRIDED_ASSIGN_VARIANT(sse4_2, DYND_TARGET_SSE4_2, float16_to_real_soft, real_to_float16_soft)
+    DYND_FLOAT16_STRIDED_ASSIGN_VARIANT(avx2, DYND_TARGET_AVX2, float16_to_real_f16c, real_to_float16_f16c)
+    DYND_FLOAT16_STRIDED_ASSIGN_VARIANT(avx512, DYND_TARGET_AVX512, float16_to_real_f16c, real_to_float16_f16c)
+#endif
+#undef DYND_FLOAT16_STRIDED_ASSIGN_VARIANT
+#undef DYND_FLOAT16_STRIDED_ASSIGN
 } // anonymous namespace
 
-static unary_strided_operation_t assign_table_strided_kernel[builtin_type_id_count-2][builtin_type_id_count-2][4] =
-{
-#define STRIDED_OPERATION_PAIR_LEVEL(dst_type, src_type, errmode) \
-            &multiple_assignment_builtin<dst_type, src_type, errmode>::strided_assign
-        
-#define ERROR_MODE_LEVEL(dst_type, src_type) { \
-        STRIDED_OPERATION_PAIR_LEVEL(dst_type, src_type, assign_error_none), \
-        STRIDED_OPERATION_PAIR_LEVEL(dst_type, src_type, assign_error_overflow), \
-        STRIDED_OPERATION_PAIR_LEVEL(dst_type, src_type, assign_error_fractional), \
-        STRIDED_OPERATION_PAIR_LEVEL(dst_type, src_type, assign_error_inexact) \
+typedef unary_strided_operation_t
+                builtin_strided_assign_table_t[builtin_type_id_count-2][builtin_type_id_count-2][4];
+
+#define ERROR_MODE_LEVEL(isa, dst_type, src_type) { \
+        &strided_assign_none_##isa<dst_type, src_type>::strided_assign, \
+        &strided_assign_checked_##isa<dst_type, src_type, assign_error_overflow>::strided_assign, \
+        &strided_assign_checked_##isa<dst_type, src_type, assign_error_fractional>::strided_assign, \
+        &strided_assign_checked_##isa<dst_type, src_type, assign_error_inexact>::strided_assign \
     }
 
-#define SRC_TYPE_LEVEL(dst_type) { \
-        ERROR_MODE_LEVEL(dst_type, dynd_bool), \
-        ERROR_MODE_LEVEL(dst_type, int8_t), \
-        ERROR_MODE_LEVEL(dst_type, int16_t), \
-        ERROR_MODE_LEVEL(dst_type, int32_t), \
-        ERROR_MODE_LEVEL(dst_type, int64_t), \
-        ERROR_MODE_LEVEL(dst_type, dynd_int128), \
-        ERROR_MODE_LEVEL(dst_type, uint8_t), \
-        ERROR_MODE_LEVEL(dst_type, uint16_t), \
-        ERROR_MODE_LEVEL(dst_type, uint32_t), \
-        ERROR_MODE_LEVEL(dst_type, uint64_t), \
-        ERROR_MODE_LEVEL(dst_type, dynd_int128), \
-        ERROR_MODE_LEVEL(dst_type, dynd_float16), \
-        ERROR_MODE_LEVEL(dst_type, float), \
-        ERROR_MODE_LEVEL(dst_type, double), \
-        ERROR_MODE_LEVEL(dst_type, dynd_float128), \
-        ERROR_MODE_LEVEL(dst_type, dynd_complex<float>), \
-        ERROR_MODE_LEVEL(dst_type, dynd_complex<double>) \
+#define SRC_TYPE_LEVEL(isa, dst_type) { \
+        ERROR_MODE_LEVEL(isa, dst_type, dynd_bool), \
+        ERROR_MODE_LEVEL(isa, dst_type, int8_t), \
+        ERROR_MODE_LEVEL(isa, dst_type, int16_t), \
+        ERROR_MODE_LEVEL(isa, dst_type, int32_t), \
+        ERROR_MODE_LEVEL(isa, dst_type, int64_t), \
+        ERROR_MODE_LEVEL(isa, dst_type, dynd_int128), \
+        ERROR_MODE_LEVEL(isa, dst_type, uint8_t), \
+        ERROR_MODE_LEVEL(isa, dst_type, uint16_t), \
+        ERROR_MODE_LEVEL(isa, dst_type, uint32_t), \
+        ERROR_MODE_LEVEL(isa, dst_type, uint64_t), \
+        ERROR_MODE_LEVEL(isa, dst_type, dynd_uint128), \
+        ERROR_MODE_LEVEL(isa, dst_type, dynd_float16), \
+        ERROR_MODE_LEVEL(isa, dst_type, float), \
+        ERROR_MODE_LEVEL(isa, dst_type, double), \
+        ERROR_MODE_LEVEL(isa, dst_type, dynd_float128), \
+        ERROR_MODE_LEVEL(isa, dst_type, dynd_complex<float>), \
+        ERROR_MODE_LEVEL(isa, dst_type, dynd_complex<double>) \
     }
 
-    SRC_TYPE_LEVEL(dynd_bool),
-    SRC_TYPE_LEVEL(int8_t),
-    SRC_TYPE_LEVEL(int16_t),
-    SRC_TYPE_LEVEL(int32_t),
-    SRC_TYPE_LEVEL(int64_t),
-    SRC_TYPE_LEVEL(dynd_int128),
-    SRC_TYPE_LEVEL(uint8_t),
-    SRC_TYPE_LEVEL(uint16_t),
-    SRC_TYPE_LEVEL(uint32_t),
-    SRC_TYPE_LEVEL(uint64_t),
-    SRC_TYPE_LEVEL(dynd_uint128),
-    SRC_TYPE_LEVEL(dynd_float16),
-    SRC_TYPE_LEVEL(float),
-    SRC_TYPE_LEVEL(double),
-    SRC_TYPE_LEVEL(dynd_float128),
-    SRC_TYPE_LEVEL(dynd_complex<float>),
-    SRC_TYPE_LEVEL(dynd_complex<double>)
+#define DST_TYPE_LEVEL(isa) { \
+        SRC_TYPE_LEVEL(isa, dynd_bool), \
+        SRC_TYPE_LEVEL(isa, int8_t), \
+        SRC_TYPE_LEVEL(isa, int16_t), \
+        SRC_TYPE_LEVEL(isa, int32_t), \
+        SRC_TYPE_LEVEL(isa, int64_t), \
+        SRC_TYPE_LEVEL(isa, dynd_int128), \
+        SRC_TYPE_LEVEL(isa, uint8_t), \
+        SRC_TYPE_LEVEL(isa, uint16_t), \
+        SRC_TYPE_LEVEL(isa, uint32_t), \
+        SRC_TYPE_LEVEL(isa, uint64_t), \
+        SRC_TYPE_LEVEL(isa, dynd_uint128), \
+        SRC_TYPE_LEVEL(isa, dynd_float16), \
+        SRC_TYPE_LEVEL(isa, float), \
+        SRC_TYPE_LEVEL(isa, double), \
+        SRC_TYPE_LEVEL(isa, dynd_float128), \
+        SRC_TYPE_LEVEL(isa, dynd_complex<float>), \
+        SRC_TYPE_LEVEL(isa, dynd_complex<double>) \
+    }
+
+static builtin_strided_assign_table_t assign_table_strided_baseline = DST_TYPE_LEVEL(baseline);
+#ifdef DYND_USE_TARGET_ATTRIBUTES
+static builtin_strided_assign_table_t assign_table_strided_sse4_2 = DST_TYPE_LEVEL(sse4_2);
+static builtin_strided_assign_table_t assign_table_strided_avx2 = DST_TYPE_LEVEL(avx2);
+static builtin_strided_assign_table_t assign_table_strided_avx512 = DST_TYPE_LEVEL(avx512);
+#endif
+
+#undef DST_TYPE_LEVEL
 #undef SRC_TYPE_LEVEL
 #undef ERROR_MODE_LEVEL
-#undef STRIDED_OPERATION_PAIR_LEVEL
+
+static builtin_strided_assign_table_t *const assign_table_strided_variants[cpu_isa_count] = {
+    &assign_table_strided_baseline,
+#ifdef DYND_USE_TARGET_ATTRIBUTES
+    &assign_table_strided_sse4_2,
+    &assign_table_strided_avx2,
+    &assign_table_strided_avx512
+#else
+    NULL, NULL, NULL
+#endif
 };
 
+/** The strided assignment kernels for this CPU, picked once */
+static builtin_strided_assign_table_t& get_assign_table_strided()
+{
+    static builtin_strided_assign_table_t *table =
+                    select_cpu_isa_variant(assign_table_strided_variants, get_cpu_isa());
+    return *table;
+}
+
 size_t dynd::make_builtin_type_assignment_kernel(
                 ckernel_builder *out, size_t offset_out,
                 type_id_t dst_type_id, type_id_t src_type_id,
@@ -414,7 +847,7 @@ size_t dynd::make_builtin_type_assignment_kernel(
                 break;
             case kernel_request_strided:
                 result->set_function<unary_strided_operation_t>(
-                                assign_table_strided_kernel[dst_type_id-bool_type_id]
+                                get_assign_table_strided()[dst_type_id-bool_type_id]
                                                 [src_type_id-bool_type_id][errmode]);
                 break;
             default: {
@@ -507,3 +940,48 @@ void dynd::strided_assign_kernel_extra::destruct(
         echild->destructor(echild);
     }
 }
+
+void dynd::blocked_assign_kernel_extra::single(char *dst, const char *src,
+                    ckernel_prefix *extra)
+{
+    extra_type *e = reinterpret_cast<extra_type *>(extra);
+    ckernel_prefix *echild = reinterpret_cast<ckernel_prefix *>(e + 1);
+    unary_strided_operation_t opchild = echild->get_function<unary_strided_operation_t>();
+    intptr_t size0 = e->size0, size1 = e->size1;
+    intptr_t dst_stride0 = e->dst_stride0, src_stride0 = e->src_stride0;
+    intptr_t dst_stride1 = e->dst_stride1, src_stride1 = e->src_stride1;
+    intptr_t block_size0 = e->block_size0, block_size1 = e->block_size1;
+    for (intptr_t i0 = 0; i0 < size0; i0 += block_size0) {
+        intptr_t count0 = min(block_size0, size0 - i0);
+        for (intptr_t i1 = 0; i1 < size1; i1 += block_size1) {
+            intptr_t count1 = min(block_size1, size1 - i1);
+            // One tile, a row of dimension 1 at a time
+            char *tile_dst = dst + i0 * dst_stride0 + i1 * dst_stride1;
+            const char *tile_src = src + i0 * src_stride0 + i1 * src_stride1;
+            for (intptr_t j = 0; j < count0; ++j,
+                            tile_dst += dst_stride0, tile_src += src_stride0) {
+                opchild(tile_dst, dst_stride1, tile_src, src_stride1, count1, echild);
+            }
+        }
+    }
+}
+
+void dynd::blocked_assign_kernel_extra::strided(char *dst, intptr_t dst_stride,
+                const char *src, intptr_t src_stride,
+                size_t count, ckernel_prefix *extra)
+{
+    for (size_t i = 0; i != count; ++i,
+                    dst += dst_stride, src += src_stride) {
+        single(dst, src, extra);
+    }
+}
+
+void dynd::blocked_assign_kernel_extra::destruct(
+                ckernel_prefix *extra)
+{
+    extra_type *e = reinterpret_cast<extra_type *>(extra);
+    ckernel_prefix *echild = reinterpret_cast<ckernel_prefix *>(e + 1);
+    if (echild->destructor) {
+        echild->destructor(echild);
+    }
+}
@@ -0,0 +1,441 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <sstream>
+
+#include <dynd/kernels/busdate_kernels.hpp>
+#include <dynd/kernels/elwise_expr_kernels.hpp>
+#include <dynd/types/date_type.hpp>
+#include <dynd/types/date_util.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+    /**
+     * The weekmask and holidays of a busdate type, with the state
+     * for looking up holidays across a column of dates.
+     */
+    struct busday_calendar {
+        bool weekmask[7];
+        int busdays_in_weekmask;
+        // Sorted, with no duplicates, NA, or days off in the weekmask
+        const int32_t *holidays_begin, *holidays_end;
+        // Where the previous holiday lookup ended. Consecutive dates in a
+        // column are usually near each other, so checking here first makes
+        // most lookups O(1) instead of a full binary search.
+        const int32_t *hint;
+
+        void init(const busdate_type *bd)
+        {
+            memcpy(weekmask, bd->get_weekmask(), sizeof(weekmask));
+            busdays_in_weekmask = bd->get_busdays_in_weekmask();
+            holidays_begin = bd->get_holiday_days();
+            holidays_end = holidays_begin + bd->get_holiday_count();
+            hint = holidays_begin;
+        }
+
+        /** The first holiday on or after the date */
+        inline const int32_t *lower_bound(int32_t days)
+        {
+            const int32_t *h = hint;
+            if (h == holidays_begin || h[-1] < days) {
+                // The answer is at the hint or after it
+                if (h != holidays_end && h[0] < days) {
+                    ++h;
+                    if (h != holidays_end && h[0] < days) {
+                        h = std::lower_bound(h + 1, holidays_end, days);
+                    }
+                }
+            } else {
+                h = std::lower_bound(holidays_begin, h, days);
+            }
+            hint = h;
+            return h;
+        }
+
+        inline bool is_busday(int32_t days)
+        {
+            if (!weekmask[date_ymd::days_to_weekday(days)]) {
+                return false;
+            }
+            const int32_t *h = lower_bound(days);
+            return h == holidays_end || *h != days;
+        }
+
+        /** Moves a business day to the next one */
+        inline int32_t next_busday(int32_t days)
+        {
+            do {
+                ++days;
+            } while (!is_busday(days));
+            return days;
+        }
+
+        /** Moves a business day to the previous one */
+        inline int32_t prev_busday(int32_t days)
+        {
+            do {
+                --days;
+            } while (!is_busday(days));
+            return days;
+        }
+
+        /**
+         * Applies a roll policy to a date which may not be a business
+         * day, producing DYND_DATE_NA for busdate_roll_nat.
+         */
+        int32_t roll(int32_t days, busdate_roll_t roll_policy)
+        {
+            if (days == DYND_DATE_NA || is_busday(days)) {
+                return days;
+            }
+            switch (roll_policy) {
+                case busdate_roll_following:
+                    return next_busday(days);
+                case busdate_roll_preceding:
+                    return prev_busday(days);
+                case busdate_roll_modifiedfollowing: {
+                    int32_t result = next_busday(days);
+                    return same_month(days, result) ? result : prev_busday(days);
+                }
+                case busdate_roll_modifiedpreceding: {
+                    int32_t result = prev_busday(days);
+                    return same_month(days, result) ? result : next_busday(days);
+                }
+                case busdate_roll_nat:
+                    return DYND_DATE_NA;
+                default: {
+                    char buf[13];
+                    stringstream ss;
+                    ss << "date ";
+                    ss.write(buf, date_ymd::days_to_str(days, buf));
+                    ss << " is not a business day";
+                    throw runtime_error(ss.str());
+                }
+            }
+        }
+
+        static inline bool same_month(int32_t days0, int32_t days1)
+        {
+            int32_t y0, m0, d0, y1, m1, d1;
+            date_ymd::days_to_ymd(days0, y0, m0, d0);
+            date_ymd::days_to_ymd(days1, y1, m1, d1);
+            return y0 == y1 && m0 == m1;
+        }
+
+        /** Offsets a business day by a number of business days */
+        int32_t offset(int32_t days, int32_t offset)
+        {
+            int32_t start = days;
+            int wd = date_ymd::days_to_weekday(days);
+            if (offset > 0) {
+                // Whole weeks first, then day by day with just the weekmask
+                days += (offset / busdays_in_weekmask) * 7;
+                offset %= busdays_in_weekmask;
+                while (offset > 0) {
+                    ++days;
+                    if (++wd == 7) {
+                        wd = 0;
+                    }
+                    if (weekmask[wd]) {
+                        --offset;
+                    }
+                }
+                // Every holiday passed over takes one more business day
+                const int32_t *h = lower_bound(start + 1);
+                while (h != holidays_end && *h <= days) {
+                    do {
+                        ++days;
+                        if (++wd == 7) {
+                            wd = 0;
+                        }
+                    } while (!weekmask[wd]);
+                    ++h;
+                }
+            } else if (offset < 0) {
+                days -= (-offset / busdays_in_weekmask) * 7;
+                offset = -(-offset % busdays_in_weekmask);
+                while (offset < 0) {
+                    --days;
+                    if (--wd < 0) {
+                        wd = 6;
+                    }
+                    if (weekmask[wd]) {
+                        ++offset;
+                    }
+                }
+                const int32_t *h = lower_bound(start);
+                while (h != holidays_begin && h[-1] >= days) {
+                    do {
+                        --days;
+                        if (--wd < 0) {
+                            wd = 6;
+                        }
+                    } while (!weekmask[wd]);
+                    --h;
+                }
+            }
+            return days;
+        }
+
+        /** Counts the business days in [begin, end), where begin <= end */
+        int32_t count(int32_t begin, int32_t end)
+        {
+            // Subtract the holidays in the range
+            const int32_t *h_begin = lower_bound(begin);
+            const int32_t *h_end = std::lower_bound(h_begin, holidays_end, end);
+            int32_t result = -static_cast<int32_t>(h_end - h_begin);
+            // Whole weeks first, then day by day with just the weekmask
+            int32_t weeks = (end - begin) / 7;
+            result += weeks * busdays_in_weekmask;
+            begin += weeks * 7;
+            int wd = date_ymd::days_to_weekday(begin);
+            for (; begin < end; ++begin) {
+                if (weekmask[wd]) {
+                    ++result;
+                }
+                if (++wd == 7) {
+                    wd = 0;
+                }
+            }
+            return result;
+        }
+    };
+
+    struct busday_kernel_extra {
+        typedef busday_kernel_extra extra_type;
+
+        ckernel_prefix base;
+        busday_calendar cal;
+        busdate_roll_t roll;
+        const busdate_type *busdate_tp;
+
+        inline int32_t offset(int32_t date, int32_t offset)
+        {
+            date = cal.roll(date, roll);
+            if (date == DYND_DATE_NA) {
+                return DYND_DATE_NA;
+            }
+            return cal.offset(date, offset);
+        }
+
+        inline int32_t count(int32_t begin, int32_t end)
+        {
+            if (begin == DYND_DATE_NA || end == DYND_DATE_NA) {
+                // INT32_MIN is the NA count, as for date differences
+                return DYND_DATE_NA;
+            } else if (begin <= end) {
+                return cal.count(begin, end);
+            } else {
+                // Counting backwards, the end date is excluded instead
+                return -cal.count(end + 1, begin + 1);
+            }
+        }
+
+        static void offset_single(char *dst, const char * const *src, ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            *reinterpret_cast<int32_t *>(dst) = e->offset(*reinterpret_cast<const int32_t *>(src[0]),
+                            *reinterpret_cast<const int32_t *>(src[1]));
+        }
+
+        static void offset_strided(char *dst, intptr_t dst_stride,
+                        const char * const *src, const intptr_t *src_stride,
+                        size_t count, ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            const char *src0 = src[0], *src1 = src[1];
+            intptr_t src0_stride = src_stride[0], src1_stride = src_stride[1];
+            for (size_t i = 0; i != count; ++i) {
+                *reinterpret_cast<int32_t *>(dst) = e->offset(*reinterpret_cast<const int32_t *>(src0),
+                                *reinterpret_cast<const int32_t *>(src1));
+                dst += dst_stride;
+                src0 += src0_stride;
+                src1 += src1_stride;
+            }
+        }
+
+        static void count_single(char *dst, const char * const *src, ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            *reinterpret_cast<int32_t *>(dst) = e->count(*reinterpret_cast<const int32_t *>(src[0]),
+                            *reinterpret_cast<const int32_t *>(src[1]));
+        }
+
+        static void count_strided(char *dst, intptr_t dst_stride,
+                        const char * const *src, const intptr_t *src_stride,
+                        size_t count, ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            const char *src0 = src[0], *src1 = src[1];
+            intptr_t src0_stride = src_stride[0], src1_stride = src_stride[1];
+            for (size_t i = 0; i != count; ++i) {
+                *reinterpret_cast<int32_t *>(dst) = e->count(*reinterpret_cast<const int32_t *>(src0),
+                                *reinterpret_cast<const int32_t *>(src1));
+                dst += dst_stride;
+                src0 += src0_stride;
+                src1 += src1_stride;
+            }
+        }
+
+        static void is_busday_single(char *dst, const char *src, ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            int32_t date = *reinterpret_cast<const int32_t *>(src);
+            *reinterpret_cast<dynd_bool *>(dst) = (date != DYND_DATE_NA && e->cal.is_busday(date));
+        }
+
+        static void is_busday_strided(char *dst, intptr_t dst_stride,
+                        const char *src, intptr_t src_stride,
+                        size_t count, ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            for (size_t i = 0; i != count; ++i, dst += dst_stride, src += src_stride) {
+                int32_t date = *reinterpret_cast<const int32_t *>(src);
+                *reinterpret_cast<dynd_bool *>(dst) = (date != DYND_DATE_NA && e->cal.is_busday(date));
+            }
+        }
+
+        static void destruct(ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            base_type_xdecref(e->busdate_tp);
+        }
+    };
+
+    enum busday_operation_t {
+        busday_operation_offset,
+        busday_operation_count,
+        busday_operation_is_busday
+    };
+
+    class busday_kernel_generator : public expr_kernel_generator {
+        ndt::type m_busdate_tp;
+        busday_operation_t m_operation;
+    public:
+        busday_kernel_generator(const ndt::type& busdate_tp, busday_operation_t operation)
+            : expr_kernel_generator(true), m_busdate_tp(busdate_tp), m_operation(operation)
+        {
+            if (busdate_tp.get_type_id() != busdate_type_id) {
+                stringstream ss;
+                ss << "busday_kernel_generator: the calendar type " << busdate_tp << " is not a busdate";
+                throw type_error(ss.str());
+            }
+        }
+
+        virtual ~busday_kernel_generator() {
+        }
+
+        size_t make_expr_kernel(
+                    ckernel_builder *out, size_t offset_out,
+                    const ndt::type& dst_tp, const char *dst_metadata,
+                    size_t src_count, const ndt::type *src_tp, const char **src_metadata,
+                    kernel_request_t kernreq, const eval::eval_context *ectx) const
+        {
+            size_t expected_src_count = (m_operation == busday_operation_is_busday) ? 1 : 2;
+            if (src_count != expected_src_count) {
+                stringstream ss;
+                ss << "busday_kernel_generator requires " << expected_src_count << " src operands, ";
+                ss << "received " << src_count;
+                throw runtime_error(ss.str());
+            }
+            bool require_elwise;
+            switch (m_operation) {
+                case busday_operation_offset:
+                    require_elwise = dst_tp.get_type_id() != date_type_id ||
+                                    src_tp[0].get_type_id() != date_type_id ||
+                                    src_tp[1].get_type_id() != int32_type_id;
+                    break;
+                case busday_operation_count:
+                    require_elwise = dst_tp.get_type_id() != int32_type_id ||
+                                    src_tp[0].get_type_id() != date_type_id ||
+                                    src_tp[1].get_type_id() != date_type_id;
+                    break;
+                default:
+                    require_elwise = dst_tp.get_type_id() != bool_type_id ||
+                                    src_tp[0].get_type_id() != date_type_id;
+                    break;
+            }
+            // If the types don't match the ones for this generator,
+            // call the elementwise dimension handler to handle one dimension,
+            // giving 'this' as the next kernel generator to call
+            if (require_elwise) {
+                return make_elwise_dimension_expr_kernel(out, offset_out,
+                                dst_tp, dst_metadata,
+                                src_count, src_tp, src_metadata,
+                                kernreq, ectx,
+                                this);
+            }
+
+            out->ensure_capacity_leaf(offset_out + sizeof(busday_kernel_extra));
+            busday_kernel_extra *e = out->get_at<busday_kernel_extra>(offset_out);
+            switch (kernreq) {
+                case kernel_request_single:
+                    if (m_operation == busday_operation_offset) {
+                        e->base.set_function<expr_single_operation_t>(&busday_kernel_extra::offset_single);
+                    } else if (m_operation == busday_operation_count) {
+                        e->base.set_function<expr_single_operation_t>(&busday_kernel_extra::count_single);
+                    } else {
+                        e->base.set_function<unary_single_operation_t>(&busday_kernel_extra::is_busday_single);
+                    }
+                    break;
+                case kernel_request_strided:
+                    if (m_operation == busday_operation_offset) {
+                        e->base.set_function<expr_strided_operation_t>(&busday_kernel_extra::offset_strided);
+                    } else if (m_operation == busday_operation_count) {
+                        e->base.set_function<expr_strided_operation_t>(&busday_kernel_extra::count_strided);
+                    } else {
+                        e->base.set_function<unary_strided_operation_t>(&busday_kernel_extra::is_busday_strided);
+                    }
+                    break;
+                default: {
+                    stringstream ss;
+                    ss << "busday_kernel_generator: unrecognized request " << (int)kernreq;
+                    throw runtime_error(ss.str());
+                }
+            }
+            e->base.destructor = &busday_kernel_extra::destruct;
+            // The kernel data owns a reference to this type
+            e->busdate_tp = static_cast<const busdate_type *>(ndt::type(m_busdate_tp).release());
+            e->cal.init(e->busdate_tp);
+            e->roll = e->busdate_tp->get_roll();
+            return offset_out + sizeof(busday_kernel_extra);
+        }
+
+        void print_type(std::ostream& o) const
+        {
+            switch (m_operation) {
+                case busday_operation_offset:
+                    o << "busday_offset(op0, op1, " << m_busdate_tp << ")";
+                    break;
+                case busday_operation_count:
+                    o << "busday_count(op0, op1, " << m_busdate_tp << ")";
+                    break;
+                default:
+                    o << "is_busday(op0, " << m_busdate_tp << ")";
+                    break;
+            }
+        }
+    };
+} // anonymous namespace
+
+expr_kernel_generator *dynd::make_busday_offset_kernelgen(const ndt::type& busdate_tp)
+{
+    return new busday_kernel_generator(busdate_tp, busday_operation_offset);
+}
+
+expr_kernel_generator *dynd::make_busday_count_kernelgen(const ndt::type& busdate_tp)
+{
+    return new busday_kernel_generator(busdate_tp, busday_operation_count);
+}
+
+expr_kernel_generator *dynd::make_is_busday_kernelgen(const ndt::type& busdate_tp)
+{
+    return new busday_kernel_generator(busdate_tp, busday_operation_is_busday);
+}
@@ -6,58 +6,187 @@
 #include <stdexcept>
 
 #include <dynd/diagnostics.hpp>
+#include <dynd/cpu_features.hpp>
 #include <dynd/kernels/byteswap_kernels.hpp>
+#include "single_assigner_builtin.hpp"
+
+#ifdef DYND_USE_TARGET_ATTRIBUTES
+# include <immintrin.h>
+#endif
 
 using namespace std;
 using namespace dynd;
 
 namespace {
+    /** Byteswaps one unit of `unit_size` bytes, works in place */
+    template<int unit_size>
+    struct byteswap_unit;
 
-    template<typename T>
-    struct aligned_fixed_size_byteswap {
-        static void single(char *dst, const char *src,
-                        ckernel_prefix *DYND_UNUSED(extra))
-        {
-            DYND_ASSERT_ALIGNED(dst, 0, sizeof(T), "type: " << ndt::type(dynd::type_id_of<T>::value));
-            DYND_ASSERT_ALIGNED(src, 0, sizeof(T), "type: " << ndt::type(dynd::type_id_of<T>::value));
-            *(T *)dst = byteswap_value(*(T *)src);
+    template<>
+    struct byteswap_unit<2> {
+        static inline void swap(char *dst, const char *src) {
+            *reinterpret_cast<uint16_t *>(dst) = byteswap_value(*reinterpret_cast<const uint16_t *>(src));
         }
-        static void strided(char *dst, intptr_t dst_stride,
-                        const char *src, intptr_t src_stride,
-                        size_t count, ckernel_prefix *DYND_UNUSED(extra))
-        {
-            DYND_ASSERT_ALIGNED(dst, dst_stride, sizeof(T), "type: " << ndt::type(dynd::type_id_of<T>::value));
-            DYND_ASSERT_ALIGNED(src, src_stride, sizeof(T), "type: " << ndt::type(dynd::type_id_of<T>::value));
-            for (size_t i = 0; i != count; ++i,
-                            dst += dst_stride, src += src_stride) {
-                *(T *)dst = byteswap_value(*(T *)src);
-            }
+    };
+
+    template<>
+    struct byteswap_unit<4> {
+        static inline void swap(char *dst, const char *src) {
+            *reinterpret_cast<uint32_t *>(dst) = byteswap_value(*reinterpret_cast<const uint32_t *>(src));
+        }
+    };
+
+    template<>
+    struct byteswap_unit<8> {
+        static inline void swap(char *dst, const char *src) {
+            *reinterpret_cast<uint64_t *>(dst) = byteswap_value(*reinterpret_cast<const uint64_t *>(src));
         }
     };
 
-    template<typename T>
-    struct aligned_fixed_size_pairwise_byteswap_kernel {
+    template<>
+    struct byteswap_unit<16> {
+        static inline void swap(char *dst, const char *src) {
+            uint64_t lo = byteswap_value(*reinterpret_cast<const uint64_t *>(src));
+            uint64_t hi = byteswap_value(*(reinterpret_cast<const uint64_t *>(src) + 1));
+            *reinterpret_cast<uint64_t *>(dst) = hi;
+            *(reinterpret_cast<uint64_t *>(dst) + 1) = lo;
+        }
+    };
+
+    template<int unit_size>
+    DYND_FORCE_INLINE void byteswap_contiguous_scalar(char *dst, const char *src, size_t unit_count)
+    {
+        for (size_t i = 0; i != unit_count; ++i) {
+            byteswap_unit<unit_size>::swap(dst + i * unit_size, src + i * unit_size);
+        }
+    }
+
+#ifdef DYND_USE_TARGET_ATTRIBUTES
+    /** The pshufb control reversing each `unit_size` byte unit of 16 bytes */
+    template<int unit_size>
+    DYND_TARGET_SSE4_2 inline __m128i byteswap_shuffle_mask()
+    {
+#define DYND_BYTESWAP_MASK(i) static_cast<char>((i) / unit_size * unit_size + unit_size - 1 - (i) % unit_size)
+        return _mm_setr_epi8(DYND_BYTESWAP_MASK(0), DYND_BYTESWAP_MASK(1), DYND_BYTESWAP_MASK(2),
+                        DYND_BYTESWAP_MASK(3), DYND_BYTESWAP_MASK(4), DYND_BYTESWAP_MASK(5),
+                        DYND_BYTESWAP_MASK(6), DYND_BYTESWAP_MASK(7), DYND_BYTESWAP_MASK(8),
+                        DYND_BYTESWAP_MASK(9), DYND_BYTESWAP_MASK(10), DYND_BYTESWAP_MASK(11),
+                        DYND_BYTESWAP_MASK(12), DYND_BYTESWAP_MASK(13), DYND_BYTESWAP_MASK(14),
+                        DYND_BYTESWAP_MASK(15));
+#undef DYND_BYTESWAP_MASK
+    }
+
+    template<int unit_size>
+    DYND_TARGET_SSE4_2 inline void byteswap_contiguous_ssse3(char *dst, const char *src, size_t unit_count)
+    {
+        size_t size = unit_count * unit_size, i = 0;
+        __m128i mask = byteswap_shuffle_mask<unit_size>();
+        for (; i + 16 <= size; i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_shuffle_epi8(v, mask));
+        }
+        byteswap_contiguous_scalar<unit_size>(dst + i, src + i, (size - i) / unit_size);
+    }
+
+    template<int unit_size>
+    DYND_TARGET_AVX2 inline void byteswap_contiguous_avx2(char *dst, const char *src, size_t unit_count)
+    {
+        size_t size = unit_count * unit_size, i = 0;
+        // The units are at most 16 bytes, so they never cross the 128-bit lanes vpshufb works within
+        __m256i mask = _mm256_broadcastsi128_si256(byteswap_shuffle_mask<unit_size>());
+        for (; i + 32 <= size; i += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_shuffle_epi8(v, mask));
+        }
+        byteswap_contiguous_scalar<unit_size>(dst + i, src + i, (size - i) / unit_size);
+    }
+#endif
+
+    /**
+     * Strided byteswap of elements made of `units` units of `unit_size`
+     * bytes each, one for a plain byteswap and two for a pairwise byteswap.
+     * The contiguous case treats the data as one long run of units.
+     */
+#define DYND_BYTESWAP_STRIDED_VARIANT(isa, target, contiguous) \
+    template<int unit_size, int units> \
+    struct byteswap_strided_##isa { \
+        target static void strided(char *dst, intptr_t dst_stride, \
+                        const char *src, intptr_t src_stride, \
+                        size_t count, ckernel_prefix *DYND_UNUSED(extra)) \
+        { \
+            DYND_ASSERT_ALIGNED(dst, dst_stride, unit_size < 8 ? unit_size : 8, "unit size: " << unit_size); \
+            DYND_ASSERT_ALIGNED(src, src_stride, unit_size < 8 ? unit_size : 8, "unit size: " << unit_size); \
+            if (dst_stride == unit_size * units && src_stride == unit_size * units) { \
+                contiguous<unit_size>(dst, src, count * units); \
+            } else { \
+                for (size_t i = 0; i != count; ++i, dst += dst_stride, src += src_stride) { \
+                    for (int j = 0; j != units; ++j) { \
+                        byteswap_unit<unit_size>::swap(dst + j * unit_size, src + j * unit_size); \
+                    } \
+                } \
+            } \
+        } \
+    };
+
+    DYND_BYTESWAP_STRIDED_VARIANT(baseline, , byteswap_contiguous_scalar)
+#ifdef DYND_USE_TARGET_ATTRIBUTES
+    DYND_BYTESWAP_STRIDED_VARIANT(sse4_2, DYND_TARGET_SSE4_2, byteswap_contiguous_ssse3)
+    DYND_BYTESWAP_STRIDED_VARIANT(avx2, DYND_TARGET_AVX2, byteswap_contiguous_avx2)
+#endif
+#undef DYND_BYTESWAP_STRIDED_VARIANT
+
+    /** Picks the strided byteswap for the instruction set from get_cpu_isa() */
+    template<int unit_size, int units>
+    unary_strided_operation_t get_byteswap_strided()
+    {
+        static const unary_strided_operation_t variants[cpu_isa_count] = {
+            &byteswap_strided_baseline<unit_size, units>::strided,
+#ifdef DYND_USE_TARGET_ATTRIBUTES
+            &byteswap_strided_sse4_2<unit_size, units>::strided,
+            &byteswap_strided_avx2<unit_size, units>::strided,
+            NULL
+#else
+            NULL, NULL, NULL
+#endif
+        };
+        return select_cpu_isa_variant(variants, get_cpu_isa());
+    }
+
+    template<int unit_size, int units>
+    struct aligned_fixed_size_byteswap {
         static void single(char *dst, const char *src,
                         ckernel_prefix *DYND_UNUSED(extra))
         {
-            DYND_ASSERT_ALIGNED(dst, 0, sizeof(T), "type: " << ndt::type(dynd::type_id_of<T>::value));
-            DYND_ASSERT_ALIGNED(src, 0, sizeof(T), "type: " << ndt::type(dynd::type_id_of<T>::value));
-            *(T *)dst = byteswap_value(*(T *)src);
-            *((T *)dst + 1) = byteswap_value(*((T *)src + 1));
-        }
-        static void strided(char *dst, intptr_t dst_stride,
-                        const char *src, intptr_t src_stride,
-                        size_t count, ckernel_prefix *DYND_UNUSED(extra))
-        {
-            DYND_ASSERT_ALIGNED(dst, dst_stride, sizeof(T), "type: " << ndt::type(dynd::type_id_of<T>::value));
-            DYND_ASSERT_ALIGNED(src, src_stride, sizeof(T), "type: " << ndt::type(dynd::type_id_of<T>::value));
-            for (size_t i = 0; i != count; ++i,
-                            dst += dst_stride, src += src_stride) {
-                *(T *)dst = byteswap_value(*(T *)src);
-                *((T *)dst + 1) = byteswap_value(*((T *)src + 1));
+            DYND_ASSERT_ALIGNED(dst, 0, unit_size < 8 ? unit_size : 8, "unit size: " << unit_size);
+            DYND_ASSERT_ALIGNED(src, 0, unit_size < 8 ? unit_size : 8, "unit size: " << unit_size);
+            for (int j = 0; j != units; ++j) {
+                byteswap_unit<unit_size>::swap(dst + j * unit_size, src + j * unit_size);
             }
         }
     };
+
+    /**
+     * Sets up a leaf byteswap kernel for elements of `units` units
+     * of `unit_size` bytes.
+     */
+    template<int unit_size, int units>
+    size_t make_aligned_fixed_size_byteswap(ckernel_builder *out, size_t offset_out,
+                    kernel_request_t kernreq, const char *func_name)
+    {
+        ckernel_prefix *result = out->get_at<ckernel_prefix>(offset_out);
+        if (kernreq == kernel_request_single) {
+            result->set_function<unary_single_operation_t>(
+                            &aligned_fixed_size_byteswap<unit_size, units>::single);
+        } else if (kernreq == kernel_request_strided) {
+            result->set_function<unary_strided_operation_t>(
+                            get_byteswap_strided<unit_size, units>());
+        } else {
+            stringstream ss;
+            ss << func_name << ": unrecognized request " << (int)kernreq;
+            throw runtime_error(ss.str());
+        }
+        return offset_out + sizeof(ckernel_prefix);
+    }
 } // anonymous namespace
 
 namespace {
@@ -123,52 +252,20 @@ size_t dynd::make_byteswap_assignment_function(
 {
     ckernel_prefix *result = NULL;
     // This is a leaf kernel, so no need to reserve more space
-    if (data_size == data_alignment) {
+    if (data_size == data_alignment || (data_size == 16 && data_alignment >= 8)) {
         switch (data_size) {
         case 2:
-            result = out->get_at<ckernel_prefix>(offset_out);
-            if (kernreq == kernel_request_single) {
-                result->set_function<unary_single_operation_t>(
-                                &aligned_fixed_size_byteswap<uint16_t>::single);
-            } else if (kernreq == kernel_request_strided) {
-                result->set_function<unary_strided_operation_t>(
-                                &aligned_fixed_size_byteswap<uint16_t>::strided);
-            } else {
-                stringstream ss;
-                ss << "make_byteswap_assignment_function: unrecognized request " << (int)kernreq;
-                throw runtime_error(ss.str());
-            }
-            return offset_out + sizeof(ckernel_prefix);
+            return make_aligned_fixed_size_byteswap<2, 1>(out, offset_out,
+                            kernreq, "make_byteswap_assignment_function");
         case 4:
-            result = out->get_at<ckernel_prefix>(offset_out);
-            if (kernreq == kernel_request_single) {
-                result->set_function<unary_single_operation_t>(
-                                &aligned_fixed_size_byteswap<uint32_t>::single);
-            } else if (kernreq == kernel_request_strided) {
-                result->set_function<unary_strided_operation_t>(
-                                &aligned_fixed_size_byteswap<uint32_t>::strided);
-            } else {
-                stringstream ss;
-                ss << "make_byteswap_assignment_function: unrecognized request " << (int)kernreq;
-                throw runtime_error(ss.str());
-            }
-            return offset_out + sizeof(ckernel_prefix);
-            break;
+            return make_aligned_fixed_size_byteswap<4, 1>(out, offset_out,
+                            kernreq, "make_byteswap_assignment_function");
         case 8:
-            result = out->get_at<ckernel_prefix>(offset_out);
-            if (kernreq == kernel_request_single) {
-                result->set_function<unary_single_operation_t>(
-                                &aligned_fixed_size_byteswap<uint64_t>::single);
-            } else if (kernreq == kernel_request_strided) {
-                result->set_function<unary_strided_operation_t>(
-                                &aligned_fixed_size_byteswap<uint64_t>::strided);
-            } else {
-                stringstream ss;
-                ss << "make_byteswap_assignment_function: unrecognized request " << (int)kernreq;
-                throw runtime_error(ss.str());
-            }
-            return offset_out + sizeof(ckernel_prefix);
-            break;
+            return make_aligned_fixed_size_byteswap<8, 1>(out, offset_out,
+                            kernreq, "make_byteswap_assignment_function");
+        case 16:
+            return make_aligned_fixed_size_byteswap<16, 1>(out, offset_out,
+                            kernreq, "make_byteswap_assignment_function");
         default:
             break;
         }
@@ -190,52 +287,17 @@ size_t dynd::make_pairwise_byteswap_assignment_function(
 {
     ckernel_prefix *result = NULL;
     // This is a leaf kernel, so no need to reserve more space
-    if (data_size == data_alignment) {
+    if (data_size == data_alignment || data_size == 2 * data_alignment) {
         switch (data_size) {
         case 4:
-            result = out->get_at<ckernel_prefix>(offset_out);
-            if (kernreq == kernel_request_single) {
-                result->set_function<unary_single_operation_t>(
-                                &aligned_fixed_size_pairwise_byteswap_kernel<uint16_t>::single);
-            } else if (kernreq == kernel_request_strided) {
-                result->set_function<unary_strided_operation_t>(
-                                &aligned_fixed_size_pairwise_byteswap_kernel<uint16_t>::strided);
-            } else {
-                stringstream ss;
-                ss << "make_pairwise_byteswap_assignment_function: unrecognized request " << (int)kernreq;
-                throw runtime_error(ss.str());
-            }
-            return offset_out + sizeof(ckernel_prefix);
+            return make_aligned_fixed_size_byteswap<2, 2>(out, offset_out,
+                            kernreq, "make_pairwise_byteswap_assignment_function");
         case 8:
-            result = out->get_at<ckernel_prefix>(offset_out);
-            if (kernreq == kernel_request_single) {
-                result->set_function<unary_single_operation_t>(
-                                &aligned_fixed_size_pairwise_byteswap_kernel<uint32_t>::single);
-            } else if (kernreq == kernel_request_strided) {
-                result->set_function<unary_strided_operation_t>(
-                                &aligned_fixed_size_pairwise_byteswap_kernel<uint32_t>::strided);
-            } else {
-                stringstream ss;
-                ss << "make_pairwise_byteswap_assignment_function: unrecognized request " << (int)kernreq;
-                throw runtime_error(ss.str());
-            }
-            return offset_out + sizeof(ckernel_prefix);
-            break;
+            return make_aligned_fixed_size_byteswap<4, 2>(out, offset_out,
+                            kernreq, "make_pairwise_byteswap_assignment_function");
         case 16:
-            result = out->get_at<ckernel_prefix>(offset_out);
-            if (kernreq == kernel_request_single) {
-                result->set_function<unary_single_operation_t>(
-                                &aligned_fixed_size_pairwise_byteswap_kernel<uint64_t>::single);
-            } else if (kernreq == kernel_request_strided) {
-                result->set_function<unary_strided_operation_t>(
-                                &aligned_fixed_size_pairwise_byteswap_kernel<uint64_t>::strided);
-            } else {
-                stringstream ss;
-                ss << "make_pairwise_byteswap_assignment_function: unrecognized request " << (int)kernreq;
-                throw runtime_error(ss.str());
-            }
-            return offset_out + sizeof(ckernel_prefix);
-            break;
+            return make_aligned_fixed_size_byteswap<8, 2>(out, offset_out,
+                            kernreq, "make_pairwise_byteswap_assignment_function");
         default:
             break;
         }
@@ -249,3 +311,202 @@ size_t dynd::make_pairwise_byteswap_assignment_function(
     reinterpret_cast<pairwise_byteswap_single_kernel_extra *>(result)->data_size = data_size;
     return offset_out + sizeof(pairwise_byteswap_single_kernel_extra);
 }
+
+namespace {
+    /** The unsigned integer type to byteswap a value of type T through */
+    template<int size>
+    struct byteswap_uint;
+    template<> struct byteswap_uint<2> { typedef uint16_t type; };
+    template<> struct byteswap_uint<4> { typedef uint32_t type; };
+    template<> struct byteswap_uint<8> { typedef uint64_t type; };
+
+    template<typename dst_type, typename src_type>
+    DYND_FORCE_INLINE void byteswap_convert_value(char *dst, const char *src)
+    {
+        typedef typename byteswap_uint<sizeof(src_type)>::type uint_type;
+        union { uint_type bits; src_type value; } conv;
+        conv.bits = byteswap_value(*reinterpret_cast<const uint_type *>(src));
+        single_assigner_builtin<dst_type, src_type, assign_error_none>::assign(
+                        reinterpret_cast<dst_type *>(dst), &conv.value, NULL);
+    }
+
+    /**
+     * The loop of the fused byteswap and conversion, which does both
+     * in one pass over the data instead of buffering the byteswapped
+     * values. The contiguous case is separate so the compiler can
+     * vectorize it.
+     */
+    template<typename dst_type, typename src_type>
+    DYND_FORCE_INLINE void byteswap_convert_loop(
+                    char *dst, intptr_t dst_stride,
+                    const char *src, intptr_t src_stride, size_t count)
+    {
+        if (dst_stride == (intptr_t)sizeof(dst_type) && src_stride == (intptr_t)sizeof(src_type)) {
+            for (size_t i = 0; i != count; ++i) {
+                byteswap_convert_value<dst_type, src_type>(dst + i * sizeof(dst_type),
+                                src + i * sizeof(src_type));
+            }
+        } else {
+            for (size_t i = 0; i != count; ++i, dst += dst_stride, src += src_stride) {
+                byteswap_convert_value<dst_type, src_type>(dst, src);
+            }
+        }
+    }
+
+    template<typename dst_type, typename src_type>
+    struct byteswap_convert_baseline {
+        static void single(char *dst, const char *src, ckernel_prefix *DYND_UNUSED(extra))
+        {
+            byteswap_convert_value<dst_type, src_type>(dst, src);
+        }
+        static void strided(char *dst, intptr_t dst_stride,
+                        const char *src, intptr_t src_stride,
+                        size_t count, ckernel_prefix *DYND_UNUSED(extra))
+        {
+            byteswap_convert_loop<dst_type, src_type>(dst, dst_stride, src, src_stride, count);
+        }
+    };
+
+#ifdef DYND_USE_TARGET_ATTRIBUTES
+#define DYND_BYTESWAP_CONVERT_VARIANT(isa, target) \
+    template<typename dst_type, typename src_type> \
+    struct byteswap_convert_##isa { \
+        target static void strided(char *dst, intptr_t dst_stride, \
+                        const char *src, intptr_t src_stride, \
+                        size_t count, ckernel_prefix *DYND_UNUSED(extra)) \
+        { \
+            byteswap_convert_loop<dst_type, src_type>(dst, dst_stride, src, src_stride, count); \
+        } \
+    };
+
+    DYND_BYTESWAP_CONVERT_VARIANT(sse4_2, DYND_TARGET_SSE4_2)
+    DYND_BYTESWAP_CONVERT_VARIANT(avx2, DYND_TARGET_AVX2)
+    DYND_BYTESWAP_CONVERT_VARIANT(avx512, DYND_TARGET_AVX512)
+#undef DYND_BYTESWAP_CONVERT_VARIANT
+#endif
+
+    /** Picks the fused strided kernel for the instruction set from get_cpu_isa() */
+    template<typename dst_type, typename src_type>
+    unary_strided_operation_t get_byteswap_convert_strided()
+    {
+        static const unary_strided_operation_t variants[cpu_isa_count] = {
+            &byteswap_convert_baseline<dst_type, src_type>::strided,
+#ifdef DYND_USE_TARGET_ATTRIBUTES
+            &byteswap_convert_sse4_2<dst_type, src_type>::strided,
+            &byteswap_convert_avx2<dst_type, src_type>::strided,
+            &byteswap_convert_avx512<dst_type, src_type>::strided
+#else
+            NULL, NULL, NULL
+#endif
+        };
+        return select_cpu_isa_variant(variants, get_cpu_isa());
+    }
+
+    template<typename dst_type, typename src_type>
+    size_t make_byteswap_convert(ckernel_builder *out, size_t offset_out,
+                    kernel_request_t kernreq)
+    {
+        ckernel_prefix *result = out->get_at<ckernel_prefix>(offset_out);
+        if (kernreq == kernel_request_single) {
+            result->set_function<unary_single_operation_t>(
+                            &byteswap_convert_baseline<dst_type, src_type>::single);
+        } else if (kernreq == kernel_request_strided) {
+            result->set_function<unary_strided_operation_t>(
+                            get_byteswap_convert_strided<dst_type, src_type>());
+        } else {
+            stringstream ss;
+            ss << "make_byteswap_convert_assignment_kernel: unrecognized request " << (int)kernreq;
+            throw runtime_error(ss.str());
+        }
+        return offset_out + sizeof(ckernel_prefix);
+    }
+
+    template<typename src_type>
+    size_t make_byteswap_convert_to(ckernel_builder *out, size_t offset_out,
+                    type_id_t dst_type_id, kernel_request_t kernreq)
+    {
+        switch (dst_type_id) {
+            case int8_type_id:
+                return make_byteswap_convert<int8_t, src_type>(out, offset_out, kernreq);
+            case int16_type_id:
+                return make_byteswap_convert<int16_t, src_type>(out, offset_out, kernreq);
+            case int32_type_id:
+                return make_byteswap_convert<int32_t, src_type>(out, offset_out, kernreq);
+            case int64_type_id:
+                return make_byteswap_convert<int64_t, src_type>(out, offset_out, kernreq);
+            case uint8_type_id:
+                return make_byteswap_convert<uint8_t, src_type>(out, offset_out, kernreq);
+            case uint16_type_id:
+                return make_byteswap_convert<uint16_t, src_type>(out, offset_out, kernreq);
+            case uint32_type_id:
+                return make_byteswap_convert<uint32_t, src_type>(out, offset_out, kernreq);
+            case uint64_type_id:
+                return make_byteswap_convert<uint64_t, src_type>(out, offset_out, kernreq);
+            case float32_type_id:
+                return make_byteswap_convert<float, src_type>(out, offset_out, kernreq);
+            case float64_type_id:
+                return make_byteswap_convert<double, src_type>(out, offset_out, kernreq);
+            default: {
+                stringstream ss;
+                ss << "make_byteswap_convert_assignment_kernel: cannot convert to " << ndt::type(dst_type_id);
+                throw runtime_error(ss.str());
+            }
+        }
+    }
+
+    bool is_byteswap_convert_type(type_id_t tid)
+    {
+        switch (tid) {
+            case int8_type_id:
+            case int16_type_id:
+            case int32_type_id:
+            case int64_type_id:
+            case uint8_type_id:
+            case uint16_type_id:
+            case uint32_type_id:
+            case uint64_type_id:
+            case float32_type_id:
+            case float64_type_id:
+                return true;
+            default:
+                return false;
+        }
+    }
+} // anonymous namespace
+
+bool dynd::has_byteswap_convert_assignment_kernel(type_id_t dst_type_id, type_id_t src_type_id)
+{
+    return is_byteswap_convert_type(dst_type_id) && is_byteswap_convert_type(src_type_id) &&
+                    src_type_id != int8_type_id && src_type_id != uint8_type_id;
+}
+
+size_t dynd::make_byteswap_convert_assignment_kernel(
+                ckernel_builder *out, size_t offset_out,
+                type_id_t dst_type_id, type_id_t src_type_id,
+                kernel_request_t kernreq)
+{
+    // This is a leaf kernel, so no need to reserve more space
+    switch (src_type_id) {
+        case int16_type_id:
+            return make_byteswap_convert_to<int16_t>(out, offset_out, dst_type_id, kernreq);
+        case int32_type_id:
+            return make_byteswap_convert_to<int32_t>(out, offset_out, dst_type_id, kernreq);
+        case int64_type_id:
+            return make_byteswap_convert_to<int64_t>(out, offset_out, dst_type_id, kernreq);
+        case uint16_type_id:
+            return make_byteswap_convert_to<uint16_t>(out, offset_out, dst_type_id, kernreq);
+        case uint32_type_id:
+            return make_byteswap_convert_to<uint32_t>(out, offset_out, dst_type_id, kernreq);
+        case uint64_type_id:
+            return make_byteswap_convert_to<uint64_t>(out, offset_out, dst_type_id, kernreq);
+        case float32_type_id:
+            return make_byteswap_convert_to<float>(out, offset_out, dst_type_id, kernreq);
+        case float64_type_id:
+            return make_byteswap_convert_to<double>(out, offset_out, dst_type_id, kernreq);
+        default: {
+            stringstream ss;
+            ss << "make_byteswap_convert_assignment_kernel: cannot convert from byteswapped " << ndt::type(src_type_id);
+            throw runtime_error(ss.str());
+        }
+    }
+}
@@ -0,0 +1,430 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <list>
+#include <map>
+#include <vector>
+
+#ifdef _WIN32
+# define NOMINMAX
+# include <Windows.h>
+#else
+# include <pthread.h>
+#endif
+
+#include <dynd/type.hpp>
+#include <dynd/kernels/ckernel_cache.hpp>
+#include <dynd/kernels/hash_kernels.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace dynd { namespace detail {
+    struct ckernel_cache_entry {
+        enum { assignment_kind, comparison_kind };
+
+        // The key
+        int kind;
+        ndt::type tp0, tp1;
+        // The assign_error_mode or comparison_type_t
+        int mode;
+        int kernreq;
+        bool has_ectx;
+        eval::eval_context ectx;
+        uint64_t hash;
+        // The metadata of tp0 followed by that of tp1, which
+        // the kernel was instantiated against
+        vector<char> metadata;
+
+        // False if the key types can't be cached, in which case the
+        // kernel refers to the caller's metadata
+        bool cacheable;
+        ckernel_builder kernel;
+
+        // Position in the cache while idle
+        list<ckernel_cache_entry *>::iterator lru_pos;
+        multimap<uint64_t, ckernel_cache_entry *>::iterator hash_pos;
+    };
+}} // namespace dynd::detail
+
+using dynd::detail::ckernel_cache_entry;
+
+namespace {
+    /** The parameters of a ckernel being looked up */
+    struct cache_key {
+        int kind;
+        const ndt::type *tp0, *tp1;
+        const char *metadata0, *metadata1;
+        int mode;
+        int kernreq;
+        const eval::eval_context *ectx;
+        uint64_t hash;
+        bool cacheable;
+    };
+
+    /**
+     * The idle ckernels, by hash and by order of
+     * last use with the most recently used first.
+     */
+    struct ckernel_cache {
+        multimap<uint64_t, ckernel_cache_entry *> by_hash;
+        list<ckernel_cache_entry *> lru;
+        size_t capacity;
+        ckernel_cache_stats stats;
+
+        ckernel_cache()
+            : capacity(256)
+        {
+            memset(&stats, 0, sizeof(stats));
+        }
+
+        void remove(ckernel_cache_entry *e) {
+            by_hash.erase(e->hash_pos);
+            lru.erase(e->lru_pos);
+        }
+    };
+
+    // Both locks are statically initialized, so the cache may be
+    // used during the static initialization of other modules
+#ifdef _WIN32
+    SRWLOCK cache_mutex = SRWLOCK_INIT;
+#else
+    pthread_mutex_t cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+    // Allocated on first use, while holding the lock
+    ckernel_cache *cache_instance = NULL;
+
+    class cache_lock {
+        // Non-copyable
+        cache_lock(const cache_lock&);
+        cache_lock& operator=(const cache_lock&);
+    public:
+        cache_lock() {
+#ifdef _WIN32
+            AcquireSRWLockExclusive(&cache_mutex);
+#else
+            pthread_mutex_lock(&cache_mutex);
+#endif
+        }
+
+        ~cache_lock() {
+#ifdef _WIN32
+            ReleaseSRWLockExclusive(&cache_mutex);
+#else
+            pthread_mutex_unlock(&cache_mutex);
+#endif
+        }
+
+        /** The cache, which must only be touched while locked */
+        ckernel_cache& get_cache() {
+            if (cache_instance == NULL) {
+                cache_instance = new ckernel_cache;
+            }
+            return *cache_instance;
+        }
+    };
+
+    static void delete_entries(const vector<ckernel_cache_entry *>& entries)
+    {
+        for (size_t i = 0; i < entries.size(); ++i) {
+            delete entries[i];
+        }
+    }
+
+    /** Evicts least recently used entries until the cache fits its capacity */
+    static void shrink_to_capacity(ckernel_cache& c, vector<ckernel_cache_entry *>& out_evicted)
+    {
+        while (c.lru.size() > c.capacity) {
+            ckernel_cache_entry *e = c.lru.back();
+            c.remove(e);
+            out_evicted.push_back(e);
+            ++c.stats.evictions;
+        }
+    }
+
+    /**
+     * Types whose metadata holds references to memory blocks
+     * can't be cached, their metadata bytes identify the data
+     * rather than its layout.
+     */
+    static bool is_cacheable_type(const ndt::type& tp)
+    {
+        return tp.is_builtin() ||
+                    (tp.get_flags() & (type_flag_blockref|type_flag_not_host_readable)) == 0;
+    }
+
+    static void init_key(cache_key& key, int kind,
+                    const ndt::type& tp0, const char *metadata0,
+                    const ndt::type& tp1, const char *metadata1,
+                    int mode, int kernreq, const eval::eval_context *ectx)
+    {
+        key.kind = kind;
+        key.tp0 = &tp0;
+        key.tp1 = &tp1;
+        key.metadata0 = metadata0;
+        key.metadata1 = metadata1;
+        key.mode = mode;
+        key.kernreq = kernreq;
+        key.ectx = ectx;
+        // Profiled ckernels report to their own profile, and ckernels
+        // locking the date format keep the format detected by each call
+        // in their data, so neither can be shared
+        key.cacheable = is_cacheable_type(tp0) && is_cacheable_type(tp1) &&
+                        (ectx == NULL || (ectx->profile == NULL && !ectx->lock_date_format));
+        if (key.cacheable) {
+            uint64_t h = hash_mix(((uint64_t)kind << 48) ^ ((uint64_t)mode << 32) ^
+                            ((uint64_t)kernreq << 16) ^
+                            ((uint64_t)tp0.get_type_id() << 8) ^ (uint64_t)tp1.get_type_id());
+            if (ectx != NULL) {
+                h = hash_mix(h ^ ((uint64_t)ectx->default_assign_error_mode << 40) ^
+                                ((uint64_t)ectx->default_cuda_device_to_device_assign_error_mode << 32) ^
+                                (uint64_t)ectx->buffer_max_mem);
+            }
+            h = hash_mix(h ^ hash_bytes(metadata0, tp0.get_metadata_size()));
+            key.hash = hash_mix(h ^ hash_bytes(metadata1, tp1.get_metadata_size()));
+        } else {
+            key.hash = 0;
+        }
+    }
+
+    /**
+     * Checks all of the key except the types, which are only compared by
+     * identity. Comparing types for equality may compare arrays, as for
+     * categorical types, and so must not be done while holding the lock.
+     */
+    static bool key_matches_locked(const cache_key& key, const ckernel_cache_entry *e,
+                    bool& out_same_types)
+    {
+        if (e->kind != key.kind || e->mode != key.mode || e->kernreq != key.kernreq) {
+            return false;
+        }
+        if (e->has_ectx != (key.ectx != NULL) || (key.ectx != NULL &&
+                        (e->ectx.default_assign_error_mode !=
+                                key.ectx->default_assign_error_mode ||
+                         e->ectx.default_cuda_device_to_device_assign_error_mode !=
+                                key.ectx->default_cuda_device_to_device_assign_error_mode ||
+                         e->ectx.profile != key.ectx->profile ||
+                         e->ectx.buffer_max_mem != key.ectx->buffer_max_mem ||
+                         e->ectx.lock_date_format != key.ectx->lock_date_format))) {
+            return false;
+        }
+        if (e->tp0.get_type_id() != key.tp0->get_type_id() ||
+                        e->tp1.get_type_id() != key.tp1->get_type_id()) {
+            return false;
+        }
+        size_t size0 = key.tp0->get_metadata_size(), size1 = key.tp1->get_metadata_size();
+        if (e->metadata.size() != size0 + size1 ||
+                        (size0 > 0 && memcmp(&e->metadata[0], key.metadata0, size0) != 0) ||
+                        (size1 > 0 && memcmp(&e->metadata[size0], key.metadata1, size1) != 0)) {
+            return false;
+        }
+        out_same_types = e->tp0.extended() == key.tp0->extended() &&
+                        e->tp1.extended() == key.tp1->extended();
+        return true;
+    }
+
+    /** Puts an entry into the cache as the most recently used */
+    static void insert_entry_locked(ckernel_cache& c, ckernel_cache_entry *e,
+                    vector<ckernel_cache_entry *>& out_evicted)
+    {
+        if (c.capacity > 0) {
+            c.lru.push_front(e);
+            e->lru_pos = c.lru.begin();
+            e->hash_pos = c.by_hash.insert(make_pair(e->hash, e));
+            shrink_to_capacity(c, out_evicted);
+        } else {
+            out_evicted.push_back(e);
+        }
+    }
+
+    /** Takes a matching idle entry out of the cache, or returns NULL */
+    static ckernel_cache_entry *take_cached_entry(const cache_key& key)
+    {
+        ckernel_cache_entry *candidate = NULL;
+        {
+            cache_lock lock;
+            ckernel_cache& c = lock.get_cache();
+            if (!key.cacheable) {
+                ++c.stats.bypasses;
+                return NULL;
+            }
+            typedef multimap<uint64_t, ckernel_cache_entry *>::iterator iterator;
+            pair<iterator, iterator> r = c.by_hash.equal_range(key.hash);
+            for (iterator it = r.first; it != r.second; ++it) {
+                ckernel_cache_entry *e = it->second;
+                bool same_types = false;
+                if (key_matches_locked(key, e, same_types)) {
+                    if (same_types) {
+                        c.remove(e);
+                        ++c.stats.hits;
+                        return e;
+                    } else if (candidate == NULL) {
+                        candidate = e;
+                    }
+                }
+            }
+            if (candidate == NULL) {
+                ++c.stats.misses;
+                return NULL;
+            }
+            c.remove(candidate);
+        }
+
+        // Equal types held in different type objects
+        bool equal_types = (candidate->tp0 == *key.tp0 && candidate->tp1 == *key.tp1);
+        vector<ckernel_cache_entry *> evicted;
+        {
+            cache_lock lock;
+            ckernel_cache& c = lock.get_cache();
+            if (equal_types) {
+                ++c.stats.hits;
+            } else {
+                ++c.stats.misses;
+                insert_entry_locked(c, candidate, evicted);
+            }
+        }
+        delete_entries(evicted);
+        return equal_types ? candidate : NULL;
+    }
+
+    /**
+     * Creates an entry for the key, copying its metadata if the
+     * kernel will be cached. The caller instantiates the kernel.
+     */
+    static ckernel_cache_entry *new_entry(const cache_key& key,
+                    const char **out_metadata0, const char **out_metadata1)
+    {
+        ckernel_cache_entry *e = new ckernel_cache_entry;
+        e->kind = key.kind;
+        e->tp0 = *key.tp0;
+        e->tp1 = *key.tp1;
+        e->mode = key.mode;
+        e->kernreq = key.kernreq;
+        e->has_ectx = (key.ectx != NULL);
+        if (key.ectx != NULL) {
+            e->ectx = *key.ectx;
+        }
+        e->hash = key.hash;
+        e->cacheable = key.cacheable;
+        if (key.cacheable) {
+            size_t size0 = key.tp0->get_metadata_size(), size1 = key.tp1->get_metadata_size();
+            e->metadata.resize(size0 + size1);
+            if (size0 > 0) {
+                memcpy(&e->metadata[0], key.metadata0, size0);
+            }
+            if (size1 > 0) {
+                memcpy(&e->metadata[size0], key.metadata1, size1);
+            }
+            *out_metadata0 = size0 > 0 ? &e->metadata[0] : NULL;
+            *out_metadata1 = size1 > 0 ? &e->metadata[size0] : NULL;
+        } else {
+            *out_metadata0 = key.metadata0;
+            *out_metadata1 = key.metadata1;
+        }
+        return e;
+    }
+} // anonymous namespace
+
+ckernel_cache_stats dynd::get_ckernel_cache_stats()
+{
+    cache_lock lock;
+    ckernel_cache& c = lock.get_cache();
+    ckernel_cache_stats result = c.stats;
+    result.size = c.lru.size();
+    return result;
+}
+
+void dynd::clear_ckernel_cache()
+{
+    vector<ckernel_cache_entry *> entries;
+    {
+        cache_lock lock;
+        ckernel_cache& c = lock.get_cache();
+        entries.assign(c.lru.begin(), c.lru.end());
+        c.lru.clear();
+        c.by_hash.clear();
+        memset(&c.stats, 0, sizeof(c.stats));
+    }
+    // Free the kernels outside the lock
+    delete_entries(entries);
+}
+
+void dynd::set_ckernel_cache_capacity(size_t capacity)
+{
+    vector<ckernel_cache_entry *> evicted;
+    {
+        cache_lock lock;
+        ckernel_cache& c = lock.get_cache();
+        c.capacity = capacity;
+        shrink_to_capacity(c, evicted);
+    }
+    delete_entries(evicted);
+}
+
+void cached_ckernel::acquire_assignment(const ndt::type& dst_tp, const char *dst_metadata,
+                const ndt::type& src_tp, const char *src_metadata,
+                kernel_request_t kernreq, assign_error_mode errmode,
+                const eval::eval_context *ectx)
+{
+    cache_key key;
+    init_key(key, ckernel_cache_entry::assignment_kind, dst_tp, dst_metadata,
+                    src_tp, src_metadata, errmode, kernreq, ectx);
+    m_entry = take_cached_entry(key);
+    if (m_entry == NULL) {
+        const char *entry_dst_metadata, *entry_src_metadata;
+        ckernel_cache_entry *e = new_entry(key, &entry_dst_metadata, &entry_src_metadata);
+        try {
+            make_assignment_kernel(&e->kernel, 0, dst_tp, entry_dst_metadata,
+                            src_tp, entry_src_metadata, kernreq, errmode, ectx);
+        } catch(...) {
+            delete e;
+            throw;
+        }
+        m_entry = e;
+    }
+}
+
+void cached_ckernel::acquire_comparison(const ndt::type& src0_tp, const char *src0_metadata,
+                const ndt::type& src1_tp, const char *src1_metadata,
+                comparison_type_t comptype,
+                const eval::eval_context *ectx)
+{
+    cache_key key;
+    init_key(key, ckernel_cache_entry::comparison_kind, src0_tp, src0_metadata,
+                    src1_tp, src1_metadata, comptype, kernel_request_single, ectx);
+    m_entry = take_cached_entry(key);
+    if (m_entry == NULL) {
+        const char *entry_src0_metadata, *entry_src1_metadata;
+        ckernel_cache_entry *e = new_entry(key, &entry_src0_metadata, &entry_src1_metadata);
+        try {
+            make_comparison_kernel(&e->kernel, 0, src0_tp, entry_src0_metadata,
+                            src1_tp, entry_src1_metadata, comptype, ectx);
+        } catch(...) {
+            delete e;
+            throw;
+        }
+        m_entry = e;
+    }
+}
+
+cached_ckernel::~cached_ckernel()
+{
+    if (m_entry == NULL) {
+        return;
+    }
+    vector<ckernel_cache_entry *> evicted;
+    if (m_entry->cacheable) {
+        cache_lock lock;
+        insert_entry_locked(lock.get_cache(), m_entry, evicted);
+    } else {
+        evicted.push_back(m_entry);
+    }
+    delete_entries(evicted);
+}
+
+ckernel_prefix *cached_ckernel::get() const
+{
+    return m_entry->kernel.get();
+}
@@ -0,0 +1,253 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <deque>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+# include <intrin.h>
+# define DYND_HAS_RDTSC
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+# include <x86intrin.h>
+# define DYND_HAS_RDTSC
+#elif defined(_WIN32)
+# define NOMINMAX
+# include <Windows.h>
+#else
+# include <time.h>
+#endif
+
+#include <dynd/atomic_refcount.hpp>
+#include <dynd/kernels/ckernel_profile.hpp>
+#include <dynd/kernels/assignment_kernels.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace dynd { namespace detail {
+    /**
+     * The nodes of a profile, shared between the ckernel_profile
+     * and all the profiling ckernels reporting to it, so that
+     * ckernels may outlive the profile.
+     */
+    struct ckernel_profile_data {
+        atomic_refcount m_use_count;
+        // A deque so node pointers stay valid as it grows
+        deque<ckernel_profile_node> nodes;
+        vector<ckernel_profile_node *> roots;
+        // The node of the ckernel currently being constructed
+        ckernel_profile_node *current;
+
+        ckernel_profile_data()
+            : m_use_count(1), current(NULL)
+        {
+        }
+    };
+}} // namespace dynd::detail
+
+using dynd::detail::ckernel_profile_data;
+
+static void profile_data_incref(ckernel_profile_data *data)
+{
+    ++data->m_use_count;
+}
+
+static void profile_data_decref(ckernel_profile_data *data)
+{
+    if (--data->m_use_count == 0) {
+        delete data;
+    }
+}
+
+/** Reads a cycle counter, or a nanosecond clock without one */
+static inline uint64_t read_cycle_counter()
+{
+#if defined(DYND_HAS_RDTSC)
+    return __rdtsc();
+#elif defined(_WIN32)
+    LARGE_INTEGER count;
+    QueryPerformanceCounter(&count);
+    return count.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+namespace {
+    struct profile_kernel_extra {
+        typedef profile_kernel_extra extra_type;
+
+        ckernel_prefix base;
+        ckernel_profile_data *data;
+        ckernel_profile_node *node;
+
+        static void single(char *dst, const char *src, ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            ckernel_prefix *echild = &(e + 1)->base;
+            unary_single_operation_t opchild = echild->get_function<unary_single_operation_t>();
+            uint64_t start = read_cycle_counter();
+            opchild(dst, src, echild);
+            ckernel_profile_node *node = e->node;
+            node->cycles += read_cycle_counter() - start;
+            ++node->calls;
+            ++node->elements;
+        }
+
+        static void strided(char *dst, intptr_t dst_stride,
+                        const char *src, intptr_t src_stride,
+                        size_t count, ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            ckernel_prefix *echild = &(e + 1)->base;
+            unary_strided_operation_t opchild = echild->get_function<unary_strided_operation_t>();
+            uint64_t start = read_cycle_counter();
+            opchild(dst, dst_stride, src, src_stride, count, echild);
+            ckernel_profile_node *node = e->node;
+            node->cycles += read_cycle_counter() - start;
+            ++node->calls;
+            node->elements += count;
+        }
+
+        static void destruct(ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            ckernel_prefix *echild = &(e + 1)->base;
+            if (echild->destructor) {
+                echild->destructor(echild);
+            }
+            if (e->data != NULL) {
+                profile_data_decref(e->data);
+            }
+        }
+    };
+} // anonymous namespace
+
+uint64_t ckernel_profile_node::get_self_cycles() const
+{
+    uint64_t child_cycles = 0;
+    for (size_t i = 0; i != children.size(); ++i) {
+        child_cycles += children[i]->cycles;
+    }
+    // Timer overhead can make the children appear to take longer
+    return child_cycles < cycles ? cycles - child_cycles : 0;
+}
+
+ckernel_profile::ckernel_profile()
+    : m_data(new ckernel_profile_data)
+{
+}
+
+ckernel_profile::~ckernel_profile()
+{
+    profile_data_decref(m_data);
+}
+
+size_t ckernel_profile::get_root_count() const
+{
+    return m_data->roots.size();
+}
+
+const ckernel_profile_node& ckernel_profile::get_root(size_t i) const
+{
+    if (i >= m_data->roots.size()) {
+        stringstream ss;
+        ss << "ckernel_profile: root index " << i << " is out of bounds, there are ";
+        ss << m_data->roots.size() << " roots";
+        throw runtime_error(ss.str());
+    }
+    return *m_data->roots[i];
+}
+
+void ckernel_profile::reset()
+{
+    deque<ckernel_profile_node>& nodes = m_data->nodes;
+    for (deque<ckernel_profile_node>::iterator it = nodes.begin(); it != nodes.end(); ++it) {
+        it->calls = 0;
+        it->elements = 0;
+        it->cycles = 0;
+    }
+}
+
+void ckernel_profile::clear()
+{
+    if (m_data->current != NULL) {
+        throw runtime_error("ckernel_profile: cannot clear while a ckernel is being constructed");
+    }
+    // Ckernels still referring to the old nodes keep them alive
+    ckernel_profile_data *data = new ckernel_profile_data;
+    profile_data_decref(m_data);
+    m_data = data;
+}
+
+static void dump_node(std::ostream& o, const ckernel_profile_node *node, int depth)
+{
+    o << setw(12) << node->calls << setw(14) << node->elements
+      << setw(16) << node->cycles << setw(16) << node->get_self_cycles() << "  ";
+    for (int i = 0; i < depth; ++i) {
+        o << "  ";
+    }
+    o << node->name << "\n";
+    for (size_t i = 0; i != node->children.size(); ++i) {
+        dump_node(o, node->children[i], depth + 1);
+    }
+}
+
+void ckernel_profile::dump(std::ostream& o) const
+{
+    o << setw(12) << "calls" << setw(14) << "elements"
+      << setw(16) << "cycles" << setw(16) << "self cycles" << "  ckernel\n";
+    for (size_t i = 0; i != m_data->roots.size(); ++i) {
+        dump_node(o, m_data->roots[i], 0);
+    }
+    o.flush();
+}
+
+size_t ckernel_profile::begin_kernel(ckernel_builder *out, size_t offset_out,
+                kernel_request_t kernreq, const std::string& name,
+                ckernel_profile_node **out_parent)
+{
+    ckernel_profile_data *data = m_data;
+    out->ensure_capacity(offset_out + sizeof(profile_kernel_extra));
+    profile_kernel_extra *e = out->get_at<profile_kernel_extra>(offset_out);
+    switch (kernreq) {
+        case kernel_request_single:
+            e->base.set_function<unary_single_operation_t>(&profile_kernel_extra::single);
+            break;
+        case kernel_request_strided:
+            e->base.set_function<unary_strided_operation_t>(&profile_kernel_extra::strided);
+            break;
+        default: {
+            stringstream ss;
+            ss << "ckernel_profile: unrecognized request " << (int)kernreq;
+            throw runtime_error(ss.str());
+        }
+    }
+    e->base.destructor = &profile_kernel_extra::destruct;
+    profile_data_incref(data);
+    e->data = data;
+
+    data->nodes.push_back(ckernel_profile_node());
+    ckernel_profile_node *node = &data->nodes.back();
+    node->name = name;
+    e->node = node;
+    if (data->current != NULL) {
+        data->current->children.push_back(node);
+    } else {
+        data->roots.push_back(node);
+    }
+    *out_parent = data->current;
+    data->current = node;
+    return offset_out + sizeof(profile_kernel_extra);
+}
+
+void ckernel_profile::end_kernel(ckernel_profile_node *parent)
+{
+    m_data->current = parent;
+}
@@ -6,6 +6,7 @@
 #include <dynd/kernels/date_assignment_kernels.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
 #include <dynd/types/cstruct_type.hpp>
+#include <dynd/types/date_parser.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -21,19 +22,55 @@ namespace {
         const base_string_type *src_string_dt;
         const char *src_metadata;
         assign_error_mode errmode;
+        // Whether the source bytes are usable as UTF-8 directly
+        bool src_is_utf8;
+        date_parser_lock_t lock;
 
-        static void single(char *dst, const char *src, ckernel_prefix *extra)
+        inline int32_t parse(const char *src)
         {
-            extra_type *e = reinterpret_cast<extra_type *>(extra);
-            const string& s = e->src_string_dt->get_utf8_string(e->src_metadata, src, e->errmode);
+            if (src_is_utf8 && lock != date_parser_locked_general) {
+                const char *begin, *end;
+                int32_t days;
+                src_string_dt->get_string_range(&begin, &end, src_metadata, src);
+                if (parse::parse_iso8601_fixed_date(begin, end, days)) {
+                    if (lock == date_parser_detecting) {
+                        lock = date_parser_locked_iso8601;
+                    }
+                    return days;
+                }
+            }
+            const string& s = src_string_dt->get_utf8_string(src_metadata, src, errmode);
             date_ymd ymd;
             // TODO: properly distinguish "date" and "option[date]" with respect to NA support
             if (s == "NA") {
-                ymd.set_to_na();
-            } else {
-                ymd.set_from_str(s);
+                return DYND_DATE_NA;
+            } else if (lock == date_parser_locked_iso8601) {
+                stringstream ss;
+                ss << "date string \"" << s << "\" is not in the ISO 8601 format YYYY-MM-DD";
+                ss << " detected from the first string";
+                throw invalid_argument(ss.str());
+            }
+            ymd.set_from_str(s);
+            if (lock == date_parser_detecting) {
+                lock = date_parser_locked_general;
+            }
+            return ymd.to_days();
+        }
+
+        static void single(char *dst, const char *src, ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            *reinterpret_cast<int32_t *>(dst) = e->parse(src);
+        }
+
+        static void strided(char *dst, intptr_t dst_stride,
+                        const char *src, intptr_t src_stride,
+                        size_t count, ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            for (size_t i = 0; i != count; ++i, dst += dst_stride, src += src_stride) {
+                *reinterpret_cast<int32_t *>(dst) = e->parse(src);
             }
-            *reinterpret_cast<int32_t *>(dst) = ymd.to_days();
         }
 
         static void destruct(ckernel_prefix *extra)
@@ -48,7 +85,7 @@ size_t dynd::make_string_to_date_assignment_kernel(
                 ckernel_builder *out, size_t offset_out,
                 const ndt::type& src_string_dt, const char *src_metadata,
                 kernel_request_t kernreq, assign_error_mode errmode,
-                const eval::eval_context *DYND_UNUSED(ectx))
+                const eval::eval_context *ectx)
 {
     if (src_string_dt.get_kind() != string_kind) {
         stringstream ss;
@@ -56,15 +93,29 @@ size_t dynd::make_string_to_date_assignment_kernel(
         throw runtime_error(ss.str());
     }
 
-    offset_out = make_kernreq_to_single_kernel_adapter(out, offset_out, kernreq);
-    out->ensure_capacity(offset_out + sizeof(string_to_date_kernel_extra));
+    out->ensure_capacity_leaf(offset_out + sizeof(string_to_date_kernel_extra));
     string_to_date_kernel_extra *e = out->get_at<string_to_date_kernel_extra>(offset_out);
-    e->base.set_function<unary_single_operation_t>(&string_to_date_kernel_extra::single);
+    switch (kernreq) {
+        case kernel_request_single:
+            e->base.set_function<unary_single_operation_t>(&string_to_date_kernel_extra::single);
+            break;
+        case kernel_request_strided:
+            e->base.set_function<unary_strided_operation_t>(&string_to_date_kernel_extra::strided);
+            break;
+        default: {
+            stringstream ss;
+            ss << "make_string_to_date_assignment_kernel: unrecognized request " << (int)kernreq;
+            throw runtime_error(ss.str());
+        }
+    }
     e->base.destructor = &string_to_date_kernel_extra::destruct;
     // The kernel data owns a reference to this type
     e->src_string_dt = static_cast<const base_string_type *>(ndt::type(src_string_dt).release());
     e->src_metadata = src_metadata;
     e->errmode = errmode;
+    string_encoding_t encoding = e->src_string_dt->get_encoding();
+    e->src_is_utf8 = (encoding == string_encoding_ascii || encoding == string_encoding_utf_8);
+    e->lock = (ectx != NULL && ectx->lock_date_format) ? date_parser_detecting : date_parser_unlocked;
     return offset_out + sizeof(string_to_date_kernel_extra);
 }
 
@@ -83,13 +134,9 @@ namespace {
         static void single(char *dst, const char *src, ckernel_prefix *extra)
         {
             extra_type *e = reinterpret_cast<extra_type *>(extra);
-            date_ymd ymd;
-            ymd.set_from_days(*reinterpret_cast<const int32_t *>(src));
-            string s = ymd.to_str();
-            if (s.empty()) {
-                s = "NA";
-            }
-            e->dst_string_dt->set_utf8_string(e->dst_metadata, dst, e->errmode, s);
+            char buf[13];
+            size_t size = date_ymd::days_to_str(*reinterpret_cast<const int32_t *>(src), buf);
+            e->dst_string_dt->set_utf8_string(e->dst_metadata, dst, e->errmode, buf, buf + size);
         }
 
         static void destruct(ckernel_prefix *extra)
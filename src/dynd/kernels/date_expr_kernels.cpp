@@ -5,6 +5,8 @@
 
 #include <time.h>
 #include <cerrno>
+#include <cstring>
+#include <vector>
 
 #include <dynd/kernels/date_expr_kernels.hpp>
 #include <dynd/kernels/elwise_expr_kernels.hpp>
@@ -134,12 +136,337 @@ namespace {
     };
 } // anonymous namespace
 
+namespace {
+    enum date_format_op_t {
+        // Copies a run of characters from the format string
+        date_format_literal,
+        // %Y, the year with no padding
+        date_format_year,
+        // %y, the last two digits of the year
+        date_format_year2,
+        // %C, the century, zero-padded to two digits
+        date_format_century,
+        // %m
+        date_format_month,
+        // %d
+        date_format_day,
+        // %e, the day padded with a space
+        date_format_day_space,
+        // %j, the day of the year from 001
+        date_format_day_of_year,
+        // %w, the day of the week with Sunday as 0
+        date_format_weekday_sunday0,
+        // %u, the day of the week with Monday as 1
+        date_format_weekday_monday1,
+        // %U, the week of the year starting on Sunday
+        date_format_week_sunday,
+        // %W, the week of the year starting on Monday
+        date_format_week_monday
+    };
+
+    struct date_format_op {
+        date_format_op_t op;
+        // The range of the literal in the format string
+        size_t literal_begin, literal_size;
+    };
+
+    /**
+     * A strftime format string for dates, compiled once into a list
+     * of ops which write their digits directly. Only directives which
+     * don't depend on the locale are supported; compile() returns false
+     * for any other, so the caller can use strftime instead.
+     */
+    class compiled_date_format {
+        string m_format;
+        vector<date_format_op> m_ops;
+        // An upper bound on the size of one formatted date
+        size_t m_max_size;
+        // Whether any op needs the day of the year
+        bool m_needs_day_of_year;
+
+        void add_op(date_format_op_t op, size_t max_size) {
+            date_format_op fop = {op, 0, 0};
+            m_ops.push_back(fop);
+            m_max_size += max_size;
+            if (op == date_format_day_of_year || op == date_format_week_sunday ||
+                            op == date_format_week_monday) {
+                m_needs_day_of_year = true;
+            }
+        }
+
+        void add_literal(size_t begin, size_t size) {
+            if (!m_ops.empty() && m_ops.back().op == date_format_literal &&
+                            m_ops.back().literal_begin + m_ops.back().literal_size == begin) {
+                m_ops.back().literal_size += size;
+            } else {
+                date_format_op fop = {date_format_literal, begin, size};
+                m_ops.push_back(fop);
+            }
+            m_max_size += size;
+        }
+
+        static inline char *write2(char *out, int value) {
+            out[0] = static_cast<char>('0' + value / 10);
+            out[1] = static_cast<char>('0' + value % 10);
+            return out + 2;
+        }
+
+        static inline char *write_int(char *out, int value) {
+            if (value >= 1000 && value <= 9999) {
+                out = write2(out, value / 100);
+                return write2(out, value % 100);
+            }
+            char buf[12];
+            char *p = buf + sizeof(buf);
+            unsigned int v = value < 0 ? 0u - static_cast<unsigned int>(value) : static_cast<unsigned int>(value);
+            do {
+                *--p = static_cast<char>('0' + v % 10);
+                v /= 10;
+            } while (v != 0);
+            if (value < 0) {
+                *--p = '-';
+            }
+            size_t size = buf + sizeof(buf) - p;
+            memcpy(out, p, size);
+            return out + size;
+        }
+
+    public:
+        compiled_date_format()
+            : m_max_size(2), m_needs_day_of_year(false)
+        {
+        }
+
+        bool compile(const string& format) {
+            // The format string has the literals, with '%' escaped as "%%"
+            m_format = format;
+            m_ops.clear();
+            m_max_size = 0;
+            m_needs_day_of_year = false;
+            for (size_t i = 0, i_end = format.size(); i != i_end; ++i) {
+                if (format[i] != '%') {
+                    add_literal(i, 1);
+                    continue;
+                }
+                if (++i == i_end) {
+                    return false;
+                }
+                switch (format[i]) {
+                    case '%':
+                        add_literal(i, 1);
+                        break;
+                    case 'n':
+                        m_format[i] = '\n';
+                        add_literal(i, 1);
+                        break;
+                    case 't':
+                        m_format[i] = '\t';
+                        add_literal(i, 1);
+                        break;
+                    case 'Y':
+                        add_op(date_format_year, 11);
+                        break;
+                    case 'y':
+                        add_op(date_format_year2, 2);
+                        break;
+                    case 'C':
+                        add_op(date_format_century, 9);
+                        break;
+                    case 'm':
+                        add_op(date_format_month, 2);
+                        break;
+                    case 'd':
+                        add_op(date_format_day, 2);
+                        break;
+                    case 'e':
+                        add_op(date_format_day_space, 2);
+                        break;
+                    case 'j':
+                        add_op(date_format_day_of_year, 3);
+                        break;
+                    case 'w':
+                        add_op(date_format_weekday_sunday0, 1);
+                        break;
+                    case 'u':
+                        add_op(date_format_weekday_monday1, 1);
+                        break;
+                    case 'U':
+                        add_op(date_format_week_sunday, 2);
+                        break;
+                    case 'W':
+                        add_op(date_format_week_monday, 2);
+                        break;
+                    case 'F': {
+                        // "%Y-%m-%d", with the '-' literals taken from "%F" itself
+                        m_format[i - 1] = '-';
+                        m_format[i] = '-';
+                        add_op(date_format_year, 11);
+                        add_literal(i - 1, 1);
+                        add_op(date_format_month, 2);
+                        add_literal(i, 1);
+                        add_op(date_format_day, 2);
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+            }
+            // Room for "NA"
+            if (m_max_size < 2) {
+                m_max_size = 2;
+            }
+            return true;
+        }
+
+        inline size_t get_max_size() const {
+            return m_max_size;
+        }
+
+        /**
+         * Formats the date into a buffer of at least get_max_size()
+         * characters, writing "NA" for DYND_DATE_NA.
+         *
+         * \returns  The number of characters written.
+         */
+        size_t format(int32_t days, char *out) const {
+            if (days == DYND_DATE_NA) {
+                out[0] = 'N';
+                out[1] = 'A';
+                return 2;
+            }
+            int32_t year, month, day, day_of_year = 0;
+            date_ymd::days_to_ymd(days, year, month, day);
+            // The days_to_weekday convention is 0 for Monday
+            int32_t wday = date_ymd::days_to_weekday(days) + 1;
+            if (wday == 7) {
+                wday = 0;
+            }
+            if (m_needs_day_of_year) {
+                day_of_year = date_ymd::month_starts[date_ymd::is_leap_year(year)][month - 1] + day - 1;
+            }
+            char *p = out;
+            for (vector<date_format_op>::const_iterator it = m_ops.begin(); it != m_ops.end(); ++it) {
+                switch (it->op) {
+                    case date_format_literal:
+                        if (it->literal_size == 1) {
+                            *p++ = m_format[it->literal_begin];
+                        } else {
+                            memcpy(p, m_format.data() + it->literal_begin, it->literal_size);
+                            p += it->literal_size;
+                        }
+                        break;
+                    case date_format_year:
+                        p = write_int(p, year);
+                        break;
+                    case date_format_year2: {
+                        int32_t y = year % 100;
+                        p = write2(p, y < 0 ? y + 100 : y);
+                        break;
+                    }
+                    case date_format_century: {
+                        int32_t c = (year >= 0) ? year / 100 : -((99 - year) / 100);
+                        if (c >= 0 && c < 10) {
+                            *p++ = '0';
+                        }
+                        p = write_int(p, c);
+                        break;
+                    }
+                    case date_format_month:
+                        p = write2(p, month);
+                        break;
+                    case date_format_day:
+                        p = write2(p, day);
+                        break;
+                    case date_format_day_space:
+                        if (day < 10) {
+                            p[0] = ' ';
+                            p[1] = static_cast<char>('0' + day);
+                            p += 2;
+                        } else {
+                            p = write2(p, day);
+                        }
+                        break;
+                    case date_format_day_of_year:
+                        *p++ = static_cast<char>('0' + (day_of_year + 1) / 100);
+                        p = write2(p, (day_of_year + 1) % 100);
+                        break;
+                    case date_format_weekday_sunday0:
+                        *p++ = static_cast<char>('0' + wday);
+                        break;
+                    case date_format_weekday_monday1:
+                        *p++ = static_cast<char>('0' + (wday == 0 ? 7 : wday));
+                        break;
+                    case date_format_week_sunday:
+                        p = write2(p, (day_of_year + 7 - wday) / 7);
+                        break;
+                    case date_format_week_monday:
+                        p = write2(p, (day_of_year + 7 - (wday + 6) % 7) / 7);
+                        break;
+                }
+            }
+            return p - out;
+        }
+    };
+
+    struct date_format_kernel_extra {
+        typedef date_format_kernel_extra extra_type;
+
+        ckernel_prefix base;
+        const compiled_date_format *format;
+        const string_type_metadata *dst_metadata;
+
+        static void single_unary(char *dst, const char *src,
+                        ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            const string_type_metadata *dst_md = e->dst_metadata;
+            string_type_data *dst_d = reinterpret_cast<string_type_data *>(dst);
+            memory_block_pod_allocator_api *allocator = get_memory_block_pod_allocator_api(dst_md->blockref);
+            allocator->allocate(dst_md->blockref, e->format->get_max_size(),
+                            1, &dst_d->begin, &dst_d->end);
+            size_t size = e->format->format(*reinterpret_cast<const int32_t *>(src), dst_d->begin);
+            allocator->resize(dst_md->blockref, size, &dst_d->begin, &dst_d->end);
+        }
+
+        static void strided_unary(char *dst, intptr_t dst_stride,
+                    const char *src, intptr_t src_stride,
+                    size_t count, ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            const compiled_date_format *format = e->format;
+            const string_type_metadata *dst_md = e->dst_metadata;
+            if (count == 0) {
+                return;
+            }
+            // One allocation sized for the whole run, with the strings packed
+            // into it one after the other, then shrunk to what they used
+            memory_block_pod_allocator_api *allocator = get_memory_block_pod_allocator_api(dst_md->blockref);
+            char *buf_begin = NULL, *buf_end = NULL;
+            allocator->allocate(dst_md->blockref, count * format->get_max_size(),
+                            1, &buf_begin, &buf_end);
+            char *p = buf_begin;
+            for (size_t i = 0; i != count; ++i, dst += dst_stride, src += src_stride) {
+                string_type_data *dst_d = reinterpret_cast<string_type_data *>(dst);
+                dst_d->begin = p;
+                p += format->format(*reinterpret_cast<const int32_t *>(src), p);
+                dst_d->end = p;
+            }
+            // Shrinking the most recent allocation never moves it
+            allocator->resize(dst_md->blockref, p - buf_begin, &buf_begin, &buf_end);
+        }
+    };
+} // anonymous namespace
+
 class date_strftime_kernel_generator : public expr_kernel_generator {
     string m_format;
+    compiled_date_format m_compiled_format;
+    // False if the format needs the C library strftime
+    bool m_compiled;
 public:
     date_strftime_kernel_generator(const string& format)
         : expr_kernel_generator(true), m_format(format)
     {
+        m_compiled = m_compiled_format.compile(format);
     }
 
     virtual ~date_strftime_kernel_generator() {
@@ -170,6 +497,29 @@ public:
                             this);
         }
 
+        if (m_compiled) {
+            out->ensure_capacity_leaf(offset_out + sizeof(date_format_kernel_extra));
+            date_format_kernel_extra *e = out->get_at<date_format_kernel_extra>(offset_out);
+            switch (kernreq) {
+                case kernel_request_single:
+                    e->base.set_function<unary_single_operation_t>(&date_format_kernel_extra::single_unary);
+                    break;
+                case kernel_request_strided:
+                    e->base.set_function<unary_strided_operation_t>(&date_format_kernel_extra::strided_unary);
+                    break;
+                default: {
+                    stringstream ss;
+                    ss << "date_strftime_kernel_generator: unrecognized request " << (int)kernreq;
+                    throw runtime_error(ss.str());
+                }
+            }
+            // The lifetime of kernels must be shorter than that of the kernel generator,
+            // so we can point at data in the kernel generator
+            e->format = &m_compiled_format;
+            e->dst_metadata = reinterpret_cast<const string_type_metadata *>(dst_metadata);
+            return offset_out + sizeof(date_format_kernel_extra);
+        }
+
         size_t extra_size = sizeof(date_strftime_kernel_extra);
         out->ensure_capacity_leaf(offset_out + extra_size);
         date_strftime_kernel_extra *e = out->get_at<date_strftime_kernel_extra>(offset_out);
@@ -362,3 +712,111 @@ expr_kernel_generator *dynd::make_replace_kernelgen(int32_t year, int32_t month,
 {
     return new date_replace_kernel_generator(year, month, day);
 }
+
+namespace {
+    /**
+     * Narrows a result computed in int64 back to int32. A result which
+     * doesn't fit, or which would be read as DYND_DATE_NA, is NA.
+     */
+    inline int32_t days_or_na(int64_t days) {
+        return (days > DYND_DATE_NA && days <= numeric_limits<int32_t>::max()) ?
+                        static_cast<int32_t>(days) : DYND_DATE_NA;
+    }
+
+    // The NA date stays NA, for any number of days
+    struct date_add_days_op {
+        static inline int32_t operate(int32_t days, int32_t n) {
+            return days != DYND_DATE_NA ? days_or_na(static_cast<int64_t>(days) + n) : DYND_DATE_NA;
+        }
+    };
+
+    struct date_subtract_days_op {
+        static inline int32_t operate(int32_t days, int32_t n) {
+            return days != DYND_DATE_NA ? days_or_na(static_cast<int64_t>(days) - n) : DYND_DATE_NA;
+        }
+    };
+
+    struct date_difference_op {
+        static inline int32_t operate(int32_t days0, int32_t days1) {
+            return (days0 != DYND_DATE_NA && days1 != DYND_DATE_NA) ?
+                            days_or_na(static_cast<int64_t>(days0) - days1) : DYND_DATE_NA;
+        }
+    };
+
+    /**
+     * The loop of a strided date arithmetic kernel, all of whose
+     * operands are int32. The contiguous case is separate so the
+     * compiler can vectorize it.
+     */
+    template<class OP>
+    inline void date_binary_strided_loop(char *dst, intptr_t dst_stride,
+                    const char * const *src, const intptr_t *src_stride,
+                    size_t count)
+    {
+        const char *src0 = src[0], *src1 = src[1];
+        intptr_t src0_stride = src_stride[0], src1_stride = src_stride[1];
+        if (dst_stride == sizeof(int32_t) && src0_stride == sizeof(int32_t) &&
+                        src1_stride == sizeof(int32_t)) {
+            int32_t *dst_typed = reinterpret_cast<int32_t *>(dst);
+            const int32_t *src0_typed = reinterpret_cast<const int32_t *>(src0);
+            const int32_t *src1_typed = reinterpret_cast<const int32_t *>(src1);
+            for (size_t i = 0; i != count; ++i) {
+                dst_typed[i] = OP::operate(src0_typed[i], src1_typed[i]);
+            }
+        } else {
+            for (size_t i = 0; i != count; ++i) {
+                *reinterpret_cast<int32_t *>(dst) = OP::operate(
+                                *reinterpret_cast<const int32_t *>(src0),
+                                *reinterpret_cast<const int32_t *>(src1));
+                dst += dst_stride;
+                src0 += src0_stride;
+                src1 += src1_stride;
+            }
+        }
+    }
+} // anonymous namespace
+
+void kernels::date_add_days_kernel::single(char *dst, const char * const *src,
+                ckernel_prefix *DYND_UNUSED(extra))
+{
+    *reinterpret_cast<int32_t *>(dst) = date_add_days_op::operate(
+                    *reinterpret_cast<const int32_t *>(src[0]),
+                    *reinterpret_cast<const int32_t *>(src[1]));
+}
+
+void kernels::date_add_days_kernel::strided(char *dst, intptr_t dst_stride,
+                const char * const *src, const intptr_t *src_stride,
+                size_t count, ckernel_prefix *DYND_UNUSED(extra))
+{
+    date_binary_strided_loop<date_add_days_op>(dst, dst_stride, src, src_stride, count);
+}
+
+void kernels::date_subtract_days_kernel::single(char *dst, const char * const *src,
+                ckernel_prefix *DYND_UNUSED(extra))
+{
+    *reinterpret_cast<int32_t *>(dst) = date_subtract_days_op::operate(
+                    *reinterpret_cast<const int32_t *>(src[0]),
+                    *reinterpret_cast<const int32_t *>(src[1]));
+}
+
+void kernels::date_subtract_days_kernel::strided(char *dst, intptr_t dst_stride,
+                const char * const *src, const intptr_t *src_stride,
+                size_t count, ckernel_prefix *DYND_UNUSED(extra))
+{
+    date_binary_strided_loop<date_subtract_days_op>(dst, dst_stride, src, src_stride, count);
+}
+
+void kernels::date_difference_kernel::single(char *dst, const char * const *src,
+                ckernel_prefix *DYND_UNUSED(extra))
+{
+    *reinterpret_cast<int32_t *>(dst) = date_difference_op::operate(
+                    *reinterpret_cast<const int32_t *>(src[0]),
+                    *reinterpret_cast<const int32_t *>(src[1]));
+}
+
+void kernels::date_difference_kernel::strided(char *dst, intptr_t dst_stride,
+                const char * const *src, const intptr_t *src_stride,
+                size_t count, ckernel_prefix *DYND_UNUSED(extra))
+{
+    date_binary_strided_loop<date_difference_op>(dst, dst_stride, src, src_stride, count);
+}
@@ -7,6 +7,7 @@
 #include <dynd/kernels/assignment_kernels.hpp>
 #include <dynd/types/cstruct_type.hpp>
 #include <dynd/types/datetime_type.hpp>
+#include <dynd/types/date_parser.hpp>
 #include <datetime_strings.h>
 
 using namespace std;
@@ -25,14 +26,60 @@ namespace {
         const char *src_metadata;
         assign_error_mode errmode;
         datetime::datetime_conversion_rule_t casting;
+        // Whether the source bytes are usable as UTF-8 directly
+        bool src_is_utf8;
+        bool is_abstract;
+        date_parser_lock_t lock;
+
+        inline int64_t parse(const char *src)
+        {
+            bool fixed_format = false;
+            if (src_is_utf8 && lock != date_parser_locked_general) {
+                const char *begin, *end;
+                int64_t ticks;
+                bool utc;
+                src_string_dt->get_string_range(&begin, &end, src_metadata, src);
+                fixed_format = parse::parse_iso8601_fixed_datetime(begin, end, ticks, utc);
+                if (fixed_format) {
+                    if (lock == date_parser_detecting) {
+                        lock = date_parser_locked_iso8601;
+                    }
+                    // A mismatched timezone goes to the general parser for its error
+                    if (utc != is_abstract || casting == datetime::datetime_conversion_relaxed) {
+                        return ticks;
+                    }
+                }
+            }
+            const string& s = src_string_dt->get_utf8_string(src_metadata, src, errmode);
+            int64_t result = datetime::parse_iso_8601_datetime(s, datetime::datetime_unit_tick,
+                                    is_abstract, casting);
+            if (result != DYND_DATETIME_NA) {
+                if (lock == date_parser_locked_iso8601 && !fixed_format) {
+                    stringstream ss;
+                    ss << "datetime string \"" << s << "\" is not in the ISO 8601 format";
+                    ss << " YYYY-MM-DDTHH:MM:SS detected from the first string";
+                    throw runtime_error(ss.str());
+                } else if (lock == date_parser_detecting) {
+                    lock = date_parser_locked_general;
+                }
+            }
+            return result;
+        }
 
         static void single(char *dst, const char *src, ckernel_prefix *extra)
         {
             extra_type *e = reinterpret_cast<extra_type *>(extra);
-            const string& s = e->src_string_dt->get_utf8_string(e->src_metadata, src, e->errmode);
-            *reinterpret_cast<int64_t *>(dst) = datetime::parse_iso_8601_datetime(s, datetime::datetime_unit_tick,
-                                    e->dst_datetime_dt->get_timezone() == tz_abstract,
-                                    e->casting);
+            *reinterpret_cast<int64_t *>(dst) = e->parse(src);
+        }
+
+        static void strided(char *dst, intptr_t dst_stride,
+                        const char *src, intptr_t src_stride,
+                        size_t count, ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            for (size_t i = 0; i != count; ++i, dst += dst_stride, src += src_stride) {
+                *reinterpret_cast<int64_t *>(dst) = e->parse(src);
+            }
         }
 
         static void destruct(ckernel_prefix *extra)
@@ -49,7 +96,7 @@ size_t dynd::make_string_to_datetime_assignment_kernel(
                 const ndt::type& dst_datetime_dt, const char *DYND_UNUSED(dst_metadata),
                 const ndt::type& src_string_dt, const char *src_metadata,
                 kernel_request_t kernreq, assign_error_mode errmode,
-                const eval::eval_context *DYND_UNUSED(ectx))
+                const eval::eval_context *ectx)
 {
     if (src_string_dt.get_kind() != string_kind) {
         stringstream ss;
@@ -57,10 +104,21 @@ size_t dynd::make_string_to_datetime_assignment_kernel(
         throw runtime_error(ss.str());
     }
 
-    offset_out = make_kernreq_to_single_kernel_adapter(out, offset_out, kernreq);
-    out->ensure_capacity(offset_out + sizeof(string_to_datetime_kernel_extra));
+    out->ensure_capacity_leaf(offset_out + sizeof(string_to_datetime_kernel_extra));
     string_to_datetime_kernel_extra *e = out->get_at<string_to_datetime_kernel_extra>(offset_out);
-    e->base.set_function<unary_single_operation_t>(&string_to_datetime_kernel_extra::single);
+    switch (kernreq) {
+        case kernel_request_single:
+            e->base.set_function<unary_single_operation_t>(&string_to_datetime_kernel_extra::single);
+            break;
+        case kernel_request_strided:
+            e->base.set_function<unary_strided_operation_t>(&string_to_datetime_kernel_extra::strided);
+            break;
+        default: {
+            stringstream ss;
+            ss << "make_string_to_datetime_assignment_kernel: unrecognized request " << (int)kernreq;
+            throw runtime_error(ss.str());
+        }
+    }
     e->base.destructor = &string_to_datetime_kernel_extra::destruct;
     // The kernel data owns a reference to this type
     e->dst_datetime_dt = static_cast<const datetime_type *>(ndt::type(dst_datetime_dt).release());
@@ -76,6 +134,10 @@ size_t dynd::make_string_to_datetime_assignment_kernel(
         default:
             e->casting = datetime::datetime_conversion_relaxed;
     }
+    string_encoding_t encoding = e->src_string_dt->get_encoding();
+    e->src_is_utf8 = (encoding == string_encoding_ascii || encoding == string_encoding_utf_8);
+    e->is_abstract = (e->dst_datetime_dt->get_timezone() == tz_abstract);
+    e->lock = (ectx != NULL && ectx->lock_date_format) ? date_parser_detecting : date_parser_unlocked;
     return offset_out + sizeof(string_to_datetime_kernel_extra);
 }
 
@@ -0,0 +1,154 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <stdexcept>
+#include <sstream>
+
+#include <dynd/kernels/datetime_tz_kernels.hpp>
+#include <dynd/kernels/elwise_expr_kernels.hpp>
+#include <dynd/types/datetime_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+    struct tz_kernel_extra {
+        typedef tz_kernel_extra extra_type;
+
+        ckernel_prefix base;
+        // The transitions to look up in, UTC or local depending
+        // on the direction, and the offsets between them
+        const int64_t *transitions;
+        size_t transition_count;
+        const int64_t *offsets;
+        // The offset sign, +1 for UTC to local and -1 for local to UTC
+        int64_t sign;
+        // The interval of the previous value. Columns of times are usually
+        // sorted or clustered, so checking this interval and the next one
+        // first makes most lookups O(1) instead of a binary search.
+        size_t hint;
+
+        /** The index into offsets of the interval containing the time */
+        inline size_t find_interval(int64_t t)
+        {
+            size_t i = hint;
+            if ((i == 0 || transitions[i - 1] <= t)) {
+                if (i != transition_count && transitions[i] <= t) {
+                    ++i;
+                    if (i != transition_count && transitions[i] <= t) {
+                        i = std::upper_bound(transitions + i + 1, transitions + transition_count, t) -
+                                        transitions;
+                    }
+                }
+            } else {
+                i = std::upper_bound(transitions, transitions + i - 1, t) - transitions;
+            }
+            hint = i;
+            return i;
+        }
+
+        inline int64_t convert(int64_t t)
+        {
+            if (t == DYND_DATETIME_NA) {
+                return t;
+            }
+            return t + sign * offsets[find_interval(t)];
+        }
+
+        static void single(char *dst, const char *src, ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            *reinterpret_cast<int64_t *>(dst) = e->convert(*reinterpret_cast<const int64_t *>(src));
+        }
+
+        static void strided(char *dst, intptr_t dst_stride,
+                        const char *src, intptr_t src_stride,
+                        size_t count, ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            for (size_t i = 0; i != count; ++i, dst += dst_stride, src += src_stride) {
+                *reinterpret_cast<int64_t *>(dst) = e->convert(*reinterpret_cast<const int64_t *>(src));
+            }
+        }
+    };
+
+    class tz_kernel_generator : public expr_kernel_generator {
+        // Cached for the life of the process, see get_tz_transitions
+        const tz_transitions& m_tz;
+        bool m_to_local;
+    public:
+        tz_kernel_generator(const tz_transitions& tz, bool to_local)
+            : expr_kernel_generator(true), m_tz(tz), m_to_local(to_local)
+        {
+        }
+
+        virtual ~tz_kernel_generator() {
+        }
+
+        size_t make_expr_kernel(
+                    ckernel_builder *out, size_t offset_out,
+                    const ndt::type& dst_tp, const char *dst_metadata,
+                    size_t src_count, const ndt::type *src_tp, const char **src_metadata,
+                    kernel_request_t kernreq, const eval::eval_context *ectx) const
+        {
+            if (src_count != 1) {
+                stringstream ss;
+                ss << "tz_kernel_generator requires 1 src operand, ";
+                ss << "received " << src_count;
+                throw runtime_error(ss.str());
+            }
+            // If the types don't match the ones for this generator,
+            // call the elementwise dimension handler to handle one dimension,
+            // giving 'this' as the next kernel generator to call
+            if (dst_tp.get_type_id() != datetime_type_id ||
+                            src_tp[0].get_type_id() != datetime_type_id) {
+                return make_elwise_dimension_expr_kernel(out, offset_out,
+                                dst_tp, dst_metadata,
+                                src_count, src_tp, src_metadata,
+                                kernreq, ectx,
+                                this);
+            }
+
+            out->ensure_capacity_leaf(offset_out + sizeof(tz_kernel_extra));
+            tz_kernel_extra *e = out->get_at<tz_kernel_extra>(offset_out);
+            switch (kernreq) {
+                case kernel_request_single:
+                    e->base.set_function<unary_single_operation_t>(&tz_kernel_extra::single);
+                    break;
+                case kernel_request_strided:
+                    e->base.set_function<unary_strided_operation_t>(&tz_kernel_extra::strided);
+                    break;
+                default: {
+                    stringstream ss;
+                    ss << "tz_kernel_generator: unrecognized request " << (int)kernreq;
+                    throw runtime_error(ss.str());
+                }
+            }
+            e->transitions = m_to_local ? m_tz.get_utc_transitions() : m_tz.get_local_transitions();
+            e->transition_count = m_tz.get_transition_count();
+            e->offsets = m_tz.get_offsets();
+            e->sign = m_to_local ? 1 : -1;
+            e->hint = 0;
+            return offset_out + sizeof(tz_kernel_extra);
+        }
+
+        void print_type(std::ostream& o) const
+        {
+            o << (m_to_local ? "tz_convert" : "tz_localize");
+            o << "(op0, \"" << m_tz.get_name() << "\")";
+        }
+    };
+} // anonymous namespace
+
+expr_kernel_generator *dynd::make_tz_convert_kernelgen(const tz_transitions& tz)
+{
+    return new tz_kernel_generator(tz, true);
+}
+
+expr_kernel_generator *dynd::make_tz_localize_kernelgen(const tz_transitions& tz)
+{
+    return new tz_kernel_generator(tz, false);
+}
@@ -25,19 +25,21 @@ namespace {
         char *buffer_metadata;
         size_t buffer_data_offset, buffer_data_size;
         intptr_t buffer_stride;
+        size_t buffer_element_count;
 
         // Initializes the type and metadata for the buffer
         // NOTE: This does NOT initialize the buffer_data_offset,
         //       just the buffer_data_size.
-        void init(const ndt::type& buffer_tp_, kernel_request_t kernreq) {
-            size_t element_count = 1;
+        void init(const ndt::type& buffer_tp_, kernel_request_t kernreq,
+                        const eval::eval_context *ectx) {
+            bool strided_request = false;
             switch (kernreq) {
                 case kernel_request_single:
                     base.set_function<unary_single_operation_t>(&single);
                     break;
                 case kernel_request_strided:
                     base.set_function<unary_strided_operation_t>(&strided);
-                    element_count = DYND_BUFFER_CHUNK_SIZE;
+                    strided_request = true;
                     break;
                 default: {
                     stringstream ss;
@@ -57,15 +59,16 @@ namespace {
                     }
                     buffer_tp->metadata_default_construct(buffer_metadata, 0, NULL);
                 }
-                // Make sure the buffer data size is pointer size-aligned
                 buffer_stride = buffer_tp->get_default_data_size(0, NULL);
-                buffer_data_size = inc_to_alignment(element_count * buffer_stride, sizeof(void *));
             } else {
-                // Make sure the buffer data size is pointer size-aligned
                 buffer_stride = buffer_tp_.get_data_size();
-                buffer_data_size = inc_to_alignment(element_count * buffer_stride, sizeof(void *));
             }
-            
+            // Size the buffer from the element size, so the chunks
+            // neither underuse nor overflow the cache
+            buffer_element_count = strided_request ?
+                            get_buffer_element_count(buffer_stride, ectx) : 1;
+            // Make sure the buffer data size is pointer size-aligned
+            buffer_data_size = inc_to_alignment(buffer_element_count * buffer_stride, sizeof(void *));
         }
 
         static void single(char *dst, const char *src,
@@ -108,13 +111,14 @@ namespace {
             char *buffer_metadata = e->buffer_metadata;
             char *buffer_data_ptr = eraw + e->buffer_data_offset;
             size_t buffer_stride = e->buffer_stride;
+            size_t buffer_element_count = e->buffer_element_count;
             echild_first = reinterpret_cast<ckernel_prefix *>(eraw + e->first_kernel_offset);
             echild_second = reinterpret_cast<ckernel_prefix *>(eraw + e->second_kernel_offset);
 
             opchild_first = echild_first->get_function<unary_strided_operation_t>();
             opchild_second = echild_second->get_function<unary_strided_operation_t>();
             while (count > 0) {
-                size_t chunk_size = min(DYND_BUFFER_CHUNK_SIZE, count);
+                size_t chunk_size = min(buffer_element_count, count);
                 // If the type needs it, initialize the buffer data to zero
                 if (!is_builtin_type(buffer_tp) && (buffer_tp->get_flags()&type_flag_zeroinit) != 0) {
                     memset(buffer_data_ptr, 0, chunk_size * e->buffer_stride);
@@ -127,6 +131,8 @@ namespace {
                 if (buffer_metadata != NULL) {
                     buffer_tp->metadata_reset_buffers(buffer_metadata);
                 }
+                src += chunk_size * src_stride;
+                dst += chunk_size * dst_stride;
                 count -= chunk_size;
             }
         }
@@ -183,7 +189,7 @@ size_t dynd::make_expression_assignment_kernel(
                                     opdt.extended())->get_value_type();
                 out->ensure_capacity(offset_out + sizeof(buffered_kernel_extra));
                 buffered_kernel_extra *e = out->get_at<buffered_kernel_extra>(offset_out);
-                e->init(buffer_tp, kernreq);
+                e->init(buffer_tp, kernreq, ectx);
                 size_t buffer_data_size = e->buffer_data_size;
                 // Construct the first kernel (src -> buffer)
                 e->first_kernel_offset = sizeof(buffered_kernel_extra);
@@ -217,7 +223,7 @@ size_t dynd::make_expression_assignment_kernel(
             }
             out->ensure_capacity(offset_out + sizeof(buffered_kernel_extra));
             buffered_kernel_extra *e = out->get_at<buffered_kernel_extra>(offset_out);
-            e->init(buffer_tp, kernreq);
+            e->init(buffer_tp, kernreq, ectx);
             size_t buffer_data_size = e->buffer_data_size;
             // Construct the first kernel (src -> buffer)
             e->first_kernel_offset = sizeof(buffered_kernel_extra);
@@ -254,7 +260,7 @@ size_t dynd::make_expression_assignment_kernel(
                                 opdt.extended())->get_value_type();
                 out->ensure_capacity(offset_out + sizeof(buffered_kernel_extra));
                 buffered_kernel_extra *e = out->get_at<buffered_kernel_extra>(offset_out);
-                e->init(buffer_tp, kernreq);
+                e->init(buffer_tp, kernreq, ectx);
                 size_t buffer_data_size = e->buffer_data_size;
                 // Construct the first kernel (src -> buffer)
                 e->first_kernel_offset = sizeof(buffered_kernel_extra);
@@ -281,7 +287,7 @@ size_t dynd::make_expression_assignment_kernel(
             const ndt::type& buffer_tp = src_tp.value_type();
             out->ensure_capacity(offset_out + sizeof(buffered_kernel_extra));
             buffered_kernel_extra *e = out->get_at<buffered_kernel_extra>(offset_out);
-            e->init(buffer_tp, kernreq);
+            e->init(buffer_tp, kernreq, ectx);
             size_t buffer_data_size = e->buffer_data_size;
             // Construct the first kernel (src -> buffer)
             e->first_kernel_offset = sizeof(buffered_kernel_extra);
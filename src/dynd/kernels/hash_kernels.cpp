@@ -0,0 +1,276 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <stdexcept>
+#include <sstream>
+
+#include <dynd/type.hpp>
+#include <dynd/kernels/hash_kernels.hpp>
+#include <dynd/types/base_struct_type.hpp>
+#include <dynd/types/bytes_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+uint64_t dynd::hash_bytes(const char *data, size_t size)
+{
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ size;
+    for (; size >= 8; data += 8, size -= 8) {
+        uint64_t v;
+        memcpy(&v, data, 8);
+        h = hash_mix(h ^ v);
+    }
+    if (size > 0) {
+        uint64_t v = 0;
+        memcpy(&v, data, size);
+        h = hash_mix(h ^ v);
+    }
+    return h;
+}
+
+size_t dynd::make_hash_kernel(
+                ckernel_builder *out, size_t offset_out,
+                const ndt::type& tp, const char *metadata,
+                const eval::eval_context *ectx)
+{
+    if (tp.is_builtin()) {
+        return make_builtin_type_hash_kernel(out, offset_out, tp.get_type_id());
+    } else {
+        return tp.extended()->make_hash_kernel(out, offset_out, metadata, ectx);
+    }
+}
+
+namespace {
+    // Signed zeros compare equal, so the floating point hashes
+    // clear the sign bit of a zero
+    template<class T>
+    struct builtin_hash {
+        static uint64_t hash(const char *src, ckernel_prefix *DYND_UNUSED(extra)) {
+            return hash_bytes(src, sizeof(T));
+        }
+    };
+
+    template<class UT>
+    struct float_bits_hash {
+        static uint64_t hash(const char *src, ckernel_prefix *DYND_UNUSED(extra)) {
+            UT bits;
+            memcpy(&bits, src, sizeof(UT));
+            if (static_cast<UT>(bits << 1) == 0) {
+                bits = 0;
+            }
+            return hash_mix(static_cast<uint64_t>(bits) ^ 0x9e3779b97f4a7c15ULL);
+        }
+    };
+
+    template<>
+    struct builtin_hash<dynd_float16> : public float_bits_hash<uint16_t> {};
+    template<>
+    struct builtin_hash<float> : public float_bits_hash<uint32_t> {};
+    template<>
+    struct builtin_hash<double> : public float_bits_hash<uint64_t> {};
+
+    template<>
+    struct builtin_hash<dynd_float128> {
+        static uint64_t hash(const char *src, ckernel_prefix *DYND_UNUSED(extra)) {
+            dynd_float128 v;
+            memcpy(&v, src, sizeof(v));
+            if ((v.m_hi << 1) == 0 && v.m_lo == 0) {
+                v.m_hi = 0;
+            }
+            return hash_mix(hash_mix(v.m_hi) ^ v.m_lo);
+        }
+    };
+
+    template<class T>
+    struct builtin_hash<dynd_complex<T> > {
+        static uint64_t hash(const char *src, ckernel_prefix *DYND_UNUSED(extra)) {
+            uint64_t re = builtin_hash<T>::hash(src, NULL);
+            uint64_t im = builtin_hash<T>::hash(src + sizeof(T), NULL);
+            return hash_mix(re + 3 * im);
+        }
+    };
+} // anonymous namespace
+
+static hash_single_operation_t hash_kernel_table[builtin_type_id_count-2] =
+{
+    &builtin_hash<dynd_bool>::hash,
+    &builtin_hash<int8_t>::hash,
+    &builtin_hash<int16_t>::hash,
+    &builtin_hash<int32_t>::hash,
+    &builtin_hash<int64_t>::hash,
+    &builtin_hash<dynd_int128>::hash,
+    &builtin_hash<uint8_t>::hash,
+    &builtin_hash<uint16_t>::hash,
+    &builtin_hash<uint32_t>::hash,
+    &builtin_hash<uint64_t>::hash,
+    &builtin_hash<dynd_uint128>::hash,
+    &builtin_hash<dynd_float16>::hash,
+    &builtin_hash<float>::hash,
+    &builtin_hash<double>::hash,
+    &builtin_hash<dynd_float128>::hash,
+    &builtin_hash<dynd_complex<float> >::hash,
+    &builtin_hash<dynd_complex<double> >::hash
+};
+
+size_t dynd::make_builtin_type_hash_kernel(
+                ckernel_builder *out, size_t offset_out,
+                type_id_t type_id)
+{
+    if (type_id >= bool_type_id && type_id <= complex_float64_type_id) {
+        // No need to reserve more space, the space for a leaf is already there
+        ckernel_prefix *result = out->get_at<ckernel_prefix>(offset_out);
+        result->set_function<hash_single_operation_t>(
+                        hash_kernel_table[type_id - bool_type_id]);
+        return offset_out + sizeof(ckernel_prefix);
+    } else {
+        stringstream ss;
+        ss << "cannot hash values of dynd type " << ndt::type(type_id);
+        throw runtime_error(ss.str());
+    }
+}
+
+namespace {
+    struct fixed_bytes_hash_kernel {
+        typedef fixed_bytes_hash_kernel extra_type;
+
+        ckernel_prefix base;
+        size_t data_size;
+
+        static uint64_t hash(const char *src, ckernel_prefix *extra) {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            return hash_bytes(src, e->data_size);
+        }
+    };
+
+    struct nul_terminated_hash_kernel {
+        typedef nul_terminated_hash_kernel extra_type;
+
+        ckernel_prefix base;
+        size_t data_size;
+
+        static uint64_t hash(const char *src, ckernel_prefix *extra) {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            const char *end = reinterpret_cast<const char *>(memchr(src, 0, e->data_size));
+            return hash_bytes(src, end ? (end - src) : e->data_size);
+        }
+    };
+
+    struct blockref_bytes_hash_kernel {
+        static uint64_t hash(const char *src, ckernel_prefix *DYND_UNUSED(extra)) {
+            const bytes_type_data *d = reinterpret_cast<const bytes_type_data *>(src);
+            return hash_bytes(d->begin, d->end - d->begin);
+        }
+    };
+
+    struct struct_hash_kernel {
+        typedef struct_hash_kernel extra_type;
+
+        ckernel_prefix base;
+        size_t field_count;
+        const size_t *src_data_offsets;
+        // After this are field_count hash kernel offsets
+
+        static uint64_t hash(const char *src, ckernel_prefix *extra) {
+            char *eraw = reinterpret_cast<char *>(extra);
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            size_t field_count = e->field_count;
+            const size_t *src_data_offsets = e->src_data_offsets;
+            const size_t *kernel_offsets = reinterpret_cast<const size_t *>(e + 1);
+            uint64_t h = field_count;
+            for (size_t i = 0; i != field_count; ++i) {
+                ckernel_prefix *echild =
+                                reinterpret_cast<ckernel_prefix *>(eraw + kernel_offsets[i]);
+                hash_single_operation_t opchild =
+                                echild->get_function<hash_single_operation_t>();
+                h = hash_mix(h + opchild(src + src_data_offsets[i], echild));
+            }
+            return h;
+        }
+
+        static void destruct(ckernel_prefix *extra)
+        {
+            char *eraw = reinterpret_cast<char *>(extra);
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            const size_t *kernel_offsets = reinterpret_cast<const size_t *>(e + 1);
+            size_t field_count = e->field_count;
+            ckernel_prefix *echild;
+            for (size_t i = 0; i != field_count; ++i) {
+                echild = reinterpret_cast<ckernel_prefix *>(eraw + kernel_offsets[i]);
+                if (echild->destructor) {
+                    echild->destructor(echild);
+                }
+            }
+        }
+    };
+} // anonymous namespace
+
+size_t dynd::make_fixed_bytes_hash_kernel(
+                ckernel_builder *out, size_t offset_out,
+                size_t data_size)
+{
+    out->ensure_capacity_leaf(offset_out + sizeof(fixed_bytes_hash_kernel));
+    fixed_bytes_hash_kernel *e = out->get_at<fixed_bytes_hash_kernel>(offset_out);
+    e->base.set_function<hash_single_operation_t>(&fixed_bytes_hash_kernel::hash);
+    e->data_size = data_size;
+    return offset_out + sizeof(fixed_bytes_hash_kernel);
+}
+
+size_t dynd::make_fixedstring_hash_kernel(
+                ckernel_builder *out, size_t offset_out,
+                size_t string_size, string_encoding_t encoding)
+{
+    size_t char_size = string_encoding_char_size_table[encoding];
+    if (char_size == 1) {
+        out->ensure_capacity_leaf(offset_out + sizeof(nul_terminated_hash_kernel));
+        nul_terminated_hash_kernel *e = out->get_at<nul_terminated_hash_kernel>(offset_out);
+        e->base.set_function<hash_single_operation_t>(&nul_terminated_hash_kernel::hash);
+        e->data_size = string_size;
+        return offset_out + sizeof(nul_terminated_hash_kernel);
+    } else {
+        return make_fixed_bytes_hash_kernel(out, offset_out, string_size * char_size);
+    }
+}
+
+size_t dynd::make_blockref_bytes_hash_kernel(
+                ckernel_builder *out, size_t offset_out)
+{
+    // No need to reserve more space, the space for a leaf is already there
+    ckernel_prefix *result = out->get_at<ckernel_prefix>(offset_out);
+    result->set_function<hash_single_operation_t>(&blockref_bytes_hash_kernel::hash);
+    return offset_out + sizeof(ckernel_prefix);
+}
+
+size_t dynd::make_struct_hash_kernel(
+                ckernel_builder *out, size_t offset_out,
+                const ndt::type& src_tp, const char *src_metadata,
+                const eval::eval_context *ectx)
+{
+    const base_struct_type *bsd = static_cast<const base_struct_type *>(src_tp.extended());
+    size_t field_count = bsd->get_field_count();
+    size_t field_kernel_offset = offset_out +
+                    sizeof(struct_hash_kernel) +
+                    field_count * sizeof(size_t);
+    out->ensure_capacity(field_kernel_offset);
+    struct_hash_kernel *e = out->get_at<struct_hash_kernel>(offset_out);
+    e->base.set_function<hash_single_operation_t>(&struct_hash_kernel::hash);
+    e->base.destructor = &struct_hash_kernel::destruct;
+    e->field_count = field_count;
+    e->src_data_offsets = bsd->get_data_offsets(src_metadata);
+    size_t *field_kernel_offsets;
+    const size_t *metadata_offsets = bsd->get_metadata_offsets();
+    const ndt::type *field_types = bsd->get_field_types();
+    for (size_t i = 0; i != field_count; ++i) {
+        // Reserve space for the child, and save the offset to this
+        // field hash kernel. Have to re-get the pointer because
+        // creating the field hash kernel may move the memory.
+        out->ensure_capacity(field_kernel_offset);
+        e = out->get_at<struct_hash_kernel>(offset_out);
+        field_kernel_offsets = reinterpret_cast<size_t *>(e + 1);
+        field_kernel_offsets[i] = field_kernel_offset - offset_out;
+        field_kernel_offset = make_hash_kernel(out, field_kernel_offset,
+                        field_types[i], src_metadata + metadata_offsets[i], ectx);
+    }
+    return field_kernel_offset;
+}
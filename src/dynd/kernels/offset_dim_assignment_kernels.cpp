@@ -0,0 +1,250 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <stdexcept>
+#include <sstream>
+
+#include <dynd/type.hpp>
+#include <dynd/exceptions.hpp>
+#include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/kernels/offset_dim_assignment_kernels.hpp>
+#include <dynd/types/offset_dim_type.hpp>
+#include <dynd/types/var_dim_type.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+    enum dim_access_kind_t {
+        dim_access_offset,
+        dim_access_var,
+        dim_access_strided,
+        // A src with fewer dimensions, broadcast across the dst
+        dim_access_broadcast
+    };
+
+    /** How an offset_dim kernel finds the elements of its dst or src dimension */
+    struct dim_access {
+        dim_access_kind_t kind;
+        intptr_t stride;
+        // The size for strided dims
+        intptr_t size;
+        const offset_dim_type_metadata *offset_md;
+        const var_dim_type_metadata *var_md;
+
+        void init(const ndt::type& tp, const char *metadata, intptr_t ndim,
+                        ndt::type& out_element_tp, const char *&out_element_metadata)
+        {
+            if (tp.get_ndim() < ndim) {
+                kind = dim_access_broadcast;
+                stride = 0;
+                size = 1;
+                out_element_tp = tp;
+                out_element_metadata = metadata;
+                return;
+            }
+            switch (tp.get_type_id()) {
+                case offset_dim_type_id: {
+                    kind = dim_access_offset;
+                    offset_md = reinterpret_cast<const offset_dim_type_metadata *>(metadata);
+                    stride = offset_md->stride;
+                    out_element_tp = static_cast<const offset_dim_type *>(tp.extended())->get_element_type();
+                    out_element_metadata = metadata + sizeof(offset_dim_type_metadata);
+                    break;
+                }
+                case var_dim_type_id: {
+                    kind = dim_access_var;
+                    var_md = reinterpret_cast<const var_dim_type_metadata *>(metadata);
+                    stride = var_md->stride;
+                    out_element_tp = static_cast<const var_dim_type *>(tp.extended())->get_element_type();
+                    out_element_metadata = metadata + sizeof(var_dim_type_metadata);
+                    break;
+                }
+                case strided_dim_type_id: {
+                    const strided_dim_type_metadata *md =
+                                    reinterpret_cast<const strided_dim_type_metadata *>(metadata);
+                    kind = dim_access_strided;
+                    stride = md->stride;
+                    size = md->size;
+                    out_element_tp = static_cast<const strided_dim_type *>(tp.extended())->get_element_type();
+                    out_element_metadata = metadata + sizeof(strided_dim_type_metadata);
+                    break;
+                }
+                case fixed_dim_type_id: {
+                    const fixed_dim_type *fdt = static_cast<const fixed_dim_type *>(tp.extended());
+                    kind = dim_access_strided;
+                    stride = fdt->get_fixed_stride();
+                    size = fdt->get_fixed_dim_size();
+                    out_element_tp = fdt->get_element_type();
+                    out_element_metadata = metadata;
+                    break;
+                }
+                default: {
+                    stringstream ss;
+                    ss << "offset_dim assignment: cannot access " << tp << " as a dimension";
+                    throw type_error(ss.str());
+                }
+            }
+        }
+
+        inline void get_row(const char *data, const char *&out_begin, intptr_t& out_size) const
+        {
+            switch (kind) {
+                case dim_access_offset: {
+                    const int64_t *d = reinterpret_cast<const int64_t *>(data);
+                    out_begin = offset_md->values + d[0] * stride;
+                    out_size = static_cast<intptr_t>(d[1] - d[0]);
+                    break;
+                }
+                case dim_access_var: {
+                    const var_dim_type_data *d = reinterpret_cast<const var_dim_type_data *>(data);
+                    if (d->begin == NULL) {
+                        throw runtime_error("Cannot assign an uninitialized dynd var_dim to an offset_dim");
+                    }
+                    out_begin = d->begin + var_md->offset;
+                    out_size = d->size;
+                    break;
+                }
+                default:
+                    out_begin = data;
+                    out_size = size;
+                    break;
+            }
+        }
+    };
+
+    struct offset_dim_assign_kernel_extra {
+        typedef offset_dim_assign_kernel_extra extra_type;
+
+        ckernel_prefix base;
+        dim_access dst, src;
+        intptr_t dst_target_alignment;
+
+        // Allocates an uninitialized var_dim dst row
+        char *allocate_var_row(var_dim_type_data *dst_d, intptr_t count)
+        {
+            if (dst.var_md->offset != 0) {
+                throw runtime_error("Cannot assign to an uninitialized dynd var_dim which has a non-zero offset");
+            }
+            memory_block_data *memblock = dst.var_md->blockref;
+            if (memblock->m_type == objectarray_memory_block_type) {
+                memory_block_objectarray_allocator_api *allocator =
+                                get_memory_block_objectarray_allocator_api(memblock);
+                dst_d->begin = allocator->allocate(memblock, count);
+            } else {
+                memory_block_pod_allocator_api *allocator =
+                                get_memory_block_pod_allocator_api(memblock);
+                char *dst_end = NULL;
+                allocator->allocate(memblock, count * dst.stride,
+                            dst_target_alignment, &dst_d->begin, &dst_end);
+            }
+            dst_d->size = count;
+            return dst_d->begin;
+        }
+
+        static void single(char *dst, const char *src, ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            ckernel_prefix *echild = &(e + 1)->base;
+            unary_strided_operation_t opchild = echild->get_function<unary_strided_operation_t>();
+            const char *src_begin;
+            intptr_t src_size;
+            e->src.get_row(src, src_begin, src_size);
+            char *dst_begin;
+            intptr_t dst_size;
+            if (e->dst.kind == dim_access_var &&
+                            reinterpret_cast<var_dim_type_data *>(dst)->begin == NULL) {
+                dst_begin = e->allocate_var_row(reinterpret_cast<var_dim_type_data *>(dst), src_size);
+                dst_size = src_size;
+            } else {
+                const char *dst_row;
+                e->dst.get_row(dst, dst_row, dst_size);
+                dst_begin = const_cast<char *>(dst_row);
+            }
+            // Check for a broadcasting error
+            if (src_size != 1 && dst_size != src_size) {
+                stringstream ss;
+                ss << "error broadcasting input dimension sized " << src_size;
+                ss << " to output offset_dim sized " << dst_size;
+                throw broadcast_error(ss.str());
+            }
+            opchild(dst_begin, e->dst.stride, src_begin, src_size != 1 ? e->src.stride : 0,
+                            dst_size, echild);
+        }
+
+        static void destruct(ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            ckernel_prefix *echild = &(e + 1)->base;
+            if (echild->destructor) {
+                echild->destructor(echild);
+            }
+        }
+    };
+
+    size_t make_offset_dim_assign_kernel(
+                    ckernel_builder *out, size_t offset_out,
+                    const ndt::type& dst_tp, const char *dst_metadata,
+                    const ndt::type& src_tp, const char *src_metadata,
+                    kernel_request_t kernreq, assign_error_mode errmode,
+                    const eval::eval_context *ectx)
+    {
+        offset_out = make_kernreq_to_single_kernel_adapter(out, offset_out, kernreq);
+        out->ensure_capacity(offset_out + sizeof(offset_dim_assign_kernel_extra));
+        offset_dim_assign_kernel_extra *e = out->get_at<offset_dim_assign_kernel_extra>(offset_out);
+        e->base.set_function<unary_single_operation_t>(&offset_dim_assign_kernel_extra::single);
+        e->base.destructor = &offset_dim_assign_kernel_extra::destruct;
+        ndt::type dst_element_tp, src_element_tp;
+        const char *dst_element_metadata, *src_element_metadata;
+        e->dst.init(dst_tp, dst_metadata, dst_tp.get_ndim(), dst_element_tp, dst_element_metadata);
+        e->src.init(src_tp, src_metadata, dst_tp.get_ndim(), src_element_tp, src_element_metadata);
+        e->dst_target_alignment = dst_element_tp.get_data_alignment();
+        return ::make_assignment_kernel(out, offset_out + sizeof(offset_dim_assign_kernel_extra),
+                        dst_element_tp, dst_element_metadata,
+                        src_element_tp, src_element_metadata,
+                        kernel_request_strided, errmode, ectx);
+    }
+} // anonymous namespace
+
+size_t dynd::make_to_offset_dim_assignment_kernel(
+                ckernel_builder *out, size_t offset_out,
+                const ndt::type& dst_offset_dim_tp, const char *dst_metadata,
+                const ndt::type& src_tp, const char *src_metadata,
+                kernel_request_t kernreq, assign_error_mode errmode,
+                const eval::eval_context *ectx)
+{
+    if (dst_offset_dim_tp.get_type_id() != offset_dim_type_id) {
+        stringstream ss;
+        ss << "make_to_offset_dim_assignment_kernel: provided destination type " << dst_offset_dim_tp << " is not an offset_dim";
+        throw runtime_error(ss.str());
+    }
+    return make_offset_dim_assign_kernel(out, offset_out,
+                    dst_offset_dim_tp, dst_metadata,
+                    src_tp, src_metadata,
+                    kernreq, errmode, ectx);
+}
+
+size_t dynd::make_from_offset_dim_assignment_kernel(
+                ckernel_builder *out, size_t offset_out,
+                const ndt::type& dst_tp, const char *dst_metadata,
+                const ndt::type& src_offset_dim_tp, const char *src_metadata,
+                kernel_request_t kernreq, assign_error_mode errmode,
+                const eval::eval_context *ectx)
+{
+    if (src_offset_dim_tp.get_type_id() != offset_dim_type_id) {
+        stringstream ss;
+        ss << "make_from_offset_dim_assignment_kernel: provided source type " << src_offset_dim_tp << " is not an offset_dim";
+        throw runtime_error(ss.str());
+    }
+    if (dst_tp.get_ndim() < src_offset_dim_tp.get_ndim()) {
+        throw broadcast_error(dst_tp, dst_metadata, src_offset_dim_tp, src_metadata);
+    }
+    return make_offset_dim_assign_kernel(out, offset_out,
+                    dst_tp, dst_metadata,
+                    src_offset_dim_tp, src_metadata,
+                    kernreq, errmode, ectx);
+}
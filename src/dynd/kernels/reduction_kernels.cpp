@@ -3,6 +3,7 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <dynd/cpu_features.hpp>
 #include <dynd/kernels/reduction_kernels.hpp>
 
 using namespace std;
@@ -31,6 +32,43 @@ static ndt::type builtin_type_pairs[builtin_type_id_count][2] = {
 };
 
 namespace {
+    /**
+     * The loop of the strided sum reduction, which is compiled
+     * into each instruction set variant.
+     */
+    template<class T, class Accum>
+    DYND_FORCE_INLINE void sum_reduction_strided_loop(char *dst, intptr_t dst_stride,
+                    const char *src, intptr_t src_stride, size_t count)
+    {
+        if (dst_stride == 0) {
+            Accum s = 0;
+            if (src_stride == sizeof(T)) {
+                const T *src_typed = reinterpret_cast<const T *>(src);
+                for (size_t i = 0; i < count; ++i) {
+                    s = s + src_typed[i];
+                }
+            } else {
+                for (size_t i = 0; i < count; ++i) {
+                    s = s + *reinterpret_cast<const T *>(src);
+                    src += src_stride;
+                }
+            }
+            *reinterpret_cast<T *>(dst) = static_cast<T>(*reinterpret_cast<const T *>(dst) + s);
+        } else if (dst_stride == sizeof(T) && src_stride == sizeof(T)) {
+            T *dst_typed = reinterpret_cast<T *>(dst);
+            const T *src_typed = reinterpret_cast<const T *>(src);
+            for (size_t i = 0; i < count; ++i) {
+                dst_typed[i] = dst_typed[i] + src_typed[i];
+            }
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                *reinterpret_cast<T *>(dst) = *reinterpret_cast<T *>(dst) + *reinterpret_cast<const T *>(src);
+                dst += dst_stride;
+                src += src_stride;
+            }
+        }
+    }
+
     template<class T, class Accum>
     struct sum_reduction {
         static void single(char *dst, const char *src,
@@ -43,22 +81,44 @@ namespace {
                         const char *src, intptr_t src_stride,
                         size_t count, ckernel_prefix *DYND_UNUSED(ckp))
         {
-            if (dst_stride == 0) {
-                Accum s = 0;
-                for (size_t i = 0; i < count; ++i) {
-                    s = s + *reinterpret_cast<const T *>(src);
-                    src += src_stride;
-                }
-                *reinterpret_cast<T *>(dst) = static_cast<T>(*reinterpret_cast<const T *>(dst) + s);
-            } else {
-                for (size_t i = 0; i < count; ++i) {
-                    *reinterpret_cast<T *>(dst) = *reinterpret_cast<T *>(dst) + *reinterpret_cast<const T *>(src);
-                    dst += dst_stride;
-                    src += src_stride;
-                }
-            }
+            sum_reduction_strided_loop<T, Accum>(dst, dst_stride, src, src_stride, count);
         }
     };
+
+#ifdef DYND_USE_TARGET_ATTRIBUTES
+#define DYND_SUM_REDUCTION_VARIANT(isa, target) \
+    template<class T, class Accum> \
+    struct sum_reduction_##isa { \
+        target static void strided(char *dst, intptr_t dst_stride, \
+                        const char *src, intptr_t src_stride, \
+                        size_t count, ckernel_prefix *DYND_UNUSED(ckp)) \
+        { \
+            sum_reduction_strided_loop<T, Accum>(dst, dst_stride, src, src_stride, count); \
+        } \
+    };
+
+    DYND_SUM_REDUCTION_VARIANT(sse4_2, DYND_TARGET_SSE4_2)
+    DYND_SUM_REDUCTION_VARIANT(avx2, DYND_TARGET_AVX2)
+    DYND_SUM_REDUCTION_VARIANT(avx512, DYND_TARGET_AVX512)
+#undef DYND_SUM_REDUCTION_VARIANT
+#endif
+
+    /** Picks the strided sum reduction for the instruction set from get_cpu_isa() */
+    template<class T, class Accum>
+    unary_strided_operation_t get_sum_reduction_strided()
+    {
+        static const unary_strided_operation_t variants[cpu_isa_count] = {
+            &sum_reduction<T, Accum>::strided,
+#ifdef DYND_USE_TARGET_ATTRIBUTES
+            &sum_reduction_sse4_2<T, Accum>::strided,
+            &sum_reduction_avx2<T, Accum>::strided,
+            &sum_reduction_avx512<T, Accum>::strided
+#else
+            NULL, NULL, NULL
+#endif
+        };
+        return select_cpu_isa_variant(variants, get_cpu_isa());
+    }
 } // anonymous namespace
 
 
@@ -98,17 +158,17 @@ intptr_t kernels::make_builtin_sum_reduction_ckernel(
     } else if (kerntype == kernel_request_strided) {
         switch (tid) {
             case int32_type_id:
-                ckp->set_function<unary_strided_operation_t>(&sum_reduction<int32_t, int32_t>::strided);
+                ckp->set_function<unary_strided_operation_t>(get_sum_reduction_strided<int32_t, int32_t>());
                 break;
             case int64_type_id:
-                ckp->set_function<unary_strided_operation_t>(&sum_reduction<int64_t, int64_t>::strided);
+                ckp->set_function<unary_strided_operation_t>(get_sum_reduction_strided<int64_t, int64_t>());
                 break;
             case float32_type_id:
                 // For float32, use float64 as the accumulator in the strided loop for a touch more accuracy
-                ckp->set_function<unary_strided_operation_t>(&sum_reduction<float, double>::strided);
+                ckp->set_function<unary_strided_operation_t>(get_sum_reduction_strided<float, double>());
                 break;
             case float64_type_id:
-                ckp->set_function<unary_strided_operation_t>(&sum_reduction<double, double>::strided);
+                ckp->set_function<unary_strided_operation_t>(get_sum_reduction_strided<double, double>());
                 break;
             case complex_float32_type_id:
                 // For float32, use float64 as the accumulator in the strided loop for a touch more accuracy
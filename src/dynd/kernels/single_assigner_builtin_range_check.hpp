@@ -0,0 +1,255 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+// This file is an internal implementation detail of built-in value assignment
+// for aligned values in native byte order. It provides the error checks of
+// single_assigner_builtin as branch-free predicates, so contiguous loops can
+// check a whole block of values at once and be vectorized. They combine
+// comparisons with & and | instead of && and ||, so they don't branch.
+// Include it after single_assigner_builtin.hpp.
+
+#ifndef _DYND__SINGLE_ASSIGNER_BUILTIN_RANGE_CHECK_HPP_
+#define _DYND__SINGLE_ASSIGNER_BUILTIN_RANGE_CHECK_HPP_
+
+#include <cmath>
+#include <limits>
+
+#include <dynd/type.hpp>
+
+namespace dynd {
+
+/** Whether contiguous loops over the type can be vectorized */
+template<class T>
+struct is_vectorizable_builtin {
+    enum { value = false };
+};
+template<> struct is_vectorizable_builtin<dynd_bool> { enum { value = true }; };
+template<> struct is_vectorizable_builtin<int8_t> { enum { value = true }; };
+template<> struct is_vectorizable_builtin<int16_t> { enum { value = true }; };
+template<> struct is_vectorizable_builtin<int32_t> { enum { value = true }; };
+template<> struct is_vectorizable_builtin<int64_t> { enum { value = true }; };
+template<> struct is_vectorizable_builtin<uint8_t> { enum { value = true }; };
+template<> struct is_vectorizable_builtin<uint16_t> { enum { value = true }; };
+template<> struct is_vectorizable_builtin<uint32_t> { enum { value = true }; };
+template<> struct is_vectorizable_builtin<uint64_t> { enum { value = true }; };
+template<> struct is_vectorizable_builtin<float> { enum { value = true }; };
+template<> struct is_vectorizable_builtin<double> { enum { value = true }; };
+
+/**
+ * The error checks of single_assigner_builtin<dst_type, src_type, errmode>
+ * as a predicate. When `vectorizable` is true, in_range(s) returns true only
+ * if the checked assignment of s succeeds and produces the same value as the
+ * assign_error_none assignment. It may return false for some values which
+ * would succeed, those just take the slower checked path.
+ */
+template<class dst_type, class src_type, assign_error_mode errmode,
+                type_kind_t dst_kind = dynd_kind_of<dst_type>::value,
+                type_kind_t src_kind = dynd_kind_of<src_type>::value,
+                bool vectorizable_types = is_vectorizable_builtin<dst_type>::value &&
+                                is_vectorizable_builtin<src_type>::value>
+struct single_assigner_builtin_range_check {
+    enum { vectorizable = false };
+    static inline bool in_range(src_type DYND_UNUSED(s)) {
+        return false;
+    }
+};
+
+// Compares against the destination's limits only when they're within
+// the source's range, avoiding always-true comparison warnings
+template<class dst_type, class src_type, bool enabled>
+struct range_check_max {
+    static inline bool in_range(src_type DYND_UNUSED(s)) {
+        return true;
+    }
+};
+template<class dst_type, class src_type>
+struct range_check_max<dst_type, src_type, true> {
+    static inline bool in_range(src_type s) {
+        return s <= static_cast<src_type>(std::numeric_limits<dst_type>::max());
+    }
+};
+template<class dst_type, class src_type, bool enabled>
+struct range_check_min {
+    static inline bool in_range(src_type DYND_UNUSED(s)) {
+        return true;
+    }
+};
+template<class dst_type, class src_type>
+struct range_check_min<dst_type, src_type, true> {
+    static inline bool in_range(src_type s) {
+        return s >= static_cast<src_type>(std::numeric_limits<dst_type>::min());
+    }
+};
+
+// The specializations below are only for vectorizable types
+#define DYND_RANGE_CHECK_VECTORIZABLE \
+    enum { vectorizable = errmode != assign_error_none }
+
+// Signed int -> signed int, overflow when the destination is smaller
+template<class dst_type, class src_type, assign_error_mode errmode>
+struct single_assigner_builtin_range_check<dst_type, src_type, errmode, int_kind, int_kind, true> {
+    DYND_RANGE_CHECK_VECTORIZABLE;
+    static inline bool in_range(src_type s) {
+        return range_check_min<dst_type, src_type, (sizeof(dst_type) < sizeof(src_type))>::in_range(s) &
+            range_check_max<dst_type, src_type, (sizeof(dst_type) < sizeof(src_type))>::in_range(s);
+    }
+};
+
+// Unsigned int -> signed int, overflow when the destination isn't bigger
+template<class dst_type, class src_type, assign_error_mode errmode>
+struct single_assigner_builtin_range_check<dst_type, src_type, errmode, int_kind, uint_kind, true> {
+    DYND_RANGE_CHECK_VECTORIZABLE;
+    static inline bool in_range(src_type s) {
+        return range_check_max<dst_type, src_type, (sizeof(dst_type) <= sizeof(src_type))>::in_range(s);
+    }
+};
+
+// Signed int -> unsigned int, overflow for negative values, and big ones
+// when the destination is smaller
+template<class dst_type, class src_type, assign_error_mode errmode>
+struct single_assigner_builtin_range_check<dst_type, src_type, errmode, uint_kind, int_kind, true> {
+    DYND_RANGE_CHECK_VECTORIZABLE;
+    static inline bool in_range(src_type s) {
+        return (s >= src_type(0)) &
+            range_check_max<dst_type, src_type, (sizeof(dst_type) < sizeof(src_type))>::in_range(s);
+    }
+};
+
+// Unsigned int -> unsigned int, overflow when the destination is smaller
+template<class dst_type, class src_type, assign_error_mode errmode>
+struct single_assigner_builtin_range_check<dst_type, src_type, errmode, uint_kind, uint_kind, true> {
+    DYND_RANGE_CHECK_VECTORIZABLE;
+    static inline bool in_range(src_type s) {
+        return range_check_max<dst_type, src_type, (sizeof(dst_type) < sizeof(src_type))>::in_range(s);
+    }
+};
+
+// Signed int -> floating point, only inexact checking
+template<class dst_type, class src_type, assign_error_mode errmode>
+struct single_assigner_builtin_range_check<dst_type, src_type, errmode, real_kind, int_kind, true> {
+    DYND_RANGE_CHECK_VECTORIZABLE;
+    static inline bool in_range(src_type s) {
+        return errmode != assign_error_inexact ||
+            static_cast<src_type>(static_cast<dst_type>(s)) == s;
+    }
+};
+
+// Unsigned int -> floating point, only inexact checking
+template<class dst_type, class src_type, assign_error_mode errmode>
+struct single_assigner_builtin_range_check<dst_type, src_type, errmode, real_kind, uint_kind, true> {
+    DYND_RANGE_CHECK_VECTORIZABLE;
+    static inline bool in_range(src_type s) {
+        return errmode != assign_error_inexact ||
+            static_cast<src_type>(static_cast<dst_type>(s)) == s;
+    }
+};
+
+// Floating point -> signed int, overflow checking and fractional checking
+template<class dst_type, class src_type, assign_error_mode errmode>
+struct single_assigner_builtin_range_check<dst_type, src_type, errmode, int_kind, real_kind, true> {
+    DYND_RANGE_CHECK_VECTORIZABLE;
+    static inline bool in_range(src_type s) {
+        return !((s < std::numeric_limits<dst_type>::min()) | (std::numeric_limits<dst_type>::max() < s)) &
+            (errmode == assign_error_overflow || std::floor(s) == s);
+    }
+};
+
+// Floating point -> unsigned int, overflow checking and fractional checking
+template<class dst_type, class src_type, assign_error_mode errmode>
+struct single_assigner_builtin_range_check<dst_type, src_type, errmode, uint_kind, real_kind, true> {
+    DYND_RANGE_CHECK_VECTORIZABLE;
+    static inline bool in_range(src_type s) {
+        return !((s < 0) | (std::numeric_limits<dst_type>::max() < s)) &
+            (errmode == assign_error_overflow || std::floor(s) == s);
+    }
+};
+
+// Floating point -> floating point, overflow checking for finite values
+// and inexact checking when the destination is smaller
+template<class dst_type, class src_type, assign_error_mode errmode>
+struct single_assigner_builtin_range_check<dst_type, src_type, errmode, real_kind, real_kind, true> {
+    DYND_RANGE_CHECK_VECTORIZABLE;
+    static inline bool in_range(src_type s) {
+        if (sizeof(dst_type) >= sizeof(src_type)) {
+            return true;
+        }
+        // Finite and too big, written so NaN compares as in range
+        src_type a = std::fabs(s);
+        bool overflow = (a > static_cast<src_type>(std::numeric_limits<dst_type>::max())) &
+                        (a <= std::numeric_limits<src_type>::max());
+        return !overflow & (errmode != assign_error_inexact ||
+                        static_cast<src_type>(static_cast<dst_type>(s)) == s);
+    }
+};
+
+// Anything -> boolean has no error checking
+template<class src_type, assign_error_mode errmode, type_kind_t src_kind>
+struct single_assigner_builtin_range_check<dynd_bool, src_type, errmode, bool_kind, src_kind, true> {
+    typedef dynd_bool dst_type;
+    DYND_RANGE_CHECK_VECTORIZABLE;
+    static inline bool in_range(src_type DYND_UNUSED(s)) {
+        return true;
+    }
+};
+
+// Boolean -> anything has no error checking
+template<class dst_type, assign_error_mode errmode, type_kind_t dst_kind>
+struct single_assigner_builtin_range_check<dst_type, dynd_bool, errmode, dst_kind, bool_kind, true> {
+    typedef dynd_bool src_type;
+    DYND_RANGE_CHECK_VECTORIZABLE;
+    static inline bool in_range(src_type DYND_UNUSED(s)) {
+        return true;
+    }
+};
+
+// Boolean -> boolean, disambiguating the two above
+template<assign_error_mode errmode>
+struct single_assigner_builtin_range_check<dynd_bool, dynd_bool, errmode, bool_kind, bool_kind, true> {
+    enum { vectorizable = errmode != assign_error_none };
+    static inline bool in_range(dynd_bool DYND_UNUSED(s)) {
+        return true;
+    }
+};
+
+// Float16 -> float32/float64 is always exact
+template<assign_error_mode errmode>
+struct single_assigner_builtin_range_check<float, dynd_float16, errmode, real_kind, real_kind, false> {
+    DYND_RANGE_CHECK_VECTORIZABLE;
+    static inline bool in_range(dynd_float16 DYND_UNUSED(s)) {
+        return true;
+    }
+};
+template<assign_error_mode errmode>
+struct single_assigner_builtin_range_check<double, dynd_float16, errmode, real_kind, real_kind, false> {
+    DYND_RANGE_CHECK_VECTORIZABLE;
+    static inline bool in_range(dynd_float16 DYND_UNUSED(s)) {
+        return true;
+    }
+};
+
+// Float32/float64 -> float16, overflow checking for finite values which
+// round to inf. The inexact checks aren't done as a predicate.
+template<assign_error_mode errmode>
+struct single_assigner_builtin_range_check<dynd_float16, float, errmode, real_kind, real_kind, false> {
+    enum { vectorizable = errmode == assign_error_overflow || errmode == assign_error_fractional };
+    static inline bool in_range(float s) {
+        float a = std::fabs(s);
+        return !((a >= 65520.0f) & (a <= std::numeric_limits<float>::max()));
+    }
+};
+template<assign_error_mode errmode>
+struct single_assigner_builtin_range_check<dynd_float16, double, errmode, real_kind, real_kind, false> {
+    enum { vectorizable = errmode == assign_error_overflow || errmode == assign_error_fractional };
+    static inline bool in_range(double s) {
+        double a = std::fabs(s);
+        return !((a >= 65520.0) & (a <= std::numeric_limits<double>::max()));
+    }
+};
+
+#undef DYND_RANGE_CHECK_VECTORIZABLE
+
+} // namespace dynd
+
+#endif // _DYND__SINGLE_ASSIGNER_BUILTIN_RANGE_CHECK_HPP_
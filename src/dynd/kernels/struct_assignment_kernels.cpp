@@ -6,9 +6,13 @@
 #include <stdexcept>
 #include <sstream>
 #include <algorithm>
+#include <vector>
 
 #include <dynd/type.hpp>
 #include <dynd/diagnostics.hpp>
+#include <dynd/exceptions.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
 #include <dynd/kernels/struct_assignment_kernels.hpp>
 
@@ -21,6 +25,9 @@ namespace {
 
         ckernel_prefix base;
         size_t field_count;
+        // The number of elements the strided function processes
+        // at a time, one field after another
+        size_t chunk_size;
         // After this, there are 'field_count' of
         // the following in a row
         struct field_items {
@@ -29,6 +36,29 @@ namespace {
             size_t src_data_offset;
         };
 
+        // Sets the function for the request, the child kernels
+        // must be created with the same request
+        void init(kernel_request_t kernreq, size_t field_count_, size_t row_size,
+                        const eval::eval_context *ectx)
+        {
+            switch (kernreq) {
+                case kernel_request_single:
+                    base.set_function<unary_single_operation_t>(&single);
+                    break;
+                case kernel_request_strided:
+                    base.set_function<unary_strided_operation_t>(&strided);
+                    break;
+                default: {
+                    stringstream ss;
+                    ss << "struct assignment kernel: unrecognized request " << (int)kernreq;
+                    throw runtime_error(ss.str());
+                }
+            }
+            base.destructor = &destruct;
+            field_count = field_count_;
+            chunk_size = get_buffer_element_count(row_size, ectx);
+        }
+
         static void single(char *dst, const char *src, ckernel_prefix *extra)
         {
             char *eraw = reinterpret_cast<char *>(extra);
@@ -46,6 +76,34 @@ namespace {
             }
         }
 
+        static void strided(char *dst, intptr_t dst_stride,
+                        const char *src, intptr_t src_stride,
+                        size_t count, ckernel_prefix *extra)
+        {
+            char *eraw = reinterpret_cast<char *>(extra);
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            const field_items *fi = reinterpret_cast<const field_items *>(e + 1);
+            size_t field_count = e->field_count, chunk_size = e->chunk_size;
+            ckernel_prefix *echild;
+            unary_strided_operation_t opchild;
+
+            // Assign a column at a time, in chunks of rows which stay in the cache
+            while (count > 0) {
+                size_t block_count = min(chunk_size, count);
+                for (size_t i = 0; i < field_count; ++i) {
+                    const field_items& item = fi[i];
+                    echild  = reinterpret_cast<ckernel_prefix *>(eraw + item.child_kernel_offset);
+                    opchild = echild->get_function<unary_strided_operation_t>();
+                    opchild(dst + item.dst_data_offset, dst_stride,
+                                    src + item.src_data_offset, src_stride,
+                                    block_count, echild);
+                }
+                dst += block_count * dst_stride;
+                src += block_count * src_stride;
+                count -= block_count;
+            }
+        }
+
         static void destruct(ckernel_prefix *extra)
         {
             char *eraw = reinterpret_cast<char *>(extra);
@@ -64,6 +122,125 @@ namespace {
             }
         }
     };
+
+    /**
+     * A run of consecutive dst fields which one child kernel assigns.
+     * Fields which are adjacent in both the dst and the src, with the
+     * same POD type, are merged into a run copied as one memory block.
+     */
+    struct field_run {
+        size_t dst_field, src_field, field_count;
+        size_t dst_data_offset, src_data_offset;
+        size_t data_size, data_alignment;
+    };
+
+    void coalesce_field_runs(size_t field_count, const size_t *field_reorder,
+                    const ndt::type *dst_field_types, const size_t *dst_data_offsets,
+                    const ndt::type *src_field_types, const size_t *src_data_offsets,
+                    vector<field_run>& out_runs)
+    {
+        out_runs.clear();
+        for (size_t i = 0; i != field_count; ++i) {
+            size_t i_src = field_reorder[i];
+            const ndt::type& tp = dst_field_types[i];
+            bool mergeable = tp == src_field_types[i_src] && tp.is_pod() && tp.get_data_size() > 0;
+            if (mergeable && !out_runs.empty()) {
+                field_run& run = out_runs.back();
+                const ndt::type& prev_tp = dst_field_types[run.dst_field + run.field_count - 1];
+                if (prev_tp.is_pod() && run.data_size > 0 &&
+                                field_reorder[run.dst_field + run.field_count - 1] + 1 == i_src &&
+                                run.dst_data_offset + run.data_size == dst_data_offsets[i] &&
+                                run.src_data_offset + run.data_size == src_data_offsets[i_src]) {
+                    ++run.field_count;
+                    run.data_size += tp.get_data_size();
+                    run.data_alignment = min(run.data_alignment, (size_t)tp.get_data_alignment());
+                    continue;
+                }
+            }
+            field_run run;
+            run.dst_field = i;
+            run.src_field = i_src;
+            run.field_count = 1;
+            run.dst_data_offset = dst_data_offsets[i];
+            run.src_data_offset = src_data_offsets[i_src];
+            // Only runs of POD fields with identical types may grow
+            run.data_size = mergeable ? tp.get_data_size() : 0;
+            run.data_alignment = tp.get_data_alignment();
+            out_runs.push_back(run);
+        }
+    }
+
+    /** The size of one struct element, for choosing the strided chunk size */
+    size_t get_struct_row_size(size_t field_count, const ndt::type *field_types,
+                    const size_t *data_offsets)
+    {
+        size_t row_size = 0;
+        for (size_t i = 0; i != field_count; ++i) {
+            row_size = max(row_size, data_offsets[i] + field_types[i].get_data_size());
+        }
+        return row_size;
+    }
+
+    /**
+     * Creates the struct kernel from the dst fields to the src fields
+     * they are matched with by field_reorder, one child kernel per run
+     * of fields.
+     */
+    size_t make_field_runs_assignment_kernel(
+                    ckernel_builder *out_ckb, size_t ckb_offset,
+                    const base_struct_type *dst_sd, const char *dst_metadata,
+                    const base_struct_type *src_sd, const char *src_metadata,
+                    const size_t *field_reorder,
+                    kernel_request_t kernreq, assign_error_mode errmode,
+                    const eval::eval_context *ectx)
+    {
+        size_t field_count = dst_sd->get_field_count();
+        const ndt::type *src_field_types = src_sd->get_field_types();
+        const ndt::type *dst_field_types = dst_sd->get_field_types();
+        const size_t *src_data_offsets = src_sd->get_data_offsets(src_metadata);
+        const size_t *dst_data_offsets = dst_sd->get_data_offsets(dst_metadata);
+        const size_t *src_metadata_offsets = src_sd->get_metadata_offsets();
+        const size_t *dst_metadata_offsets = dst_sd->get_metadata_offsets();
+
+        vector<field_run> runs;
+        coalesce_field_runs(field_count, field_reorder,
+                        dst_field_types, dst_data_offsets,
+                        src_field_types, src_data_offsets, runs);
+        size_t run_count = runs.size();
+
+        size_t extra_size = sizeof(struct_kernel_extra) +
+                        run_count * sizeof(struct_kernel_extra::field_items);
+        out_ckb->ensure_capacity(ckb_offset + extra_size);
+        struct_kernel_extra *e = out_ckb->get_at<struct_kernel_extra>(ckb_offset);
+        e->init(kernreq, run_count,
+                        get_struct_row_size(field_count, dst_field_types, dst_data_offsets), ectx);
+
+        // Create the kernels and dst offsets for copying the runs of fields
+        size_t current_offset = ckb_offset + extra_size;
+        struct_kernel_extra::field_items *fi;
+        for (size_t i = 0; i != run_count; ++i) {
+            const field_run& run = runs[i];
+            out_ckb->ensure_capacity(current_offset);
+            // Ensuring capacity may have invalidated 'e', so get it again
+            e = out_ckb->get_at<struct_kernel_extra>(ckb_offset);
+            fi = reinterpret_cast<struct_kernel_extra::field_items *>(e + 1) + i;
+            fi->child_kernel_offset = current_offset - ckb_offset;
+            fi->dst_data_offset = run.dst_data_offset;
+            fi->src_data_offset = run.src_data_offset;
+            if (run.field_count > 1) {
+                current_offset = make_pod_typed_data_assignment_kernel(out_ckb, current_offset,
+                                run.data_size, run.data_alignment, kernreq);
+            } else {
+                current_offset = ::make_assignment_kernel(out_ckb, current_offset,
+                                dst_field_types[run.dst_field],
+                                dst_metadata + dst_metadata_offsets[run.dst_field],
+                                src_field_types[run.src_field],
+                                src_metadata + src_metadata_offsets[run.src_field],
+                                kernreq, errmode, ectx);
+            }
+        }
+        return current_offset;
+    }
 } // anonymous namespace
 
 /////////////////////////////////////////
@@ -88,39 +265,17 @@ size_t dynd::make_struct_identical_assignment_kernel(
                         kernreq);
     }
 
-    ckb_offset = make_kernreq_to_single_kernel_adapter(out_ckb, ckb_offset, kernreq);
-
     const base_struct_type *sd = static_cast<const base_struct_type *>(val_struct_tp.extended());
     size_t field_count = sd->get_field_count();
-
-    size_t extra_size = sizeof(struct_kernel_extra) +
-                    field_count * sizeof(struct_kernel_extra::field_items);
-    out_ckb->ensure_capacity(ckb_offset + extra_size);
-    struct_kernel_extra *e = out_ckb->get_at<struct_kernel_extra>(ckb_offset);
-    e->base.set_function<unary_single_operation_t>(&struct_kernel_extra::single);
-    e->base.destructor = &struct_kernel_extra::destruct;
-    e->field_count = field_count;
-
-    const size_t *dst_data_offsets = sd->get_data_offsets(dst_metadata);
-    const size_t *src_data_offsets = sd->get_data_offsets(src_metadata);
-
-    // Create the kernels and dst offsets for copying individual fields
-    size_t current_offset = ckb_offset + extra_size;
-    struct_kernel_extra::field_items *fi;
+    vector<size_t> field_order(field_count);
     for (size_t i = 0; i != field_count; ++i) {
-        out_ckb->ensure_capacity(current_offset);
-        // Adding another kernel may have invalidated 'e', so get it again
-        e = out_ckb->get_at<struct_kernel_extra>(ckb_offset);
-        fi = reinterpret_cast<struct_kernel_extra::field_items *>(e + 1) + i;
-        fi->child_kernel_offset = current_offset - ckb_offset;
-        fi->dst_data_offset = dst_data_offsets[i];
-        fi->src_data_offset = src_data_offsets[i];
-        current_offset = ::make_assignment_kernel(out_ckb, current_offset,
-                        sd->get_field_types()[i], dst_metadata + sd->get_metadata_offsets()[i],
-                        sd->get_field_types()[i], src_metadata + sd->get_metadata_offsets()[i],
-                        kernel_request_single, errmode, ectx);
+        field_order[i] = i;
     }
-    return current_offset;
+    // A struct with no fields has no field order to point at
+    return make_field_runs_assignment_kernel(out_ckb, ckb_offset,
+                    sd, dst_metadata, sd, src_metadata,
+                    field_order.empty() ? NULL : &field_order[0],
+                    kernreq, errmode, ectx);
 }
 
 /////////////////////////////////////////
@@ -154,16 +309,6 @@ size_t dynd::make_struct_assignment_kernel(
         throw runtime_error(ss.str());
     }
 
-    ckb_offset = make_kernreq_to_single_kernel_adapter(out_ckb, ckb_offset, kernreq);
-
-    size_t extra_size = sizeof(struct_kernel_extra) +
-                    field_count * sizeof(struct_kernel_extra::field_items);
-    out_ckb->ensure_capacity(ckb_offset + extra_size);
-    struct_kernel_extra *e = out_ckb->get_at<struct_kernel_extra>(ckb_offset);
-    e->base.set_function<unary_single_operation_t>(&struct_kernel_extra::single);
-    e->base.destructor = &struct_kernel_extra::destruct;
-    e->field_count = field_count;
-
     // Match up the fields
     const string *dst_field_names = dst_sd->get_field_names();
     const string *src_field_names = src_sd->get_field_names();
@@ -181,31 +326,10 @@ size_t dynd::make_struct_assignment_kernel(
         field_reorder[i] = it - src_field_names;
     }
 
-    const ndt::type *src_field_types = src_sd->get_field_types();
-    const ndt::type *dst_field_types = dst_sd->get_field_types();
-    const size_t *src_data_offsets = src_sd->get_data_offsets(src_metadata);
-    const size_t *dst_data_offsets = dst_sd->get_data_offsets(dst_metadata);
-    const size_t *src_metadata_offsets = src_sd->get_metadata_offsets();
-    const size_t *dst_metadata_offsets = dst_sd->get_metadata_offsets();
-
-    // Create the kernels and dst offsets for copying individual fields
-    size_t current_offset = ckb_offset + extra_size;
-    struct_kernel_extra::field_items *fi;
-    for (size_t i = 0; i != field_count; ++i) {
-        size_t i_src = field_reorder[i];
-        out_ckb->ensure_capacity(current_offset);
-        // Ensuring capacity may have invalidated 'e', so get it again
-        e = out_ckb->get_at<struct_kernel_extra>(ckb_offset);
-        fi = reinterpret_cast<struct_kernel_extra::field_items *>(e + 1) + i;
-        fi->child_kernel_offset = current_offset - ckb_offset;
-        fi->dst_data_offset = dst_data_offsets[i];
-        fi->src_data_offset = src_data_offsets[i_src];
-        current_offset = ::make_assignment_kernel(out_ckb, current_offset,
-                        dst_field_types[i], dst_metadata + dst_metadata_offsets[i],
-                        src_field_types[i_src], src_metadata + src_metadata_offsets[i_src],
-                        kernel_request_single, errmode, ectx);
-    }
-    return current_offset;
+    return make_field_runs_assignment_kernel(out_ckb, ckb_offset,
+                    dst_sd, dst_metadata, src_sd, src_metadata,
+                    field_reorder.empty() ? NULL : &field_reorder[0],
+                    kernreq, errmode, ectx);
 }
 
 /////////////////////////////////////////
@@ -230,19 +354,16 @@ size_t dynd::make_broadcast_to_struct_assignment_kernel(
     const base_struct_type *dst_sd = static_cast<const base_struct_type *>(dst_struct_tp.extended());
     size_t field_count = dst_sd->get_field_count();
 
-    ckb_offset = make_kernreq_to_single_kernel_adapter(out_ckb, ckb_offset, kernreq);
+    const ndt::type *dst_field_types = dst_sd->get_field_types();
+    const size_t *dst_data_offsets = dst_sd->get_data_offsets(dst_metadata);
+    const size_t *dst_metadata_offsets = dst_sd->get_metadata_offsets();
 
     size_t extra_size = sizeof(struct_kernel_extra) +
                     field_count * sizeof(struct_kernel_extra::field_items);
     out_ckb->ensure_capacity(ckb_offset + extra_size);
     struct_kernel_extra *e = out_ckb->get_at<struct_kernel_extra>(ckb_offset);
-    e->base.set_function<unary_single_operation_t>(&struct_kernel_extra::single);
-    e->base.destructor = &struct_kernel_extra::destruct;
-    e->field_count = field_count;
-
-    const ndt::type *dst_field_types = dst_sd->get_field_types();
-    const size_t *dst_data_offsets = dst_sd->get_data_offsets(dst_metadata);
-    const size_t *dst_metadata_offsets = dst_sd->get_metadata_offsets();
+    e->init(kernreq, field_count,
+                    get_struct_row_size(field_count, dst_field_types, dst_data_offsets), ectx);
 
     // Create the kernels and dst offsets for copying individual fields
     size_t current_offset = ckb_offset + extra_size;
@@ -258,7 +379,228 @@ size_t dynd::make_broadcast_to_struct_assignment_kernel(
         current_offset = ::make_assignment_kernel(out_ckb, current_offset,
                         dst_field_types[i], dst_metadata + dst_metadata_offsets[i],
                         src_tp, src_metadata,
-                        kernel_request_single, errmode, ectx);
+                        kernreq, errmode, ectx);
+    }
+    return current_offset;
+}
+
+/////////////////////////////////////////
+// array of structs to/from struct of columns assignment
+
+namespace {
+    struct columnar_struct_kernel_extra {
+        typedef columnar_struct_kernel_extra extra_type;
+
+        ckernel_prefix base;
+        size_t field_count;
+        intptr_t size;
+        // After this, there are 'field_count' of
+        // the following in a row
+        struct field_items {
+            size_t child_kernel_offset;
+            size_t dst_data_offset;
+            intptr_t dst_stride;
+            size_t src_data_offset;
+            intptr_t src_stride;
+        };
+
+        static void single(char *dst, const char *src, ckernel_prefix *extra)
+        {
+            char *eraw = reinterpret_cast<char *>(extra);
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            const field_items *fi = reinterpret_cast<const field_items *>(e + 1);
+            size_t field_count = e->field_count;
+            intptr_t size = e->size;
+            ckernel_prefix *echild;
+            unary_strided_operation_t opchild;
+
+            for (size_t i = 0; i < field_count; ++i) {
+                const field_items& item = fi[i];
+                echild  = reinterpret_cast<ckernel_prefix *>(eraw + item.child_kernel_offset);
+                opchild = echild->get_function<unary_strided_operation_t>();
+                opchild(dst + item.dst_data_offset, item.dst_stride,
+                                src + item.src_data_offset, item.src_stride,
+                                size, echild);
+            }
+        }
+
+        static void destruct(ckernel_prefix *extra)
+        {
+            char *eraw = reinterpret_cast<char *>(extra);
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            ckernel_prefix *echild;
+            const field_items *fi = reinterpret_cast<const field_items *>(e + 1);
+            size_t field_count = e->field_count;
+            for (size_t i = 0; i < field_count; ++i) {
+                const field_items& item = fi[i];
+                if (item.child_kernel_offset != 0) {
+                    echild  = reinterpret_cast<ckernel_prefix *>(eraw + item.child_kernel_offset);
+                    if (echild->destructor != NULL) {
+                        echild->destructor(echild);
+                    }
+                }
+            }
+        }
+    };
+
+    /** A strided_dim or fixed_dim dimension, the array side of a columnar assignment */
+    struct column_dim {
+        intptr_t size, stride;
+        ndt::type element_tp;
+        const char *element_metadata;
+    };
+
+    inline bool is_column_dim_type(const ndt::type& tp)
+    {
+        return tp.get_type_id() == strided_dim_type_id || tp.get_type_id() == fixed_dim_type_id;
+    }
+
+    /**
+     * Gets the dimension. With a NULL metadata, only the element type is
+     * valid for a strided_dim, and the size and stride are zero.
+     */
+    void get_column_dim(const ndt::type& tp, const char *metadata, column_dim& out)
+    {
+        if (tp.get_type_id() == strided_dim_type_id) {
+            const strided_dim_type *sdt = static_cast<const strided_dim_type *>(tp.extended());
+            out.element_tp = sdt->get_element_type();
+            if (metadata != NULL) {
+                const strided_dim_type_metadata *md =
+                                reinterpret_cast<const strided_dim_type_metadata *>(metadata);
+                out.size = md->size;
+                out.stride = md->stride;
+                out.element_metadata = metadata + sizeof(strided_dim_type_metadata);
+            } else {
+                out.size = 0;
+                out.stride = 0;
+                out.element_metadata = NULL;
+            }
+        } else {
+            const fixed_dim_type *fdt = static_cast<const fixed_dim_type *>(tp.extended());
+            out.element_tp = fdt->get_element_type();
+            out.size = fdt->get_fixed_dim_size();
+            out.stride = fdt->get_fixed_stride();
+            out.element_metadata = metadata;
+        }
+    }
+} // anonymous namespace
+
+bool dynd::is_columnar_struct_assignment(const ndt::type& dst_tp, const ndt::type& src_tp)
+{
+    const ndt::type *columns_tp, *aos_tp;
+    if (dst_tp.get_kind() == struct_kind && is_column_dim_type(src_tp)) {
+        columns_tp = &dst_tp;
+        aos_tp = &src_tp;
+    } else if (src_tp.get_kind() == struct_kind && is_column_dim_type(dst_tp)) {
+        columns_tp = &src_tp;
+        aos_tp = &dst_tp;
+    } else {
+        return false;
+    }
+    column_dim aos_dim;
+    get_column_dim(*aos_tp, NULL, aos_dim);
+    if (aos_dim.element_tp.get_kind() != struct_kind) {
+        return false;
+    }
+    const base_struct_type *columns_sd = static_cast<const base_struct_type *>(columns_tp->extended());
+    const base_struct_type *element_sd = static_cast<const base_struct_type *>(aos_dim.element_tp.extended());
+    size_t field_count = columns_sd->get_field_count();
+    if (field_count != element_sd->get_field_count()) {
+        return false;
+    }
+    const ndt::type *column_types = columns_sd->get_field_types();
+    const ndt::type *element_field_types = element_sd->get_field_types();
+    const string *column_names = columns_sd->get_field_names();
+    for (size_t i = 0; i != field_count; ++i) {
+        intptr_t i_element = element_sd->get_field_index(column_names[i]);
+        // Each column has exactly one more dimension than its field, otherwise
+        // this is broadcasting fields which are themselves arrays
+        if (i_element < 0 || !is_column_dim_type(column_types[i]) ||
+                        column_types[i].get_ndim() != element_field_types[i_element].get_ndim() + 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t dynd::make_columnar_struct_assignment_kernel(
+                ckernel_builder *out_ckb, size_t ckb_offset,
+                const ndt::type& dst_tp, const char *dst_metadata,
+                const ndt::type& src_tp, const char *src_metadata,
+                kernel_request_t kernreq, assign_error_mode errmode,
+                const eval::eval_context *ectx)
+{
+    if (!is_columnar_struct_assignment(dst_tp, src_tp)) {
+        stringstream ss;
+        ss << "make_columnar_struct_assignment_kernel: cannot assign from " << src_tp << " to " << dst_tp;
+        ss << " as columns of a struct";
+        throw runtime_error(ss.str());
+    }
+    bool to_columns = (dst_tp.get_kind() == struct_kind);
+    const ndt::type& columns_tp = to_columns ? dst_tp : src_tp;
+    const char *columns_metadata = to_columns ? dst_metadata : src_metadata;
+    column_dim aos_dim;
+    get_column_dim(to_columns ? src_tp : dst_tp, to_columns ? src_metadata : dst_metadata, aos_dim);
+
+    const base_struct_type *columns_sd = static_cast<const base_struct_type *>(columns_tp.extended());
+    const base_struct_type *element_sd = static_cast<const base_struct_type *>(aos_dim.element_tp.extended());
+    size_t field_count = columns_sd->get_field_count();
+    const ndt::type *column_types = columns_sd->get_field_types();
+    const string *column_names = columns_sd->get_field_names();
+    const size_t *column_data_offsets = columns_sd->get_data_offsets(columns_metadata);
+    const size_t *column_metadata_offsets = columns_sd->get_metadata_offsets();
+    const ndt::type *element_field_types = element_sd->get_field_types();
+    const size_t *element_data_offsets = element_sd->get_data_offsets(aos_dim.element_metadata);
+    const size_t *element_metadata_offsets = element_sd->get_metadata_offsets();
+
+    ckb_offset = make_kernreq_to_single_kernel_adapter(out_ckb, ckb_offset, kernreq);
+
+    size_t extra_size = sizeof(columnar_struct_kernel_extra) +
+                    field_count * sizeof(columnar_struct_kernel_extra::field_items);
+    out_ckb->ensure_capacity(ckb_offset + extra_size);
+    columnar_struct_kernel_extra *e = out_ckb->get_at<columnar_struct_kernel_extra>(ckb_offset);
+    e->base.set_function<unary_single_operation_t>(&columnar_struct_kernel_extra::single);
+    e->base.destructor = &columnar_struct_kernel_extra::destruct;
+    e->field_count = field_count;
+    e->size = aos_dim.size;
+
+    // Create the strided kernels for the columns
+    size_t current_offset = ckb_offset + extra_size;
+    columnar_struct_kernel_extra::field_items *fi;
+    for (size_t i = 0; i != field_count; ++i) {
+        column_dim col_dim;
+        get_column_dim(column_types[i], columns_metadata + column_metadata_offsets[i], col_dim);
+        if (col_dim.size != aos_dim.size) {
+            throw broadcast_error(dst_tp, dst_metadata, src_tp, src_metadata);
+        }
+        size_t i_element = (size_t)element_sd->get_field_index(column_names[i]);
+        const ndt::type& field_tp = element_field_types[i_element];
+        const char *field_metadata = aos_dim.element_metadata + element_metadata_offsets[i_element];
+
+        out_ckb->ensure_capacity(current_offset);
+        // Ensuring capacity may have invalidated 'e', so get it again
+        e = out_ckb->get_at<columnar_struct_kernel_extra>(ckb_offset);
+        fi = reinterpret_cast<columnar_struct_kernel_extra::field_items *>(e + 1) + i;
+        fi->child_kernel_offset = current_offset - ckb_offset;
+        if (to_columns) {
+            fi->dst_data_offset = column_data_offsets[i];
+            fi->dst_stride = col_dim.stride;
+            fi->src_data_offset = element_data_offsets[i_element];
+            fi->src_stride = aos_dim.stride;
+            current_offset = ::make_assignment_kernel(out_ckb, current_offset,
+                            col_dim.element_tp, col_dim.element_metadata,
+                            field_tp, field_metadata,
+                            kernel_request_strided, errmode, ectx);
+        } else {
+            fi->dst_data_offset = element_data_offsets[i_element];
+            fi->dst_stride = aos_dim.stride;
+            fi->src_data_offset = column_data_offsets[i];
+            fi->src_stride = col_dim.stride;
+            current_offset = ::make_assignment_kernel(out_ckb, current_offset,
+                            field_tp, field_metadata,
+                            col_dim.element_tp, col_dim.element_metadata,
+                            kernel_request_strided, errmode, ectx);
+        }
     }
     return current_offset;
 }
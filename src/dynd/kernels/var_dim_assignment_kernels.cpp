@@ -5,6 +5,7 @@
 
 #include <stdexcept>
 #include <sstream>
+#include <cstring>
 
 #include <dynd/type.hpp>
 #include <dynd/diagnostics.hpp>
@@ -17,6 +18,45 @@
 using namespace std;
 using namespace dynd;
 
+namespace {
+    /**
+     * Allocates 'count' elements of var_dim data from the destination's
+     * memory block, which may be a POD or an objectarray memory block.
+     */
+    char *allocate_var_dim_elements(const var_dim_type_metadata *dst_md,
+                    intptr_t dst_target_alignment, intptr_t count)
+    {
+        memory_block_data *memblock = dst_md->blockref;
+        if (memblock->m_type == objectarray_memory_block_type) {
+            memory_block_objectarray_allocator_api *allocator =
+                            get_memory_block_objectarray_allocator_api(memblock);
+            return allocator->allocate(memblock, count);
+        } else {
+            memory_block_pod_allocator_api *allocator =
+                            get_memory_block_pod_allocator_api(memblock);
+            char *dst_begin = NULL, *dst_end = NULL;
+            allocator->allocate(memblock, count * dst_md->stride,
+                        dst_target_alignment, &dst_begin, &dst_end);
+            return dst_begin;
+        }
+    }
+
+    /**
+     * The element size when rows can be copied with memcpy, which
+     * is when both sides are contiguous in the same POD type, 0 otherwise.
+     */
+    intptr_t get_contiguous_pod_size(const ndt::type& dst_element_tp, intptr_t dst_stride,
+                    const ndt::type& src_element_tp, intptr_t src_stride)
+    {
+        if (dst_element_tp == src_element_tp && dst_element_tp.is_pod() &&
+                        dst_stride == (intptr_t)dst_element_tp.get_data_size() &&
+                        src_stride == dst_stride) {
+            return dst_stride;
+        }
+        return 0;
+    }
+} // anonymous namespace
+
 /////////////////////////////////////////
 // broadcast to var array assignment
 
@@ -116,45 +156,45 @@ namespace {
         ckernel_prefix base;
         intptr_t dst_target_alignment;
         const var_dim_type_metadata *dst_md, *src_md;
+        // Nonzero when rows can be copied with memcpy
+        intptr_t contiguous_pod_size;
 
-        static void single(char *dst, const char *src,
-                            ckernel_prefix *extra)
+        inline void copy_row(char *dst, intptr_t dst_stride,
+                        const char *src, intptr_t src_stride, intptr_t dim_size)
+        {
+            if (contiguous_pod_size != 0 && src_stride != 0) {
+                memcpy(dst, src, dim_size * contiguous_pod_size);
+            } else {
+                ckernel_prefix *echild = &(this + 1)->base;
+                unary_strided_operation_t opchild = echild->get_function<unary_strided_operation_t>();
+                opchild(dst, dst_stride, src, src_stride, dim_size, echild);
+            }
+        }
+
+        // Assigns a row whose destination is already allocated, or
+        // is being allocated at 'dst_alloc' by the caller
+        inline void assign_row(var_dim_type_data *dst_d, const var_dim_type_data *src_d,
+                        char *&dst_alloc)
         {
-            var_dim_type_data *dst_d = reinterpret_cast<var_dim_type_data *>(dst);
-            const var_dim_type_data *src_d = reinterpret_cast<const var_dim_type_data *>(src);
-            extra_type *e = reinterpret_cast<extra_type *>(extra);
-            ckernel_prefix *echild = &(e + 1)->base;
-            unary_strided_operation_t opchild = (e + 1)->base.get_function<unary_strided_operation_t>();
             if (dst_d->begin == NULL) {
-                if (e->dst_md->offset != 0) {
+                if (dst_md->offset != 0) {
                     throw runtime_error("Cannot assign to an uninitialized dynd var_dim which has a non-zero offset");
                 }
                 // As a special case, allow uninitialized -> uninitialized assignment as a no-op
                 if (src_d->begin != NULL) {
                     intptr_t dim_size = src_d->size;
-                    intptr_t dst_stride = e->dst_md->stride, src_stride = e->src_md->stride;
+                    intptr_t dst_stride = dst_md->stride;
                     // If we're writing to an empty array, have to allocate the output
-                    memory_block_data *memblock = e->dst_md->blockref;
-                    if (memblock->m_type == objectarray_memory_block_type) {
-                        memory_block_objectarray_allocator_api *allocator =
-                                        get_memory_block_objectarray_allocator_api(memblock);
-
-                        // Allocate the output array data
-                        dst_d->begin = allocator->allocate(memblock, dim_size);
+                    if (dst_alloc == NULL) {
+                        dst_d->begin = allocate_var_dim_elements(dst_md, dst_target_alignment, dim_size);
                     } else {
-                        memory_block_pod_allocator_api *allocator =
-                                        get_memory_block_pod_allocator_api(memblock);
-
-                        // Allocate the output array data
-                        char *dst_end = NULL;
-                        allocator->allocate(memblock, dim_size * dst_stride,
-                                    e->dst_target_alignment, &dst_d->begin, &dst_end);
+                        dst_d->begin = dst_alloc;
+                        dst_alloc += dim_size * dst_stride;
                     }
                     dst_d->size = dim_size;
                     // Copy to the newly allocated element
-                    dst = dst_d->begin;
-                    src = src_d->begin + e->src_md->offset;
-                    opchild(dst, dst_stride, src, src_stride, dim_size, echild);
+                    copy_row(dst_d->begin, dst_stride,
+                                    src_d->begin + src_md->offset, src_md->stride, dim_size);
                 }
             } else {
                 if (src_d->begin == NULL) {
@@ -162,8 +202,8 @@ namespace {
                                     " to an initialized one");
                 }
                 intptr_t dst_dim_size = dst_d->size, src_dim_size = src_d->size;
-                intptr_t dst_stride = e->dst_md->stride,
-                                src_stride = src_dim_size != 1 ? e->src_md->stride : 0;
+                intptr_t dst_stride = dst_md->stride,
+                                src_stride = src_dim_size != 1 ? src_md->stride : 0;
                 // Check for a broadcasting error
                 if (src_dim_size != 1 && dst_dim_size != src_dim_size) {
                     stringstream ss;
@@ -172,9 +212,43 @@ namespace {
                     throw broadcast_error(ss.str());
                 }
                 // We're copying/broadcasting elements to an already allocated array segment
-                dst = dst_d->begin + e->dst_md->offset;
-                src = src_d->begin + e->src_md->offset;
-                opchild(dst, dst_stride, src, src_stride, dst_dim_size, echild);
+                copy_row(dst_d->begin + dst_md->offset, dst_stride,
+                                src_d->begin + src_md->offset, src_stride, dst_dim_size);
+            }
+        }
+
+        static void single(char *dst, const char *src,
+                            ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            char *dst_alloc = NULL;
+            e->assign_row(reinterpret_cast<var_dim_type_data *>(dst),
+                            reinterpret_cast<const var_dim_type_data *>(src), dst_alloc);
+        }
+
+        static void strided(char *dst, intptr_t dst_stride,
+                        const char *src, intptr_t src_stride,
+                        size_t count, ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            // Sum the sizes of the rows which need allocating, so they
+            // can share a single allocation
+            intptr_t total_size = 0;
+            const char *src_row = src;
+            char *dst_row = dst;
+            for (size_t i = 0; i != count; ++i, dst_row += dst_stride, src_row += src_stride) {
+                const var_dim_type_data *src_d = reinterpret_cast<const var_dim_type_data *>(src_row);
+                if (reinterpret_cast<var_dim_type_data *>(dst_row)->begin == NULL && src_d->begin != NULL) {
+                    total_size += src_d->size;
+                }
+            }
+            char *dst_alloc = NULL;
+            if (total_size > 0 && e->dst_md->offset == 0) {
+                dst_alloc = allocate_var_dim_elements(e->dst_md, e->dst_target_alignment, total_size);
+            }
+            for (size_t i = 0; i != count; ++i, dst += dst_stride, src += src_stride) {
+                e->assign_row(reinterpret_cast<var_dim_type_data *>(dst),
+                                reinterpret_cast<const var_dim_type_data *>(src), dst_alloc);
             }
         }
 
@@ -209,18 +283,31 @@ size_t dynd::make_var_dim_assignment_kernel(
     const var_dim_type *dst_vad = static_cast<const var_dim_type *>(dst_var_dim_tp.extended());
     const var_dim_type *src_vad = static_cast<const var_dim_type *>(src_var_dim_tp.extended());
 
-    offset_out = make_kernreq_to_single_kernel_adapter(out, offset_out, kernreq);
     out->ensure_capacity(offset_out + sizeof(var_assign_kernel_extra));
     const var_dim_type_metadata *dst_md =
                     reinterpret_cast<const var_dim_type_metadata *>(dst_metadata);
     const var_dim_type_metadata *src_md =
                     reinterpret_cast<const var_dim_type_metadata *>(src_metadata);
     var_assign_kernel_extra *e = out->get_at<var_assign_kernel_extra>(offset_out);
-    e->base.set_function<unary_single_operation_t>(&var_assign_kernel_extra::single);
+    switch (kernreq) {
+        case kernel_request_single:
+            e->base.set_function<unary_single_operation_t>(&var_assign_kernel_extra::single);
+            break;
+        case kernel_request_strided:
+            e->base.set_function<unary_strided_operation_t>(&var_assign_kernel_extra::strided);
+            break;
+        default: {
+            stringstream ss;
+            ss << "make_var_dim_assignment_kernel: unrecognized request " << (int)kernreq;
+            throw runtime_error(ss.str());
+        }
+    }
     e->base.destructor = &var_assign_kernel_extra::destruct;
     e->dst_target_alignment = dst_vad->get_target_alignment();
     e->dst_md = dst_md;
     e->src_md = src_md;
+    e->contiguous_pod_size = get_contiguous_pod_size(dst_vad->get_element_type(), dst_md->stride,
+                    src_vad->get_element_type(), src_md->stride);
     return ::make_assignment_kernel(out, offset_out + sizeof(var_assign_kernel_extra),
                     dst_vad->get_element_type(), dst_metadata + sizeof(var_dim_type_metadata),
                     src_vad->get_element_type(), src_metadata + sizeof(var_dim_type_metadata),
@@ -238,44 +325,43 @@ namespace {
         intptr_t dst_target_alignment;
         const var_dim_type_metadata *dst_md;
         intptr_t src_stride, src_dim_size;
+        // Nonzero when rows can be copied with memcpy
+        intptr_t contiguous_pod_size;
 
-        static void single(char *dst, const char *src,
-                            ckernel_prefix *extra)
+        inline void copy_row(char *dst, intptr_t dst_stride,
+                        const char *src, intptr_t src_stride, intptr_t dim_size)
+        {
+            if (contiguous_pod_size != 0) {
+                memcpy(dst, src, dim_size * contiguous_pod_size);
+            } else {
+                ckernel_prefix *echild = &(this + 1)->base;
+                unary_strided_operation_t opchild = echild->get_function<unary_strided_operation_t>();
+                opchild(dst, dst_stride, src, src_stride, dim_size, echild);
+            }
+        }
+
+        // Assigns a row whose destination is already allocated, or
+        // is being allocated at 'dst_alloc' by the caller
+        inline void assign_row(var_dim_type_data *dst_d, const char *src, char *&dst_alloc)
         {
-            var_dim_type_data *dst_d = reinterpret_cast<var_dim_type_data *>(dst);
-            extra_type *e = reinterpret_cast<extra_type *>(extra);
-            ckernel_prefix *echild = &(e + 1)->base;
-            unary_strided_operation_t opchild = (e + 1)->base.get_function<unary_strided_operation_t>();
             if (dst_d->begin == NULL) {
-                if (e->dst_md->offset != 0) {
+                if (dst_md->offset != 0) {
                     throw runtime_error("Cannot assign to an uninitialized dynd var_dim which has a non-zero offset");
                 }
-                intptr_t dim_size = e->src_dim_size;
-                intptr_t dst_stride = e->dst_md->stride, src_stride = e->src_stride;
+                intptr_t dim_size = src_dim_size;
+                intptr_t dst_stride = dst_md->stride;
                 // If we're writing to an empty array, have to allocate the output
-                memory_block_data *memblock = e->dst_md->blockref;
-                if (memblock->m_type == objectarray_memory_block_type) {
-                    memory_block_objectarray_allocator_api *allocator =
-                                    get_memory_block_objectarray_allocator_api(memblock);
-
-                    // Allocate the output array data
-                    dst_d->begin = allocator->allocate(memblock, dim_size);
+                if (dst_alloc == NULL) {
+                    dst_d->begin = allocate_var_dim_elements(dst_md, dst_target_alignment, dim_size);
                 } else {
-                    memory_block_pod_allocator_api *allocator =
-                                    get_memory_block_pod_allocator_api(memblock);
-
-                    // Allocate the output array data
-                    char *dst_end = NULL;
-                    allocator->allocate(memblock, dim_size * dst_stride,
-                                e->dst_target_alignment, &dst_d->begin, &dst_end);
+                    dst_d->begin = dst_alloc;
+                    dst_alloc += dim_size * dst_stride;
                 }
                 dst_d->size = dim_size;
                 // Copy to the newly allocated element
-                dst = dst_d->begin;
-                opchild(dst, dst_stride, src, src_stride, dim_size, echild);
+                copy_row(dst_d->begin, dst_stride, src, src_stride, dim_size);
             } else {
-                intptr_t dst_dim_size = dst_d->size, src_dim_size = e->src_dim_size;
-                intptr_t dst_stride = e->dst_md->stride, src_stride = e->src_stride;
+                intptr_t dst_dim_size = dst_d->size;
                 // Check for a broadcasting error
                 if (src_dim_size != 1 && dst_dim_size != src_dim_size) {
                     stringstream ss;
@@ -284,8 +370,45 @@ namespace {
                     throw broadcast_error(ss.str());
                 }
                 // We're copying/broadcasting elements to an already allocated array segment
-                dst = dst_d->begin + e->dst_md->offset;
-                opchild(dst, dst_stride, src, src_stride, dst_dim_size, echild);
+                if (src_dim_size == 1 && dst_dim_size != 1) {
+                    ckernel_prefix *echild = &(this + 1)->base;
+                    unary_strided_operation_t opchild = echild->get_function<unary_strided_operation_t>();
+                    opchild(dst_d->begin + dst_md->offset, dst_md->stride, src, src_stride, dst_dim_size, echild);
+                } else {
+                    copy_row(dst_d->begin + dst_md->offset, dst_md->stride, src, src_stride, dst_dim_size);
+                }
+            }
+        }
+
+        static void single(char *dst, const char *src,
+                            ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            char *dst_alloc = NULL;
+            e->assign_row(reinterpret_cast<var_dim_type_data *>(dst), src, dst_alloc);
+        }
+
+        static void strided(char *dst, intptr_t dst_stride,
+                        const char *src, intptr_t src_stride,
+                        size_t count, ckernel_prefix *extra)
+        {
+            extra_type *e = reinterpret_cast<extra_type *>(extra);
+            // Count the rows which need allocating, so they
+            // can share a single allocation
+            intptr_t alloc_count = 0;
+            char *dst_row = dst;
+            for (size_t i = 0; i != count; ++i, dst_row += dst_stride) {
+                if (reinterpret_cast<var_dim_type_data *>(dst_row)->begin == NULL) {
+                    ++alloc_count;
+                }
+            }
+            char *dst_alloc = NULL;
+            if (alloc_count > 0 && e->src_dim_size > 0 && e->dst_md->offset == 0) {
+                dst_alloc = allocate_var_dim_elements(e->dst_md, e->dst_target_alignment,
+                                alloc_count * e->src_dim_size);
+            }
+            for (size_t i = 0; i != count; ++i, dst += dst_stride, src += src_stride) {
+                e->assign_row(reinterpret_cast<var_dim_type_data *>(dst), src, dst_alloc);
             }
         }
 
@@ -314,12 +437,23 @@ size_t dynd::make_strided_to_var_dim_assignment_kernel(
     }
     const var_dim_type *dst_vad = static_cast<const var_dim_type *>(dst_var_dim_tp.extended());
 
-    offset_out = make_kernreq_to_single_kernel_adapter(out, offset_out, kernreq);
     out->ensure_capacity(offset_out + sizeof(strided_to_var_assign_kernel_extra));
     const var_dim_type_metadata *dst_md =
                     reinterpret_cast<const var_dim_type_metadata *>(dst_metadata);
     strided_to_var_assign_kernel_extra *e = out->get_at<strided_to_var_assign_kernel_extra>(offset_out);
-    e->base.set_function<unary_single_operation_t>(&strided_to_var_assign_kernel_extra::single);
+    switch (kernreq) {
+        case kernel_request_single:
+            e->base.set_function<unary_single_operation_t>(&strided_to_var_assign_kernel_extra::single);
+            break;
+        case kernel_request_strided:
+            e->base.set_function<unary_strided_operation_t>(&strided_to_var_assign_kernel_extra::strided);
+            break;
+        default: {
+            stringstream ss;
+            ss << "make_strided_to_var_dim_assignment_kernel: unrecognized request " << (int)kernreq;
+            throw runtime_error(ss.str());
+        }
+    }
     e->base.destructor = &strided_to_var_assign_kernel_extra::destruct;
     e->dst_target_alignment = dst_vad->get_target_alignment();
     e->dst_md = dst_md;
@@ -345,6 +479,8 @@ size_t dynd::make_strided_to_var_dim_assignment_kernel(
         ss << "make_strided_to_var_dim_assignment_kernel: provided source type " << src_strided_dim_tp << " is not a strided_dim or fixed_array";
         throw runtime_error(ss.str());
     }
+    e->contiguous_pod_size = get_contiguous_pod_size(dst_vad->get_element_type(), dst_md->stride,
+                    src_element_tp, e->src_stride);
 
     return ::make_assignment_kernel(out, offset_out + sizeof(strided_to_var_assign_kernel_extra),
                     dst_vad->get_element_type(), dst_metadata + sizeof(var_dim_type_metadata),
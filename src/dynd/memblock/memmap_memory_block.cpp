@@ -63,6 +63,22 @@ static void clip_begin_end(intptr_t size, intptr_t& begin, intptr_t& end)
     }
 }
 
+#ifndef WIN32
+static int get_posix_advice(memmap_advice_t advice)
+{
+    switch (advice) {
+        case memmap_advice_sequential:
+            return POSIX_MADV_SEQUENTIAL;
+        case memmap_advice_random:
+            return POSIX_MADV_RANDOM;
+        case memmap_advice_willneed:
+            return POSIX_MADV_WILLNEED;
+        default:
+            return POSIX_MADV_NORMAL;
+    }
+}
+#endif
+
 namespace {
     struct memmap_memory_block {
         /** Every memory block object needs this at the front */
@@ -85,7 +101,7 @@ namespace {
 
         memmap_memory_block(const std::string& filename,
                     uint32_t access, char **out_pointer, intptr_t *out_size,
-                    intptr_t begin, intptr_t end)
+                    intptr_t begin, intptr_t end, memmap_advice_t advice)
             : m_mbd(1, memmap_memory_block_type), m_filename(filename),
                 m_access(access), m_begin(begin), m_end(end)
         {
@@ -161,6 +177,9 @@ namespace {
                 ss << "failure mapping view of file \"" << m_filename << "\" for memory mapping";
                 throw runtime_error(ss.str());
             }
+            // There is no equivalent of madvise for views of files
+            // on all supported versions of Windows, so the advice is ignored
+            (void)advice;
             *out_pointer = m_mapPointer + m_mapOffset;
             *out_size = end - begin;
 #else // Finished win32 implementation, now posix
@@ -209,6 +228,10 @@ namespace {
                    << "\" for memory mapping";
                 throw runtime_error(ss.str());
             }
+            if (advice != memmap_advice_normal) {
+                // The advice is only a hint, so a failure is not an error
+                (void)posix_madvise(m_mapPointer, mapsize, get_posix_advice(advice));
+            }
 
             *out_pointer = m_mapPointer + m_mapOffset;
             *out_size = end - begin;
@@ -232,10 +255,10 @@ namespace {
 
 memory_block_ptr dynd::make_memmap_memory_block(const std::string& filename,
     uint32_t access, char **out_pointer, intptr_t *out_size,
-    intptr_t begin, intptr_t end)
+    intptr_t begin, intptr_t end, memmap_advice_t advice)
 {
     memmap_memory_block *pmb = new memmap_memory_block(
-        filename, access, out_pointer, out_size, begin, end);
+        filename, access, out_pointer, out_size, begin, end, advice);
     return memory_block_ptr(reinterpret_cast<memory_block_data *>(pmb), false);
 }
 
@@ -665,8 +665,9 @@ axis_order_classification_t dynd::classify_strided_axis_order(intptr_t current_s
             }
         }
         case pointer_type_id:
-        case var_dim_type_id: {
-            // A pointer or a var type is treated like C-order
+        case var_dim_type_id:
+        case offset_dim_type_id: {
+            // A pointer, var or offset type is treated like C-order
             axis_order_classification_t aoc =
                             element_tp.extended()->classify_axis_order(element_metadata);
             return (aoc == axis_order_none || aoc == axis_order_c)
@@ -0,0 +1,940 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <vector>
+
+#include <dynd/sort.hpp>
+#include <dynd/shortvector.hpp>
+#include <dynd/kernels/comparison_kernels.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+    enum radix_kind_t {
+        radix_unsigned,
+        radix_signed,
+        radix_float
+    };
+
+    // The bit pattern of +inf for the floating point types, indexed by
+    // the unsigned integer type with the same size
+    template<class UT> struct float_inf_bits;
+    template<> struct float_inf_bits<uint16_t> {
+        static uint16_t value() { return 0x7c00u; }
+    };
+    template<> struct float_inf_bits<uint32_t> {
+        static uint32_t value() { return 0x7f800000u; }
+    };
+    template<> struct float_inf_bits<uint64_t> {
+        static uint64_t value() { return 0x7ff0000000000000ULL; }
+    };
+
+    /**
+     * Maps the bits of a value to an unsigned key whose unsigned
+     * ordering matches the ordering of the values. equal_key gives
+     * values which compare equal the same key.
+     */
+    template<class UT, radix_kind_t Kind>
+    struct radix_key;
+
+    template<class UT>
+    struct radix_key<UT, radix_unsigned> {
+        static inline UT to_key(UT bits) {
+            return bits;
+        }
+        static inline UT from_key(UT key) {
+            return key;
+        }
+        static inline bool is_nan(UT) {
+            return false;
+        }
+        static inline UT equal_key(UT bits) {
+            return bits;
+        }
+    };
+
+    template<class UT>
+    struct radix_key<UT, radix_signed> {
+        static inline UT sign_bit() {
+            return static_cast<UT>(UT(1) << (8 * sizeof(UT) - 1));
+        }
+        static inline UT to_key(UT bits) {
+            return static_cast<UT>(bits ^ sign_bit());
+        }
+        static inline UT from_key(UT key) {
+            return static_cast<UT>(key ^ sign_bit());
+        }
+        static inline bool is_nan(UT) {
+            return false;
+        }
+        static inline UT equal_key(UT bits) {
+            return to_key(bits);
+        }
+    };
+
+    template<class UT>
+    struct radix_key<UT, radix_float> {
+        static inline UT sign_bit() {
+            return static_cast<UT>(UT(1) << (8 * sizeof(UT) - 1));
+        }
+        // Negative values get all their bits flipped, positive values
+        // get just the sign bit flipped
+        static inline UT to_key(UT bits) {
+            return (bits & sign_bit()) ? static_cast<UT>(~bits)
+                                       : static_cast<UT>(bits | sign_bit());
+        }
+        static inline UT from_key(UT key) {
+            return (key & sign_bit()) ? static_cast<UT>(key & ~sign_bit())
+                                      : static_cast<UT>(~key);
+        }
+        static inline bool is_nan(UT bits) {
+            return static_cast<UT>(bits & ~sign_bit()) > float_inf_bits<UT>::value();
+        }
+        // Like to_key, but -0.0 gets the key of 0.0 since they compare
+        // equal. The value can't be recovered with from_key, so this is
+        // only for keys which order indices rather than values.
+        static inline UT equal_key(UT bits) {
+            if (static_cast<UT>(bits & ~sign_bit()) == 0) {
+                bits = 0;
+            }
+            return to_key(bits);
+        }
+    };
+
+    /**
+     * LSD radix sort of unsigned keys, one byte per pass. If `idx` is
+     * non-NULL, the indices are permuted along with the keys, and the
+     * sort is stable. Passes where every key has the same digit are
+     * skipped. The sorted data ends up in either the original buffers
+     * or the tmp buffers, and the return value says which (true means tmp).
+     */
+    template<class UT>
+    static bool radix_sort_keys(UT *keys, UT *keys_tmp,
+                    intptr_t *idx, intptr_t *idx_tmp, intptr_t count)
+    {
+        const int npasses = (int)sizeof(UT);
+        intptr_t hist[sizeof(UT)][256];
+        memset(hist, 0, sizeof(hist));
+        for (intptr_t i = 0; i < count; ++i) {
+            UT k = keys[i];
+            for (int pass = 0; pass < npasses; ++pass) {
+                ++hist[pass][(k >> (8 * pass)) & 0xff];
+            }
+        }
+
+        bool in_tmp = false;
+        for (int pass = 0; pass < npasses; ++pass) {
+            int shift = 8 * pass;
+            intptr_t *h = hist[pass];
+            if (h[(keys[0] >> shift) & 0xff] == count) {
+                // All the keys have the same digit, nothing to do
+                continue;
+            }
+            // Convert the histogram into starting offsets
+            intptr_t total = 0;
+            for (int b = 0; b < 256; ++b) {
+                intptr_t c = h[b];
+                h[b] = total;
+                total += c;
+            }
+            if (idx != NULL) {
+                for (intptr_t i = 0; i < count; ++i) {
+                    intptr_t pos = h[(keys[i] >> shift) & 0xff]++;
+                    keys_tmp[pos] = keys[i];
+                    idx_tmp[pos] = idx[i];
+                }
+                swap(idx, idx_tmp);
+            } else {
+                for (intptr_t i = 0; i < count; ++i) {
+                    keys_tmp[h[(keys[i] >> shift) & 0xff]++] = keys[i];
+                }
+            }
+            swap(keys, keys_tmp);
+            in_tmp = !in_tmp;
+        }
+        return in_tmp;
+    }
+
+    // Below this size, the 256-bucket histograms cost more than they save
+    const intptr_t radix_sort_min_count = 64;
+
+    template<class UT>
+    struct key_index_less {
+        const UT *m_keys;
+        key_index_less(const UT *keys) : m_keys(keys) {}
+        bool operator()(intptr_t i, intptr_t j) const {
+            return m_keys[i] < m_keys[j];
+        }
+    };
+
+    template<class UT, radix_kind_t Kind>
+    static void radix_sort_strided(char *data, intptr_t stride, intptr_t count)
+    {
+        typedef radix_key<UT, Kind> K;
+        bool contiguous = (stride == (intptr_t)sizeof(UT) &&
+                        offset_is_aligned(reinterpret_cast<size_t>(data), sizeof(UT)));
+        vector<UT> keys_buf, tmp_buf, nans;
+        UT *keys;
+        if (contiguous) {
+            // Transform the data into keys in place, moving any NaNs aside
+            keys = reinterpret_cast<UT *>(data);
+        } else {
+            keys_buf.resize(count);
+            keys = &keys_buf[0];
+        }
+        intptr_t nkeys = 0;
+        for (intptr_t i = 0; i < count; ++i) {
+            UT bits;
+            memcpy(&bits, data + i * stride, sizeof(UT));
+            if (K::is_nan(bits)) {
+                nans.push_back(bits);
+            } else {
+                keys[nkeys++] = K::to_key(bits);
+            }
+        }
+
+        if (nkeys < radix_sort_min_count) {
+            std::sort(keys, keys + nkeys);
+        } else {
+            tmp_buf.resize(nkeys);
+            if (radix_sort_keys<UT>(keys, &tmp_buf[0], NULL, NULL, nkeys)) {
+                memcpy(keys, &tmp_buf[0], nkeys * sizeof(UT));
+            }
+        }
+
+        for (intptr_t i = 0; i < nkeys; ++i) {
+            UT bits = K::from_key(keys[i]);
+            memcpy(data + i * stride, &bits, sizeof(UT));
+        }
+        // NaNs go at the end, matching comparison_type_sorting_less
+        for (size_t i = 0; i < nans.size(); ++i) {
+            memcpy(data + (nkeys + i) * stride, &nans[i], sizeof(UT));
+        }
+    }
+
+    template<class UT, radix_kind_t Kind>
+    static void radix_argsort_strided(const char *data, intptr_t stride, intptr_t count,
+                    intptr_t *out_perm)
+    {
+        typedef radix_key<UT, Kind> K;
+        vector<UT> keys(count);
+        vector<intptr_t> nan_idx;
+        intptr_t nkeys = 0;
+        for (intptr_t i = 0; i < count; ++i) {
+            UT bits;
+            memcpy(&bits, data + i * stride, sizeof(UT));
+            if (K::is_nan(bits)) {
+                nan_idx.push_back(i);
+            } else {
+                // Equal values need equal keys to keep the sort stable
+                keys[nkeys] = K::equal_key(bits);
+                out_perm[nkeys++] = i;
+            }
+        }
+
+        if (nkeys < radix_sort_min_count) {
+            // keys[j] is the key of element out_perm[j], so sort the
+            // positions and then map them back to element indices
+            vector<intptr_t> pos(nkeys);
+            for (intptr_t i = 0; i < nkeys; ++i) {
+                pos[i] = i;
+            }
+            std::stable_sort(pos.begin(), pos.end(), key_index_less<UT>(keys.empty() ? NULL : &keys[0]));
+            vector<intptr_t> orig(out_perm, out_perm + nkeys);
+            for (intptr_t i = 0; i < nkeys; ++i) {
+                out_perm[i] = orig[pos[i]];
+            }
+        } else {
+            vector<UT> keys_tmp(nkeys);
+            vector<intptr_t> idx_tmp(nkeys);
+            if (radix_sort_keys<UT>(&keys[0], &keys_tmp[0], out_perm, &idx_tmp[0], nkeys)) {
+                memcpy(out_perm, &idx_tmp[0], nkeys * sizeof(intptr_t));
+            }
+        }
+
+        for (size_t i = 0; i < nan_idx.size(); ++i) {
+            out_perm[nkeys + i] = nan_idx[i];
+        }
+    }
+
+    struct strided_index_less {
+        const char *m_origin;
+        intptr_t m_stride;
+        binary_single_predicate_t m_less;
+        ckernel_prefix *m_extra;
+
+        strided_index_less(const char *origin, intptr_t stride,
+                        binary_single_predicate_t less, ckernel_prefix *extra)
+            : m_origin(origin), m_stride(stride), m_less(less), m_extra(extra) {}
+
+        bool operator()(intptr_t i, intptr_t j) const {
+            return m_less(m_origin + i * m_stride, m_origin + j * m_stride, m_extra) != 0;
+        }
+    };
+
+    static void comparison_argsort_strided(const ndt::type& tp, const char *metadata,
+                    const char *data, intptr_t stride, intptr_t count,
+                    intptr_t *out_perm, const eval::eval_context *ectx)
+    {
+        comparison_ckernel_builder k;
+        make_comparison_kernel(&k, 0, tp, metadata, tp, metadata,
+                        comparison_type_sorting_less, ectx);
+        for (intptr_t i = 0; i < count; ++i) {
+            out_perm[i] = i;
+        }
+        // std::stable_sort is a merge sort, which keeps the number of
+        // (potentially expensive) comparison kernel calls at O(n log n)
+        std::stable_sort(out_perm, out_perm + count,
+                        strided_index_less(data, stride, k.get_function(), k.get()));
+    }
+
+    static void comparison_sort_strided(const ndt::type& tp, const char *metadata,
+                    char *data, intptr_t stride, intptr_t count,
+                    const eval::eval_context *ectx)
+    {
+        size_t data_size = tp.get_data_size();
+        if (data_size == 0) {
+            stringstream ss;
+            ss << "cannot sort elements of dynd type " << tp << ", it does not have a fixed size";
+            throw runtime_error(ss.str());
+        }
+        vector<intptr_t> perm(count);
+        comparison_argsort_strided(tp, metadata, data, stride, count, &perm[0], ectx);
+        // Gather the elements in sorted order, then copy them back
+        vector<char> buf(count * data_size);
+        for (intptr_t i = 0; i < count; ++i) {
+            memcpy(&buf[i * data_size], data + perm[i] * stride, data_size);
+        }
+        for (intptr_t i = 0; i < count; ++i) {
+            memcpy(data + i * stride, &buf[i * data_size], data_size);
+        }
+    }
+} // anonymous namespace
+
+void dynd::strided_sort(const ndt::type& tp, const char *metadata,
+                char *data, intptr_t stride, intptr_t count,
+                const eval::eval_context *ectx)
+{
+    if (count <= 1) {
+        return;
+    }
+    switch (tp.get_type_id()) {
+        case bool_type_id:
+        case uint8_type_id:
+            radix_sort_strided<uint8_t, radix_unsigned>(data, stride, count);
+            return;
+        case uint16_type_id:
+            radix_sort_strided<uint16_t, radix_unsigned>(data, stride, count);
+            return;
+        case uint32_type_id:
+            radix_sort_strided<uint32_t, radix_unsigned>(data, stride, count);
+            return;
+        case uint64_type_id:
+            radix_sort_strided<uint64_t, radix_unsigned>(data, stride, count);
+            return;
+        case int8_type_id:
+            radix_sort_strided<uint8_t, radix_signed>(data, stride, count);
+            return;
+        case int16_type_id:
+            radix_sort_strided<uint16_t, radix_signed>(data, stride, count);
+            return;
+        case int32_type_id:
+            radix_sort_strided<uint32_t, radix_signed>(data, stride, count);
+            return;
+        case int64_type_id:
+            radix_sort_strided<uint64_t, radix_signed>(data, stride, count);
+            return;
+        case float16_type_id:
+            radix_sort_strided<uint16_t, radix_float>(data, stride, count);
+            return;
+        case float32_type_id:
+            radix_sort_strided<uint32_t, radix_float>(data, stride, count);
+            return;
+        case float64_type_id:
+            radix_sort_strided<uint64_t, radix_float>(data, stride, count);
+            return;
+        default:
+            comparison_sort_strided(tp, metadata, data, stride, count, ectx);
+            return;
+    }
+}
+
+void dynd::strided_argsort(const ndt::type& tp, const char *metadata,
+                const char *data, intptr_t stride, intptr_t count,
+                intptr_t *out_perm, const eval::eval_context *ectx)
+{
+    if (count <= 1) {
+        if (count == 1) {
+            out_perm[0] = 0;
+        }
+        return;
+    }
+    switch (tp.get_type_id()) {
+        case bool_type_id:
+        case uint8_type_id:
+            radix_argsort_strided<uint8_t, radix_unsigned>(data, stride, count, out_perm);
+            return;
+        case uint16_type_id:
+            radix_argsort_strided<uint16_t, radix_unsigned>(data, stride, count, out_perm);
+            return;
+        case uint32_type_id:
+            radix_argsort_strided<uint32_t, radix_unsigned>(data, stride, count, out_perm);
+            return;
+        case uint64_type_id:
+            radix_argsort_strided<uint64_t, radix_unsigned>(data, stride, count, out_perm);
+            return;
+        case int8_type_id:
+            radix_argsort_strided<uint8_t, radix_signed>(data, stride, count, out_perm);
+            return;
+        case int16_type_id:
+            radix_argsort_strided<uint16_t, radix_signed>(data, stride, count, out_perm);
+            return;
+        case int32_type_id:
+            radix_argsort_strided<uint32_t, radix_signed>(data, stride, count, out_perm);
+            return;
+        case int64_type_id:
+            radix_argsort_strided<uint64_t, radix_signed>(data, stride, count, out_perm);
+            return;
+        case float16_type_id:
+            radix_argsort_strided<uint16_t, radix_float>(data, stride, count, out_perm);
+            return;
+        case float32_type_id:
+            radix_argsort_strided<uint32_t, radix_float>(data, stride, count, out_perm);
+            return;
+        case float64_type_id:
+            radix_argsort_strided<uint64_t, radix_float>(data, stride, count, out_perm);
+            return;
+        default:
+            comparison_argsort_strided(tp, metadata, data, stride, count, out_perm, ectx);
+            return;
+    }
+}
+
+namespace {
+    /**
+     * Reads a builtin value as an unsigned key whose ordering matches
+     * comparison_type_sorting_less. All NaNs map to the largest key,
+     * and -0.0 maps to the same key as 0.0, since they compare equal.
+     */
+    template<class UT, radix_kind_t Kind>
+    struct search_key {
+        static inline UT get(const char *ptr) {
+            UT bits;
+            memcpy(&bits, ptr, sizeof(UT));
+            return radix_key<UT, Kind>::equal_key(bits);
+        }
+    };
+
+    template<class UT>
+    struct search_key<UT, radix_float> {
+        static inline UT get(const char *ptr) {
+            typedef radix_key<UT, radix_float> K;
+            UT bits;
+            memcpy(&bits, ptr, sizeof(UT));
+            if (K::is_nan(bits)) {
+                return static_cast<UT>(~UT(0));
+            }
+            return K::equal_key(bits);
+        }
+    };
+
+    // Searching to the left finds the first element which is not less
+    // than the needle, searching to the right finds the first element
+    // which is greater than the needle
+    template<class UT, bool Right>
+    struct search_pred {
+        static inline bool go_right(UT elem, UT needle) {
+            return Right ? (elem <= needle) : (elem < needle);
+        }
+    };
+
+    // How many needles are searched in lockstep by the branchless search
+    enum { searchsorted_group_size = 8 };
+    // Minimum number of sorted elements for which an Eytzinger copy is built
+    enum { eytzinger_min_count = 1024 };
+
+    /**
+     * Branchless binary search directly on the strided sorted data. The
+     * needles are processed in groups which all take the same number of
+     * steps, so the next probes of every needle in a group can be
+     * prefetched while the others are compared.
+     */
+    template<class UT, radix_kind_t Kind, bool Right>
+    static void branchless_searchsorted(const char *sdata, intptr_t sstride, intptr_t count,
+                    const char *ndata, intptr_t nstride, intptr_t ncount, intptr_t *out)
+    {
+        typedef search_key<UT, Kind> SK;
+        typedef search_pred<UT, Right> P;
+        UT v[searchsorted_group_size];
+        intptr_t lo[searchsorted_group_size];
+        for (intptr_t j0 = 0; j0 < ncount; j0 += searchsorted_group_size) {
+            int g = (int)std::min<intptr_t>(searchsorted_group_size, ncount - j0);
+            for (int i = 0; i < g; ++i) {
+                v[i] = SK::get(ndata + (j0 + i) * nstride);
+                lo[i] = 0;
+            }
+            intptr_t n = count;
+            while (n > 1) {
+                intptr_t half = n / 2, next_half = (n - half) / 2;
+                for (int i = 0; i < g; ++i) {
+                    const char *base = sdata + lo[i] * sstride;
+                    DYND_PREFETCH(base + next_half * sstride);
+                    DYND_PREFETCH(base + (half + next_half) * sstride);
+                    lo[i] += static_cast<intptr_t>(P::go_right(SK::get(base + half * sstride), v[i])) * half;
+                }
+                n -= half;
+            }
+            for (int i = 0; i < g; ++i) {
+                out[j0 + i] = (count == 0) ? 0 :
+                    lo[i] + static_cast<intptr_t>(P::go_right(SK::get(sdata + lo[i] * sstride), v[i]));
+            }
+        }
+    }
+
+    /**
+     * Fills `eyt[1..n]` with the keys in Eytzinger (BFS) order, and
+     * `rank` with the sorted index of each Eytzinger slot.
+     */
+    template<class UT, radix_kind_t Kind>
+    static intptr_t eytzinger_fill(const char *sdata, intptr_t sstride,
+                    UT *eyt, intptr_t *rank, intptr_t i, intptr_t k, intptr_t n)
+    {
+        if (k <= n) {
+            i = eytzinger_fill<UT, Kind>(sdata, sstride, eyt, rank, i, 2 * k, n);
+            eyt[k] = search_key<UT, Kind>::get(sdata + i * sstride);
+            rank[k] = i++;
+            i = eytzinger_fill<UT, Kind>(sdata, sstride, eyt, rank, i, 2 * k + 1, n);
+        }
+        return i;
+    }
+
+    /**
+     * Search through an Eytzinger copy of the sorted keys. Building the
+     * copy is O(n), so this is only used when there are enough needles
+     * to pay for it. Its access pattern is cache friendly, and the
+     * descendants several levels down are contiguous, so one prefetch
+     * per step covers them.
+     */
+    template<class UT, radix_kind_t Kind, bool Right>
+    static void eytzinger_searchsorted(const char *sdata, intptr_t sstride, intptr_t count,
+                    const char *ndata, intptr_t nstride, intptr_t ncount, intptr_t *out)
+    {
+        typedef search_key<UT, Kind> SK;
+        typedef search_pred<UT, Right> P;
+        // The number of keys in a 64 byte cache line
+        const intptr_t line_keys = 64 / sizeof(UT);
+        vector<UT> eyt(count + 1);
+        vector<intptr_t> rank(count + 1);
+        eytzinger_fill<UT, Kind>(sdata, sstride, &eyt[0], &rank[0], 0, 1, count);
+        const UT *e = &eyt[0];
+        for (intptr_t j = 0; j < ncount; ++j) {
+            UT v = SK::get(ndata + j * nstride);
+            intptr_t k = 1;
+            while (k <= count) {
+                DYND_PREFETCH(e + std::min(k * line_keys, count));
+                k = 2 * k + static_cast<intptr_t>(P::go_right(e[k], v));
+            }
+            // Undo the trailing right turns, and the final left turn
+            while (k & 1) {
+                k >>= 1;
+            }
+            k >>= 1;
+            out[j] = (k == 0) ? count : rank[k];
+        }
+    }
+
+    template<class UT, radix_kind_t Kind, bool Right>
+    static void builtin_searchsorted_side(const char *sdata, intptr_t sstride, intptr_t count,
+                    const char *ndata, intptr_t nstride, intptr_t ncount, intptr_t *out)
+    {
+        if (count >= eytzinger_min_count && ncount >= count / 16) {
+            eytzinger_searchsorted<UT, Kind, Right>(sdata, sstride, count,
+                            ndata, nstride, ncount, out);
+        } else {
+            branchless_searchsorted<UT, Kind, Right>(sdata, sstride, count,
+                            ndata, nstride, ncount, out);
+        }
+    }
+
+    template<class UT, radix_kind_t Kind>
+    static void builtin_searchsorted(const char *sdata, intptr_t sstride, intptr_t count,
+                    const char *ndata, intptr_t nstride, intptr_t ncount,
+                    searchsorted_side_t side, intptr_t *out)
+    {
+        if (side == searchsorted_right) {
+            builtin_searchsorted_side<UT, Kind, true>(sdata, sstride, count,
+                            ndata, nstride, ncount, out);
+        } else {
+            builtin_searchsorted_side<UT, Kind, false>(sdata, sstride, count,
+                            ndata, nstride, ncount, out);
+        }
+    }
+
+    static void comparison_searchsorted(const ndt::type& tp,
+                    const char *sorted_metadata, const char *sdata, intptr_t sstride, intptr_t count,
+                    const char *needle_metadata, const char *ndata, intptr_t nstride, intptr_t ncount,
+                    searchsorted_side_t side, intptr_t *out, const eval::eval_context *ectx)
+    {
+        // Only one comparison direction is needed, so a single kernel
+        // is built for the whole batch of needles
+        comparison_ckernel_builder k;
+        bool right = (side == searchsorted_right);
+        if (right) {
+            make_comparison_kernel(&k, 0, tp, needle_metadata, tp, sorted_metadata,
+                            comparison_type_sorting_less, ectx);
+        } else {
+            make_comparison_kernel(&k, 0, tp, sorted_metadata, tp, needle_metadata,
+                            comparison_type_sorting_less, ectx);
+        }
+        binary_single_predicate_t less = k.get_function();
+        ckernel_prefix *extra = k.get();
+        for (intptr_t j = 0; j < ncount; ++j) {
+            const char *v = ndata + j * nstride;
+            intptr_t first = 0, last = count;
+            while (first < last) {
+                intptr_t trial = first + (last - first) / 2;
+                const char *trial_data = sdata + trial * sstride;
+                bool go_right = right ? (less(v, trial_data, extra) == 0)
+                                      : (less(trial_data, v, extra) != 0);
+                if (go_right) {
+                    first = trial + 1;
+                } else {
+                    last = trial;
+                }
+            }
+            out[j] = first;
+        }
+    }
+} // anonymous namespace
+
+void dynd::strided_searchsorted(const ndt::type& tp,
+                const char *sorted_metadata, const char *sorted_data,
+                intptr_t sorted_stride, intptr_t sorted_count,
+                const char *needle_metadata, const char *needle_data,
+                intptr_t needle_stride, intptr_t needle_count,
+                searchsorted_side_t side, intptr_t *out,
+                const eval::eval_context *ectx)
+{
+    const char *sd = sorted_data, *nd = needle_data;
+    intptr_t ss = sorted_stride, sc = sorted_count;
+    intptr_t ns = needle_stride, nc = needle_count;
+    switch (tp.get_type_id()) {
+        case bool_type_id:
+        case uint8_type_id:
+            builtin_searchsorted<uint8_t, radix_unsigned>(sd, ss, sc, nd, ns, nc, side, out);
+            return;
+        case uint16_type_id:
+            builtin_searchsorted<uint16_t, radix_unsigned>(sd, ss, sc, nd, ns, nc, side, out);
+            return;
+        case uint32_type_id:
+            builtin_searchsorted<uint32_t, radix_unsigned>(sd, ss, sc, nd, ns, nc, side, out);
+            return;
+        case uint64_type_id:
+            builtin_searchsorted<uint64_t, radix_unsigned>(sd, ss, sc, nd, ns, nc, side, out);
+            return;
+        case int8_type_id:
+            builtin_searchsorted<uint8_t, radix_signed>(sd, ss, sc, nd, ns, nc, side, out);
+            return;
+        case int16_type_id:
+            builtin_searchsorted<uint16_t, radix_signed>(sd, ss, sc, nd, ns, nc, side, out);
+            return;
+        case int32_type_id:
+            builtin_searchsorted<uint32_t, radix_signed>(sd, ss, sc, nd, ns, nc, side, out);
+            return;
+        case int64_type_id:
+            builtin_searchsorted<uint64_t, radix_signed>(sd, ss, sc, nd, ns, nc, side, out);
+            return;
+        case float16_type_id:
+            builtin_searchsorted<uint16_t, radix_float>(sd, ss, sc, nd, ns, nc, side, out);
+            return;
+        case float32_type_id:
+            builtin_searchsorted<uint32_t, radix_float>(sd, ss, sc, nd, ns, nc, side, out);
+            return;
+        case float64_type_id:
+            builtin_searchsorted<uint64_t, radix_float>(sd, ss, sc, nd, ns, nc, side, out);
+            return;
+        default:
+            comparison_searchsorted(tp, sorted_metadata, sd, ss, sc,
+                            needle_metadata, nd, ns, nc, side, out, ectx);
+            return;
+    }
+}
+
+namespace {
+    /**
+     * Callback which processes one run of elements along the sort axis.
+     * When the operation produces an output (argsort), `out`/`out_stride`
+     * describe the matching run in the output. `extra` is passed
+     * through unchanged from foreach_axis_run.
+     */
+    typedef void (*axis_run_fn_t)(const ndt::type& dtp, const char *dmeta,
+                    char *data, intptr_t stride, intptr_t count,
+                    char *out, intptr_t out_stride, void *extra,
+                    const eval::eval_context *ectx);
+
+    static void sort_run(const ndt::type& dtp, const char *dmeta,
+                    char *data, intptr_t stride, intptr_t count,
+                    char *DYND_UNUSED(out), intptr_t DYND_UNUSED(out_stride),
+                    void *DYND_UNUSED(extra), const eval::eval_context *ectx)
+    {
+        strided_sort(dtp, dmeta, data, stride, count, ectx);
+    }
+
+    static void argsort_run(const ndt::type& dtp, const char *dmeta,
+                    char *data, intptr_t stride, intptr_t count,
+                    char *out, intptr_t out_stride, void *DYND_UNUSED(extra),
+                    const eval::eval_context *ectx)
+    {
+        if (out_stride == (intptr_t)sizeof(intptr_t)) {
+            strided_argsort(dtp, dmeta, data, stride, count,
+                            reinterpret_cast<intptr_t *>(out), ectx);
+        } else {
+            vector<intptr_t> perm(count);
+            if (count > 0) {
+                strided_argsort(dtp, dmeta, data, stride, count, &perm[0], ectx);
+            }
+            for (intptr_t i = 0; i < count; ++i) {
+                *reinterpret_cast<intptr_t *>(out + i * out_stride) = perm[i];
+            }
+        }
+    }
+
+    struct searchsorted_run_extra {
+        const char *sorted_metadata, *sorted_data;
+        intptr_t sorted_stride, sorted_count;
+        searchsorted_side_t side;
+    };
+
+    static void searchsorted_run(const ndt::type& dtp, const char *dmeta,
+                    char *data, intptr_t stride, intptr_t count,
+                    char *out, intptr_t out_stride, void *extra,
+                    const eval::eval_context *ectx)
+    {
+        const searchsorted_run_extra *e = reinterpret_cast<const searchsorted_run_extra *>(extra);
+        if (count <= 1 || out_stride == (intptr_t)sizeof(intptr_t)) {
+            strided_searchsorted(dtp, e->sorted_metadata, e->sorted_data,
+                            e->sorted_stride, e->sorted_count,
+                            dmeta, data, stride, count, e->side,
+                            reinterpret_cast<intptr_t *>(out), ectx);
+        } else {
+            vector<intptr_t> idx(count);
+            strided_searchsorted(dtp, e->sorted_metadata, e->sorted_data,
+                            e->sorted_stride, e->sorted_count,
+                            dmeta, data, stride, count, e->side, &idx[0], ectx);
+            for (intptr_t i = 0; i < count; ++i) {
+                *reinterpret_cast<intptr_t *>(out + i * out_stride) = idx[i];
+            }
+        }
+    }
+
+    /**
+     * Walks all the one-dimensional runs along `axis` of the
+     * type/metadata/data, calling `fn` on each.
+     */
+    static void foreach_axis_run(const ndt::type& tp, const char *metadata, char *data,
+                    intptr_t axis, char *out, const intptr_t *out_strides,
+                    axis_run_fn_t fn, void *extra, const eval::eval_context *ectx)
+    {
+        if (tp.is_builtin() || !tp.extended()->is_strided()) {
+            stringstream ss;
+            ss << "cannot sort along a dimension of dynd type " << tp;
+            throw runtime_error(ss.str());
+        }
+        ndt::type el_tp;
+        const char *el_origin = NULL;
+        intptr_t stride = 0, dim_size = 0;
+        tp.extended()->process_strided(metadata, data, el_tp, el_origin, stride, dim_size);
+        char *el_metadata = const_cast<char *>(metadata);
+        tp.get_type_at_dimension(&el_metadata, 1);
+
+        if (axis > 0) {
+            for (intptr_t i = 0; i < dim_size; ++i) {
+                foreach_axis_run(el_tp, el_metadata,
+                                const_cast<char *>(el_origin) + i * stride,
+                                axis - 1, out ? out + i * out_strides[0] : NULL,
+                                out_strides + 1, fn, extra, ectx);
+            }
+            return;
+        }
+
+        // The dimensions after the axis must have a single layout, so
+        // every run along the axis can be processed with the same stride
+        intptr_t inner_ndim = el_tp.get_ndim();
+        dimvector inner_shape(inner_ndim), inner_strides(inner_ndim);
+        const char *dmeta = el_metadata;
+        ndt::type dtp = el_tp;
+        if (inner_ndim > 0) {
+            el_tp.extended()->get_shape(inner_ndim, 0, inner_shape.get(), el_metadata, NULL);
+            el_tp.extended()->get_strides(0, inner_strides.get(), el_metadata);
+            for (intptr_t i = 0; i < inner_ndim; ++i) {
+                if (inner_shape[i] < 0) {
+                    stringstream ss;
+                    ss << "cannot sort along axis of dynd array with type " << tp
+                       << ", the dimensions after the axis must be strided";
+                    throw runtime_error(ss.str());
+                }
+            }
+            char *m = el_metadata;
+            dtp = el_tp.get_type_at_dimension(&m, inner_ndim);
+            dmeta = m;
+        }
+
+        intptr_t out_stride = out ? out_strides[0] : 0;
+        dimvector idx(inner_ndim);
+        for (intptr_t i = 0; i < inner_ndim; ++i) {
+            if (inner_shape[i] == 0) {
+                return;
+            }
+            idx[i] = 0;
+        }
+        // Odometer iteration over the dimensions after the axis
+        for (;;) {
+            intptr_t offset = 0, out_offset = 0;
+            for (intptr_t i = 0; i < inner_ndim; ++i) {
+                offset += idx[i] * inner_strides[i];
+                if (out) {
+                    out_offset += idx[i] * out_strides[i + 1];
+                }
+            }
+            fn(dtp, dmeta, const_cast<char *>(el_origin) + offset, stride, dim_size,
+                            out ? out + out_offset : NULL, out_stride, extra, ectx);
+            intptr_t i = inner_ndim - 1;
+            for (; i >= 0; --i) {
+                if (++idx[i] < inner_shape[i]) {
+                    break;
+                }
+                idx[i] = 0;
+            }
+            if (i < 0) {
+                break;
+            }
+        }
+    }
+
+    static intptr_t normalize_axis(const nd::array& a, intptr_t axis)
+    {
+        intptr_t ndim = a.get_ndim();
+        if (axis < 0) {
+            axis += ndim;
+        }
+        if (axis < 0 || axis >= ndim) {
+            stringstream ss;
+            ss << "axis is out of bounds for sorting dynd array with type " << a.get_type();
+            throw runtime_error(ss.str());
+        }
+        return axis;
+    }
+} // anonymous namespace
+
+nd::array nd::sort(const nd::array& a, intptr_t axis, const eval::eval_context *ectx)
+{
+    normalize_axis(a, axis);
+    array result = a.eval_copy(readwrite_access_flags, ectx);
+    sort_inplace(result, axis, ectx);
+    return result;
+}
+
+void nd::sort_inplace(const nd::array& a, intptr_t axis, const eval::eval_context *ectx)
+{
+    axis = normalize_axis(a, axis);
+    if ((a.get_access_flags() & write_access_flag) == 0) {
+        throw runtime_error("tried to sort a dynd array which is not writable");
+    }
+    if (a.get_type().is_expression()) {
+        stringstream ss;
+        ss << "cannot sort dynd array with expression type " << a.get_type() << " in place";
+        throw runtime_error(ss.str());
+    }
+    foreach_axis_run(a.get_type(), a.get_ndo_meta(), a.get_readwrite_originptr(),
+                    axis, NULL, NULL, &sort_run, NULL, ectx);
+}
+
+nd::array nd::argsort(const nd::array& a, intptr_t axis, const eval::eval_context *ectx)
+{
+    axis = normalize_axis(a, axis);
+    array a_eval = a.eval(ectx);
+    intptr_t ndim = a_eval.get_ndim();
+    dimvector shape(ndim);
+    a_eval.get_shape(shape.get());
+    for (intptr_t i = 0; i < ndim; ++i) {
+        if (shape[i] < 0) {
+            stringstream ss;
+            ss << "argsort requires a dynd array with strided dimensions, not " << a.get_type();
+            throw runtime_error(ss.str());
+        }
+    }
+    array result = make_strided_array(ndt::make_type<intptr_t>(), ndim, shape.get(),
+                    read_access_flag|write_access_flag, NULL);
+    dimvector out_strides(ndim);
+    result.get_strides(out_strides.get());
+    foreach_axis_run(a_eval.get_type(), a_eval.get_ndo_meta(),
+                    const_cast<char *>(a_eval.get_readonly_originptr()),
+                    axis, result.get_readwrite_originptr(), out_strides.get(),
+                    &argsort_run, NULL, ectx);
+    return result;
+}
+
+nd::array nd::searchsorted(const nd::array& sorted, const nd::array& needles,
+                searchsorted_side_t side, const eval::eval_context *ectx)
+{
+    if (sorted.get_ndim() != 1) {
+        stringstream ss;
+        ss << "searchsorted requires a one-dimensional sorted dynd array, not " << sorted.get_type();
+        throw runtime_error(ss.str());
+    }
+    array sorted_eval = sorted.eval(ectx);
+    const ndt::type& sorted_tp = sorted_eval.get_type();
+    ndt::type el_tp;
+    const char *sorted_data = NULL;
+    intptr_t sorted_stride = 0, sorted_count = 0;
+    sorted_tp.extended()->process_strided(sorted_eval.get_ndo_meta(),
+                    sorted_eval.get_readonly_originptr(),
+                    el_tp, sorted_data, sorted_stride, sorted_count);
+    char *el_metadata = const_cast<char *>(sorted_eval.get_ndo_meta());
+    sorted_tp.get_type_at_dimension(&el_metadata, 1);
+
+    // The needles are converted to the element type of the sorted array,
+    // so the builtin fast paths and comparison kernels see matching types
+    intptr_t ndim = needles.get_ndim();
+    array n = needles;
+    if (n.get_dtype() != el_tp) {
+        n = n.ucast(el_tp);
+    }
+    n = n.eval(ectx);
+    dimvector shape(ndim);
+    n.get_shape(shape.get());
+    for (intptr_t i = 0; i < ndim; ++i) {
+        if (shape[i] < 0) {
+            stringstream ss;
+            ss << "searchsorted requires needles with strided dimensions, not " << needles.get_type();
+            throw runtime_error(ss.str());
+        }
+    }
+
+    array result = make_strided_array(ndt::make_type<intptr_t>(), ndim, shape.get(),
+                    read_access_flag|write_access_flag, NULL);
+    searchsorted_run_extra e;
+    e.sorted_metadata = el_metadata;
+    e.sorted_data = sorted_data;
+    e.sorted_stride = sorted_stride;
+    e.sorted_count = sorted_count;
+    e.side = side;
+    if (ndim == 0) {
+        searchsorted_run(n.get_type(), n.get_ndo_meta(),
+                        const_cast<char *>(n.get_readonly_originptr()), 0, 1,
+                        result.get_readwrite_originptr(), 0, &e, ectx);
+    } else {
+        dimvector out_strides(ndim);
+        result.get_strides(out_strides.get());
+        foreach_axis_run(n.get_type(), n.get_ndo_meta(),
+                        const_cast<char *>(n.get_readonly_originptr()),
+                        ndim - 1, result.get_readwrite_originptr(), out_strides.get(),
+                        &searchsorted_run, &e, ectx);
+    }
+    return result;
+}
@@ -13,6 +13,7 @@
 #include <dynd/typed_data_assign.hpp>
 #include <dynd/types/convert_type.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/kernels/ckernel_cache.hpp>
 #include <dynd/diagnostics.hpp>
 
 using namespace std;
@@ -174,8 +175,7 @@ void dynd::typed_data_copy(const ndt::type& tp,
     if (tp.is_pod()) {
         memcpy(dst_data, src_data, data_size);
     } else {
-        assignment_ckernel_builder k;
-        make_assignment_kernel(&k, 0, tp, dst_metadata,
+        cached_assignment_ckernel k(tp, dst_metadata,
                         tp, src_metadata,
                         kernel_request_single,
                         assign_error_none, &eval::default_eval_context);
@@ -206,8 +206,7 @@ void dynd::typed_data_assign(const ndt::type& dst_tp, const char *dst_metadata,
         }
     }
 
-    assignment_ckernel_builder k;
-    make_assignment_kernel(&k, 0, dst_tp, dst_metadata,
+    cached_assignment_ckernel k(dst_tp, dst_metadata,
                     src_tp, src_metadata,
                     kernel_request_single,
                     errmode, ectx);
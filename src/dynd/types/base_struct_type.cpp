@@ -192,8 +192,9 @@ void base_struct_type::data_destruct_strided(const char *metadata, char *data,
     size_t field_count = get_field_count();
     // Destruct all the fields a chunk at a time, in an
     // attempt to have some kind of locality
+    size_t max_chunk_size = get_buffer_element_count(stride >= 0 ? stride : -stride, NULL);
     while (count > 0) {
-        size_t chunk_size = min(count, DYND_BUFFER_CHUNK_SIZE);
+        size_t chunk_size = min(count, max_chunk_size);
         for (size_t i = 0; i != field_count; ++i) {
             const ndt::type& dt = field_types[i];
             if (dt.get_flags()&type_flag_destructor) {
@@ -262,6 +262,16 @@ size_t base_type::make_comparison_kernel(
     throw std::runtime_error(ss.str());
 }
 
+size_t base_type::make_hash_kernel(
+                ckernel_builder *DYND_UNUSED(out), size_t DYND_UNUSED(offset_out),
+                const char *DYND_UNUSED(metadata),
+                const eval::eval_context *DYND_UNUSED(ectx)) const
+{
+    stringstream ss;
+    ss << "make_hash_kernel has not been implemented for " << ndt::type(this, true);
+    throw std::runtime_error(ss.str());
+}
+
 void base_type::foreach_leading(char *DYND_UNUSED(data), const char *DYND_UNUSED(metadata),
                 foreach_fn_t DYND_UNUSED(callback), void *DYND_UNUSED(callback_data)) const
 {
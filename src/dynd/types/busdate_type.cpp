@@ -4,11 +4,17 @@
 //
 
 #include <algorithm>
+#include <vector>
 
 #include <dynd/types/busdate_type.hpp>
 #include <dynd/types/date_type.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+#include <dynd/types/expr_type.hpp>
+#include <dynd/types/unary_expr_type.hpp>
 #include <dynd/kernels/string_assignment_kernels.hpp>
+#include <dynd/kernels/busdate_kernels.hpp>
 #include <dynd/exceptions.hpp>
+#include <dynd/shape_tools.hpp>
 
 #include <datetime_strings.h>
 
@@ -18,15 +24,47 @@ using namespace dynd;
 dynd::busdate_type::busdate_type(busdate_roll_t roll, const bool *weekmask, const nd::array& holidays)
     : base_type(busdate_type_id, datetime_kind, 4, 4, type_flag_scalar, 0, 0), m_roll(roll)
 {
-    memcpy(m_workweek, weekmask, sizeof(m_workweek));
+    if (weekmask != NULL) {
+        memcpy(m_workweek, weekmask, sizeof(m_workweek));
+    } else {
+        // Monday through Friday
+        for (int i = 0; i < 7; ++i) {
+            m_workweek[i] = (i < 5);
+        }
+    }
     m_busdays_in_weekmask = 0;
     for (int i = 0; i < 7; ++i) {
-        m_busdays_in_weekmask += weekmask[i] ? 1 : 0;
+        m_busdays_in_weekmask += m_workweek[i] ? 1 : 0;
+    }
+    if (m_busdays_in_weekmask == 0) {
+        throw runtime_error("a busdate weekmask must have at least one business day");
     }
     if (!holidays.is_empty()) {
-        nd::array hol = holidays.ucast(ndt::make_date()).eval_immutable();
-        // TODO: Make sure hol is contiguous and one-dimensional
-        m_holidays = hol;
+        nd::array hol = holidays.ucast(ndt::make_date()).eval();
+        if (hol.get_ndim() != 1) {
+            stringstream ss;
+            ss << "busdate holidays must be one-dimensional, not " << hol.get_type();
+            throw runtime_error(ss.str());
+        }
+        // Sorted, without NA, duplicates, or days which aren't in the weekmask,
+        // so the kernels can binary search them and count them in a range
+        intptr_t count = hol.get_dim_size();
+        nd::array contig = nd::empty(count, ndt::make_strided_dim(ndt::make_date()));
+        contig.vals() = hol;
+        const int32_t *contig_data = reinterpret_cast<const int32_t *>(contig.get_readonly_originptr());
+        vector<int32_t> days(contig_data, contig_data + count);
+        vector<int32_t>::iterator it = days.begin();
+        for (vector<int32_t>::const_iterator i = days.begin(); i != days.end(); ++i) {
+            if (*i != DYND_DATE_NA && m_workweek[date_ymd::days_to_weekday(*i)]) {
+                *it++ = *i;
+            }
+        }
+        days.erase(it, days.end());
+        sort(days.begin(), days.end());
+        days.erase(unique(days.begin(), days.end()), days.end());
+        if (!days.empty()) {
+            m_holidays = nd::array(days).view_scalars(ndt::make_date()).eval_immutable();
+        }
     }
 }
 
@@ -45,9 +83,18 @@ void dynd::busdate_type::print_workweek(std::ostream& o) const
     if (m_workweek[6]) o << "Su";
 }
 
-void dynd::busdate_type::print_holidays(std::ostream& /*o*/) const
+void dynd::busdate_type::print_holidays(std::ostream& o) const
 {
-    throw std::runtime_error("busdate_type::print_holidays to be implemented");
+    const int32_t *days = get_holiday_days();
+    for (intptr_t i = 0, i_end = get_holiday_count(); i != i_end; ++i) {
+        char buf[13];
+        if (i != 0) {
+            o << ", ";
+        }
+        o << "'";
+        o.write(buf, date_ymd::days_to_str(days[i], buf));
+        o << "'";
+    }
 }
 
 void dynd::busdate_type::print_data(std::ostream& o, const char *DYND_UNUSED(metadata), const char *data) const
@@ -119,3 +166,70 @@ bool dynd::busdate_type::operator==(const base_type& rhs) const
                 m_holidays.equals_exact(dt->m_holidays);
     }
 }
+
+/**
+ * Casts the operands of a busday function to the types its kernels take,
+ * evaluating any which become expressions so they can be combined.
+ */
+static nd::array as_busday_operand(const nd::array& op, const ndt::type& tp)
+{
+    nd::array result = op.ucast(tp);
+    if (result.get_dtype().get_kind() == expression_kind) {
+        result = result.eval();
+    }
+    return result;
+}
+
+/**
+ * Makes a deferred expression array applying a two operand busday
+ * kernel generator, broadcasting the operands together.
+ */
+static nd::array make_binary_busday_expr(const nd::array *ops, const ndt::type& result_tp,
+                const expr_kernel_generator *kgen)
+{
+    // Get the broadcasted shape
+    size_t ndim = max(ops[0].get_ndim(), ops[1].get_ndim());
+    dimvector result_shape(ndim), tmp_shape(ndim);
+    for (size_t j = 0; j != ndim; ++j) {
+        result_shape[j] = 1;
+    }
+    for (size_t i = 0; i != 2; ++i) {
+        size_t ndim_i = ops[i].get_ndim();
+        if (ndim_i > 0) {
+            ops[i].get_shape(tmp_shape.get());
+            incremental_broadcast(ndim, result_shape.get(), ndim_i, tmp_shape.get());
+        }
+    }
+
+    string field_names[2] = {"arg0", "arg1"};
+    nd::array result = combine_into_struct(2, field_names, ops);
+    // Because the expr type's operand is the result's type,
+    // we can swap it in as the type
+    ndt::type edt = ndt::make_expr(ndt::make_type(ndim, result_shape.get(), result_tp),
+                    result.get_type(), kgen);
+    edt.swap(result.get_ndo()->m_type);
+    return result;
+}
+
+nd::array nd::busday_offset(const nd::array& dates, const nd::array& offsets,
+                const ndt::type& busdate_tp)
+{
+    nd::array ops[2] = {as_busday_operand(dates, ndt::make_date()),
+                    as_busday_operand(offsets, ndt::make_type<int32_t>())};
+    return make_binary_busday_expr(ops, ndt::make_date(), make_busday_offset_kernelgen(busdate_tp));
+}
+
+nd::array nd::busday_count(const nd::array& begin_dates, const nd::array& end_dates,
+                const ndt::type& busdate_tp)
+{
+    nd::array ops[2] = {as_busday_operand(begin_dates, ndt::make_date()),
+                    as_busday_operand(end_dates, ndt::make_date())};
+    return make_binary_busday_expr(ops, ndt::make_type<int32_t>(), make_busday_count_kernelgen(busdate_tp));
+}
+
+nd::array nd::is_busday(const nd::array& dates, const ndt::type& busdate_tp)
+{
+    nd::array n = dates.ucast(ndt::make_date());
+    return n.replace_dtype(ndt::make_unary_expr(ndt::make_type<dynd_bool>(), n.get_dtype(),
+                    make_is_busday_kernelgen(busdate_tp)));
+}
@@ -123,3 +123,27 @@ size_t byteswap_type::make_value_to_operand_assignment_kernel(
                         kernreq);
     }
 }
+
+size_t byteswap_type::make_assignment_kernel(
+                ckernel_builder *out, size_t offset_out,
+                const ndt::type& dst_tp, const char *dst_metadata,
+                const ndt::type& src_tp, const char *src_metadata,
+                kernel_request_t kernreq, assign_error_mode errmode,
+                const eval::eval_context *ectx) const
+{
+    // Reading byteswapped data into a built-in type without error checks
+    // can swap and convert in one pass instead of through a buffer. This
+    // requires the operand to be aligned, i.e. not a view.
+    if (src_tp.extended() == this && dst_tp.is_builtin() &&
+                    m_operand_type.get_kind() != expression_kind &&
+                    has_byteswap_convert_assignment_kernel(dst_tp.get_type_id(),
+                                    m_value_type.get_type_id()) &&
+                    (errmode == assign_error_none ||
+                     ::dynd::is_lossless_assignment(dst_tp, m_value_type))) {
+        return make_byteswap_convert_assignment_kernel(out, offset_out,
+                        dst_tp.get_type_id(), m_value_type.get_type_id(), kernreq);
+    }
+    return base_expression_type::make_assignment_kernel(out, offset_out,
+                    dst_tp, dst_metadata, src_tp, src_metadata,
+                    kernreq, errmode, ectx);
+}
@@ -14,26 +14,13 @@
 #include <dynd/types/strided_dim_type.hpp>
 #include <dynd/types/convert_type.hpp>
 #include <dynd/gfunc/make_callable.hpp>
+#include <dynd/sort.hpp>
 
 using namespace dynd;
 using namespace std;
 
 namespace {
 
-    class sorter {
-        const char *m_originptr;
-        intptr_t m_stride;
-        const binary_single_predicate_t m_less;
-        ckernel_prefix *m_extra;
-    public:
-        sorter(const char *originptr, intptr_t stride,
-                        const binary_single_predicate_t less, ckernel_prefix *extra) :
-            m_originptr(originptr), m_stride(stride), m_less(less), m_extra(extra) {}
-        bool operator()(intptr_t i, intptr_t j) const {
-            return m_less(m_originptr + i * m_stride, m_originptr + j * m_stride, m_extra) != 0;
-        }
-    };
-
     class cmp {
         const binary_single_predicate_t m_less;
         ckernel_prefix *m_extra;
@@ -256,9 +243,11 @@ categorical_type::categorical_type(const nd::array& categories, bool presorted)
         }
         // TODO: Putting everything in a set already caused a sort operation to occur,
         //       there's no reason we should need a second sort.
-        std::sort(m_category_index_to_value.begin(), m_category_index_to_value.end(),
-                        sorter(categories.get_readonly_originptr(), categories_stride,
-                            k.get_function(), k.get()));
+        if (category_count > 0) {
+            strided_argsort(m_category_tp, categories_element_metadata,
+                            categories.get_readonly_originptr(), categories_stride,
+                            category_count, &m_category_index_to_value[0]);
+        }
 
         // invert the m_category_index_to_value permutation
         for (uint32_t i = 0; i < m_category_index_to_value.size(); ++i) {
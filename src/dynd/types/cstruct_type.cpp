@@ -5,6 +5,7 @@
 
 #include <dynd/types/cstruct_type.hpp>
 #include <dynd/types/struct_type.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/types/type_alignment.hpp>
 #include <dynd/types/property_type.hpp>
 #include <dynd/shape_tools.hpp>
@@ -13,6 +14,7 @@
 #include <dynd/kernels/assignment_kernels.hpp>
 #include <dynd/kernels/struct_assignment_kernels.hpp>
 #include <dynd/kernels/struct_comparison_kernels.hpp>
+#include <dynd/kernels/hash_kernels.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -337,6 +339,11 @@ size_t cstruct_type::make_assignment_kernel(
                             dst_tp, dst_metadata,
                             src_tp, src_metadata,
                             kernreq, errmode, ectx);
+        } else if (is_columnar_struct_assignment(dst_tp, src_tp)) {
+            return make_columnar_struct_assignment_kernel(out_ckb, ckb_offset,
+                            dst_tp, dst_metadata,
+                            src_tp, src_metadata,
+                            kernreq, errmode, ectx);
         } else if (src_tp.is_builtin()) {
             return make_broadcast_to_struct_assignment_kernel(out_ckb, ckb_offset,
                             dst_tp, dst_metadata,
@@ -378,6 +385,15 @@ size_t cstruct_type::make_comparison_kernel(
     throw not_comparable_error(src0_tp, src1_tp, comptype);
 }
 
+size_t cstruct_type::make_hash_kernel(
+                ckernel_builder *out, size_t offset_out,
+                const char *metadata,
+                const eval::eval_context *ectx) const
+{
+    return make_struct_hash_kernel(out, offset_out,
+                    ndt::type(this, true), metadata, ectx);
+}
+
 bool cstruct_type::operator==(const base_type& rhs) const
 {
     if (this == &rhs) {
@@ -588,3 +604,21 @@ void cstruct_type::get_dynamic_array_properties(const std::pair<std::string, gfu
     *out_properties = m_array_properties.empty() ? NULL : &m_array_properties[0];
     *out_count = (int)m_array_properties.size();
 }
+
+ndt::type ndt::make_columnar_cstruct(intptr_t dim_size, const ndt::type& struct_tp)
+{
+    if (struct_tp.get_kind() != struct_kind) {
+        stringstream ss;
+        ss << "make_columnar_cstruct: provided type " << struct_tp << " is not of struct kind";
+        throw runtime_error(ss.str());
+    }
+    const base_struct_type *sd = static_cast<const base_struct_type *>(struct_tp.extended());
+    size_t field_count = sd->get_field_count();
+    const ndt::type *field_types = sd->get_field_types();
+    vector<ndt::type> column_types(field_count);
+    for (size_t i = 0; i != field_count; ++i) {
+        column_types[i] = ndt::make_fixed_dim(dim_size, field_types[i]);
+    }
+    return ndt::make_cstruct(field_count, field_count ? &column_types[0] : NULL,
+                    sd->get_field_names());
+}
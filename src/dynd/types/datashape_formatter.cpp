@@ -8,6 +8,7 @@
 #include <dynd/types/strided_dim_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/types/var_dim_type.hpp>
+#include <dynd/types/offset_dim_type.hpp>
 #include <dynd/types/string_type.hpp>
 #include <dynd/types/fixedstring_type.hpp>
 
@@ -125,6 +126,26 @@ static void format_uniform_dim_datashape(std::ostream& o,
                             indent, multiline, identifier);
             break;
         }
+        case offset_dim_type_id: {
+            // Datashape has no offset dimension, so it is formatted as var
+            const offset_dim_type *odt = static_cast<const offset_dim_type *>(dt.extended());
+            const char *child_data = NULL;
+            if (data == NULL || metadata == NULL) {
+                o << "var * ";
+            } else {
+                const int64_t *d = reinterpret_cast<const int64_t *>(data);
+                o << (d[1] - d[0]) << " * ";
+                if (d[1] - d[0] == 1) {
+                    const offset_dim_type_metadata *md = reinterpret_cast<const offset_dim_type_metadata *>(metadata);
+                    child_data = md->values + d[0] * md->stride;
+                }
+            }
+            format_datashape(o, odt->get_element_type(),
+                            metadata ? (metadata + sizeof(offset_dim_type_metadata)) : NULL,
+                            child_data,
+                            indent, multiline, identifier);
+            break;
+        }
         default: {
             stringstream ss;
             ss << "Datashape formatting for dynd type " << dt << " is not yet implemented";
@@ -3,8 +3,15 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <list>
 #include <map>
-#include <set>
+
+#ifdef _WIN32
+# define NOMINMAX
+# include <Windows.h>
+#else
+# include <pthread.h>
+#endif
 
 #include <dynd/types/datashape_parser.hpp>
 #include <dynd/types/strided_dim_type.hpp>
@@ -27,6 +34,7 @@
 #include <dynd/types/byteswap_type.hpp>
 #include <dynd/types/cuda_host_type.hpp>
 #include <dynd/types/cuda_device_type.hpp>
+#include <dynd/kernels/hash_kernels.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -55,62 +63,177 @@ namespace {
 
 static ndt::type parse_rhs_expression(const char *&begin, const char *end, map<string, ndt::type>& symtable);
 
-static const map<string, ndt::type>& get_builtin_types()
-{
-    static map<string, ndt::type> builtin_types;
-    if (builtin_types.empty()) {
-        builtin_types["void"] = ndt::make_type<void>();
-        builtin_types["bool"] = ndt::make_type<dynd_bool>();
-        builtin_types["int8"] = ndt::make_type<int8_t>();
-        builtin_types["int16"] = ndt::make_type<int16_t>();
-        builtin_types["int32"] = ndt::make_type<int32_t>();
-        builtin_types["int64"] = ndt::make_type<int64_t>();
-        builtin_types["int128"] = ndt::make_type<dynd_int128>();
-        builtin_types["intptr"] = ndt::make_type<intptr_t>();
-        builtin_types["uint8"] = ndt::make_type<uint8_t>();
-        builtin_types["uint16"] = ndt::make_type<uint16_t>();
-        builtin_types["uint32"] = ndt::make_type<uint32_t>();
-        builtin_types["uint64"] = ndt::make_type<uint64_t>();
-        builtin_types["uint128"] = ndt::make_type<dynd_uint128>();
-        builtin_types["uintptr"] = ndt::make_type<uintptr_t>();
-        builtin_types["float16"] = ndt::make_type<dynd_float16>();
-        builtin_types["float32"] = ndt::make_type<float>();
-        builtin_types["float64"] = ndt::make_type<double>();
-        builtin_types["float128"] = ndt::make_type<dynd_float128>();
-        builtin_types["complex64"] = ndt::make_type<dynd_complex<float> >();
-        builtin_types["complex128"] = ndt::make_type<dynd_complex<double> >();
-        builtin_types["json"] = ndt::make_json();
-        builtin_types["date"] = ndt::make_date();
-        builtin_types["time"] = ndt::make_time(tz_abstract);
-        builtin_types["datetime"] = ndt::make_datetime(tz_abstract);
-        builtin_types["bytes"] = ndt::make_bytes(1);
-        builtin_types["type"] = ndt::make_type();
-        builtin_types["ckernel_deferred"] = ndt::make_ckernel_deferred();
-    }
-    return builtin_types;
-}
-static const set<string>& get_reserved_typenames()
+namespace {
+    /** A NAME or NUMBER token, pointing into the datashape string */
+    struct token_range {
+        const char *begin, *end;
+
+        token_range()
+            : begin(NULL), end(NULL)
+        {
+        }
+
+        token_range(const char *b, const char *e)
+            : begin(b), end(e)
+        {
+        }
+
+        inline bool empty() const {
+            return begin == end;
+        }
+
+        inline bool is_number() const {
+            return begin != end && '0' <= *begin && *begin <= '9';
+        }
+
+        template <int N>
+        inline bool operator==(const char (&s)[N]) const {
+            return end - begin == N - 1 && memcmp(begin, s, N - 1) == 0;
+        }
+
+        inline string str() const {
+            return string(begin, end);
+        }
+
+        /** The value of a NUMBER token */
+        inline intptr_t to_int() const {
+            intptr_t result = 0;
+            for (const char *p = begin; p != end; ++p) {
+                result = result * 10 + (*p - '0');
+            }
+            return result;
+        }
+    };
+
+    enum keyword_t {
+        keyword_none,
+        // A builtin type which takes no parameters
+        keyword_builtin,
+        keyword_var,
+        keyword_string,
+        keyword_char,
+        keyword_complex,
+        keyword_datetime,
+        keyword_time,
+        keyword_unaligned,
+        keyword_pointer,
+        keyword_byteswap,
+        keyword_bytes,
+        keyword_cuda_host,
+        keyword_cuda_device
+    };
+
+    /**
+     * A perfect hash table of the datashape keywords, so recognizing a
+     * name is one hash and one comparison instead of a chain of string
+     * comparisons and map lookups. The hash multiplier is chosen so the
+     * keywords all land in different slots, which the constructor checks.
+     */
+    class keyword_table {
+        struct entry {
+            const char *name;
+            size_t name_size;
+            keyword_t kw;
+            // The type the name stands for by itself, if it is a builtin
+            // type name which can't be redefined by a type statement
+            ndt::type tp;
+        };
+
+        enum { slot_count = 128, hash_multiplier = 557 };
+        entry m_slots[slot_count];
+
+        static inline uint32_t hash(const char *begin, const char *end) {
+            uint32_t h = 0;
+            for (; begin != end; ++begin) {
+                h = h * hash_multiplier + static_cast<unsigned char>(*begin);
+            }
+            return (h ^ (h >> 16)) & (slot_count - 1);
+        }
+
+        void add(const char *name, keyword_t kw, const ndt::type& tp = ndt::type()) {
+            size_t name_size = strlen(name);
+            entry& e = m_slots[hash(name, name + name_size)];
+            if (e.name != NULL) {
+                stringstream ss;
+                ss << "datashape keywords \"" << e.name << "\" and \"" << name << "\" have the same hash";
+                throw runtime_error(ss.str());
+            }
+            e.name = name;
+            e.name_size = name_size;
+            e.kw = kw;
+            e.tp = tp;
+        }
+
+    public:
+        keyword_table() {
+            for (int i = 0; i < slot_count; ++i) {
+                m_slots[i].name = NULL;
+                m_slots[i].name_size = 0;
+                m_slots[i].kw = keyword_none;
+            }
+            add("void", keyword_builtin, ndt::make_type<void>());
+            add("bool", keyword_builtin, ndt::make_type<dynd_bool>());
+            add("int8", keyword_builtin, ndt::make_type<int8_t>());
+            add("int16", keyword_builtin, ndt::make_type<int16_t>());
+            add("int32", keyword_builtin, ndt::make_type<int32_t>());
+            add("int64", keyword_builtin, ndt::make_type<int64_t>());
+            add("int128", keyword_builtin, ndt::make_type<dynd_int128>());
+            add("intptr", keyword_builtin, ndt::make_type<intptr_t>());
+            add("uint8", keyword_builtin, ndt::make_type<uint8_t>());
+            add("uint16", keyword_builtin, ndt::make_type<uint16_t>());
+            add("uint32", keyword_builtin, ndt::make_type<uint32_t>());
+            add("uint64", keyword_builtin, ndt::make_type<uint64_t>());
+            add("uint128", keyword_builtin, ndt::make_type<dynd_uint128>());
+            add("uintptr", keyword_builtin, ndt::make_type<uintptr_t>());
+            add("float16", keyword_builtin, ndt::make_type<dynd_float16>());
+            add("float32", keyword_builtin, ndt::make_type<float>());
+            add("float64", keyword_builtin, ndt::make_type<double>());
+            add("float128", keyword_builtin, ndt::make_type<dynd_float128>());
+            add("complex64", keyword_builtin, ndt::make_type<dynd_complex<float> >());
+            add("complex128", keyword_builtin, ndt::make_type<dynd_complex<double> >());
+            add("json", keyword_builtin, ndt::make_json());
+            add("date", keyword_builtin, ndt::make_date());
+            add("type", keyword_builtin, ndt::make_type());
+            add("ckernel_deferred", keyword_builtin, ndt::make_ckernel_deferred());
+            add("time", keyword_time, ndt::make_time(tz_abstract));
+            add("datetime", keyword_datetime, ndt::make_datetime(tz_abstract));
+            add("bytes", keyword_bytes, ndt::make_bytes(1));
+            add("var", keyword_var);
+            add("string", keyword_string);
+            add("char", keyword_char);
+            add("complex", keyword_complex);
+            add("unaligned", keyword_unaligned);
+            add("pointer", keyword_pointer);
+            add("byteswap", keyword_byteswap);
+            add("cuda_host", keyword_cuda_host);
+            add("cuda_device", keyword_cuda_device);
+        }
+
+        /** Looks up a name, returning keyword_none if it isn't a keyword */
+        inline keyword_t find(const token_range& name, const ndt::type **out_tp = NULL) const {
+            const entry& e = m_slots[hash(name.begin, name.end)];
+            if (e.name != NULL && e.name_size == (size_t)(name.end - name.begin) &&
+                            memcmp(e.name, name.begin, e.name_size) == 0) {
+                if (out_tp != NULL) {
+                    *out_tp = &e.tp;
+                }
+                return e.kw;
+            }
+            return keyword_none;
+        }
+
+        /** Whether the name is a builtin type, which can't be redefined */
+        inline bool is_builtin_type(const token_range& name) const {
+            const ndt::type *tp = NULL;
+            return find(name, &tp) != keyword_none && tp->get_type_id() != uninitialized_type_id;
+        }
+    };
+} // anonymous namespace
+
+static const keyword_table& get_keyword_table()
 {
-    static set<string> reserved_typenames;
-    if (reserved_typenames.empty()) {
-        const map<string, ndt::type>& builtin_types = get_builtin_types();
-        for (map<string, ndt::type>::const_iterator i = builtin_types.begin();
-                        i != builtin_types.end(); ++i) {
-            reserved_typenames.insert(i->first);
-        }
-        reserved_typenames.insert("string");
-        reserved_typenames.insert("char");
-        reserved_typenames.insert("time");
-        reserved_typenames.insert("datetime");
-        reserved_typenames.insert("unaligned");
-        reserved_typenames.insert("pointer");
-        reserved_typenames.insert("complex");
-        reserved_typenames.insert("bytes");
-        reserved_typenames.insert("byteswap");
-		reserved_typenames.insert("cuda_host");
-		reserved_typenames.insert("cuda_device");
-    }
-    return reserved_typenames;
+    static keyword_table keywords;
+    return keywords;
 }
 
 static const char *skip_whitespace(const char *begin, const char *end)
@@ -156,19 +279,19 @@ static bool parse_token(const char *&begin, const char *end, char token)
 }
 
 // NAME : [a-zA-Z_][a-zA-Z0-9_]*
-static string parse_name(const char *&begin, const char *end)
+static token_range parse_name(const char *&begin, const char *end)
 {
     const char *begin_skipws, *pos;
     begin_skipws = pos = skip_whitespace(begin, end);
     if (pos == end) {
-        return "";
+        return token_range();
     }
     if (('a' <= *pos && *pos <= 'z') ||
                     ('A' <= *pos && *pos <= 'Z') ||
                     *pos == '_') {
         ++pos;
     } else {
-        return "";
+        return token_range();
     }
     while (pos < end && (('a' <= *pos && *pos <= 'z') ||
                     ('A' <= *pos && *pos <= 'Z') ||
@@ -177,10 +300,10 @@ static string parse_name(const char *&begin, const char *end)
         ++pos;
     }
     begin = pos;
-    return string(begin_skipws, pos);
+    return token_range(begin_skipws, pos);
 }
 
-static string parse_number(const char *&begin, const char *end)
+static token_range parse_number(const char *&begin, const char *end)
 {
     const char *begin_skipws = skip_whitespace(begin, end);
     const char *pos = begin_skipws;
@@ -189,16 +312,16 @@ static string parse_number(const char *&begin, const char *end)
     }
     if (pos > begin_skipws) {
         begin = pos;
-        return string(begin_skipws, pos);
+        return token_range(begin_skipws, pos);
     } else {
-        return string();
+        return token_range();
     }
 }
 
-static string parse_name_or_number(const char *&begin, const char *end)
+static token_range parse_name_or_number(const char *&begin, const char *end)
 {
     // NAME
-    string result = parse_name(begin, end);
+    token_range result = parse_name(begin, end);
     if (result.empty()) {
         // NUMBER
         return parse_number(begin, end);
@@ -313,12 +436,12 @@ static ndt::type parse_string_parameters(const char *&begin, const char *end)
 {
     if (parse_token(begin, end, '[')) {
         const char *saved_begin = begin;
-        string value = parse_number(begin, end);
+        token_range value = parse_number(begin, end);
         string encoding_str;
         string_encoding_t encoding = string_encoding_utf_8;
         int string_size = 0;
         if (!value.empty()) {
-            string_size = atoi(value.c_str());
+            string_size = static_cast<int>(value.to_int());
             if (string_size == 0) {
                 throw datashape_parse_error(saved_begin, "string size cannot be zero");
             }
@@ -354,10 +477,10 @@ static ndt::type parse_char_parameters(const char *&begin, const char *end)
 {
     if (parse_token(begin, end, '[')) {
         const char *saved_begin = begin;
-        string encoding_str = parse_name(begin, end);
+        token_range encoding_str = parse_name(begin, end);
         string_encoding_t encoding;
         if (!encoding_str.empty()) {
-            encoding = string_to_encoding(saved_begin, encoding_str);
+            encoding = string_to_encoding(saved_begin, encoding_str.str());
         } else {
             throw datashape_parse_error(saved_begin, "expected a string encoding");
         }
@@ -425,22 +548,22 @@ static ndt::type parse_bytes_parameters(const char *&begin, const char *end)
             if (!parse_token(begin, end, '=')) {
                 throw datashape_parse_error(begin, "expected an =");
             }
-            string align_val = parse_number(begin, end);
+            token_range align_val = parse_number(begin, end);
             if (align_val.empty()) {
                 throw datashape_parse_error(begin, "expected an integer");
             }
             if (!parse_token(begin, end, ']')) {
                 throw datashape_parse_error(begin, "expected closing ']'");
             }
-            return ndt::make_bytes(atoi(align_val.c_str()));
+            return ndt::make_bytes(align_val.to_int());
         }
-        string size_val = parse_number(begin, end);
+        token_range size_val = parse_number(begin, end);
         if (size_val.empty()) {
             throw datashape_parse_error(begin, "expected 'align' or an integer");
         }
         if (parse_token(begin, end, ']')) {
             // Fixed bytes with just a size parameter
-            return ndt::make_fixedbytes(atoi(size_val.c_str()), 1);
+            return ndt::make_fixedbytes(size_val.to_int(), 1);
         }
         if (!parse_token(begin, end, ',')) {
             throw datashape_parse_error(begin, "expected closing ']' or another argument");
@@ -451,14 +574,14 @@ static ndt::type parse_bytes_parameters(const char *&begin, const char *end)
         if (!parse_token(begin, end, '=')) {
             throw datashape_parse_error(begin, "expected an =");
         }
-        string align_val = parse_number(begin, end);
+        token_range align_val = parse_number(begin, end);
         if (align_val.empty()) {
             throw datashape_parse_error(begin, "expected an integer");
         }
         if (!parse_token(begin, end, ']')) {
             throw datashape_parse_error(begin, "expected closing ']'");
         }
-        return ndt::make_fixedbytes(atoi(size_val.c_str()), atoi(align_val.c_str()));
+        return ndt::make_fixedbytes(size_val.to_int(), align_val.to_int());
     } else {
         return ndt::make_bytes(1);
     }
@@ -626,10 +749,11 @@ static ndt::type parse_pointer_parameters(const char *&begin, const char *end,
 static bool parse_record_item(const char *&begin, const char *end, map<string, ndt::type>& symtable,
                 string& out_field_name, ndt::type& out_field_type)
 {
-    out_field_name = parse_name(begin, end);
-    if (out_field_name.empty()) {
+    token_range name = parse_name(begin, end);
+    if (name.empty()) {
         return false;
     }
+    out_field_name.assign(name.begin, name.end);
     if (!parse_token(begin, end , ':')) {
         throw datashape_parse_error(begin, "expected ':' after record item name");
     }
@@ -685,31 +809,33 @@ static ndt::type parse_record(const char *&begin, const char *end, map<string, n
 /** This is what parses the main datashape grammar, excluding type aliases, etc. */
 static ndt::type parse_rhs_expression(const char *&begin, const char *end, map<string, ndt::type>& symtable)
 {
-    const set<string>& reserved_typenames = get_reserved_typenames();
+    const keyword_table& keywords = get_keyword_table();
     ndt::type result;
     vector<intptr_t> shape;
     // rhs_expression : ((NAME | NUMBER) ASTERISK)* (record | NAME LPAREN rhs_expression RPAREN | NAME)
     for (;;) {
         const char *saved_begin = begin;
-        string n = parse_name_or_number(begin, end); // NAME | NUMBER
+        token_range n = parse_name_or_number(begin, end); // NAME | NUMBER
         if (n.empty()) {
             break;
         } else if (!parse_token(begin, end, '*')) { // ASTERISK
             begin = saved_begin;
             break;
         } else {
-            if ('0' <= n[0] && n[0] <= '9') {
-                shape.push_back(atoi(n.c_str()));
-            } else if (n == "var") {
-                // Use -1 to signal a variable-length dimension
-                shape.push_back(-1);
-            } else if (reserved_typenames.find(n) == reserved_typenames.end() &&
-                            symtable.find(n) == symtable.end()) {
-                // Use -2 to signal a free dimension
-                shape.push_back(-2);
+            if (n.is_number()) {
+                shape.push_back(n.to_int());
             } else {
-                throw datashape_parse_error(skip_whitespace(saved_begin, end),
-                                "only free variables can be used for datashape dimensions");
+                keyword_t kw = keywords.find(n);
+                if (kw == keyword_var) {
+                    // Use -1 to signal a variable-length dimension
+                    shape.push_back(-1);
+                } else if (kw == keyword_none && (symtable.empty() || symtable.find(n.str()) == symtable.end())) {
+                    // Use -2 to signal a free dimension
+                    shape.push_back(-2);
+                } else {
+                    throw datashape_parse_error(skip_whitespace(saved_begin, end),
+                                    "only free variables can be used for datashape dimensions");
+                }
             }
         }
     }
@@ -718,42 +844,57 @@ static ndt::type parse_rhs_expression(const char *&begin, const char *end, map<s
     if (result.get_type_id() == uninitialized_type_id) {
         const char *begin_saved = begin;
         // NAME
-        string n = parse_name(begin, end);
+        token_range n = parse_name(begin, end);
+        const ndt::type *builtin_tp = NULL;
         if (n.empty()) {
             if (shape.empty()) {
                 return ndt::type(uninitialized_type_id);
             } else {
                 throw datashape_parse_error(begin, "expected data type");
             }
-        } else if (n == "string") {
-            result = parse_string_parameters(begin, end);
-        } else if (n == "complex") {
-            result = parse_complex_parameters(begin, end, symtable);
-        } else if (n == "datetime") {
-            result = parse_datetime_parameters(begin, end);
-        } else if (n == "time") {
-            result = parse_time_parameters(begin, end);
-        } else if (n == "unaligned") {
-            result = parse_unaligned_parameters(begin, end, symtable);
-        } else if (n == "pointer") {
-            result = parse_pointer_parameters(begin, end, symtable);
-        } else if (n == "char") {
-            result = parse_char_parameters(begin, end);
-        } else if (n == "byteswap") {
-            result = parse_byteswap_parameters(begin, end, symtable);
-        } else if (n == "bytes") {
-            result = parse_bytes_parameters(begin, end);
-        } else if (n == "cuda_host") {
-            result = parse_cuda_host_parameters(begin, end, symtable);
-        } else if (n == "cuda_device") {
-            result = parse_cuda_device_parameters(begin, end, symtable);
-        } else {
-            const map<string, ndt::type>& builtin_types = get_builtin_types();
-            map<string, ndt::type>::const_iterator i = builtin_types.find(n);
-            if (i != builtin_types.end()) {
-                result = i->second;
-            } else {
-                i = symtable.find(n);
+        }
+        switch (keywords.find(n, &builtin_tp)) {
+            case keyword_builtin:
+                result = *builtin_tp;
+                break;
+            case keyword_string:
+                result = parse_string_parameters(begin, end);
+                break;
+            case keyword_complex:
+                result = parse_complex_parameters(begin, end, symtable);
+                break;
+            case keyword_datetime:
+                result = parse_datetime_parameters(begin, end);
+                break;
+            case keyword_time:
+                result = parse_time_parameters(begin, end);
+                break;
+            case keyword_unaligned:
+                result = parse_unaligned_parameters(begin, end, symtable);
+                break;
+            case keyword_pointer:
+                result = parse_pointer_parameters(begin, end, symtable);
+                break;
+            case keyword_char:
+                result = parse_char_parameters(begin, end);
+                break;
+            case keyword_byteswap:
+                result = parse_byteswap_parameters(begin, end, symtable);
+                break;
+            case keyword_bytes:
+                result = parse_bytes_parameters(begin, end);
+                break;
+            case keyword_cuda_host:
+                result = parse_cuda_host_parameters(begin, end, symtable);
+                break;
+            case keyword_cuda_device:
+                result = parse_cuda_device_parameters(begin, end, symtable);
+                break;
+            default: {
+                map<string, ndt::type>::const_iterator i = symtable.end();
+                if (!symtable.empty()) {
+                    i = symtable.find(n.str());
+                }
                 if (i != symtable.end()) {
                     result = i->second;
                 } else {
@@ -767,21 +908,20 @@ static ndt::type parse_rhs_expression(const char *&begin, const char *end, map<s
                                         "unrecognized data type");
                     }
                 }
+                break;
             }
         }
     }
 
     if (result.get_type_id() != uninitialized_type_id) {
         // Apply the shape
-        if (!shape.empty()) {
-            for (ptrdiff_t i = (ptrdiff_t)shape.size() - 1; i >= 0; --i) {
-                if (shape[i] == -2) {
-                    result = ndt::make_strided_dim(result);
-                } else if (shape[i] == -1) {
-                    result = ndt::make_var_dim(result);
-                } else {
-                    result = ndt::make_fixed_dim(shape[i], result);
-                }
+        for (ptrdiff_t i = (ptrdiff_t)shape.size() - 1; i >= 0; --i) {
+            if (shape[i] == -2) {
+                result = ndt::make_strided_dim(result);
+            } else if (shape[i] == -1) {
+                result = ndt::make_var_dim(result);
+            } else {
+                result = ndt::make_fixed_dim(shape[i], result);
             }
         }
     }
@@ -793,13 +933,13 @@ static ndt::type parse_stmt(const char *&begin, const char *end, map<string, ndt
     // stmt : TYPE name EQUALS rhs_expression
     // NOTE that this doesn't support parameterized lhs_expression, this is subset of Blaze datashape
     if (parse_token(begin, end, "type")) {
-        const map<string, ndt::type>& builtin_types = get_builtin_types();
+        const keyword_table& keywords = get_keyword_table();
         const char *saved_begin = begin;
-        string tname = parse_name(begin, end);
+        token_range tname = parse_name(begin, end);
         if (tname.empty()) {
             if (skip_whitespace(begin, end) == end) {
                 // If it's only "type" by itself, return the "type" type
-                return builtin_types.find("type")->second;
+                return ndt::make_type();
             } else {
                 throw datashape_parse_error(begin, "expected an identifier for a type name");
             }
@@ -812,15 +952,16 @@ static ndt::type parse_stmt(const char *&begin, const char *end, map<string, ndt
             throw datashape_parse_error(begin, "expected a data type");
         }
         // ACTION: Put the parsed type in the symbol table
-        if (builtin_types.find(tname) != builtin_types.end()) {
+        if (keywords.is_builtin_type(tname)) {
             throw datashape_parse_error(skip_whitespace(saved_begin, end),
                             "cannot redefine a builtin type");
         }
-        if (symtable.find(tname) != symtable.end()) {
+        string tname_str = tname.str();
+        if (symtable.find(tname_str) != symtable.end()) {
             throw datashape_parse_error(skip_whitespace(saved_begin, end),
                             "type name already defined in datashape string");
         }
-        symtable[tname] = result;
+        symtable[tname_str] = result;
         return result;
     }
     // stmt : rhs_expression
@@ -881,7 +1022,7 @@ static void get_error_line_column(const char *begin, const char *end, const char
     throw runtime_error("Cannot get line number of error, its position is out of range");
 }
 
-ndt::type dynd::type_from_datashape(const char *datashape_begin, const char *datashape_end)
+static ndt::type parse_datashape(const char *datashape_begin, const char *datashape_end)
 {
     try {
         // Symbol table for intermediate types declared in the datashape
@@ -909,3 +1050,169 @@ ndt::type dynd::type_from_datashape(const char *datashape_begin, const char *dat
     }
 }
 
+namespace {
+    struct datashape_cache_entry {
+        string text;
+        uint64_t hash;
+        ndt::type tp;
+    };
+
+    typedef list<datashape_cache_entry> datashape_cache_list;
+
+    /**
+     * The parsed types by hash of their datashape text, and by
+     * order of last use with the most recently used first.
+     */
+    struct datashape_cache {
+        multimap<uint64_t, datashape_cache_list::iterator> by_hash;
+        datashape_cache_list lru;
+        size_t capacity;
+        datashape_cache_stats stats;
+
+        datashape_cache()
+            : capacity(1024)
+        {
+            memset(&stats, 0, sizeof(stats));
+        }
+
+        datashape_cache_list::iterator find(uint64_t hash, const char *begin, const char *end) {
+            typedef multimap<uint64_t, datashape_cache_list::iterator>::iterator hash_iterator;
+            pair<hash_iterator, hash_iterator> range = by_hash.equal_range(hash);
+            size_t size = end - begin;
+            for (hash_iterator i = range.first; i != range.second; ++i) {
+                const string& text = i->second->text;
+                if (text.size() == size && memcmp(text.data(), begin, size) == 0) {
+                    return i->second;
+                }
+            }
+            return lru.end();
+        }
+
+        /** Moves the least recently used entries beyond the capacity to out_evicted */
+        void shrink_to_capacity(datashape_cache_list& out_evicted) {
+            while (lru.size() > capacity) {
+                datashape_cache_list::iterator e = --lru.end();
+                typedef multimap<uint64_t, datashape_cache_list::iterator>::iterator hash_iterator;
+                pair<hash_iterator, hash_iterator> range = by_hash.equal_range(e->hash);
+                for (hash_iterator i = range.first; i != range.second; ++i) {
+                    if (i->second == e) {
+                        by_hash.erase(i);
+                        break;
+                    }
+                }
+                out_evicted.splice(out_evicted.begin(), lru, e);
+                ++stats.evictions;
+            }
+        }
+    };
+
+    // Longer datashapes are parsed every time rather than cached
+    const size_t max_cached_datashape_size = 4096;
+
+    // Statically initialized, so types may be parsed during
+    // the static initialization of other modules
+#ifdef _WIN32
+    SRWLOCK datashape_cache_mutex = SRWLOCK_INIT;
+#else
+    pthread_mutex_t datashape_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+    // Allocated on first use, while holding the lock
+    datashape_cache *datashape_cache_instance = NULL;
+
+    class datashape_cache_lock {
+        // Non-copyable
+        datashape_cache_lock(const datashape_cache_lock&);
+        datashape_cache_lock& operator=(const datashape_cache_lock&);
+    public:
+        datashape_cache_lock() {
+#ifdef _WIN32
+            AcquireSRWLockExclusive(&datashape_cache_mutex);
+#else
+            pthread_mutex_lock(&datashape_cache_mutex);
+#endif
+        }
+
+        ~datashape_cache_lock() {
+#ifdef _WIN32
+            ReleaseSRWLockExclusive(&datashape_cache_mutex);
+#else
+            pthread_mutex_unlock(&datashape_cache_mutex);
+#endif
+        }
+
+        /** The cache, which must only be touched while locked */
+        datashape_cache& get_cache() {
+            if (datashape_cache_instance == NULL) {
+                datashape_cache_instance = new datashape_cache;
+            }
+            return *datashape_cache_instance;
+        }
+    };
+} // anonymous namespace
+
+ndt::type dynd::type_from_datashape(const char *datashape_begin, const char *datashape_end)
+{
+    size_t size = datashape_end - datashape_begin;
+    if (size > max_cached_datashape_size) {
+        datashape_cache_lock lock;
+        ++lock.get_cache().stats.bypasses;
+    } else {
+        uint64_t hash = hash_bytes(datashape_begin, size);
+        {
+            datashape_cache_lock lock;
+            datashape_cache& c = lock.get_cache();
+            datashape_cache_list::iterator e = c.find(hash, datashape_begin, datashape_end);
+            if (e != c.lru.end()) {
+                c.lru.splice(c.lru.begin(), c.lru, e);
+                ++c.stats.hits;
+                return e->tp;
+            }
+            ++c.stats.misses;
+        }
+        // Parse without holding the lock, errors aren't cached
+        ndt::type result = parse_datashape(datashape_begin, datashape_end);
+        // Types freed by eviction are destroyed after the lock is released
+        datashape_cache_list evicted;
+        datashape_cache_lock lock;
+        datashape_cache& c = lock.get_cache();
+        if (c.capacity > 0 && c.find(hash, datashape_begin, datashape_end) == c.lru.end()) {
+            c.lru.push_front(datashape_cache_entry());
+            datashape_cache_entry& e = c.lru.front();
+            e.text.assign(datashape_begin, datashape_end);
+            e.hash = hash;
+            e.tp = result;
+            c.by_hash.insert(make_pair(hash, c.lru.begin()));
+            c.shrink_to_capacity(evicted);
+        }
+        return result;
+    }
+    return parse_datashape(datashape_begin, datashape_end);
+}
+
+datashape_cache_stats dynd::get_datashape_cache_stats()
+{
+    datashape_cache_lock lock;
+    datashape_cache& c = lock.get_cache();
+    datashape_cache_stats result = c.stats;
+    result.size = c.lru.size();
+    return result;
+}
+
+void dynd::clear_datashape_cache()
+{
+    datashape_cache_list evicted;
+    datashape_cache_lock lock;
+    datashape_cache& c = lock.get_cache();
+    c.by_hash.clear();
+    evicted.swap(c.lru);
+    memset(&c.stats, 0, sizeof(c.stats));
+}
+
+void dynd::set_datashape_cache_capacity(size_t capacity)
+{
+    datashape_cache_list evicted;
+    datashape_cache_lock lock;
+    datashape_cache& c = lock.get_cache();
+    c.capacity = capacity;
+    c.shrink_to_capacity(evicted);
+}
@@ -4,10 +4,12 @@
 //
 
 #include <string>
+#include <cstring>
 
 #include <dynd/parser_util.hpp>
 #include <dynd/types/date_parser.hpp>
 #include <dynd/types/date_util.hpp>
+#include <dynd/types/time_util.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -478,3 +480,131 @@ bool dynd::string_to_date(const char *begin, const char *end, date_ymd& out_ymd,
         return false;
     }
 }
+
+namespace {
+    /**
+     * A fixed pattern of 8 characters, where '0' marks a digit and any
+     * other character must match exactly. The masks are loaded from memory
+     * the same way as the input, so they work with either byte order.
+     */
+    struct fixed_pattern8 {
+        uint64_t mask, expected, digit_mask, digit_check;
+
+        fixed_pattern8(const char *pattern)
+        {
+            unsigned char m[8], e[8], dm[8], dc[8];
+            for (int i = 0; i < 8; ++i) {
+                if (pattern[i] == '0') {
+                    m[i] = 0xf0;
+                    e[i] = 0x30;
+                    dm[i] = 0xf0;
+                    dc[i] = 0x06;
+                } else {
+                    m[i] = 0xff;
+                    e[i] = static_cast<unsigned char>(pattern[i]);
+                    dm[i] = 0;
+                    dc[i] = 0;
+                }
+            }
+            memcpy(&mask, m, 8);
+            memcpy(&expected, e, 8);
+            memcpy(&digit_mask, dm, 8);
+            memcpy(&digit_check, dc, 8);
+        }
+
+        /**
+         * Checks all 8 characters at once. A digit is 0x30 to 0x39, so its
+         * high nibble is 3, and adding 6 must not carry into the high nibble.
+         * Once every high nibble is checked, adding 6 can't carry between bytes.
+         */
+        inline bool matches(const char *s) const
+        {
+            uint64_t v;
+            memcpy(&v, s, 8);
+            return (v & mask) == expected &&
+                            ((v + digit_check) & digit_mask) == (expected & digit_mask);
+        }
+    };
+
+    const fixed_pattern8 iso8601_date_head("0000-00-");
+    const fixed_pattern8 iso8601_time("00:00:00");
+
+    inline bool is_digit(char c)
+    {
+        return static_cast<unsigned char>(c - '0') <= 9;
+    }
+
+    inline int digits2(const char *s)
+    {
+        return 10 * (s[0] - '0') + (s[1] - '0');
+    }
+
+    /** Parses the "YYYY-MM-DD" at `begin`, which has at least 10 characters */
+    inline bool parse_iso8601_fixed_days(const char *begin, int32_t &out_days)
+    {
+        if (!iso8601_date_head.matches(begin) || !is_digit(begin[8]) || !is_digit(begin[9])) {
+            return false;
+        }
+        int year = 100 * digits2(begin) + digits2(begin + 2);
+        int month = digits2(begin + 5), day = digits2(begin + 8);
+        if (!date_ymd::is_valid(year, month, day)) {
+            return false;
+        }
+        out_days = date_ymd::to_days(year, month, day);
+        return true;
+    }
+} // anonymous namespace
+
+bool parse::parse_iso8601_fixed_date(const char *begin, const char *end, int32_t &out_days)
+{
+    return end - begin == 10 && parse_iso8601_fixed_days(begin, out_days);
+}
+
+bool parse::parse_iso8601_fixed_datetime(const char *begin, const char *end,
+                int64_t &out_ticks, bool &out_utc)
+{
+    intptr_t len = end - begin;
+    out_utc = (len > 16 && end[-1] == 'Z');
+    if (out_utc) {
+        --len;
+    }
+    // Requires at least "YYYY-MM-DDTHH:MM"
+    int32_t days;
+    if (len < 16 || (begin[10] != 'T' && begin[10] != ' ') ||
+                    !parse_iso8601_fixed_days(begin, days)) {
+        return false;
+    }
+    const char *t = begin + 11;
+    int hour, minute, second = 0;
+    int64_t fraction = 0;
+    if (len == 16) {
+        if (!is_digit(t[0]) || !is_digit(t[1]) || t[2] != ':' || !is_digit(t[3]) || !is_digit(t[4])) {
+            return false;
+        }
+    } else if (len >= 19 && iso8601_time.matches(t)) {
+        second = digits2(t + 6);
+        if (len > 19) {
+            // One to seven digits of fractional seconds, down to ticks
+            if (t[8] != '.' || len == 20 || len > 27) {
+                return false;
+            }
+            int64_t scale = 1000000;
+            for (const char *f = t + 9; f != begin + len; ++f, scale /= 10) {
+                if (!is_digit(*f)) {
+                    return false;
+                }
+                fraction += (*f - '0') * scale;
+            }
+        }
+    } else {
+        return false;
+    }
+    hour = digits2(t);
+    minute = digits2(t + 3);
+    if (hour >= 24 || minute >= 60 || second >= 60) {
+        return false;
+    }
+    out_ticks = days * DYND_TICKS_PER_DAY + hour * DYND_TICKS_PER_HOUR +
+                    minute * DYND_TICKS_PER_MINUTE + second * DYND_TICKS_PER_SECOND + fraction;
+    return true;
+}
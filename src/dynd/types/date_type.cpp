@@ -17,6 +17,7 @@
 #include <dynd/kernels/date_expr_kernels.hpp>
 #include <dynd/kernels/string_assignment_kernels.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/kernels/hash_kernels.hpp>
 #include <dynd/exceptions.hpp>
 #include <dynd/gfunc/make_callable.hpp>
 #include <dynd/array_iter.hpp>
@@ -72,14 +73,8 @@ date_ymd date_type::get_ymd(const char *DYND_UNUSED(metadata), const char *data)
 
 void date_type::print_data(std::ostream& o, const char *DYND_UNUSED(metadata), const char *data) const
 {
-    date_ymd ymd;
-    ymd.set_from_days(*reinterpret_cast<const int32_t *>(data));
-    string s = ymd.to_str();
-    if (s.empty()) {
-        o << "NA";
-    } else {
-        o << s;
-    }
+    char buf[13];
+    o.write(buf, date_ymd::days_to_str(*reinterpret_cast<const int32_t *>(data), buf));
 }
 
 void date_type::print_type(std::ostream& o) const
@@ -186,6 +181,15 @@ size_t date_type::make_comparison_kernel(
     throw not_comparable_error(src0_tp, src1_tp, comptype);
 }
 
+size_t date_type::make_hash_kernel(
+                ckernel_builder *out, size_t offset_out,
+                const char *DYND_UNUSED(metadata),
+                const eval::eval_context *DYND_UNUSED(ectx)) const
+{
+    // Dates are stored as int32 days
+    return make_builtin_type_hash_kernel(out, offset_out, int32_type_id);
+}
+
 ///////// properties on the type
 
 //static pair<string, gfunc::callable> date_type_properties[] = {
@@ -321,41 +325,86 @@ void date_type::get_dynamic_array_functions(
 ///////// property accessor kernels (used by property_type)
 
 namespace {
-    void get_property_kernel_year_single(char *dst, const char *src,
-                    ckernel_prefix *DYND_UNUSED(extra))
-    {
-        date_ymd ymd;
-        ymd.set_from_days(*reinterpret_cast<const int32_t *>(src));
-        *reinterpret_cast<int32_t *>(dst) = ymd.year;
-    }
+    // The year, month and day of an NA date are 0, -128 and 0, like date_ymd
+    struct date_year_getter {
+        static inline int32_t get(int32_t days) {
+            int32_t y, m, d;
+            date_ymd::days_to_ymd(days, y, m, d);
+            return days != DYND_DATE_NA ? y : 0;
+        }
+    };
 
-    void get_property_kernel_month_single(char *dst, const char *src,
-                    ckernel_prefix *DYND_UNUSED(extra))
-    {
-        date_ymd ymd;
-        ymd.set_from_days(*reinterpret_cast<const int32_t *>(src));
-        *reinterpret_cast<int32_t *>(dst) = ymd.month;
-    }
+    struct date_month_getter {
+        static inline int32_t get(int32_t days) {
+            int32_t y, m, d;
+            date_ymd::days_to_ymd(days, y, m, d);
+            return days != DYND_DATE_NA ? m : -128;
+        }
+    };
 
-    void get_property_kernel_day_single(char *dst, const char *src,
-                    ckernel_prefix *DYND_UNUSED(extra))
-    {
-        date_ymd ymd;
-        ymd.set_from_days(*reinterpret_cast<const int32_t *>(src));
-        *reinterpret_cast<int32_t *>(dst) = ymd.day;
-    }
+    struct date_day_getter {
+        static inline int32_t get(int32_t days) {
+            int32_t y, m, d;
+            date_ymd::days_to_ymd(days, y, m, d);
+            return days != DYND_DATE_NA ? d : 0;
+        }
+    };
 
-    void get_property_kernel_weekday_single(char *dst, const char *src,
-                    ckernel_prefix *DYND_UNUSED(extra))
-    {
-        int32_t days = *reinterpret_cast<const int32_t *>(src);
-        // 1970-01-05 is Monday
-        int weekday = (int)((days - 4) % 7);
-        if (weekday < 0) {
-            weekday += 7;
+    struct date_weekday_getter {
+        static inline int32_t get(int32_t days) {
+            return date_ymd::days_to_weekday(days);
         }
-        *reinterpret_cast<int32_t *>(dst) = weekday;
-    }
+    };
+
+    /**
+     * Kernels for the int32 properties of a date. The contiguous
+     * case of the strided kernel is separate so the compiler can
+     * vectorize it.
+     */
+    template<class GET>
+    struct date_property_kernel {
+        static void single(char *dst, const char *src,
+                        ckernel_prefix *DYND_UNUSED(extra))
+        {
+            *reinterpret_cast<int32_t *>(dst) = GET::get(*reinterpret_cast<const int32_t *>(src));
+        }
+
+        static void strided(char *dst, intptr_t dst_stride,
+                        const char *src, intptr_t src_stride,
+                        size_t count, ckernel_prefix *DYND_UNUSED(extra))
+        {
+            if (dst_stride == sizeof(int32_t) && src_stride == sizeof(int32_t)) {
+                int32_t *dst_typed = reinterpret_cast<int32_t *>(dst);
+                const int32_t *src_typed = reinterpret_cast<const int32_t *>(src);
+                for (size_t i = 0; i != count; ++i) {
+                    dst_typed[i] = GET::get(src_typed[i]);
+                }
+            } else {
+                for (size_t i = 0; i != count; ++i, dst += dst_stride, src += src_stride) {
+                    *reinterpret_cast<int32_t *>(dst) = GET::get(*reinterpret_cast<const int32_t *>(src));
+                }
+            }
+        }
+
+        static size_t make(ckernel_builder *out, size_t offset_out, kernel_request_t kernreq)
+        {
+            ckernel_prefix *e = out->get_at<ckernel_prefix>(offset_out);
+            switch (kernreq) {
+                case kernel_request_single:
+                    e->set_function<unary_single_operation_t>(&single);
+                    break;
+                case kernel_request_strided:
+                    e->set_function<unary_strided_operation_t>(&strided);
+                    break;
+                default: {
+                    stringstream ss;
+                    ss << "date property kernel: unrecognized request " << (int)kernreq;
+                    throw runtime_error(ss.str());
+                }
+            }
+            return offset_out + sizeof(ckernel_prefix);
+        }
+    };
 
     void get_property_kernel_days_after_1970_int64_single(char *dst, const char *src,
                     ckernel_prefix *DYND_UNUSED(extra))
@@ -460,21 +509,21 @@ size_t date_type::make_elwise_property_getter_kernel(
                 const char *DYND_UNUSED(src_metadata), size_t src_property_index,
                 kernel_request_t kernreq, const eval::eval_context *DYND_UNUSED(ectx)) const
 {
-    offset_out = make_kernreq_to_single_kernel_adapter(out, offset_out, kernreq);
-    ckernel_prefix *e = out->get_at<ckernel_prefix>(offset_out);
     switch (src_property_index) {
         case dateprop_year:
-            e->set_function<unary_single_operation_t>(&get_property_kernel_year_single);
-            return offset_out + sizeof(ckernel_prefix);
+            return date_property_kernel<date_year_getter>::make(out, offset_out, kernreq);
         case dateprop_month:
-            e->set_function<unary_single_operation_t>(&get_property_kernel_month_single);
-            return offset_out + sizeof(ckernel_prefix);
+            return date_property_kernel<date_month_getter>::make(out, offset_out, kernreq);
         case dateprop_day:
-            e->set_function<unary_single_operation_t>(&get_property_kernel_day_single);
-            return offset_out + sizeof(ckernel_prefix);
+            return date_property_kernel<date_day_getter>::make(out, offset_out, kernreq);
         case dateprop_weekday:
-            e->set_function<unary_single_operation_t>(&get_property_kernel_weekday_single);
-            return offset_out + sizeof(ckernel_prefix);
+            return date_property_kernel<date_weekday_getter>::make(out, offset_out, kernreq);
+        default:
+            break;
+    }
+    offset_out = make_kernreq_to_single_kernel_adapter(out, offset_out, kernreq);
+    ckernel_prefix *e = out->get_at<ckernel_prefix>(offset_out);
+    switch (src_property_index) {
         case dateprop_days_after_1970_int64:
             e->set_function<unary_single_operation_t>(&get_property_kernel_days_after_1970_int64_single);
             return offset_out + sizeof(ckernel_prefix);
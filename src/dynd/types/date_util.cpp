@@ -25,22 +25,15 @@ const int date_ymd::month_starts[2][13] = {
 int32_t date_ymd::to_days(int year, int month, int day)
 {
     if (is_valid(year, month, day)) {
-        // Start with 365 days a year
-        int result = (year - 1970) * 365;
-        // Use the inclusion-exclusion principle to count leap years
-        if (result >= 0) {
-            result += ((year - (1968 + 1)) / 4) -
-                        ((year - (1900 + 1)) / 100) +
-                        ((year - (1600 + 1)) / 400);
-        } else {
-            result += ((year - 1972) / 4) -
-                        ((year - 2000) / 100) +
-                        ((year - 2000) / 400);
-        }
-        // Add in the months and days
-        result += month_starts[is_leap_year(year)][month-1];
-        result += day-1;
-        return result;
+        // The Neri-Schneider algorithm, in a calendar whose years start
+        // on March 1, shifted by 2000000 years so everything is unsigned
+        uint32_t jan_or_feb = month <= 2;
+        uint64_t y = static_cast<uint64_t>(static_cast<int64_t>(year) + 2000000 - jan_or_feb);
+        uint32_t m = jan_or_feb ? month + 12 : month;
+        uint64_t century = y / 100;
+        uint64_t year_days = 1461 * y / 4 - century + century / 4;
+        uint32_t month_days = (979 * m - 2919) / 32;
+        return static_cast<int32_t>(year_days + month_days + (day - 1) - 731204468);
     } else {
         return DYND_DATE_NA;
     }
@@ -48,87 +41,57 @@ int32_t date_ymd::to_days(int year, int month, int day)
 
 std::string date_ymd::to_str(int year, int month, int day)
 {
-    string s;
-    if (is_valid(year, month, day)) {
-         if (year >= 1 && year <= 9999) {
-            // ISO 8601 date
-            s.resize(10);
-            s[0] = '0' + (year / 1000);
-            s[1] = '0' + ((year / 100) % 10);
-            s[2] = '0' + ((year / 10) % 10);
-            s[3] = '0' + (year % 10);
-            s[4] = '-';
-            s[5] = '0' + (month / 10);
-            s[6] = '0' + (month % 10);
-            s[7] = '-';
-            s[8] = '0' + (day / 10);
-            s[9] = '0' + (day % 10);
+    char buf[13];
+    return string(buf, to_str(year, month, day, buf));
+}
+
+size_t date_ymd::to_str(int year, int month, int day, char *out)
+{
+    if (!is_valid(year, month, day)) {
+        return 0;
+    }
+    char *s = out;
+    if (year >= 1 && year <= 9999) {
+        // ISO 8601 date
+        s[0] = '0' + (year / 1000);
+        s[1] = '0' + ((year / 100) % 10);
+        s[2] = '0' + ((year / 10) % 10);
+        s[3] = '0' + (year % 10);
+        s += 4;
+    } else {
+        // Expanded ISO 8601 date, using +/- 6 digit year
+        if (year >= 0) {
+            s[0] = '+';
         } else {
-            // Expanded ISO 8601 date, using +/- 6 digit year
-            s.resize(13);
-            if (year >= 0) {
-                s[0] = '+';
-            } else {
-                s[0] = '-';
-                year = -year;
-            }
-            s[1] = '0' + (year / 100000);
-            s[2] = '0' + ((year / 10000) % 10);
-            s[3] = '0' + ((year / 1000) % 10);
-            s[4] = '0' + ((year / 100) % 10);
-            s[5] = '0' + ((year / 10) % 10);
-            s[6] = '0' + (year % 10);
-            s[7] = '-';
-            s[8] = '0' + (month / 10);
-            s[9] = '0' + (month % 10);
-            s[10] = '-';
-            s[11] = '0' + (day / 10);
-            s[12] = '0' + (day % 10);
+            s[0] = '-';
+            year = -year;
         }
+        s[1] = '0' + (year / 100000);
+        s[2] = '0' + ((year / 10000) % 10);
+        s[3] = '0' + ((year / 1000) % 10);
+        s[4] = '0' + ((year / 100) % 10);
+        s[5] = '0' + ((year / 10) % 10);
+        s[6] = '0' + (year % 10);
+        s += 7;
     }
-    return s;
+    s[0] = '-';
+    s[1] = '0' + (month / 10);
+    s[2] = '0' + (month % 10);
+    s[3] = '-';
+    s[4] = '0' + (day / 10);
+    s[5] = '0' + (day % 10);
+    return s + 6 - out;
 }
 
 
 void date_ymd::set_from_days(int32_t days)
 {
     if (days != DYND_DATE_NA) {
-        int yearcalc;
-        // Make the days relative to year 0
-        days += 719528;
-        // To a 400 year cycle
-        if (days >= 0) {
-            yearcalc = 400 * (days / (400 * 365 + 100 - 4 + 1));
-            days = days % (400 * 365 + 100 - 4 + 1);
-        } else {
-            yearcalc = 400 * ((days - (400 * 365 + 100 - 4)) / (400 * 365 + 100 - 4 + 1));
-            days = days % (400 * 365 + 100 - 4 + 1);
-            if (days < 0) {
-                days += (400 * 365 + 100 - 4 + 1);
-            }
-        }
-        if (days >= 366) {
-            // To a 100 year cycle
-            yearcalc += 100 * ((days - 1) / (100 * 365 + 25 - 1));
-            days = (days - 1) % (100 * 365 + 25 - 1);
-            if (days >= 365) {
-                // To a 4 year cycle
-                yearcalc += 4 * ((days + 1) / (4 * 365 + 1));
-                days = (days + 1) % (4 * 365 + 1);
-                if (days >= 366) {
-                    // To a 1 year cycle
-                    yearcalc += (days - 1) / 365;
-                    days = (days - 1) % 365;
-                }
-            }
-        }
-        // Search for the month
-        const int *monthstart = month_starts[is_leap_year(yearcalc)];
-        const int *monthfound = std::upper_bound(monthstart + 1, monthstart + 13, days);
-        // Set the ymd
-        year = yearcalc;
-        month = static_cast<int8_t>(monthfound - monthstart);
-        day = days - *(monthfound - 1) + 1;
+        int32_t y, m, d;
+        days_to_ymd(days, y, m, d);
+        year = static_cast<int16_t>(y);
+        month = static_cast<int8_t>(m);
+        day = static_cast<int8_t>(d);
     } else {
         year = 0;
         month = -128;
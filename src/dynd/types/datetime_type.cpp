@@ -15,6 +15,7 @@
 #include <dynd/types/string_type.hpp>
 #include <dynd/types/unary_expr_type.hpp>
 #include <dynd/kernels/datetime_assignment_kernels.hpp>
+#include <dynd/kernels/datetime_tz_kernels.hpp>
 #include <dynd/kernels/date_expr_kernels.hpp>
 #include <dynd/kernels/string_assignment_kernels.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
@@ -418,124 +419,125 @@ namespace {
         }
     }
 
-    void get_property_kernel_year_single(char *dst, const char *src,
-                    ckernel_prefix *extra)
+    /** Divides ticks by a positive divisor, rounding toward negative infinity */
+    inline int64_t ticks_floor_div(int64_t ticks, int64_t divisor)
     {
-        const datetime_property_kernel_extra *e = reinterpret_cast<datetime_property_kernel_extra *>(extra);
-        const datetime_type *dd = e->datetime_tp;
-        datetime_tz_t tz = dd->get_timezone();
-        if (tz == tz_utc || tz == tz_abstract) {
-            date_ymd ymd;
-            ymd.set_from_ticks(*reinterpret_cast<const int64_t *>(src));
-            *reinterpret_cast<int32_t *>(dst) = ymd.year;
-        } else {
-            throw runtime_error("datetime property access only implemented for UTC and abstract timezones");
-        }
+        int64_t q = ticks / divisor;
+        return q - ((q * divisor) > ticks);
     }
 
-    void get_property_kernel_month_single(char *dst, const char *src,
-                    ckernel_prefix *extra)
+    /** The remainder matching ticks_floor_div, always nonnegative */
+    inline int64_t ticks_floor_mod(int64_t ticks, int64_t divisor)
     {
-        const datetime_property_kernel_extra *e = reinterpret_cast<datetime_property_kernel_extra *>(extra);
-        const datetime_type *dd = e->datetime_tp;
-        datetime_tz_t tz = dd->get_timezone();
-        if (tz == tz_utc || tz == tz_abstract) {
-            date_ymd ymd;
-            ymd.set_from_ticks(*reinterpret_cast<const int64_t *>(src));
-            *reinterpret_cast<int32_t *>(dst) = ymd.month;
-        } else {
-            throw runtime_error("datetime property access only implemented for UTC and abstract timezones");
-        }
+        return ticks - ticks_floor_div(ticks, divisor) * divisor;
     }
 
-    void get_property_kernel_day_single(char *dst, const char *src,
-                    ckernel_prefix *extra)
-    {
-        const datetime_property_kernel_extra *e = reinterpret_cast<datetime_property_kernel_extra *>(extra);
-        const datetime_type *dd = e->datetime_tp;
-        datetime_tz_t tz = dd->get_timezone();
-        if (tz == tz_utc || tz == tz_abstract) {
-            date_ymd ymd;
-            ymd.set_from_ticks(*reinterpret_cast<const int64_t *>(src));
-            *reinterpret_cast<int32_t *>(dst) = ymd.day;
-        } else {
-            throw runtime_error("datetime property access only implemented for UTC and abstract timezones");
+    // The year, month and day of an NA datetime are 0, -128 and 0, like date_ymd
+    struct datetime_year_getter {
+        static inline int32_t get(int64_t ticks) {
+            int32_t y, m, d;
+            date_ymd::days_to_ymd(static_cast<int32_t>(ticks_floor_div(ticks, DYND_TICKS_PER_DAY)), y, m, d);
+            return ticks != DYND_DATETIME_NA ? y : 0;
         }
-    }
+    };
 
-    void get_property_kernel_hour_single(char *dst, const char *src,
-                    ckernel_prefix *extra)
-    {
-        const datetime_property_kernel_extra *e = reinterpret_cast<datetime_property_kernel_extra *>(extra);
-        const datetime_type *dd = e->datetime_tp;
-        datetime_tz_t tz = dd->get_timezone();
-        if (tz == tz_utc || tz == tz_abstract) {
-            int64_t hour =
-                *reinterpret_cast<const int64_t *>(src) % DYND_TICKS_PER_DAY;
-            if (hour < 0) {
-                hour += DYND_TICKS_PER_DAY;
-            }
-            hour /= DYND_TICKS_PER_HOUR;
-            *reinterpret_cast<int32_t *>(dst) = static_cast<int32_t>(hour);
-        } else {
-            throw runtime_error("datetime property access only implemented for UTC and abstract timezones");
+    struct datetime_month_getter {
+        static inline int32_t get(int64_t ticks) {
+            int32_t y, m, d;
+            date_ymd::days_to_ymd(static_cast<int32_t>(ticks_floor_div(ticks, DYND_TICKS_PER_DAY)), y, m, d);
+            return ticks != DYND_DATETIME_NA ? m : -128;
         }
-    }
+    };
 
-    void get_property_kernel_minute_single(char *dst, const char *src,
-                    ckernel_prefix *extra)
-    {
-        const datetime_property_kernel_extra *e = reinterpret_cast<datetime_property_kernel_extra *>(extra);
-        const datetime_type *dd = e->datetime_tp;
-        datetime_tz_t tz = dd->get_timezone();
-        if (tz == tz_utc || tz == tz_abstract) {
-            int64_t minute =
-                *reinterpret_cast<const int64_t *>(src) % DYND_TICKS_PER_HOUR;
-            if (minute < 0) {
-                minute += DYND_TICKS_PER_HOUR;
+    struct datetime_day_getter {
+        static inline int32_t get(int64_t ticks) {
+            int32_t y, m, d;
+            date_ymd::days_to_ymd(static_cast<int32_t>(ticks_floor_div(ticks, DYND_TICKS_PER_DAY)), y, m, d);
+            return ticks != DYND_DATETIME_NA ? d : 0;
+        }
+    };
+
+    struct datetime_hour_getter {
+        static inline int32_t get(int64_t ticks) {
+            return static_cast<int32_t>(ticks_floor_mod(ticks, DYND_TICKS_PER_DAY) / DYND_TICKS_PER_HOUR);
+        }
+    };
+
+    struct datetime_minute_getter {
+        static inline int32_t get(int64_t ticks) {
+            return static_cast<int32_t>(ticks_floor_mod(ticks, DYND_TICKS_PER_HOUR) / DYND_TICKS_PER_MINUTE);
+        }
+    };
+
+    struct datetime_second_getter {
+        static inline int32_t get(int64_t ticks) {
+            return static_cast<int32_t>(ticks_floor_mod(ticks, DYND_TICKS_PER_MINUTE) / DYND_TICKS_PER_SECOND);
+        }
+    };
+
+    struct datetime_tick_getter {
+        static inline int32_t get(int64_t ticks) {
+            return static_cast<int32_t>(ticks_floor_mod(ticks, 10000000LL));
+        }
+    };
+
+    /**
+     * Kernels for the int32 properties of a datetime. The timezone is
+     * checked once per call, and the contiguous case of the strided
+     * kernel is separate so the compiler can vectorize it.
+     */
+    template<class GET>
+    struct datetime_property_kernel {
+        static void check_timezone(ckernel_prefix *extra)
+        {
+            const datetime_property_kernel_extra *e = reinterpret_cast<datetime_property_kernel_extra *>(extra);
+            datetime_tz_t tz = e->datetime_tp->get_timezone();
+            if (tz != tz_utc && tz != tz_abstract) {
+                throw runtime_error("datetime property access only implemented for UTC and abstract timezones");
             }
-            minute /= DYND_TICKS_PER_MINUTE;
-            *reinterpret_cast<int32_t *>(dst) = static_cast<int32_t>(minute);
-        } else {
-            throw runtime_error("datetime property access only implemented for UTC and abstract timezones");
         }
-    }
 
-    void get_property_kernel_second_single(char *dst, const char *src,
-                    ckernel_prefix *extra)
-    {
-        const datetime_property_kernel_extra *e = reinterpret_cast<datetime_property_kernel_extra *>(extra);
-        const datetime_type *dd = e->datetime_tp;
-        datetime_tz_t tz = dd->get_timezone();
-        if (tz == tz_utc || tz == tz_abstract) {
-            int64_t second =
-                *reinterpret_cast<const int64_t *>(src) % DYND_TICKS_PER_MINUTE;
-            if (second < 0) {
-                second += DYND_TICKS_PER_MINUTE;
+        static void single(char *dst, const char *src, ckernel_prefix *extra)
+        {
+            check_timezone(extra);
+            *reinterpret_cast<int32_t *>(dst) = GET::get(*reinterpret_cast<const int64_t *>(src));
+        }
+
+        static void strided(char *dst, intptr_t dst_stride,
+                        const char *src, intptr_t src_stride,
+                        size_t count, ckernel_prefix *extra)
+        {
+            check_timezone(extra);
+            if (dst_stride == sizeof(int32_t) && src_stride == sizeof(int64_t)) {
+                int32_t *dst_typed = reinterpret_cast<int32_t *>(dst);
+                const int64_t *src_typed = reinterpret_cast<const int64_t *>(src);
+                for (size_t i = 0; i != count; ++i) {
+                    dst_typed[i] = GET::get(src_typed[i]);
+                }
+            } else {
+                for (size_t i = 0; i != count; ++i, dst += dst_stride, src += src_stride) {
+                    *reinterpret_cast<int32_t *>(dst) = GET::get(*reinterpret_cast<const int64_t *>(src));
+                }
             }
-            second /= DYND_TICKS_PER_SECOND;
-            *reinterpret_cast<int32_t *>(dst) = static_cast<int32_t>(second);
-        } else {
-            throw runtime_error("datetime property access only implemented for UTC and abstract timezones");
         }
-    }
 
-    void get_property_kernel_tick_single(char *dst, const char *src,
-                    ckernel_prefix *extra)
-    {
-        const datetime_property_kernel_extra *e = reinterpret_cast<datetime_property_kernel_extra *>(extra);
-        const datetime_type *dd = e->datetime_tp;
-        datetime_tz_t tz = dd->get_timezone();
-        if (tz == tz_utc || tz == tz_abstract) {
-            int64_t tick = *reinterpret_cast<const int64_t *>(src) % 10000000LL;
-            if (tick < 0) {
-                tick += 10000000LL;
+        static void set_functions(ckernel_prefix *e, kernel_request_t kernreq)
+        {
+            switch (kernreq) {
+                case kernel_request_single:
+                    e->set_function<unary_single_operation_t>(&single);
+                    break;
+                case kernel_request_strided:
+                    e->set_function<unary_strided_operation_t>(&strided);
+                    break;
+                default: {
+                    stringstream ss;
+                    ss << "datetime property kernel: unrecognized request " << (int)kernreq;
+                    throw runtime_error(ss.str());
+                }
             }
-            *reinterpret_cast<int32_t *>(dst) = static_cast<int32_t>(tick);
-        } else {
-            throw runtime_error("datetime property access only implemented for UTC and abstract timezones");
         }
-    }
+    };
 } // anonymous namespace
 
 namespace {
@@ -605,7 +607,12 @@ size_t datetime_type::make_elwise_property_getter_kernel(
                 const char *DYND_UNUSED(src_metadata), size_t src_property_index,
                 kernel_request_t kernreq, const eval::eval_context *DYND_UNUSED(ectx)) const
 {
-    offset_out = make_kernreq_to_single_kernel_adapter(out, offset_out, kernreq);
+    if (src_property_index == datetimeprop_struct || src_property_index == datetimeprop_date) {
+        // These properties only have single kernels
+        offset_out = make_kernreq_to_single_kernel_adapter(out, offset_out, kernreq);
+        kernreq = kernel_request_single;
+    }
+    out->ensure_capacity_leaf(offset_out + sizeof(datetime_property_kernel_extra));
     datetime_property_kernel_extra *e = out->get_at<datetime_property_kernel_extra>(offset_out);
     switch (src_property_index) {
         case datetimeprop_struct:
@@ -615,25 +622,25 @@ size_t datetime_type::make_elwise_property_getter_kernel(
             e->base.set_function<unary_single_operation_t>(&get_property_kernel_date_single);
             break;
         case datetimeprop_year:
-            e->base.set_function<unary_single_operation_t>(&get_property_kernel_year_single);
+            datetime_property_kernel<datetime_year_getter>::set_functions(&e->base, kernreq);
             break;
         case datetimeprop_month:
-            e->base.set_function<unary_single_operation_t>(&get_property_kernel_month_single);
+            datetime_property_kernel<datetime_month_getter>::set_functions(&e->base, kernreq);
             break;
         case datetimeprop_day:
-            e->base.set_function<unary_single_operation_t>(&get_property_kernel_day_single);
+            datetime_property_kernel<datetime_day_getter>::set_functions(&e->base, kernreq);
             break;
         case datetimeprop_hour:
-            e->base.set_function<unary_single_operation_t>(&get_property_kernel_hour_single);
+            datetime_property_kernel<datetime_hour_getter>::set_functions(&e->base, kernreq);
             break;
         case datetimeprop_minute:
-            e->base.set_function<unary_single_operation_t>(&get_property_kernel_minute_single);
+            datetime_property_kernel<datetime_minute_getter>::set_functions(&e->base, kernreq);
             break;
         case datetimeprop_second:
-            e->base.set_function<unary_single_operation_t>(&get_property_kernel_second_single);
+            datetime_property_kernel<datetime_second_getter>::set_functions(&e->base, kernreq);
             break;
         case datetimeprop_tick:
-            e->base.set_function<unary_single_operation_t>(&get_property_kernel_tick_single);
+            datetime_property_kernel<datetime_tick_getter>::set_functions(&e->base, kernreq);
             break;
         default:
             stringstream ss;
@@ -664,3 +671,18 @@ size_t datetime_type::make_elwise_property_setter_kernel(
     }
 }
 
+nd::array nd::tz_convert(const nd::array& utc_datetimes, const std::string& tz_name)
+{
+    const tz_transitions& tz = get_tz_transitions(tz_name);
+    nd::array n = utc_datetimes.ucast(ndt::make_datetime(tz_utc));
+    return n.replace_dtype(ndt::make_unary_expr(ndt::make_datetime(tz_abstract), n.get_dtype(),
+                    make_tz_convert_kernelgen(tz)));
+}
+
+nd::array nd::tz_localize(const nd::array& local_datetimes, const std::string& tz_name)
+{
+    const tz_transitions& tz = get_tz_transitions(tz_name);
+    nd::array n = local_datetimes.ucast(ndt::make_datetime(tz_abstract));
+    return n.replace_dtype(ndt::make_unary_expr(ndt::make_datetime(tz_utc), n.get_dtype(),
+                    make_tz_localize_kernelgen(tz)));
+}
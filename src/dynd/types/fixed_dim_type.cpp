@@ -10,6 +10,7 @@
 #include <dynd/shortvector.hpp>
 #include <dynd/exceptions.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/kernels/struct_assignment_kernels.hpp>
 #include <dynd/gfunc/callable.hpp>
 #include <dynd/gfunc/make_callable.hpp>
 
@@ -500,6 +501,13 @@ size_t fixed_dim_type::make_assignment_kernel(
                 const eval::eval_context *ectx) const
 {
     if (this == dst_tp.extended()) {
+        if (src_tp.get_kind() == struct_kind && is_columnar_struct_assignment(dst_tp, src_tp)) {
+            // Columns of a struct into this array of structs
+            return make_columnar_struct_assignment_kernel(out, offset_out,
+                            dst_tp, dst_metadata,
+                            src_tp, src_metadata,
+                            kernreq, errmode, ectx);
+        }
         out->ensure_capacity(offset_out + sizeof(strided_assign_kernel_extra));
         strided_assign_kernel_extra *e = out->get_at<strided_assign_kernel_extra>(offset_out);
         switch (kernreq) {
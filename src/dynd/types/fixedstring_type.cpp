@@ -10,6 +10,7 @@
 #include <dynd/kernels/string_assignment_kernels.hpp>
 #include <dynd/kernels/string_comparison_kernels.hpp>
 #include <dynd/kernels/string_numeric_assignment_kernels.hpp>
+#include <dynd/kernels/hash_kernels.hpp>
 #include <dynd/exceptions.hpp>
 #include <dynd/gfunc/make_callable.hpp>
 #include <dynd/iter/string_iter.hpp>
@@ -236,6 +237,14 @@ size_t fixedstring_type::make_comparison_kernel(
     throw not_comparable_error(src0_dt, src1_dt, comptype);
 }
 
+size_t fixedstring_type::make_hash_kernel(
+                ckernel_builder *out, size_t offset_out,
+                const char *DYND_UNUSED(metadata),
+                const eval::eval_context *DYND_UNUSED(ectx)) const
+{
+    return make_fixedstring_hash_kernel(out, offset_out, m_stringsize, m_encoding);
+}
+
 void fixedstring_type::make_string_iter(dim_iter *out_di, string_encoding_t encoding,
             const char *metadata, const char *data,
             const memory_block_ptr& ref,
@@ -0,0 +1,622 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/array.hpp>
+#include <dynd/types/offset_dim_type.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/shape_tools.hpp>
+#include <dynd/exceptions.hpp>
+#include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/kernels/offset_dim_assignment_kernels.hpp>
+
+using namespace std;
+using namespace dynd;
+
+offset_dim_type::offset_dim_type(const ndt::type& element_tp)
+    : base_uniform_dim_type(offset_dim_type_id, element_tp, sizeof(int64_t),
+                    sizeof(int64_t), sizeof(offset_dim_type_metadata),
+                    type_flag_blockref)
+{
+    // NOTE: Like var_dim, the lifetime of the elements is owned by
+    //       the memory block of the values, not by the offsets.
+}
+
+offset_dim_type::~offset_dim_type()
+{
+}
+
+/** Gets the elements of one offset_dim element from its offsets */
+static inline const char *get_offset_dim_row(const offset_dim_type_metadata *md,
+                const char *data, intptr_t& out_size)
+{
+    const int64_t *d = reinterpret_cast<const int64_t *>(data);
+    out_size = static_cast<intptr_t>(d[1] - d[0]);
+    return md->values + d[0] * md->stride;
+}
+
+void offset_dim_type::print_data(std::ostream& o, const char *metadata, const char *data) const
+{
+    const offset_dim_type_metadata *md = reinterpret_cast<const offset_dim_type_metadata *>(metadata);
+    intptr_t size;
+    const char *element_data = get_offset_dim_row(md, data, size);
+    intptr_t stride = md->stride;
+    metadata += sizeof(offset_dim_type_metadata);
+    o << "[";
+    for (intptr_t i = 0; i != size; ++i, element_data += stride) {
+        m_element_tp.print_data(o, metadata, element_data);
+        if (i != size - 1) {
+            o << ", ";
+        }
+    }
+    o << "]";
+}
+
+void offset_dim_type::print_type(std::ostream& o) const
+{
+    o << "offset * " << m_element_tp;
+}
+
+bool offset_dim_type::is_expression() const
+{
+    return m_element_tp.is_expression();
+}
+
+bool offset_dim_type::is_unique_data_owner(const char *DYND_UNUSED(metadata)) const
+{
+    // The values are usually shared with the array they were made from
+    return false;
+}
+
+void offset_dim_type::transform_child_types(type_transform_fn_t transform_fn, void *extra,
+                ndt::type& out_transformed_tp, bool& out_was_transformed) const
+{
+    ndt::type tmp_tp;
+    bool was_transformed = false;
+    transform_fn(m_element_tp, extra, tmp_tp, was_transformed);
+    if (was_transformed) {
+        out_transformed_tp = ndt::type(new offset_dim_type(tmp_tp), false);
+        out_was_transformed = true;
+    } else {
+        out_transformed_tp = ndt::type(this, true);
+    }
+}
+
+ndt::type offset_dim_type::get_canonical_type() const
+{
+    return ndt::type(new offset_dim_type(m_element_tp.get_canonical_type()), false);
+}
+
+bool offset_dim_type::is_strided() const
+{
+    return true;
+}
+
+void offset_dim_type::process_strided(const char *metadata, const char *data,
+                ndt::type& out_dt, const char *&out_origin,
+                intptr_t& out_stride, intptr_t& out_dim_size) const
+{
+    const offset_dim_type_metadata *md = reinterpret_cast<const offset_dim_type_metadata *>(metadata);
+    out_dt = m_element_tp;
+    out_origin = get_offset_dim_row(md, data, out_dim_size);
+    out_stride = md->stride;
+}
+
+ndt::type offset_dim_type::apply_linear_index(intptr_t nindices, const irange *indices,
+                size_t current_i, const ndt::type& root_tp, bool leading_dimension) const
+{
+    if (nindices == 0) {
+        return ndt::type(this, true);
+    } else if (leading_dimension) {
+        if (indices->step() == 0) {
+            return m_element_tp.apply_linear_index(nindices-1, indices+1,
+                            current_i+1, root_tp, true);
+        } else {
+            // In leading dimensions, we convert offset_dim to strided_dim
+            ndt::type edt = m_element_tp.apply_linear_index(nindices-1, indices+1,
+                            current_i+1, root_tp, false);
+            return ndt::type(new strided_dim_type(edt), false);
+        }
+    } else if (indices->is_nop()) {
+        // If the indexing operation does nothing, then leave things unchanged
+        ndt::type edt = m_element_tp.apply_linear_index(nindices-1, indices+1,
+                        current_i+1, root_tp, false);
+        return ndt::type(new offset_dim_type(edt), false);
+    } else {
+        throw runtime_error("offset_dim_type::apply_linear_index only supports slicing"
+                        " an offset_dim as the leading dimension");
+    }
+}
+
+intptr_t offset_dim_type::apply_linear_index(intptr_t nindices, const irange *indices, const char *metadata,
+                const ndt::type& result_tp, char *out_metadata,
+                memory_block_data *embedded_reference,
+                size_t current_i, const ndt::type& root_tp,
+                bool leading_dimension, char **inout_data,
+                memory_block_data **inout_dataref) const
+{
+    if (nindices == 0) {
+        // If there are no more indices, copy the metadata verbatim
+        metadata_copy_construct(out_metadata, metadata, embedded_reference);
+        return 0;
+    }
+    const offset_dim_type_metadata *md = reinterpret_cast<const offset_dim_type_metadata *>(metadata);
+    if (leading_dimension) {
+        intptr_t dim_size;
+        const char *begin = get_offset_dim_row(md, *inout_data, dim_size);
+        bool remove_dimension;
+        intptr_t start_index, index_stride, dimension_size;
+        apply_single_linear_index(*indices, dim_size, current_i, &root_tp,
+                        remove_dimension, start_index, index_stride, dimension_size);
+        // Point at the values, which are in the values' memory block
+        *inout_data = const_cast<char *>(begin) + start_index * md->stride;
+        if (*inout_dataref) {
+            memory_block_decref(*inout_dataref);
+        }
+        *inout_dataref = md->blockref ? md->blockref : embedded_reference;
+        memory_block_incref(*inout_dataref);
+        if (remove_dimension) {
+            // Then apply the rest of the indices to the element type
+            if (!m_element_tp.is_builtin()) {
+                return m_element_tp.extended()->apply_linear_index(
+                                nindices - 1, indices + 1,
+                                metadata + sizeof(offset_dim_type_metadata),
+                                result_tp, out_metadata, embedded_reference,
+                                current_i + 1, root_tp,
+                                true, inout_data, inout_dataref);
+            } else {
+                return 0;
+            }
+        } else {
+            // Produce a strided array of the selected values
+            strided_dim_type_metadata *out_md = reinterpret_cast<strided_dim_type_metadata *>(out_metadata);
+            out_md->size = dimension_size;
+            out_md->stride = dimension_size > 1 ? md->stride * index_stride : 0;
+            if (!m_element_tp.is_builtin()) {
+                const strided_dim_type *sad = static_cast<const strided_dim_type *>(result_tp.extended());
+                return m_element_tp.extended()->apply_linear_index(
+                                nindices - 1, indices + 1,
+                                metadata + sizeof(offset_dim_type_metadata),
+                                sad->get_element_type(),
+                                out_metadata + sizeof(strided_dim_type_metadata), embedded_reference,
+                                current_i + 1, root_tp,
+                                false, NULL, NULL);
+            }
+            return 0;
+        }
+    } else if (indices->is_nop()) {
+        // If the indexing operation does nothing, then leave things unchanged
+        metadata_copy_construct_onedim(out_metadata, metadata, embedded_reference);
+        if (!m_element_tp.is_builtin()) {
+            const offset_dim_type *odt = static_cast<const offset_dim_type *>(result_tp.extended());
+            reinterpret_cast<offset_dim_type_metadata *>(out_metadata)->values +=
+                            m_element_tp.extended()->apply_linear_index(
+                                nindices - 1, indices + 1,
+                                metadata + sizeof(offset_dim_type_metadata),
+                                odt->get_element_type(),
+                                out_metadata + sizeof(offset_dim_type_metadata), embedded_reference,
+                                current_i + 1, root_tp,
+                                false, NULL, NULL);
+        }
+        return 0;
+    } else {
+        throw runtime_error("offset_dim_type::apply_linear_index only supports slicing"
+                        " an offset_dim as the leading dimension");
+    }
+}
+
+ndt::type offset_dim_type::at_single(intptr_t i0, const char **inout_metadata, const char **inout_data) const
+{
+    if (inout_metadata) {
+        const offset_dim_type_metadata *md = reinterpret_cast<const offset_dim_type_metadata *>(*inout_metadata);
+        // Modify the metadata
+        *inout_metadata += sizeof(offset_dim_type_metadata);
+        // If requested, modify the data pointer
+        if (inout_data) {
+            intptr_t dim_size;
+            const char *begin = get_offset_dim_row(md, *inout_data, dim_size);
+            // Bounds-checking of the index
+            i0 = apply_single_index(i0, dim_size, NULL);
+            *inout_data = begin + i0 * md->stride;
+        }
+    }
+    return m_element_tp;
+}
+
+ndt::type offset_dim_type::get_type_at_dimension(char **inout_metadata, intptr_t i, intptr_t total_ndim) const
+{
+    if (i == 0) {
+        return ndt::type(this, true);
+    } else {
+        if (inout_metadata) {
+            *inout_metadata += sizeof(offset_dim_type_metadata);
+        }
+        return m_element_tp.get_type_at_dimension(inout_metadata, i - 1, total_ndim + 1);
+    }
+}
+
+intptr_t offset_dim_type::get_dim_size(const char *metadata, const char *data) const
+{
+    if (data != NULL) {
+        intptr_t dim_size;
+        get_offset_dim_row(reinterpret_cast<const offset_dim_type_metadata *>(metadata), data, dim_size);
+        return dim_size;
+    } else {
+        return -1;
+    }
+}
+
+void offset_dim_type::get_shape(intptr_t ndim, intptr_t i, intptr_t *out_shape,
+                const char *metadata, const char *data) const
+{
+    if (metadata == NULL || data == NULL) {
+        out_shape[i] = -1;
+        data = NULL;
+    } else {
+        const offset_dim_type_metadata *md = reinterpret_cast<const offset_dim_type_metadata *>(metadata);
+        intptr_t dim_size;
+        const char *begin = get_offset_dim_row(md, data, dim_size);
+        out_shape[i] = dim_size;
+        data = (dim_size == 1) ? begin : NULL;
+    }
+
+    // Process the later shape values
+    if (i+1 < ndim) {
+        if (!m_element_tp.is_builtin()) {
+            m_element_tp.extended()->get_shape(ndim, i+1, out_shape,
+                            metadata ? (metadata + sizeof(offset_dim_type_metadata)) : NULL,
+                            data);
+        } else {
+            stringstream ss;
+            ss << "requested too many dimensions from type " << ndt::type(this, true);
+            throw runtime_error(ss.str());
+        }
+    }
+}
+
+void offset_dim_type::get_strides(size_t i, intptr_t *out_strides, const char *metadata) const
+{
+    const offset_dim_type_metadata *md = reinterpret_cast<const offset_dim_type_metadata *>(metadata);
+
+    out_strides[i] = md->stride;
+
+    // Process the later shape values
+    if (!m_element_tp.is_builtin()) {
+        m_element_tp.extended()->get_strides(i+1, out_strides, metadata + sizeof(offset_dim_type_metadata));
+    }
+}
+
+axis_order_classification_t offset_dim_type::classify_axis_order(const char *metadata) const
+{
+    // Treat the offset_dim type as C-order, like var_dim
+    if (m_element_tp.get_ndim() > 1) {
+        axis_order_classification_t aoc = m_element_tp.extended()->classify_axis_order(
+                        metadata + sizeof(offset_dim_type_metadata));
+        return (aoc == axis_order_none || aoc == axis_order_c)
+                        ? axis_order_c : axis_order_neither;
+    } else {
+        return axis_order_c;
+    }
+}
+
+bool offset_dim_type::is_lossless_assignment(const ndt::type& dst_tp, const ndt::type& src_tp) const
+{
+    if (dst_tp.extended() == this) {
+        if (src_tp.extended() == this) {
+            return true;
+        } else if (src_tp.get_type_id() == offset_dim_type_id) {
+            return *dst_tp.extended() == *src_tp.extended();
+        }
+    }
+
+    return false;
+}
+
+bool offset_dim_type::operator==(const base_type& rhs) const
+{
+    if (this == &rhs) {
+        return true;
+    } else if (rhs.get_type_id() != offset_dim_type_id) {
+        return false;
+    } else {
+        const offset_dim_type *dt = static_cast<const offset_dim_type*>(&rhs);
+        return m_element_tp == dt->m_element_tp;
+    }
+}
+
+void offset_dim_type::metadata_default_construct(char *DYND_UNUSED(metadata),
+                intptr_t DYND_UNUSED(ndim), const intptr_t* DYND_UNUSED(shape)) const
+{
+    // The offsets of N elements take N+1 values, so the enclosing
+    // dimension can't allocate them
+    stringstream ss;
+    ss << "Cannot default construct an array of type " << ndt::type(this, true);
+    ss << ", use nd::make_offset_dim_array to create it";
+    throw runtime_error(ss.str());
+}
+
+void offset_dim_type::metadata_copy_construct(char *dst_metadata, const char *src_metadata, memory_block_data *embedded_reference) const
+{
+    metadata_copy_construct_onedim(dst_metadata, src_metadata, embedded_reference);
+    if (!m_element_tp.is_builtin()) {
+        m_element_tp.extended()->metadata_copy_construct(dst_metadata + sizeof(offset_dim_type_metadata),
+                        src_metadata + sizeof(offset_dim_type_metadata), embedded_reference);
+    }
+}
+
+size_t offset_dim_type::metadata_copy_construct_onedim(char *dst_metadata, const char *src_metadata,
+                memory_block_data *embedded_reference) const
+{
+    const offset_dim_type_metadata *src_md = reinterpret_cast<const offset_dim_type_metadata *>(src_metadata);
+    offset_dim_type_metadata *dst_md = reinterpret_cast<offset_dim_type_metadata *>(dst_metadata);
+    dst_md->values = src_md->values;
+    dst_md->stride = src_md->stride;
+    dst_md->blockref = src_md->blockref ? src_md->blockref : embedded_reference;
+    if (dst_md->blockref) {
+        memory_block_incref(dst_md->blockref);
+    }
+    return sizeof(offset_dim_type_metadata);
+}
+
+void offset_dim_type::metadata_reset_buffers(char *DYND_UNUSED(metadata)) const
+{
+    throw runtime_error("cannot reset the buffers of an offset_dim type, its values are fixed");
+}
+
+void offset_dim_type::metadata_finalize_buffers(char *metadata) const
+{
+    // The values buffer is never appended to, only finalize any child metadata
+    if (!m_element_tp.is_builtin()) {
+        m_element_tp.extended()->metadata_finalize_buffers(metadata + sizeof(offset_dim_type_metadata));
+    }
+}
+
+void offset_dim_type::metadata_destruct(char *metadata) const
+{
+    offset_dim_type_metadata *md = reinterpret_cast<offset_dim_type_metadata *>(metadata);
+    if (md->blockref) {
+        memory_block_decref(md->blockref);
+    }
+    if (!m_element_tp.is_builtin()) {
+        m_element_tp.extended()->metadata_destruct(metadata + sizeof(offset_dim_type_metadata));
+    }
+}
+
+void offset_dim_type::metadata_debug_print(const char *metadata, std::ostream& o, const std::string& indent) const
+{
+    const offset_dim_type_metadata *md = reinterpret_cast<const offset_dim_type_metadata *>(metadata);
+    o << indent << "offset_dim metadata\n";
+    o << indent << " values: " << (const void *)md->values << "\n";
+    o << indent << " stride: " << md->stride << "\n";
+    memory_block_debug_print(md->blockref, o, indent + " ");
+    if (!m_element_tp.is_builtin()) {
+        m_element_tp.extended()->metadata_debug_print(metadata + sizeof(offset_dim_type_metadata), o, indent + "  ");
+    }
+}
+
+// Iteration with iterdata needs a fixed shape for each dimension being
+// iterated, which a ragged dimension doesn't have
+static void throw_no_iterdata()
+{
+    throw type_error("offset_dim does not support iterdata");
+}
+
+size_t offset_dim_type::get_iterdata_size(intptr_t DYND_UNUSED(ndim)) const
+{
+    throw_no_iterdata();
+    return 0;
+}
+
+size_t offset_dim_type::iterdata_construct(iterdata_common *DYND_UNUSED(iterdata), const char **DYND_UNUSED(inout_metadata), intptr_t DYND_UNUSED(ndim), const intptr_t* DYND_UNUSED(shape), ndt::type& DYND_UNUSED(out_uniform_tp)) const
+{
+    throw_no_iterdata();
+    return 0;
+}
+
+size_t offset_dim_type::iterdata_destruct(iterdata_common *DYND_UNUSED(iterdata), intptr_t DYND_UNUSED(ndim)) const
+{
+    throw_no_iterdata();
+    return 0;
+}
+
+size_t offset_dim_type::make_assignment_kernel(
+                ckernel_builder *out, size_t offset_out,
+                const ndt::type& dst_tp, const char *dst_metadata,
+                const ndt::type& src_tp, const char *src_metadata,
+                kernel_request_t kernreq, assign_error_mode errmode,
+                const eval::eval_context *ectx) const
+{
+    if (this == dst_tp.extended()) {
+        switch (src_tp.get_type_id()) {
+            case offset_dim_type_id:
+            case var_dim_type_id:
+            case strided_dim_type_id:
+            case fixed_dim_type_id:
+                break;
+            default:
+                if (src_tp.get_ndim() >= dst_tp.get_ndim() && !src_tp.is_builtin()) {
+                    // Give the src type a chance to make a kernel
+                    return src_tp.extended()->make_assignment_kernel(out, offset_out,
+                                    dst_tp, dst_metadata,
+                                    src_tp, src_metadata,
+                                    kernreq, errmode, ectx);
+                }
+                break;
+        }
+        return make_to_offset_dim_assignment_kernel(out, offset_out,
+                        dst_tp, dst_metadata,
+                        src_tp, src_metadata,
+                        kernreq, errmode, ectx);
+    } else if (dst_tp.get_ndim() < src_tp.get_ndim()) {
+        throw broadcast_error(dst_tp, dst_metadata, src_tp, src_metadata);
+    } else if (dst_tp.get_type_id() == var_dim_type_id ||
+                    dst_tp.get_type_id() == strided_dim_type_id ||
+                    dst_tp.get_type_id() == fixed_dim_type_id) {
+        return make_from_offset_dim_assignment_kernel(out, offset_out,
+                        dst_tp, dst_metadata,
+                        src_tp, src_metadata,
+                        kernreq, errmode, ectx);
+    } else {
+        stringstream ss;
+        ss << "Cannot assign from " << src_tp << " to " << dst_tp;
+        throw dynd::type_error(ss.str());
+    }
+}
+
+void offset_dim_type::foreach_leading(char *data, const char *metadata, foreach_fn_t callback, void *callback_data) const
+{
+    const offset_dim_type_metadata *md = reinterpret_cast<const offset_dim_type_metadata *>(metadata);
+    const char *child_metadata = metadata + sizeof(offset_dim_type_metadata);
+    intptr_t dim_size;
+    char *element_data = const_cast<char *>(get_offset_dim_row(md, data, dim_size));
+    intptr_t stride = md->stride;
+    for (intptr_t i = 0; i < dim_size; ++i, element_data += stride) {
+        callback(m_element_tp, element_data, child_metadata, callback_data);
+    }
+}
+
+/**
+ * Gets the size, stride, element type and element metadata of a
+ * one-dimensional strided_dim or fixed_dim array.
+ */
+static void get_one_dim(const nd::array& a, const char *name, intptr_t& out_size, intptr_t& out_stride,
+                ndt::type& out_element_tp, const char *&out_element_metadata)
+{
+    const ndt::type& tp = a.get_type();
+    if (tp.get_ndim() >= 1 && tp.get_type_id() == strided_dim_type_id) {
+        const strided_dim_type_metadata *md =
+                        reinterpret_cast<const strided_dim_type_metadata *>(a.get_ndo_meta());
+        out_size = md->size;
+        out_stride = md->stride;
+        out_element_tp = static_cast<const strided_dim_type *>(tp.extended())->get_element_type();
+        out_element_metadata = a.get_ndo_meta() + sizeof(strided_dim_type_metadata);
+    } else if (tp.get_ndim() >= 1 && tp.get_type_id() == fixed_dim_type_id) {
+        const fixed_dim_type *fdt = static_cast<const fixed_dim_type *>(tp.extended());
+        out_size = fdt->get_fixed_dim_size();
+        out_stride = fdt->get_fixed_stride();
+        out_element_tp = fdt->get_element_type();
+        out_element_metadata = a.get_ndo_meta();
+    } else {
+        stringstream ss;
+        ss << "make_offset_dim_array: the " << name << " must be a strided or fixed dimension, not " << tp;
+        throw runtime_error(ss.str());
+    }
+}
+
+nd::array nd::make_offset_dim_array(const nd::array& offsets, const nd::array& values)
+{
+    intptr_t offsets_size, offsets_stride, values_size, values_stride;
+    ndt::type offsets_element_tp, values_element_tp;
+    const char *offsets_element_metadata, *values_element_metadata;
+    get_one_dim(offsets, "offsets", offsets_size, offsets_stride,
+                    offsets_element_tp, offsets_element_metadata);
+    get_one_dim(values, "values", values_size, values_stride,
+                    values_element_tp, values_element_metadata);
+    if (offsets_element_tp.get_type_id() != int64_type_id ||
+                    (offsets_size > 1 && offsets_stride != sizeof(int64_t)) || offsets_size < 1) {
+        stringstream ss;
+        ss << "make_offset_dim_array: the offsets must be a nonempty contiguous int64 array, not ";
+        ss << offsets.get_type();
+        throw runtime_error(ss.str());
+    }
+    // Validate the offsets, so indexing the values stays in bounds
+    const int64_t *offsets_ptr = reinterpret_cast<const int64_t *>(offsets.get_readonly_originptr());
+    for (intptr_t i = 0; i < offsets_size; ++i) {
+        if (offsets_ptr[i] < 0 || offsets_ptr[i] > values_size ||
+                        (i > 0 && offsets_ptr[i] < offsets_ptr[i - 1])) {
+            stringstream ss;
+            ss << "make_offset_dim_array: offset " << offsets_ptr[i] << " at index " << i;
+            ss << " is out of order or out of bounds for " << values_size << " values";
+            throw runtime_error(ss.str());
+        }
+    }
+
+    intptr_t dim_size = offsets_size - 1, stride = sizeof(int64_t);
+    char *uniform_metadata = NULL;
+    nd::array result = nd::make_strided_array_from_data(ndt::make_offset_dim(values_element_tp),
+                    1, &dim_size, &stride,
+                    offsets.get_flags() & values.get_flags(),
+                    offsets.get_ndo()->m_data_pointer, offsets.get_data_memblock(),
+                    &uniform_metadata);
+    offset_dim_type_metadata *md = reinterpret_cast<offset_dim_type_metadata *>(uniform_metadata);
+    md->blockref = values.get_data_memblock().release();
+    md->values = values.get_ndo()->m_data_pointer;
+    md->stride = values_stride;
+    if (!values_element_tp.is_builtin()) {
+        values_element_tp.extended()->metadata_copy_construct(
+                        uniform_metadata + sizeof(offset_dim_type_metadata),
+                        values_element_metadata, md->blockref);
+    }
+    return result;
+}
+
+nd::array nd::make_offset_dim_array(const nd::array& rows)
+{
+    intptr_t dim_size, stride;
+    ndt::type row_tp;
+    const char *row_metadata;
+    get_one_dim(rows, "rows", dim_size, stride, row_tp, row_metadata);
+    if (row_tp.get_kind() != uniform_dim_kind) {
+        stringstream ss;
+        ss << "make_offset_dim_array: the rows must be two-dimensional, not " << rows.get_type();
+        throw runtime_error(ss.str());
+    }
+    const base_uniform_dim_type *row_dim = static_cast<const base_uniform_dim_type *>(row_tp.extended());
+
+    // Prefix sum of the row sizes
+    nd::array offsets = nd::empty(dim_size + 1, ndt::make_strided_dim(ndt::make_type<int64_t>()));
+    int64_t *offsets_ptr = reinterpret_cast<int64_t *>(offsets.get_readwrite_originptr());
+    const char *data = rows.get_readonly_originptr();
+    offsets_ptr[0] = 0;
+    for (intptr_t i = 0; i < dim_size; ++i, data += stride) {
+        offsets_ptr[i + 1] = offsets_ptr[i] + row_dim->get_dim_size(row_metadata, data);
+    }
+
+    nd::array values = nd::empty(offsets_ptr[dim_size],
+                    ndt::make_strided_dim(row_dim->get_element_type()));
+    nd::array result = make_offset_dim_array(offsets, values);
+    result.val_assign(rows);
+    return result;
+}
+
+nd::array nd::get_offset_dim_values(const nd::array& a)
+{
+    const ndt::type& tp = a.get_type();
+    if (tp.get_type_id() != strided_dim_type_id ||
+                    tp.at_single(0).get_type_id() != offset_dim_type_id) {
+        stringstream ss;
+        ss << "get_offset_dim_values: expected a strided array of offset_dim, not " << tp;
+        throw runtime_error(ss.str());
+    }
+    const strided_dim_type_metadata *outer_md =
+                    reinterpret_cast<const strided_dim_type_metadata *>(a.get_ndo_meta());
+    const char *uniform_metadata = a.get_ndo_meta() + sizeof(strided_dim_type_metadata);
+    const offset_dim_type_metadata *md =
+                    reinterpret_cast<const offset_dim_type_metadata *>(uniform_metadata);
+    const offset_dim_type *odt = static_cast<const offset_dim_type *>(tp.at_single(0).extended());
+    // The values span from the first row's start to the last row's end
+    intptr_t count = 0;
+    const int64_t *first = reinterpret_cast<const int64_t *>(a.get_readonly_originptr());
+    if (outer_md->size > 0) {
+        const int64_t *last = reinterpret_cast<const int64_t *>(
+                        a.get_readonly_originptr() + (outer_md->size - 1) * outer_md->stride);
+        count = static_cast<intptr_t>(last[1] - first[0]);
+    }
+    if (count < 0 || (outer_md->size > 1 && outer_md->stride != sizeof(int64_t))) {
+        throw runtime_error("get_offset_dim_values: the rows must be contiguous and in order");
+    }
+    const ndt::type& element_tp = odt->get_element_type();
+    char *element_metadata = NULL;
+    intptr_t values_stride = md->stride;
+    nd::array result = nd::make_strided_array_from_data(element_tp, 1, &count, &values_stride,
+                    a.get_flags(),
+                    md->values + (count > 0 ? first[0] * md->stride : 0),
+                    memory_block_ptr(md->blockref, true), &element_metadata);
+    if (!element_tp.is_builtin()) {
+        element_tp.extended()->metadata_copy_construct(element_metadata,
+                        uniform_metadata + sizeof(offset_dim_type_metadata), md->blockref);
+    }
+    return result;
+}
@@ -9,6 +9,7 @@
 #include <dynd/shape_tools.hpp>
 #include <dynd/exceptions.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/kernels/struct_assignment_kernels.hpp>
 #include <dynd/gfunc/callable.hpp>
 #include <dynd/gfunc/make_callable.hpp>
 
@@ -492,6 +493,103 @@ void strided_dim_type::data_destruct_strided(const char *metadata, char *data,
     }
 }
 
+/**
+ * When assigning between two strided dimensions of strided dimensions
+ * whose memory orders differ, or which are both in the opposite order
+ * of the dimensions, creates a kernel iterating the pair of dimensions
+ * in a better order. The axis permutations of the strides pick the
+ * order, with a tiled traversal when src and dst disagree, like in a
+ * transpose. Returns 0 when the nested strided kernels are already fine.
+ */
+static size_t make_permuted_strided_assignment_kernel(
+                ckernel_builder *out, size_t offset_out,
+                const strided_dim_type *dst_sad, const char *dst_metadata,
+                const strided_dim_type *src_sad, const char *src_metadata,
+                kernel_request_t kernreq, assign_error_mode errmode,
+                const eval::eval_context *ectx)
+{
+    const ndt::type& dst_el_tp = dst_sad->get_element_type();
+    const ndt::type& src_el_tp = src_sad->get_element_type();
+    if (dst_el_tp.get_type_id() != strided_dim_type_id ||
+                    src_el_tp.get_type_id() != strided_dim_type_id) {
+        return 0;
+    }
+    const strided_dim_type_metadata *dst_md =
+                    reinterpret_cast<const strided_dim_type_metadata *>(dst_metadata);
+    const strided_dim_type_metadata *src_md =
+                    reinterpret_cast<const strided_dim_type_metadata *>(src_metadata);
+    // Leave broadcasting to the nested kernels
+    if (dst_md[0].size != src_md[0].size || dst_md[1].size != src_md[1].size) {
+        return 0;
+    }
+    intptr_t dst_strides[2] = {dst_md[0].stride, dst_md[1].stride};
+    intptr_t src_strides[2] = {src_md[0].stride, src_md[1].stride};
+    if (dst_strides[0] == 0 || dst_strides[1] == 0 || src_strides[0] == 0 || src_strides[1] == 0) {
+        return 0;
+    }
+    // Small arrays stay in the cache whatever the order
+    const ndt::type& dst_inner_tp = static_cast<const strided_dim_type *>(
+                    dst_el_tp.extended())->get_element_type();
+    intptr_t element_size = dst_inner_tp.get_data_size();
+    if (element_size == 0 || dst_md[0].size * dst_md[1].size * element_size < 16384) {
+        return 0;
+    }
+
+    int dst_perm[2], src_perm[2], perm[2];
+    const intptr_t *operstrides[2] = {dst_strides, src_strides};
+    strides_to_axis_perm(2, dst_strides, dst_perm);
+    strides_to_axis_perm(2, src_strides, src_perm);
+    multistrides_to_axis_perm(2, 2, operstrides, perm);
+    bool blocked = (dst_perm[0] != src_perm[0]);
+    if (!blocked && perm[0] == 1) {
+        // Both are in the order of the dimensions
+        return 0;
+    }
+
+    out->ensure_capacity(offset_out + sizeof(blocked_assign_kernel_extra));
+    blocked_assign_kernel_extra *e = out->get_at<blocked_assign_kernel_extra>(offset_out);
+    switch (kernreq) {
+        case kernel_request_single:
+            e->base.set_function<unary_single_operation_t>(&blocked_assign_kernel_extra::single);
+            break;
+        case kernel_request_strided:
+            e->base.set_function<unary_strided_operation_t>(&blocked_assign_kernel_extra::strided);
+            break;
+        default: {
+            stringstream ss;
+            ss << "strided_dim_type::make_assignment_kernel: unrecognized request " << (int)kernreq;
+            throw runtime_error(ss.str());
+        }
+    }
+    e->base.destructor = &blocked_assign_kernel_extra::destruct;
+    // The inner loop goes along perm[0], the axis with the smallest strides
+    int inner = perm[0], outer = perm[1];
+    e->size0 = dst_md[outer].size;
+    e->size1 = dst_md[inner].size;
+    e->dst_stride0 = dst_strides[outer];
+    e->src_stride0 = src_strides[outer];
+    e->dst_stride1 = dst_strides[inner];
+    e->src_stride1 = src_strides[inner];
+    if (blocked) {
+        // Tiles of about 256 bytes per row, so a tile's rows of both
+        // src and dst use whole cache lines and fit in the L1 cache
+        intptr_t block_size = 256 / element_size;
+        block_size = max(intptr_t(8), min(intptr_t(64), block_size));
+        e->block_size0 = block_size;
+        e->block_size1 = block_size;
+    } else {
+        // Just a reordering of the loops
+        e->block_size0 = e->size0;
+        e->block_size1 = e->size1;
+    }
+    return ::make_assignment_kernel(out, offset_out + sizeof(blocked_assign_kernel_extra),
+                    static_cast<const strided_dim_type *>(dst_el_tp.extended())->get_element_type(),
+                    dst_metadata + 2 * sizeof(strided_dim_type_metadata),
+                    static_cast<const strided_dim_type *>(src_el_tp.extended())->get_element_type(),
+                    src_metadata + 2 * sizeof(strided_dim_type_metadata),
+                    kernel_request_strided, errmode, ectx);
+}
+
 size_t strided_dim_type::make_assignment_kernel(
                 ckernel_builder *out, size_t offset_out,
                 const ndt::type& dst_tp, const char *dst_metadata,
@@ -500,6 +598,13 @@ size_t strided_dim_type::make_assignment_kernel(
                 const eval::eval_context *ectx) const
 {
     if (this == dst_tp.extended()) {
+        if (src_tp.get_kind() == struct_kind && is_columnar_struct_assignment(dst_tp, src_tp)) {
+            // Columns of a struct into this array of structs
+            return make_columnar_struct_assignment_kernel(out, offset_out,
+                            dst_tp, dst_metadata,
+                            src_tp, src_metadata,
+                            kernreq, errmode, ectx);
+        }
         out->ensure_capacity(offset_out + sizeof(strided_assign_kernel_extra));
         const strided_dim_type_metadata *dst_md =
                         reinterpret_cast<const strided_dim_type_metadata *>(dst_metadata);
@@ -536,6 +641,12 @@ size_t strided_dim_type::make_assignment_kernel(
             if (src_md->size != 1 && dst_md->size != src_md->size) {
                 throw broadcast_error(dst_tp, dst_metadata, src_tp, src_metadata);
             }
+            // Iterate two dimensions in a different order if their memory orders call for it
+            size_t permuted_offset = make_permuted_strided_assignment_kernel(out, offset_out,
+                            this, dst_metadata, src_sad, src_metadata, kernreq, errmode, ectx);
+            if (permuted_offset != 0) {
+                return permuted_offset;
+            }
             e->size = dst_md->size;
             e->dst_stride = dst_md->stride;
             // In DyND, the src stride is required to be zero for size-one dimensions,
@@ -11,6 +11,7 @@
 #include <dynd/gfunc/make_callable.hpp>
 #include <dynd/kernels/struct_assignment_kernels.hpp>
 #include <dynd/kernels/struct_comparison_kernels.hpp>
+#include <dynd/kernels/hash_kernels.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -272,6 +273,11 @@ size_t struct_type::make_assignment_kernel(
                             dst_tp, dst_metadata,
                             src_tp, src_metadata,
                             kernreq, errmode, ectx);
+        } else if (is_columnar_struct_assignment(dst_tp, src_tp)) {
+            return make_columnar_struct_assignment_kernel(out_ckb, ckb_offset,
+                            dst_tp, dst_metadata,
+                            src_tp, src_metadata,
+                            kernreq, errmode, ectx);
         } else if (src_tp.is_builtin()) {
             return make_broadcast_to_struct_assignment_kernel(out_ckb, ckb_offset,
                             dst_tp, dst_metadata,
@@ -313,6 +319,15 @@ size_t struct_type::make_comparison_kernel(
     throw not_comparable_error(src0_dt, src1_dt, comptype);
 }
 
+size_t struct_type::make_hash_kernel(
+                ckernel_builder *out, size_t offset_out,
+                const char *metadata,
+                const eval::eval_context *ectx) const
+{
+    return make_struct_hash_kernel(out, offset_out,
+                    ndt::type(this, true), metadata, ectx);
+}
+
 bool struct_type::operator==(const base_type& rhs) const
 {
     if (this == &rhs) {
@@ -115,6 +115,8 @@ std::ostream& dynd::operator<<(std::ostream& o, type_id_t tid)
             return (o << "fixed_dim");
         case var_dim_type_id:
             return (o << "var_dim");
+        case offset_dim_type_id:
+            return (o << "offset_dim");
         case struct_type_id:
             return (o << "struct");
         case cstruct_type_id:
@@ -0,0 +1,432 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+# define NOMINMAX
+# include <Windows.h>
+#else
+# include <pthread.h>
+#endif
+
+#include <dynd/types/tzdata.hpp>
+#include <dynd/types/date_util.hpp>
+
+using namespace std;
+using namespace dynd;
+
+#define DYND_TICKS_PER_SECOND 10000000LL
+
+// Transitions are extended with the POSIX TZ rule up to this year
+#define DYND_TZ_RULE_END_YEAR 2400
+
+namespace {
+    inline uint32_t read_be32(const char *p)
+    {
+        const unsigned char *u = reinterpret_cast<const unsigned char *>(p);
+        return (static_cast<uint32_t>(u[0]) << 24) | (static_cast<uint32_t>(u[1]) << 16) |
+                        (static_cast<uint32_t>(u[2]) << 8) | static_cast<uint32_t>(u[3]);
+    }
+
+    inline int64_t read_be64(const char *p)
+    {
+        return static_cast<int64_t>((static_cast<uint64_t>(read_be32(p)) << 32) | read_be32(p + 4));
+    }
+
+    /** The header counts of a TZif data block */
+    struct tzif_counts {
+        uint32_t isutcnt, isstdcnt, leapcnt, timecnt, typecnt, charcnt;
+
+        size_t data_size(size_t time_size) const {
+            return timecnt * time_size + timecnt + typecnt * 6 + charcnt +
+                            leapcnt * (time_size + 4) + isstdcnt + isutcnt;
+        }
+    };
+
+    const size_t tzif_header_size = 44;
+
+    static void invalid_tzif(const string& name)
+    {
+        stringstream ss;
+        ss << "the time zone database entry for \"" << name << "\" is not a valid TZif file";
+        throw runtime_error(ss.str());
+    }
+
+    static tzif_counts read_tzif_header(const string& name, const char *begin, const char *end)
+    {
+        if (end - begin < (intptr_t)tzif_header_size || memcmp(begin, "TZif", 4) != 0) {
+            invalid_tzif(name);
+        }
+        tzif_counts c;
+        c.isutcnt = read_be32(begin + 20);
+        c.isstdcnt = read_be32(begin + 24);
+        c.leapcnt = read_be32(begin + 28);
+        c.timecnt = read_be32(begin + 32);
+        c.typecnt = read_be32(begin + 36);
+        c.charcnt = read_be32(begin + 40);
+        if (c.typecnt == 0) {
+            invalid_tzif(name);
+        }
+        return c;
+    }
+
+    /**
+     * A parsed POSIX TZ string like "EST5EDT,M3.2.0,M11.1.0", as found
+     * in the footer of a TZif file. The offsets are seconds east of UTC,
+     * the opposite sign from the string.
+     */
+    struct posix_tz_rule {
+        struct date_rule {
+            // 'J' for Jn, 'n' for n, 'M' for Mm.w.d
+            char kind;
+            int n, m, w, d;
+            // Seconds after local midnight
+            int time;
+        };
+
+        int std_offset, dst_offset;
+        bool has_dst;
+        date_rule start, end;
+
+        /** Returns the 1970 epoch day the rule falls on in the given year */
+        static int32_t rule_days(const date_rule& r, int year) {
+            int32_t jan1 = date_ymd::to_days(year, 1, 1);
+            switch (r.kind) {
+                case 'J':
+                    // 1-based, never counting February 29
+                    return jan1 + r.n - 1 + (date_ymd::is_leap_year(year) && r.n >= 60);
+                case 'n':
+                    return jan1 + r.n;
+                default: {
+                    // Day d (0 is Sunday) of week w (5 is the last) of month m
+                    int32_t first = date_ymd::to_days(year, r.m, 1);
+                    int first_weekday = (date_ymd::days_to_weekday(first) + 1) % 7;
+                    int day = (r.d - first_weekday + 7) % 7 + 7 * (r.w - 1);
+                    while (day >= date_ymd::get_month_length(year, r.m)) {
+                        day -= 7;
+                    }
+                    return first + day;
+                }
+            }
+        }
+
+        /** Appends the transitions of a year, as UTC seconds with the offset after */
+        void get_year_transitions(int year, vector<pair<int64_t, int> >& out) const {
+            // Daylight time starts at a standard time, and ends at a daylight time
+            int64_t start_utc = rule_days(start, year) * 86400LL + start.time - std_offset;
+            int64_t end_utc = rule_days(end, year) * 86400LL + end.time - dst_offset;
+            if (start_utc < end_utc) {
+                out.push_back(make_pair(start_utc, dst_offset));
+                out.push_back(make_pair(end_utc, std_offset));
+            } else {
+                // The southern hemisphere, with daylight time over the new year
+                out.push_back(make_pair(end_utc, std_offset));
+                out.push_back(make_pair(start_utc, dst_offset));
+            }
+        }
+    };
+
+    class posix_tz_parser {
+        const char *m_begin, *m_end;
+
+        bool parse_name() {
+            if (m_begin < m_end && *m_begin == '<') {
+                while (m_begin < m_end && *m_begin != '>') {
+                    ++m_begin;
+                }
+                if (m_begin == m_end) {
+                    return false;
+                }
+                ++m_begin;
+                return true;
+            }
+            const char *name_begin = m_begin;
+            while (m_begin < m_end && ((*m_begin >= 'A' && *m_begin <= 'Z') ||
+                                    (*m_begin >= 'a' && *m_begin <= 'z'))) {
+                ++m_begin;
+            }
+            return m_begin - name_begin >= 3;
+        }
+
+        bool parse_uint(int& out) {
+            if (m_begin == m_end || *m_begin < '0' || *m_begin > '9') {
+                return false;
+            }
+            out = 0;
+            while (m_begin < m_end && *m_begin >= '0' && *m_begin <= '9' && out < 100000) {
+                out = out * 10 + (*m_begin++ - '0');
+            }
+            return true;
+        }
+
+        /** Parses [+-]hh[:mm[:ss]] as seconds */
+        bool parse_time(int& out) {
+            int sign = 1;
+            if (m_begin < m_end && (*m_begin == '+' || *m_begin == '-')) {
+                sign = (*m_begin++ == '-') ? -1 : 1;
+            }
+            int h, m = 0, s = 0;
+            if (!parse_uint(h)) {
+                return false;
+            }
+            if (m_begin < m_end && *m_begin == ':') {
+                ++m_begin;
+                if (!parse_uint(m)) {
+                    return false;
+                }
+                if (m_begin < m_end && *m_begin == ':') {
+                    ++m_begin;
+                    if (!parse_uint(s)) {
+                        return false;
+                    }
+                }
+            }
+            out = sign * (h * 3600 + m * 60 + s);
+            return true;
+        }
+
+        bool parse_date_rule(posix_tz_rule::date_rule& out) {
+            if (m_begin == m_end || *m_begin++ != ',') {
+                return false;
+            }
+            if (m_begin < m_end && *m_begin == 'M') {
+                ++m_begin;
+                out.kind = 'M';
+                if (!parse_uint(out.m) || m_begin == m_end || *m_begin++ != '.' ||
+                                !parse_uint(out.w) || m_begin == m_end || *m_begin++ != '.' ||
+                                !parse_uint(out.d)) {
+                    return false;
+                }
+                if (out.m < 1 || out.m > 12 || out.w < 1 || out.w > 5 || out.d > 6) {
+                    return false;
+                }
+            } else {
+                out.kind = 'n';
+                if (m_begin < m_end && *m_begin == 'J') {
+                    ++m_begin;
+                    out.kind = 'J';
+                }
+                if (!parse_uint(out.n) || out.n > 365 || (out.kind == 'J' && out.n < 1)) {
+                    return false;
+                }
+            }
+            out.time = 2 * 3600;
+            if (m_begin < m_end && *m_begin == '/') {
+                ++m_begin;
+                return parse_time(out.time);
+            }
+            return true;
+        }
+
+    public:
+        posix_tz_parser(const char *begin, const char *end)
+            : m_begin(begin), m_end(end)
+        {
+        }
+
+        bool parse(posix_tz_rule& out) {
+            int offset;
+            if (!parse_name() || !parse_time(offset)) {
+                return false;
+            }
+            out.std_offset = -offset;
+            out.has_dst = m_begin < m_end;
+            if (!out.has_dst) {
+                return true;
+            }
+            if (!parse_name()) {
+                return false;
+            }
+            out.dst_offset = out.std_offset + 3600;
+            if (m_begin < m_end && *m_begin != ',') {
+                if (!parse_time(offset)) {
+                    return false;
+                }
+                out.dst_offset = -offset;
+            }
+            // Without explicit rules, POSIX leaves the dates up to the
+            // implementation, so they are treated as unusable
+            return parse_date_rule(out.start) && parse_date_rule(out.end) && m_begin == m_end;
+        }
+    };
+} // anonymous namespace
+
+tz_transitions::tz_transitions(const std::string& name, const char *tzif_begin, const char *tzif_end)
+    : m_name(name)
+{
+    const char *begin = tzif_begin, *end = tzif_end;
+    tzif_counts c = read_tzif_header(name, begin, end);
+    size_t time_size = 4;
+    if (begin[4] >= '2') {
+        // Skip the 32-bit data for the 64-bit data which follows it
+        begin += tzif_header_size + c.data_size(4);
+        c = read_tzif_header(name, begin, end);
+        time_size = 8;
+    }
+    const char *data = begin + tzif_header_size;
+    if ((size_t)(end - data) < c.data_size(time_size)) {
+        invalid_tzif(name);
+    }
+    const char *times = data;
+    const char *type_indices = times + c.timecnt * time_size;
+    const char *ttinfos = type_indices + c.timecnt;
+
+    // Before the first transition, the first local time type applies
+    vector<pair<int64_t, int> > transitions;
+    int first_offset = static_cast<int32_t>(read_be32(ttinfos));
+    for (uint32_t i = 0; i < c.timecnt; ++i) {
+        int64_t t = (time_size == 8) ? read_be64(times + 8 * i)
+                                     : static_cast<int32_t>(read_be32(times + 4 * i));
+        uint8_t type_index = static_cast<uint8_t>(type_indices[i]);
+        if (type_index >= c.typecnt) {
+            invalid_tzif(name);
+        }
+        int offset = static_cast<int32_t>(read_be32(ttinfos + 6 * type_index));
+        // Skip the "big bang" transitions some files start with,
+        // which can't be represented as ticks
+        if (t < -(1LL << 40)) {
+            first_offset = offset;
+        } else {
+            transitions.push_back(make_pair(t, offset));
+        }
+    }
+
+    // The footer rule, from the year of the last transition
+    if (time_size == 8) {
+        const char *footer = data + c.data_size(8);
+        if (footer < end && *footer == '\n') {
+            const char *footer_end = static_cast<const char *>(memchr(footer + 1, '\n', end - footer - 1));
+            posix_tz_rule rule;
+            if (footer_end != NULL &&
+                            posix_tz_parser(footer + 1, footer_end).parse(rule) && rule.has_dst) {
+                int64_t last = transitions.empty() ? -(1LL << 40) : transitions.back().first;
+                date_ymd ymd;
+                ymd.set_from_days(static_cast<int32_t>(
+                                max(last, (int64_t)-10000 * 86400) / 86400));
+                vector<pair<int64_t, int> > year_transitions;
+                for (int year = max((int)ymd.year, 1900); year <= DYND_TZ_RULE_END_YEAR; ++year) {
+                    year_transitions.clear();
+                    rule.get_year_transitions(year, year_transitions);
+                    for (size_t i = 0; i < year_transitions.size(); ++i) {
+                        if (year_transitions[i].first > last) {
+                            transitions.push_back(year_transitions[i]);
+                            last = year_transitions[i].first;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    m_offsets.push_back(first_offset * DYND_TICKS_PER_SECOND);
+    for (size_t i = 0; i < transitions.size(); ++i) {
+        int64_t offset = transitions[i].second * DYND_TICKS_PER_SECOND;
+        // Leave out transitions which only change the abbreviation or DST flag
+        if (offset == m_offsets.back()) {
+            continue;
+        }
+        int64_t utc = transitions[i].first * DYND_TICKS_PER_SECOND;
+        m_utc_transitions.push_back(utc);
+        m_local_transitions.push_back(utc + max(offset, m_offsets.back()));
+        m_offsets.push_back(offset);
+    }
+}
+
+namespace {
+    typedef map<string, const tz_transitions *> tz_cache;
+
+    // Statically initialized, like the ckernel cache lock
+#ifdef _WIN32
+    SRWLOCK tz_cache_mutex = SRWLOCK_INIT;
+#else
+    pthread_mutex_t tz_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+    // Allocated on first use, while holding the lock
+    tz_cache *tz_cache_instance = NULL;
+
+    class tz_cache_lock {
+        // Non-copyable
+        tz_cache_lock(const tz_cache_lock&);
+        tz_cache_lock& operator=(const tz_cache_lock&);
+    public:
+        tz_cache_lock() {
+#ifdef _WIN32
+            AcquireSRWLockExclusive(&tz_cache_mutex);
+#else
+            pthread_mutex_lock(&tz_cache_mutex);
+#endif
+        }
+
+        ~tz_cache_lock() {
+#ifdef _WIN32
+            ReleaseSRWLockExclusive(&tz_cache_mutex);
+#else
+            pthread_mutex_unlock(&tz_cache_mutex);
+#endif
+        }
+
+        /** The cache, which must only be touched while locked */
+        tz_cache& get_cache() {
+            if (tz_cache_instance == NULL) {
+                tz_cache_instance = new tz_cache;
+            }
+            return *tz_cache_instance;
+        }
+    };
+
+    static void unknown_tz(const string& name)
+    {
+        stringstream ss;
+        ss << "unknown time zone \"" << name << "\"";
+        throw runtime_error(ss.str());
+    }
+
+    static const tz_transitions *load_tz_transitions(const string& name)
+    {
+        // Only plain relative paths inside the database
+        if (name.empty() || name[0] == '/' || name[0] == '\\' || name.find("..") != string::npos) {
+            unknown_tz(name);
+        }
+        const char *tzdir = getenv("TZDIR");
+        string path = (tzdir != NULL && *tzdir != '\0') ? tzdir : "/usr/share/zoneinfo";
+        path += '/';
+        path += name;
+        FILE *f = fopen(path.c_str(), "rb");
+        if (f == NULL) {
+            unknown_tz(name);
+        }
+        vector<char> contents;
+        char buf[4096];
+        size_t count;
+        while ((count = fread(buf, 1, sizeof(buf), f)) > 0) {
+            contents.insert(contents.end(), buf, buf + count);
+        }
+        fclose(f);
+        if (contents.size() < 4 || memcmp(&contents[0], "TZif", 4) != 0) {
+            unknown_tz(name);
+        }
+        return new tz_transitions(name, &contents[0], &contents[0] + contents.size());
+    }
+} // anonymous namespace
+
+const tz_transitions& dynd::get_tz_transitions(const std::string& name)
+{
+    tz_cache_lock lock;
+    tz_cache& cache = lock.get_cache();
+    tz_cache::iterator it = cache.find(name);
+    if (it != cache.end()) {
+        return *it->second;
+    }
+    // Zones are few and loaded once, so loading under the lock is fine
+    const tz_transitions *result = load_tz_transitions(name);
+    cache[name] = result;
+    return *result;
+}
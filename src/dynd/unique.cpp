@@ -0,0 +1,220 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <vector>
+
+#include <dynd/unique.hpp>
+#include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/kernels/comparison_kernels.hpp>
+#include <dynd/kernels/hash_kernels.hpp>
+#include <dynd/types/cstruct_type.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+    /** The elements of a one-dimensional array */
+    struct element_run {
+        nd::array arr;
+        ndt::type el_tp;
+        char *el_metadata;
+        const char *data;
+        intptr_t stride, count;
+
+        inline const char *at(intptr_t i) const {
+            return data + i * stride;
+        }
+    };
+
+    static void init_element_run(element_run& r, const nd::array& a, const char *funcname,
+                    const eval::eval_context *ectx)
+    {
+        if (a.get_ndim() != 1) {
+            stringstream ss;
+            ss << "dynd " << funcname << " requires a one-dimensional array, not " << a.get_type();
+            throw runtime_error(ss.str());
+        }
+        r.arr = a.eval(ectx);
+        const ndt::type& tp = r.arr.get_type();
+        tp.extended()->process_strided(r.arr.get_ndo_meta(), r.arr.get_readonly_originptr(),
+                        r.el_tp, r.data, r.stride, r.count);
+        r.el_metadata = const_cast<char *>(r.arr.get_ndo_meta());
+        tp.get_type_at_dimension(&r.el_metadata, 1);
+    }
+
+    /**
+     * Open addressing hash table of row indices with linear probing.
+     * The hash of each occupied slot is kept alongside its row, so
+     * most mismatches are rejected without calling an equality kernel.
+     */
+    class row_hash_table {
+        vector<intptr_t> m_rows;
+        vector<uint64_t> m_hashes;
+        size_t m_mask;
+    public:
+        explicit row_hash_table(intptr_t max_count) {
+            size_t size = 16;
+            while (size < 2 * (size_t)max_count) {
+                size *= 2;
+            }
+            m_rows.resize(size, -1);
+            m_hashes.resize(size);
+            m_mask = size - 1;
+        }
+
+        /**
+         * Returns the slot of the row equal to `value`, or the empty
+         * slot where it would be inserted.
+         */
+        size_t find(uint64_t h, const char *value, const element_run& rows,
+                        comparison_ckernel_builder& eq) const {
+            size_t slot = h & m_mask;
+            while (m_rows[slot] >= 0) {
+                if (m_hashes[slot] == h && eq(value, rows.at(m_rows[slot]))) {
+                    break;
+                }
+                slot = (slot + 1) & m_mask;
+            }
+            return slot;
+        }
+
+        inline bool is_empty(size_t slot) const {
+            return m_rows[slot] < 0;
+        }
+
+        inline intptr_t get_row(size_t slot) const {
+            return m_rows[slot];
+        }
+
+        inline void insert(size_t slot, uint64_t h, intptr_t row) {
+            m_rows[slot] = row;
+            m_hashes[slot] = h;
+        }
+    };
+
+    /**
+     * Finds the distinct elements, returning the index of the first
+     * occurrence of each in `out_first`, and optionally how many times
+     * each occurs in `out_counts`.
+     */
+    static void find_distinct(const element_run& r, vector<intptr_t>& out_first,
+                    vector<intptr_t> *out_counts, const eval::eval_context *ectx)
+    {
+        hash_ckernel_builder hash;
+        comparison_ckernel_builder eq;
+        make_hash_kernel(&hash, 0, r.el_tp, r.el_metadata, ectx);
+        make_comparison_kernel(&eq, 0, r.el_tp, r.el_metadata, r.el_tp, r.el_metadata,
+                        comparison_type_equal, ectx);
+        row_hash_table table(r.count);
+        // For the first occurrence rows, their position in out_first
+        vector<intptr_t> group_of_row(out_counts ? r.count : 0);
+        for (intptr_t i = 0; i < r.count; ++i) {
+            const char *value = r.at(i);
+            uint64_t h = hash(value);
+            size_t slot = table.find(h, value, r, eq);
+            if (table.is_empty(slot)) {
+                table.insert(slot, h, i);
+                if (out_counts) {
+                    group_of_row[i] = (intptr_t)out_first.size();
+                    out_counts->push_back(1);
+                }
+                out_first.push_back(i);
+            } else if (out_counts) {
+                ++(*out_counts)[group_of_row[table.get_row(slot)]];
+            }
+        }
+    }
+
+    /** Copies the chosen elements into a strided destination */
+    static void gather_elements(const element_run& r, const vector<intptr_t>& rows,
+                    const char *dst_metadata, char *dst, intptr_t dst_stride,
+                    const eval::eval_context *ectx)
+    {
+        assignment_ckernel_builder k;
+        make_assignment_kernel(&k, 0, r.el_tp, dst_metadata, r.el_tp, r.el_metadata,
+                        kernel_request_single, assign_error_none, ectx);
+        for (size_t i = 0; i < rows.size(); ++i, dst += dst_stride) {
+            k(dst, r.at(rows[i]));
+        }
+    }
+} // anonymous namespace
+
+nd::array nd::unique(const nd::array& a, const eval::eval_context *ectx)
+{
+    element_run r;
+    init_element_run(r, a, "unique", ectx);
+    vector<intptr_t> first;
+    find_distinct(r, first, NULL, ectx);
+
+    array result = nd::empty((intptr_t)first.size(), ndt::make_strided_dim(r.el_tp));
+    const strided_dim_type_metadata *md =
+                    reinterpret_cast<const strided_dim_type_metadata *>(result.get_ndo_meta());
+    gather_elements(r, first, result.get_ndo_meta() + sizeof(strided_dim_type_metadata),
+                    result.get_readwrite_originptr(), md->stride, ectx);
+    return result;
+}
+
+nd::array nd::value_counts(const nd::array& a, const eval::eval_context *ectx)
+{
+    element_run r;
+    init_element_run(r, a, "value_counts", ectx);
+    vector<intptr_t> first, counts;
+    find_distinct(r, first, &counts, ectx);
+
+    ndt::type row_tp = ndt::make_cstruct(r.el_tp, "value", ndt::make_type<intptr_t>(), "count");
+    const cstruct_type *cd = static_cast<const cstruct_type *>(row_tp.extended());
+    array result = nd::empty((intptr_t)first.size(), ndt::make_strided_dim(row_tp));
+    const strided_dim_type_metadata *md =
+                    reinterpret_cast<const strided_dim_type_metadata *>(result.get_ndo_meta());
+    const char *row_metadata = result.get_ndo_meta() + sizeof(strided_dim_type_metadata);
+    char *data = result.get_readwrite_originptr();
+    gather_elements(r, first, row_metadata + cd->get_metadata_offsets()[0],
+                    data + cd->get_data_offsets()[0], md->stride, ectx);
+    char *count_data = data + cd->get_data_offsets()[1];
+    for (size_t i = 0; i < counts.size(); ++i, count_data += md->stride) {
+        *reinterpret_cast<intptr_t *>(count_data) = counts[i];
+    }
+    return result;
+}
+
+nd::array nd::isin(const nd::array& a, const nd::array& values, const eval::eval_context *ectx)
+{
+    element_run r, v;
+    init_element_run(r, a, "isin", ectx);
+    if (values.get_ndim() == 1 && values.get_dtype() != r.el_tp) {
+        init_element_run(v, values.ucast(r.el_tp), "isin", ectx);
+    } else {
+        init_element_run(v, values, "isin", ectx);
+    }
+
+    // Put the values in the table, then probe it with the elements
+    hash_ckernel_builder v_hash, a_hash;
+    comparison_ckernel_builder v_eq, a_eq;
+    make_hash_kernel(&v_hash, 0, v.el_tp, v.el_metadata, ectx);
+    make_hash_kernel(&a_hash, 0, r.el_tp, r.el_metadata, ectx);
+    make_comparison_kernel(&v_eq, 0, v.el_tp, v.el_metadata, v.el_tp, v.el_metadata,
+                    comparison_type_equal, ectx);
+    make_comparison_kernel(&a_eq, 0, r.el_tp, r.el_metadata, v.el_tp, v.el_metadata,
+                    comparison_type_equal, ectx);
+    row_hash_table table(v.count);
+    for (intptr_t j = 0; j < v.count; ++j) {
+        const char *value = v.at(j);
+        uint64_t h = v_hash(value);
+        size_t slot = table.find(h, value, v, v_eq);
+        if (table.is_empty(slot)) {
+            table.insert(slot, h, j);
+        }
+    }
+
+    array result = nd::empty(r.count, ndt::make_strided_dim(ndt::make_type<dynd_bool>()));
+    intptr_t stride = reinterpret_cast<const strided_dim_type_metadata *>(result.get_ndo_meta())->stride;
+    char *dst = result.get_readwrite_originptr();
+    for (intptr_t i = 0; i < r.count; ++i, dst += stride) {
+        const char *value = r.at(i);
+        *dst = !table.is_empty(table.find(a_hash(value), value, v, a_eq));
+    }
+    return result;
+}
@@ -203,6 +203,73 @@ TYPED_TEST_P(ArrayAssign, ScalarAssignment_Uint64) {
     EXPECT_EQ(20000000000ULL, TestFixture::First::Dereference(ptr_u64));
 }
 
+template<class Dst, class Src>
+static void check_axis_order_assign(intptr_t rows, intptr_t cols,
+                const int *dst_axis_perm, const int *src_axis_perm)
+{
+    intptr_t shape[2] = {rows, cols};
+    nd::array a = nd::make_strided_array(ndt::make_type<Src>(), 2, shape,
+                    nd::read_access_flag|nd::write_access_flag, src_axis_perm);
+    const strided_dim_type_metadata *a_md =
+                    reinterpret_cast<const strided_dim_type_metadata *>(a.get_ndo_meta());
+    for (intptr_t i = 0; i < rows; ++i) {
+        for (intptr_t j = 0; j < cols; ++j) {
+            *reinterpret_cast<Src *>(a.get_readwrite_originptr() +
+                            i * a_md[0].stride + j * a_md[1].stride) = static_cast<Src>(i * 1000 + j);
+        }
+    }
+    nd::array b = nd::make_strided_array(ndt::make_type<Dst>(), 2, shape,
+                    nd::read_access_flag|nd::write_access_flag, dst_axis_perm);
+    b.val_assign(a);
+    const strided_dim_type_metadata *b_md =
+                    reinterpret_cast<const strided_dim_type_metadata *>(b.get_ndo_meta());
+    for (intptr_t i = 0; i < rows; ++i) {
+        for (intptr_t j = 0; j < cols; ++j) {
+            ASSERT_EQ(static_cast<Dst>(i * 1000 + j), *reinterpret_cast<const Dst *>(
+                            b.get_readonly_originptr() + i * b_md[0].stride + j * b_md[1].stride))
+                                << i << ", " << j;
+        }
+    }
+}
+
+TEST(ArrayAssign, AxisOrderAssign) {
+    int c_order[2] = {1, 0}, f_order[2] = {0, 1};
+    // Sizes which aren't multiples of the tile size, and big enough to not be skipped
+    check_axis_order_assign<int32_t, int32_t>(300, 201, f_order, c_order);
+    check_axis_order_assign<int32_t, int32_t>(300, 201, c_order, f_order);
+    check_axis_order_assign<int32_t, int32_t>(300, 201, f_order, f_order);
+    check_axis_order_assign<double, double>(37, 1001, f_order, c_order);
+    check_axis_order_assign<int8_t, int8_t>(513, 129, c_order, f_order);
+    // With a conversion in the inner kernel
+    check_axis_order_assign<double, int32_t>(129, 257, f_order, c_order);
+    // Small ones use the nested kernels
+    check_axis_order_assign<int16_t, int16_t>(5, 7, f_order, c_order);
+}
+
+TEST(ArrayAssign, TransposedView) {
+    // Assigning a transposed view of a matrix, with an extra inner dimension
+    nd::array a = nd::empty(100, 90, 3, "strided * strided * strided * int32");
+    int32_t *a_ptr = reinterpret_cast<int32_t *>(a.get_readwrite_originptr());
+    for (int i = 0; i < 100 * 90 * 3; ++i) {
+        a_ptr[i] = i;
+    }
+    const strided_dim_type_metadata *a_md =
+                    reinterpret_cast<const strided_dim_type_metadata *>(a.get_ndo_meta());
+    intptr_t shape[3] = {90, 100, 3};
+    intptr_t strides[3] = {a_md[1].stride, a_md[0].stride, a_md[2].stride};
+    nd::array at = nd::make_strided_array_from_data(ndt::make_type<int32_t>(), 3, shape, strides,
+                    nd::read_access_flag, a.get_readwrite_originptr(), a.get_memblock(), NULL);
+    nd::array b = nd::empty(90, 100, 3, "strided * strided * strided * int32");
+    b.val_assign(at);
+    for (int i = 0; i < 90; i += 7) {
+        for (int j = 0; j < 100; j += 3) {
+            for (int k = 0; k < 3; ++k) {
+                EXPECT_EQ((j * 90 + i) * 3 + k, b(i, j, k).as<int32_t>());
+            }
+        }
+    }
+}
+
 #if !(defined(_WIN32) && !defined(_M_X64)) // TODO: How to mark as expected failures in googletest?
 
 TYPED_TEST_P(ArrayAssign, ScalarAssignment_Uint64_LargeNumbers) {
@@ -515,6 +582,75 @@ TEST(ArrayAssign, ZeroSizedAssign) {
     a.vals() = b;
 }
 
+TEST(ArrayAssign, ContiguousCheckedAssign) {
+    // Sizes around the blocks of the checked contiguous loop
+    int sizes[] = {1, 7, 255, 256, 257, 1000};
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k) {
+        int n = sizes[k];
+        nd::array a = nd::empty(n, "strided * int64");
+        int64_t *a_ptr = reinterpret_cast<int64_t *>(a.get_readwrite_originptr());
+        for (int i = 0; i < n; ++i) {
+            a_ptr[i] = (i % 200) - 100;
+        }
+        nd::array b = nd::empty(n, "strided * int8");
+        b.val_assign(a, assign_error_overflow);
+        nd::array c = nd::empty(n, "strided * float32");
+        c.val_assign(a, assign_error_inexact);
+        nd::array d = nd::empty(n, "strided * int16");
+        d.val_assign(c, assign_error_fractional);
+        for (int i = 0; i < n; ++i) {
+            EXPECT_EQ((i % 200) - 100, b(i).as<int>());
+            EXPECT_EQ((i % 200) - 100, c(i).as<float>());
+            EXPECT_EQ((i % 200) - 100, d(i).as<int>());
+        }
+    }
+}
+
+TEST(ArrayAssign, ContiguousCheckedAssignErrors) {
+    nd::array a = nd::empty(1000, "strided * int32");
+    int32_t *a_ptr = reinterpret_cast<int32_t *>(a.get_readwrite_originptr());
+    for (int i = 0; i < 1000; ++i) {
+        a_ptr[i] = i % 100;
+    }
+    // An overflow in the middle of the array raises the same error as a scalar
+    a_ptr[600] = 1000;
+    nd::array b = nd::empty(1000, "strided * int8");
+    string scalar_msg, array_msg;
+    try {
+        nd::empty(ndt::make_type<int8_t>()).val_assign(a(600), assign_error_overflow);
+    } catch (const overflow_error& e) {
+        scalar_msg = e.what();
+    }
+    try {
+        b.val_assign(a, assign_error_overflow);
+    } catch (const overflow_error& e) {
+        array_msg = e.what();
+    }
+    EXPECT_NE("", scalar_msg);
+    EXPECT_EQ(scalar_msg, array_msg);
+    // Values before the failing block were assigned
+    EXPECT_EQ(55, b(255).as<int>());
+
+    nd::array f = nd::empty(1000, "strided * float64");
+    double *f_ptr = reinterpret_cast<double *>(f.get_readwrite_originptr());
+    for (int i = 0; i < 1000; ++i) {
+        f_ptr[i] = i * 0.25;
+    }
+    nd::array g = nd::empty(1000, "strided * float32");
+    g.val_assign(f, assign_error_inexact);
+    EXPECT_EQ(249.75f, g(999).as<float>());
+    nd::array h = nd::empty(1000, "strided * int32");
+    EXPECT_THROW(h.val_assign(f, assign_error_fractional), runtime_error);
+    h.val_assign(f, assign_error_overflow);
+    EXPECT_EQ(249, h(999).as<int>());
+    f_ptr[777] = 1e300;
+    EXPECT_THROW(g.val_assign(f, assign_error_overflow), overflow_error);
+    f_ptr[777] = 0.1;
+    EXPECT_THROW(g.val_assign(f, assign_error_inexact), runtime_error);
+    g.val_assign(f, assign_error_fractional);
+    EXPECT_EQ(0.1f, g(777).as<float>());
+}
+
 #if !(defined(_WIN32) && !defined(_M_X64)) // TODO: How to mark as expected failures in googletest?
 REGISTER_TYPED_TEST_CASE_P(ArrayAssign, ScalarAssignment_Bool, ScalarAssignment_Int8, ScalarAssignment_UInt16,
     ScalarAssignment_Float32, ScalarAssignment_Float64, ScalarAssignment_Uint64,
@@ -91,3 +91,21 @@ TEST(JSONFormatter, UniformDim) {
     EXPECT_EQ("[\"testing\",\"one\",\"two\"]", format_json(n).as<string>());
 }
 
+
+TEST(JSONFormatter, ExpressionUniformDim) {
+    nd::array n = nd::empty(1000, "strided * int32");
+    for (int i = 0; i < 1000; ++i) {
+        n(i).vals() = i;
+    }
+    // Formatting a conversion evaluates it in chunks
+    string result = format_json(n.ucast<double>()).as<string>();
+    EXPECT_EQ("[0,1,2,", result.substr(0, 7));
+    EXPECT_EQ(",998,999]", result.substr(result.size() - 9));
+    EXPECT_EQ(format_json(n).as<string>(), result);
+    // With a nested dimension
+    n = parse_json("2 * 3 * int16", "[[1, 2, 3], [4, 5, 6]]");
+    EXPECT_EQ("[[1,2,3],[4,5,6]]", format_json(n.ucast<int64_t>()).as<string>());
+    n = parse_json("3 * string", "[\"testing\", \"one\", \"two\"]");
+    EXPECT_EQ("[\"testing\",\"one\",\"two\"]",
+                    format_json(n.ucast(ndt::make_string(string_encoding_utf_16))).as<string>());
+}
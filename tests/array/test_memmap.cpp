@@ -57,3 +57,51 @@ TEST(ArrayMemMap, SimpleString) {
     unlink("test.txt");
 #endif
 }
+
+TEST(ArrayMemMap, Typed) {
+    int32_t vals[] = {0, 10, 20, 30, 40, 50};
+    write_string_file("test.bin", reinterpret_cast<const char *>(vals), sizeof(vals));
+
+    // A leading strided dimension gets its size from the file
+    nd::array a = nd::memmap("test.bin", ndt::type("strided * int32"), 0,
+                    nd::read_access_flag|nd::write_access_flag,
+                    memmap_advice_sequential);
+    EXPECT_EQ(ndt::type("strided * int32"), a.get_type());
+    ASSERT_EQ(6, a.get_dim_size());
+    EXPECT_EQ(0, a(0).as<int>());
+    EXPECT_EQ(50, a(5).as<int>());
+    // Writes go to the file
+    a(1).vals() = 11;
+    a = nd::array();
+    a = nd::memmap("test.bin", ndt::type("strided * int32"), 8,
+                    nd::read_access_flag, memmap_advice_random);
+    ASSERT_EQ(4, a.get_dim_size());
+    EXPECT_EQ(20, a(0).as<int>());
+    a = nd::memmap("test.bin", ndt::type("strided * int32"), -8);
+    ASSERT_EQ(2, a.get_dim_size());
+    EXPECT_EQ(40, a(0).as<int>());
+
+    // Fixed dimensions and structs
+    a = nd::memmap("test.bin", ndt::type("2 * {x: int32, y: int32}"), 4,
+                    nd::read_access_flag, memmap_advice_willneed);
+    EXPECT_EQ(ndt::type("2 * {x: int32, y: int32}"), a.get_type());
+    EXPECT_EQ(11, a(0, 0).as<int>());
+    EXPECT_EQ(20, a(0, 1).as<int>());
+    EXPECT_EQ(40, a(1, 1).as<int>());
+    a = nd::memmap("test.bin", ndt::type("int64"), 16, nd::read_access_flag);
+    EXPECT_EQ((int64_t)40 + ((int64_t)50 << 32), a.as<int64_t>());
+
+    // Size and alignment validation
+    EXPECT_THROW(nd::memmap("test.bin", ndt::type("strided * int64"), 4), runtime_error);
+    EXPECT_THROW(nd::memmap("test.bin", ndt::type("strided * int32"), 2), runtime_error);
+    EXPECT_THROW(nd::memmap("test.bin", ndt::type("7 * int32")), runtime_error);
+    EXPECT_THROW(nd::memmap("test.bin", ndt::type("strided * string")), runtime_error);
+    EXPECT_THROW(nd::memmap("test.bin", ndt::type("strided * strided * int32")), runtime_error);
+    a = nd::array();
+
+#ifdef WIN32
+    _unlink("test.bin");
+#else
+    unlink("test.bin");
+#endif
+}
@@ -248,6 +248,15 @@ TEST(ArithmeticOp, ComplexScalar) {
     EXPECT_EQ(dynd_complex<float>(0,-3), c(2).as<dynd_complex<float> >());
 }
 
+TEST(ArithmeticOp, NonBuiltinRightOperand) {
+    // A number times or divided by a date isn't supported
+    nd::array a = 2, b = nd::array("2000-01-01").ucast(ndt::type("date")).eval();
+    EXPECT_THROW(a * b, runtime_error);
+    EXPECT_THROW(a / b, runtime_error);
+    EXPECT_THROW(b * a, runtime_error);
+    EXPECT_THROW(b / a, runtime_error);
+}
+
 TEST(ArithmeticOp, MatchingDTypes_View) {
     nd::array a, b, c, d;
 
@@ -0,0 +1,146 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/kernels/ckernel_cache.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(CKernelCache, HitsAndMisses) {
+    clear_ckernel_cache();
+    nd::array a = nd::empty(3, "strided * float64");
+    int vals[] = {1, 2, 3};
+    a.vals() = vals;
+    ckernel_cache_stats st = get_ckernel_cache_stats();
+    EXPECT_EQ(0u, st.hits);
+    EXPECT_EQ(1u, st.misses);
+    EXPECT_EQ(1u, st.size);
+    // A different array with the same layout reuses the ckernel
+    nd::array b = nd::empty(3, "strided * float64");
+    int vals2[] = {4, 5, 6};
+    b.vals() = vals2;
+    st = get_ckernel_cache_stats();
+    EXPECT_EQ(1u, st.hits);
+    EXPECT_EQ(1u, st.misses);
+    EXPECT_EQ(1u, st.size);
+    // A different shape is a different metadata fingerprint
+    nd::array c = nd::empty(2, "strided * float64");
+    int vals3[] = {7, 8};
+    c.vals() = vals3;
+    st = get_ckernel_cache_stats();
+    EXPECT_EQ(2u, st.misses);
+    EXPECT_EQ(2u, st.size);
+    EXPECT_EQ(4., b(0).as<double>());
+    EXPECT_EQ(6., b(2).as<double>());
+    EXPECT_EQ(8., c(1).as<double>());
+
+    clear_ckernel_cache();
+    st = get_ckernel_cache_stats();
+    EXPECT_EQ(0u, st.hits);
+    EXPECT_EQ(0u, st.misses);
+    EXPECT_EQ(0u, st.size);
+}
+
+TEST(CKernelCache, EvalContextIsPartOfKey) {
+    nd::array a = nd::empty(3, "strided * float64");
+    nd::array b = nd::empty(3, "strided * int32");
+    int vals[] = {1, 2, 3};
+    b.vals() = vals;
+    clear_ckernel_cache();
+    eval::eval_context ectx;
+    a.val_assign(b, assign_error_default, &ectx);
+    a.val_assign(b, assign_error_default, &ectx);
+    EXPECT_EQ(1u, get_ckernel_cache_stats().hits);
+    // Each field of the context may change the ckernel, so
+    // a context differing in any of them is a miss
+    ectx.buffer_max_mem = ectx.buffer_max_mem / 2;
+    a.val_assign(b, assign_error_default, &ectx);
+    ectx.default_assign_error_mode = assign_error_overflow;
+    a.val_assign(b, assign_error_default, &ectx);
+    ckernel_cache_stats st = get_ckernel_cache_stats();
+    EXPECT_EQ(1u, st.hits);
+    EXPECT_EQ(3u, st.misses);
+    EXPECT_EQ(3., a(2).as<double>());
+}
+
+TEST(CKernelCache, MetadataOutlivesCaller) {
+    clear_ckernel_cache();
+    // The struct data offsets live in the metadata, so the cached
+    // ckernel must not refer to the first array's metadata
+    ndt::type tp("{x: int32, y: float64}");
+    {
+        nd::array a = parse_json(tp, "{\"x\": 1, \"y\": 2.5}");
+        nd::array b = nd::empty(tp);
+        b.vals() = a;
+    }
+    nd::array a = parse_json(tp, "{\"x\": 3, \"y\": 4.5}");
+    nd::array b = nd::empty(tp);
+    uint64_t hits = get_ckernel_cache_stats().hits;
+    b.vals() = a;
+    EXPECT_EQ(hits + 1, get_ckernel_cache_stats().hits);
+    EXPECT_EQ(3, b(0).as<int>());
+    EXPECT_EQ(4.5, b(1).as<double>());
+    EXPECT_TRUE(a.equals_exact(b));
+}
+
+TEST(CKernelCache, Comparisons) {
+    clear_ckernel_cache();
+    EXPECT_TRUE(nd::array(1) < nd::array(2));
+    EXPECT_FALSE(nd::array(3) < nd::array(2));
+    ckernel_cache_stats st = get_ckernel_cache_stats();
+    EXPECT_EQ(1u, st.hits);
+    EXPECT_EQ(1u, st.misses);
+    // A different comparison type is a different key
+    EXPECT_TRUE(nd::array(3) > nd::array(2));
+    EXPECT_EQ(2u, get_ckernel_cache_stats().misses);
+}
+
+TEST(CKernelCache, BlockrefTypesBypass) {
+    clear_ckernel_cache();
+    nd::array a = nd::empty("string");
+    a.vals() = "test";
+    nd::array b = nd::empty("string");
+    b.vals() = a;
+    ckernel_cache_stats st = get_ckernel_cache_stats();
+    EXPECT_EQ(0u, st.hits);
+    EXPECT_EQ(0u, st.misses);
+    EXPECT_EQ(0u, st.size);
+    EXPECT_LE(2u, st.bypasses);
+    EXPECT_EQ("test", b.as<string>());
+}
+
+TEST(CKernelCache, Capacity) {
+    clear_ckernel_cache();
+    set_ckernel_cache_capacity(2);
+    nd::array a = nd::empty("int64");
+    a.vals() = 1;
+    a.vals() = 2.0f;
+    a.vals() = 3.0;
+    ckernel_cache_stats st = get_ckernel_cache_stats();
+    EXPECT_EQ(3u, st.misses);
+    EXPECT_EQ(1u, st.evictions);
+    EXPECT_EQ(2u, st.size);
+    // The least recently used one was evicted
+    a.vals() = 1;
+    EXPECT_EQ(4u, get_ckernel_cache_stats().misses);
+    a.vals() = 3.0;
+    EXPECT_EQ(1u, get_ckernel_cache_stats().hits);
+    EXPECT_EQ(3, a.as<int>());
+
+    // Capacity zero disables the cache
+    set_ckernel_cache_capacity(0);
+    EXPECT_EQ(0u, get_ckernel_cache_stats().size);
+    a.vals() = 1;
+    a.vals() = 1;
+    EXPECT_EQ(0u, get_ckernel_cache_stats().size);
+    set_ckernel_cache_capacity(256);
+    clear_ckernel_cache();
+}
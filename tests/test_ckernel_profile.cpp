@@ -0,0 +1,75 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/kernels/ckernel_profile.hpp>
+#include <dynd/kernels/ckernel_cache.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(CKernelProfile, StringToInt) {
+    nd::array a = nd::empty(3, "strided * string");
+    a(0).vals() = "1";
+    a(1).vals() = "22";
+    a(2).vals() = "333";
+    nd::array b = nd::empty(3, "strided * int32");
+
+    ckernel_profile prof;
+    eval::eval_context ectx;
+    ectx.profile = &prof;
+    b.val_assign(a, assign_error_default, &ectx);
+    EXPECT_EQ(22, b(1).as<int>());
+    EXPECT_EQ(333, b(2).as<int>());
+
+    // The dimension kernel, with the element kernel as its child
+    ASSERT_EQ(1u, prof.get_root_count());
+    const ckernel_profile_node& root = prof.get_root(0);
+    EXPECT_EQ("strided * string -> strided * int32", root.name);
+    EXPECT_EQ(1u, root.calls);
+    EXPECT_EQ(1u, root.elements);
+    ASSERT_EQ(1u, root.children.size());
+    const ckernel_profile_node *child = root.children[0];
+    EXPECT_EQ("string -> int32", child->name);
+    EXPECT_EQ(1u, child->calls);
+    EXPECT_EQ(3u, child->elements);
+    EXPECT_LE(child->cycles, root.cycles);
+    EXPECT_EQ(root.cycles - child->cycles, root.get_self_cycles());
+
+    stringstream ss;
+    prof.dump(ss);
+    EXPECT_NE(string::npos, ss.str().find("  string -> int32\n"));
+
+    prof.reset();
+    EXPECT_EQ(0u, prof.get_root(0).calls);
+    EXPECT_EQ(0u, prof.get_root(0).children[0]->elements);
+    prof.clear();
+    EXPECT_EQ(0u, prof.get_root_count());
+    EXPECT_THROW(prof.get_root(0), runtime_error);
+}
+
+TEST(CKernelProfile, NotCached) {
+    clear_ckernel_cache();
+    nd::array a = nd::empty(4, "strided * float32");
+    a.vals() = 1.5f;
+    nd::array b = nd::empty(4, "strided * float64");
+    ckernel_profile prof;
+    eval::eval_context ectx;
+    ectx.profile = &prof;
+    size_t cache_size = get_ckernel_cache_stats().size;
+    b.val_assign(a, assign_error_default, &ectx);
+    b.val_assign(a, assign_error_default, &ectx);
+    EXPECT_EQ(cache_size, get_ckernel_cache_stats().size);
+    // Each assignment built its own ckernel tree
+    ASSERT_EQ(2u, prof.get_root_count());
+    EXPECT_EQ(1u, prof.get_root(1).children.size());
+    EXPECT_EQ(4u, prof.get_root(1).children[0]->elements);
+    EXPECT_EQ(1.5, b(3).as<double>());
+}
@@ -0,0 +1,89 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/cpu_features.hpp>
+#include <dynd/kernels/reduction_kernels.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(CPUFeatures, ISAMatchesFeatures) {
+    cpu_isa_t isa = get_cpu_isa();
+    EXPECT_GE(isa, cpu_isa_baseline);
+    EXPECT_LT(isa, cpu_isa_count);
+    // The level is determined once
+    EXPECT_EQ(isa, get_cpu_isa());
+    if (isa >= cpu_isa_sse4_2) {
+        EXPECT_TRUE(has_cpu_features(cpu_feature_sse4_2 | cpu_feature_popcnt));
+    }
+    if (isa >= cpu_isa_avx2) {
+        EXPECT_TRUE(has_cpu_features(cpu_feature_avx2 | cpu_feature_fma | cpu_feature_f16c));
+    }
+    if (isa >= cpu_isa_avx512) {
+        EXPECT_TRUE(has_cpu_features(cpu_feature_avx512f | cpu_feature_avx512bw));
+    }
+    EXPECT_EQ("baseline", string(get_cpu_isa_name(cpu_isa_baseline)));
+    EXPECT_EQ("avx2", string(get_cpu_isa_name(cpu_isa_avx2)));
+}
+
+TEST(CPUFeatures, SelectVariant) {
+    const char *variants[cpu_isa_count] = {"baseline", NULL, "avx2", NULL};
+    EXPECT_EQ(string("baseline"), select_cpu_isa_variant(variants, cpu_isa_baseline));
+    EXPECT_EQ(string("baseline"), select_cpu_isa_variant(variants, cpu_isa_sse4_2));
+    EXPECT_EQ(string("avx2"), select_cpu_isa_variant(variants, cpu_isa_avx2));
+    // Falls back to the best variant below the level
+    EXPECT_EQ(string("avx2"), select_cpu_isa_variant(variants, cpu_isa_avx512));
+}
+
+TEST(CPUFeatures, ContiguousAndStridedAgree) {
+    // Odd sizes, so vectorized loops also run their remainders
+    nd::array a = nd::empty(37, "strided * int32");
+    nd::array b = nd::empty(37, "strided * int32");
+    for (int i = 0; i < 37; ++i) {
+        a(i).vals() = i * 3 - 50;
+        b(i).vals() = 1000 - i;
+    }
+    nd::array c = (a + b).eval();
+    nd::array d = (a(irange().by(2)) + b(irange().by(2))).eval();
+    for (int i = 0; i < 37; ++i) {
+        EXPECT_EQ(950 + 2 * i, c(i).as<int>());
+    }
+    for (int i = 0; i < 19; ++i) {
+        EXPECT_EQ(950 + 4 * i, d(i).as<int>());
+    }
+
+    nd::array f = nd::empty(37, "strided * float64");
+    f.val_assign(a, assign_error_none);
+    nd::array g = nd::empty(19, "strided * float64");
+    g.val_assign(a(irange().by(2)), assign_error_none);
+    for (int i = 0; i < 19; ++i) {
+        EXPECT_EQ(f(2 * i).as<double>(), g(i).as<double>());
+        EXPECT_EQ(i * 6 - 50, g(i).as<double>());
+    }
+}
+
+TEST(CPUFeatures, StridedSumReduction) {
+    assignment_strided_ckernel_builder ckb;
+    kernels::make_builtin_sum_reduction_ckernel(&ckb, 0, int32_type_id, kernel_request_strided);
+    int32_t vals[37], sums[37];
+    for (int i = 0; i < 37; ++i) {
+        vals[i] = i - 10;
+        sums[i] = 100;
+    }
+    // Reducing into one value
+    int32_t s = 5;
+    ckb((char *)&s, 0, (const char *)vals, sizeof(int32_t), 37);
+    EXPECT_EQ(5 + 37 * 18 - 370, s);
+    // Accumulating elementwise
+    ckb((char *)sums, sizeof(int32_t), (const char *)vals, sizeof(int32_t), 37);
+    for (int i = 0; i < 37; ++i) {
+        EXPECT_EQ(100 + i - 10, sums[i]);
+    }
+}
@@ -0,0 +1,99 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/dim_iter.hpp>
+#include <dynd/types/convert_type.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+#include <dynd/types/var_dim_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(DimIter, EvalNoExpression) {
+    nd::array a = nd::empty(10, "strided * int32");
+    for (int i = 0; i < 10; ++i) {
+        a(i).vals() = i;
+    }
+    // Without expressions, the iterator points at the array's data
+    dim_iter it;
+    make_eval_dim_iter(&it, a);
+    EXPECT_EQ(ndt::make_type<int32_t>(), ndt::type(it.eltype, true));
+    ASSERT_EQ(1, it.vtable->next(&it));
+    EXPECT_EQ(10, it.data_elcount);
+    EXPECT_EQ(a.get_readonly_originptr(), it.data_ptr);
+    EXPECT_EQ(0, it.vtable->next(&it));
+}
+
+TEST(DimIter, EvalChunked) {
+    nd::array a = nd::empty(1000, "strided * int32");
+    for (int i = 0; i < 1000; ++i) {
+        a(i).vals() = i * 3;
+    }
+    nd::array b = a.ucast<double>();
+    // A buffer of 100 doubles, so there are 10 chunks through the same memory
+    dim_iter it;
+    make_eval_dim_iter(&it, b, 100 * sizeof(double));
+    EXPECT_EQ(ndt::make_type<double>(), ndt::type(it.eltype, true));
+    EXPECT_TRUE((it.flags & dim_iter_contiguous) != 0);
+    const char *buffer = it.data_ptr;
+    int count = 0, chunks = 0;
+    while (it.vtable->next(&it)) {
+        EXPECT_EQ(buffer, it.data_ptr);
+        EXPECT_EQ(100, it.data_elcount);
+        for (intptr_t i = 0; i < it.data_elcount; ++i, ++count) {
+            EXPECT_EQ(count * 3, *reinterpret_cast<const double *>(it.data_ptr + i * it.data_stride));
+        }
+        ++chunks;
+    }
+    EXPECT_EQ(1000, count);
+    EXPECT_EQ(10, chunks);
+
+    // Seeking evaluates from the requested element, with a partial last chunk
+    it.vtable->seek(&it, 950);
+    EXPECT_EQ(50, it.data_elcount);
+    EXPECT_EQ(950 * 3, *reinterpret_cast<const double *>(it.data_ptr));
+    EXPECT_EQ(0, it.vtable->next(&it));
+}
+
+TEST(DimIter, EvalChunkedMultiDim) {
+    nd::array a = nd::empty(7, 5, "strided * strided * int16");
+    for (int i = 0; i < 7; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            a(i, j).vals() = i * 10 + j;
+        }
+    }
+    nd::array b = a.ucast<float>();
+    // Room for two rows at a time
+    dim_iter it;
+    make_eval_dim_iter(&it, b, 2 * 5 * sizeof(float));
+    ndt::type el_tp(it.eltype, true);
+    EXPECT_EQ(ndt::type("strided * float32"), el_tp);
+    int row = 0;
+    while (it.vtable->next(&it)) {
+        EXPECT_GE(2, it.data_elcount);
+        EXPECT_LT(0, it.data_elcount);
+        for (intptr_t i = 0; i < it.data_elcount; ++i, ++row) {
+            nd::array el = nd::empty(5, "strided * float32");
+            el.val_assign(el_tp, it.elmeta, it.data_ptr + i * it.data_stride);
+            for (int j = 0; j < 5; ++j) {
+                EXPECT_EQ(row * 10 + j, el(j).as<float>());
+            }
+        }
+    }
+    EXPECT_EQ(7, row);
+}
+
+TEST(DimIter, EvalErrors) {
+    dim_iter it;
+    nd::array a = nd::array(3).ucast<float>();
+    EXPECT_THROW(make_eval_dim_iter(&it, a), runtime_error);
+    a = nd::empty(ndt::type("var * int32")).ucast<float>();
+    EXPECT_THROW(make_eval_dim_iter(&it, a), runtime_error);
+}
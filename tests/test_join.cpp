@@ -0,0 +1,116 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include "inc_gtest.hpp"
+
+#include <dynd/join.hpp>
+#include <dynd/json_parser.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(Join, InnerHash) {
+    nd::array left = parse_json("var * {id: int32, name: string}",
+                    "[{\"id\": 3, \"name\": \"c\"}, {\"id\": 1, \"name\": \"a\"},"
+                    " {\"id\": 7, \"name\": \"x\"}, {\"id\": 3, \"name\": \"cc\"}]");
+    nd::array right = parse_json("var * {id: int32, value: float64}",
+                    "[{\"id\": 1, \"value\": 1.5}, {\"id\": 3, \"value\": 3.5},"
+                    " {\"id\": 3, \"value\": 4.5}, {\"id\": 9, \"value\": 9.5}]");
+    nd::array j = nd::join(left, right, "id");
+    EXPECT_EQ(ndt::type("strided * {id: int32, name: string, value: float64}"), j.get_type());
+    ASSERT_EQ(5, j.get_dim_size());
+    // Rows are in left order, matches in right order
+    EXPECT_EQ(3, j(0, 0).as<int>());
+    EXPECT_EQ("c", j(0, 1).as<string>());
+    EXPECT_EQ(3.5, j(0, 2).as<double>());
+    EXPECT_EQ(3, j(1, 0).as<int>());
+    EXPECT_EQ(4.5, j(1, 2).as<double>());
+    EXPECT_EQ(1, j(2, 0).as<int>());
+    EXPECT_EQ("a", j(2, 1).as<string>());
+    EXPECT_EQ(1.5, j(2, 2).as<double>());
+    EXPECT_EQ("cc", j(3, 1).as<string>());
+    EXPECT_EQ(3.5, j(3, 2).as<double>());
+    EXPECT_EQ("cc", j(4, 1).as<string>());
+    EXPECT_EQ(4.5, j(4, 2).as<double>());
+}
+
+TEST(Join, LeftHash) {
+    nd::array left = parse_json("var * {id: int32, name: string}",
+                    "[{\"id\": 3, \"name\": \"c\"}, {\"id\": 7, \"name\": \"x\"}]");
+    nd::array right = parse_json("var * {id: int32, tag: string}",
+                    "[{\"id\": 3, \"tag\": \"three\"}]");
+    nd::array j = nd::join(left, right, "id", left_join);
+    ASSERT_EQ(2, j.get_dim_size());
+    EXPECT_EQ("three", j(0, 2).as<string>());
+    EXPECT_EQ(7, j(1, 0).as<int>());
+    EXPECT_EQ("x", j(1, 1).as<string>());
+    // Unmatched right fields are zero-filled
+    EXPECT_EQ("", j(1, 2).as<string>());
+}
+
+TEST(Join, MergeSortedMultiKey) {
+    nd::array left = parse_json("var * {a: int32, b: string, x: int32}",
+                    "[{\"a\": 1, \"b\": \"p\", \"x\": 10}, {\"a\": 1, \"b\": \"q\", \"x\": 11},"
+                    " {\"a\": 2, \"b\": \"p\", \"x\": 12}, {\"a\": 2, \"b\": \"p\", \"x\": 13},"
+                    " {\"a\": 5, \"b\": \"z\", \"x\": 14}]");
+    nd::array right = parse_json("var * {a: int32, b: string, y: int32}",
+                    "[{\"a\": 1, \"b\": \"q\", \"y\": 20}, {\"a\": 2, \"b\": \"p\", \"y\": 21},"
+                    " {\"a\": 2, \"b\": \"p\", \"y\": 22}, {\"a\": 3, \"b\": \"a\", \"y\": 23}]");
+    string keys[] = {"a", "b"};
+    nd::array j = nd::join(left, right, 2, keys);
+    EXPECT_EQ(ndt::type("strided * {a: int32, b: string, x: int32, y: int32}"), j.get_type());
+    ASSERT_EQ(5, j.get_dim_size());
+    int expected_x[] = {11, 12, 12, 13, 13};
+    int expected_y[] = {20, 21, 22, 21, 22};
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(expected_x[i], j(i, 2).as<int>());
+        EXPECT_EQ(expected_y[i], j(i, 3).as<int>());
+    }
+
+    j = nd::join(left, right, 2, keys, left_join);
+    ASSERT_EQ(7, j.get_dim_size());
+    EXPECT_EQ(10, j(0, 2).as<int>());
+    EXPECT_EQ(0, j(0, 3).as<int>());
+    EXPECT_EQ(14, j(6, 2).as<int>());
+    EXPECT_EQ(0, j(6, 3).as<int>());
+}
+
+TEST(Join, HashMatchesMerge) {
+    // The same data sorted and shuffled gives the same matches
+    nd::array sorted_left = nd::empty(200, "strided * {k: int64, v: int32}");
+    nd::array shuffled_right = nd::empty(150, "strided * {k: int64, w: int32}");
+    for (int i = 0; i < 200; ++i) {
+        sorted_left(i, 0).vals() = i / 2;
+        sorted_left(i, 1).vals() = i;
+    }
+    for (int i = 0; i < 150; ++i) {
+        shuffled_right(i, 0).vals() = (i * 37) % 150;
+        shuffled_right(i, 1).vals() = i;
+    }
+    nd::array j = nd::join(sorted_left, shuffled_right, "k");
+    ASSERT_EQ(200, j.get_dim_size());
+    for (int i = 0; i < 200; ++i) {
+        int64_t k = j(i, 0).as<int64_t>();
+        EXPECT_EQ(k, i / 2);
+        EXPECT_EQ(i, j(i, 1).as<int>());
+        EXPECT_EQ(k, (j(i, 2).as<int>() * 37) % 150);
+    }
+}
+
+TEST(Join, Errors) {
+    nd::array left = parse_json("var * {id: int32, name: string}", "[]");
+    nd::array right = parse_json("var * {id: int64, name: string}", "[]");
+    nd::array right2 = parse_json("var * {id: int32, name: string}", "[]");
+    // Missing key field
+    EXPECT_THROW(nd::join(left, right, "nope"), runtime_error);
+    // Key types differ
+    EXPECT_THROW(nd::join(left, right, "id"), runtime_error);
+    // Non-key field names collide
+    EXPECT_THROW(nd::join(left, right2, "id"), runtime_error);
+    // Not an array of structs
+    EXPECT_THROW(nd::join(nd::array(1), right2, "id"), runtime_error);
+}
@@ -0,0 +1,305 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "inc_gtest.hpp"
+
+#include <dynd/sort.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(Sort, SmallInt32) {
+    int vals[] = {5, -3, 7, 0, -100, 42, 7};
+    nd::array a = vals;
+    nd::array b = nd::sort(a);
+    EXPECT_EQ(ndt::type("strided * int32"), b.get_type());
+    EXPECT_EQ(-100, b(0).as<int>());
+    EXPECT_EQ(-3, b(1).as<int>());
+    EXPECT_EQ(0, b(2).as<int>());
+    EXPECT_EQ(5, b(3).as<int>());
+    EXPECT_EQ(7, b(4).as<int>());
+    EXPECT_EQ(7, b(5).as<int>());
+    EXPECT_EQ(42, b(6).as<int>());
+    // The input is left alone
+    EXPECT_EQ(5, a(0).as<int>());
+}
+
+template<class T>
+static void check_radix_sort(intptr_t count)
+{
+    vector<T> vals(count);
+    for (intptr_t i = 0; i < count; ++i) {
+        vals[i] = static_cast<T>((i * 7919 + 13) % 1021 - 510);
+    }
+    nd::array a = vals;
+    nd::array b = nd::sort(a);
+    nd::array p = nd::argsort(a);
+    std::stable_sort(vals.begin(), vals.end());
+    for (intptr_t i = 0; i < count; ++i) {
+        EXPECT_EQ(vals[i], b(i).as<T>());
+        EXPECT_EQ(vals[i], a(p(i).as<intptr_t>()).as<T>());
+    }
+}
+
+TEST(Sort, RadixBuiltins) {
+    check_radix_sort<int16_t>(1000);
+    check_radix_sort<int32_t>(1000);
+    check_radix_sort<int64_t>(1000);
+    check_radix_sort<uint32_t>(1000);
+    check_radix_sort<float>(1000);
+    check_radix_sort<double>(1000);
+    // Small sizes use a different code path
+    check_radix_sort<int32_t>(10);
+    check_radix_sort<double>(10);
+}
+
+TEST(Sort, FloatNaNAtEnd) {
+    double nan = numeric_limits<double>::quiet_NaN();
+    vector<double> vals;
+    for (int i = 0; i < 200; ++i) {
+        vals.push_back((i % 5 == 0) ? nan : (100.0 - i) * 0.5);
+    }
+    vals.push_back(-numeric_limits<double>::infinity());
+    vals.push_back(-0.0);
+    nd::array a = vals;
+    nd::array b = nd::sort(a);
+    EXPECT_EQ(-numeric_limits<double>::infinity(), b(0).as<double>());
+    for (int i = 0; i < 161; ++i) {
+        EXPECT_FALSE(DYND_ISNAN(b(i).as<double>()));
+        if (i > 0) {
+            EXPECT_LE(b(i-1).as<double>(), b(i).as<double>());
+        }
+    }
+    for (int i = 162; i < 202; ++i) {
+        EXPECT_TRUE(DYND_ISNAN(b(i).as<double>()));
+    }
+
+    // argsort places the NaN indices at the end, in their original order
+    nd::array p = nd::argsort(a);
+    EXPECT_EQ(200, p(0).as<intptr_t>());
+    EXPECT_EQ(0, p(162).as<intptr_t>());
+    EXPECT_EQ(5, p(163).as<intptr_t>());
+    EXPECT_EQ(195, p(201).as<intptr_t>());
+}
+
+TEST(Sort, ArgsortSignedZeros) {
+    // -0.0 and 0.0 compare equal, so a stable argsort keeps them in order
+    for (int count = 4; count <= 100; count += 96) {
+        vector<double> vals(count);
+        vals[0] = 0.0;
+        vals[1] = -0.0;
+        for (int i = 2; i < count; ++i) {
+            vals[i] = (i % 2 == 0) ? -0.0 : 0.0;
+        }
+        vals[count - 1] = 1.0;
+        nd::array p = nd::argsort(nd::array(vals));
+        for (int i = 0; i < count; ++i) {
+            EXPECT_EQ(i, p(i).as<intptr_t>());
+        }
+    }
+
+    vector<float> fvals(100, -0.0f);
+    fvals[3] = 0.0f;
+    fvals[50] = -1.0f;
+    nd::array p = nd::argsort(nd::array(fvals));
+    EXPECT_EQ(50, p(0).as<intptr_t>());
+    for (int i = 1; i < 100; ++i) {
+        EXPECT_EQ(i <= 50 ? i - 1 : i, p(i).as<intptr_t>());
+    }
+}
+
+TEST(Sort, Strings) {
+    const char *vals[] = {"pear", "apple", "zebra", "banana", "apple", ""};
+    nd::array a = vals;
+    nd::array b = nd::sort(a);
+    EXPECT_EQ("", b(0).as<string>());
+    EXPECT_EQ("apple", b(1).as<string>());
+    EXPECT_EQ("apple", b(2).as<string>());
+    EXPECT_EQ("banana", b(3).as<string>());
+    EXPECT_EQ("pear", b(4).as<string>());
+    EXPECT_EQ("zebra", b(5).as<string>());
+
+    // Stable, so the two "apple" values stay in order
+    nd::array p = nd::argsort(a);
+    EXPECT_EQ(5, p(0).as<intptr_t>());
+    EXPECT_EQ(1, p(1).as<intptr_t>());
+    EXPECT_EQ(4, p(2).as<intptr_t>());
+    EXPECT_EQ(3, p(3).as<intptr_t>());
+    EXPECT_EQ(0, p(4).as<intptr_t>());
+    EXPECT_EQ(2, p(5).as<intptr_t>());
+}
+
+TEST(Sort, Structs) {
+    nd::array a = parse_json("4 * {x: int32, y: string}",
+                    "[{\"x\": 2, \"y\": \"b\"}, {\"x\": 1, \"y\": \"z\"},"
+                    " {\"x\": 2, \"y\": \"a\"}, {\"x\": 1, \"y\": \"c\"}]");
+    nd::array b = nd::sort(a);
+    EXPECT_EQ(1, b(0, 0).as<int>());
+    EXPECT_EQ("c", b(0, 1).as<string>());
+    EXPECT_EQ(1, b(1, 0).as<int>());
+    EXPECT_EQ("z", b(1, 1).as<string>());
+    EXPECT_EQ(2, b(2, 0).as<int>());
+    EXPECT_EQ("a", b(2, 1).as<string>());
+    EXPECT_EQ(2, b(3, 0).as<int>());
+    EXPECT_EQ("b", b(3, 1).as<string>());
+}
+
+TEST(Sort, Axis) {
+    int vals[2][3] = {{3, 1, 2}, {0, 5, -1}};
+    nd::array a = vals;
+
+    nd::array b = nd::sort(a);
+    EXPECT_EQ(1, b(0, 0).as<int>());
+    EXPECT_EQ(2, b(0, 1).as<int>());
+    EXPECT_EQ(3, b(0, 2).as<int>());
+    EXPECT_EQ(-1, b(1, 0).as<int>());
+    EXPECT_EQ(0, b(1, 1).as<int>());
+    EXPECT_EQ(5, b(1, 2).as<int>());
+
+    b = nd::sort(a, 0);
+    EXPECT_EQ(0, b(0, 0).as<int>());
+    EXPECT_EQ(1, b(0, 1).as<int>());
+    EXPECT_EQ(-1, b(0, 2).as<int>());
+    EXPECT_EQ(3, b(1, 0).as<int>());
+    EXPECT_EQ(5, b(1, 1).as<int>());
+    EXPECT_EQ(2, b(1, 2).as<int>());
+
+    nd::array p = nd::argsort(a, 0);
+    EXPECT_EQ(1, p(0, 0).as<intptr_t>());
+    EXPECT_EQ(0, p(0, 1).as<intptr_t>());
+    EXPECT_EQ(1, p(0, 2).as<intptr_t>());
+    EXPECT_EQ(0, p(1, 0).as<intptr_t>());
+    EXPECT_EQ(1, p(1, 1).as<intptr_t>());
+    EXPECT_EQ(0, p(1, 2).as<intptr_t>());
+
+    EXPECT_THROW(nd::sort(a, 2), runtime_error);
+    EXPECT_THROW(nd::sort(a, -3), runtime_error);
+}
+
+TEST(Sort, VarDimInPlace) {
+    nd::array a = parse_json("3 * var * int32", "[[3, 2, 1], [], [9, -9, 0, 4]]");
+    a = a.eval_copy(nd::readwrite_access_flags);
+    nd::sort_inplace(a);
+    EXPECT_EQ(1, a(0, 0).as<int>());
+    EXPECT_EQ(3, a(0, 2).as<int>());
+    EXPECT_EQ(0, a(1).get_dim_size());
+    EXPECT_EQ(-9, a(2, 0).as<int>());
+    EXPECT_EQ(0, a(2, 1).as<int>());
+    EXPECT_EQ(4, a(2, 2).as<int>());
+    EXPECT_EQ(9, a(2, 3).as<int>());
+
+    // A strided view with a negative stride
+    int vals[] = {1, 2, 3, 4, 5, 6};
+    nd::array b = nd::array(vals)(irange().by(-2));
+    nd::array c = nd::sort(b);
+    EXPECT_EQ(2, c(0).as<int>());
+    EXPECT_EQ(4, c(1).as<int>());
+    EXPECT_EQ(6, c(2).as<int>());
+
+    // Can't sort a readonly array in place
+    EXPECT_THROW(nd::sort_inplace(nd::array(vals).eval_immutable()), runtime_error);
+}
+
+TEST(Sort, SearchSortedSmall) {
+    int vals[] = {1, 2, 2, 2, 5, 9};
+    int needles[] = {0, 2, 3, 9, 10};
+    nd::array a = vals;
+    nd::array left = nd::searchsorted(a, needles);
+    nd::array right = nd::searchsorted(a, needles, searchsorted_right);
+    EXPECT_EQ(ndt::type("strided * intptr"), left.get_type());
+    intptr_t left_expected[] = {0, 1, 4, 5, 6};
+    intptr_t right_expected[] = {0, 4, 4, 6, 6};
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(left_expected[i], left(i).as<intptr_t>());
+        EXPECT_EQ(right_expected[i], right(i).as<intptr_t>());
+    }
+    // A scalar needle gives a scalar result
+    EXPECT_EQ(4, nd::searchsorted(a, 3).as<intptr_t>());
+    // Empty sorted array
+    nd::array empty = nd::empty(0, ndt::type("strided * int32"));
+    EXPECT_EQ(0, nd::searchsorted(empty, needles)(4).as<intptr_t>());
+
+    EXPECT_THROW(nd::searchsorted(nd::array(5), needles), runtime_error);
+}
+
+template<class T>
+static void check_searchsorted(intptr_t count, intptr_t needle_count)
+{
+    vector<T> vals(count), needles(needle_count);
+    for (intptr_t i = 0; i < count; ++i) {
+        vals[i] = static_cast<T>(i / 3 * 2);
+    }
+    for (intptr_t i = 0; i < needle_count; ++i) {
+        needles[i] = static_cast<T>((i * 7919) % (count + 10) - 5);
+    }
+    nd::array a = vals, n = needles;
+    nd::array left = nd::searchsorted(a, n);
+    nd::array right = nd::searchsorted(a, n, searchsorted_right);
+    for (intptr_t i = 0; i < needle_count; ++i) {
+        EXPECT_EQ(lower_bound(vals.begin(), vals.end(), needles[i]) - vals.begin(),
+                        left(i).as<intptr_t>());
+        EXPECT_EQ(upper_bound(vals.begin(), vals.end(), needles[i]) - vals.begin(),
+                        right(i).as<intptr_t>());
+    }
+}
+
+TEST(Sort, SearchSortedBuiltins) {
+    // Few needles use the branchless search on the data
+    check_searchsorted<int32_t>(3000, 20);
+    check_searchsorted<double>(3000, 20);
+    // Many needles use an Eytzinger layout copy
+    check_searchsorted<int32_t>(3000, 1000);
+    check_searchsorted<int64_t>(5000, 1000);
+    check_searchsorted<uint16_t>(2000, 1000);
+    check_searchsorted<float>(4096, 600);
+}
+
+TEST(Sort, SearchSortedNaN) {
+    double nan = numeric_limits<double>::quiet_NaN();
+    double vals[] = {-1.0, -0.0, 0.0, 3.5, nan, nan};
+    double needles[] = {nan, 0.0, -0.0, 4.0};
+    nd::array a = vals;
+    nd::array left = nd::searchsorted(a, needles);
+    nd::array right = nd::searchsorted(a, needles, searchsorted_right);
+    EXPECT_EQ(4, left(0).as<intptr_t>());
+    EXPECT_EQ(6, right(0).as<intptr_t>());
+    EXPECT_EQ(1, left(1).as<intptr_t>());
+    EXPECT_EQ(3, right(1).as<intptr_t>());
+    EXPECT_EQ(1, left(2).as<intptr_t>());
+    EXPECT_EQ(3, right(2).as<intptr_t>());
+    EXPECT_EQ(4, left(3).as<intptr_t>());
+}
+
+TEST(Sort, SearchSortedStrings) {
+    const char *vals[] = {"apple", "banana", "banana", "pear"};
+    nd::array needles = parse_json("2 * 2 * string",
+                    "[[\"banana\", \"zebra\"], [\"\", \"cherry\"]]");
+    nd::array a = vals;
+    nd::array left = nd::searchsorted(a, needles);
+    nd::array right = nd::searchsorted(a, needles, searchsorted_right);
+    EXPECT_EQ(ndt::type("strided * strided * intptr"), left.get_type());
+    EXPECT_EQ(1, left(0, 0).as<intptr_t>());
+    EXPECT_EQ(3, right(0, 0).as<intptr_t>());
+    EXPECT_EQ(4, left(0, 1).as<intptr_t>());
+    EXPECT_EQ(0, left(1, 0).as<intptr_t>());
+    EXPECT_EQ(3, left(1, 1).as<intptr_t>());
+}
+
+TEST(Sort, SearchSortedConvertsNeedles) {
+    double vals[] = {0.5, 1.5, 2.5};
+    int needles[] = {0, 1, 2, 3};
+    nd::array left = nd::searchsorted(vals, needles);
+    EXPECT_EQ(0, left(0).as<intptr_t>());
+    EXPECT_EQ(1, left(1).as<intptr_t>());
+    EXPECT_EQ(2, left(2).as<intptr_t>());
+    EXPECT_EQ(3, left(3).as<intptr_t>());
+}
@@ -0,0 +1,117 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include "inc_gtest.hpp"
+
+#include <dynd/unique.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/kernels/hash_kernels.hpp>
+#include <dynd/types/fixedstring_type.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/types/cstruct_type.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+static uint64_t hash_of(const nd::array& a)
+{
+    hash_ckernel_builder k;
+    make_hash_kernel(&k, 0, a.get_type(), a.get_ndo_meta(), &eval::default_eval_context);
+    return k(a.get_readonly_originptr());
+}
+
+TEST(HashKernels, EqualValuesHashEqual) {
+    EXPECT_EQ(hash_of(nd::array(0.0)), hash_of(nd::array(-0.0)));
+    EXPECT_EQ(hash_of(nd::array(0.0f)), hash_of(nd::array(-0.0f)));
+    EXPECT_NE(hash_of(nd::array(1.0)), hash_of(nd::array(2.0)));
+    EXPECT_EQ(hash_of(nd::array("abc")), hash_of(nd::array(std::string("abc"))));
+    EXPECT_NE(hash_of(nd::array("abc")), hash_of(nd::array("abd")));
+    // Fixedstrings compare equal up to the first NUL
+    ndt::type fs = ndt::make_fixedstring(8, string_encoding_utf_8);
+    EXPECT_EQ(hash_of(nd::array("ab").ucast(fs).eval()), hash_of(nd::array("ab").ucast(fs).eval()));
+    EXPECT_EQ(hash_of(nd::array("2014-01-02").ucast(ndt::type("date")).eval()),
+                    hash_of(nd::array("2014-01-02").ucast(ndt::type("date")).eval()));
+    EXPECT_NE(hash_of(nd::array("2014-01-02").ucast(ndt::type("date")).eval()),
+                    hash_of(nd::array("2014-01-03").ucast(ndt::type("date")).eval()));
+    EXPECT_EQ(hash_of(parse_json("{x: int32, y: string}", "{\"x\": 1, \"y\": \"a\"}")),
+                    hash_of(parse_json("{x: int32, y: string}", "{\"x\": 1, \"y\": \"a\"}")));
+    EXPECT_NE(hash_of(parse_json("{x: int32, y: string}", "{\"x\": 1, \"y\": \"a\"}")),
+                    hash_of(parse_json("{x: int32, y: string}", "{\"x\": 1, \"y\": \"b\"}")));
+    EXPECT_THROW(hash_of(parse_json("3 * int32", "[1, 2, 3]")), runtime_error);
+}
+
+TEST(Unique, Builtins) {
+    int vals[] = {3, 1, 3, 2, 1, 3};
+    nd::array u = nd::unique(vals);
+    EXPECT_EQ(ndt::type("strided * int32"), u.get_type());
+    ASSERT_EQ(3, u.get_dim_size());
+    // First appearance order
+    EXPECT_EQ(3, u(0).as<int>());
+    EXPECT_EQ(1, u(1).as<int>());
+    EXPECT_EQ(2, u(2).as<int>());
+
+    double dvals[] = {0.0, -0.0, 1.5};
+    u = nd::unique(dvals);
+    ASSERT_EQ(2, u.get_dim_size());
+    EXPECT_EQ(1.5, u(1).as<double>());
+
+    u = nd::unique(nd::empty(0, ndt::type("strided * int32")));
+    EXPECT_EQ(0, u.get_dim_size());
+}
+
+TEST(Unique, StringsAndStructs) {
+    const char *svals[] = {"b", "a", "b", "c", "a"};
+    nd::array u = nd::unique(svals);
+    ASSERT_EQ(3, u.get_dim_size());
+    EXPECT_EQ("b", u(0).as<string>());
+    EXPECT_EQ("a", u(1).as<string>());
+    EXPECT_EQ("c", u(2).as<string>());
+
+    nd::array a = parse_json("var * {x: int32, y: string}",
+                    "[{\"x\": 1, \"y\": \"a\"}, {\"x\": 1, \"y\": \"b\"},"
+                    " {\"x\": 1, \"y\": \"a\"}]");
+    u = nd::unique(a);
+    ASSERT_EQ(2, u.get_dim_size());
+    EXPECT_EQ("b", u(1, 1).as<string>());
+
+    EXPECT_THROW(nd::unique(parse_json("2 * 2 * int32", "[[1, 2], [3, 4]]")), runtime_error);
+}
+
+TEST(Unique, ValueCounts) {
+    const char *svals[] = {"b", "a", "b", "c", "b", "a"};
+    nd::array vc = nd::value_counts(svals);
+    EXPECT_EQ(ndt::make_strided_dim(ndt::make_cstruct(ndt::make_string(), "value",
+                    ndt::make_type<intptr_t>(), "count")), vc.get_type());
+    ASSERT_EQ(3, vc.get_dim_size());
+    EXPECT_EQ("b", vc(0, 0).as<string>());
+    EXPECT_EQ(3, vc(0, 1).as<intptr_t>());
+    EXPECT_EQ("a", vc(1, 0).as<string>());
+    EXPECT_EQ(2, vc(1, 1).as<intptr_t>());
+    EXPECT_EQ("c", vc(2, 0).as<string>());
+    EXPECT_EQ(1, vc(2, 1).as<intptr_t>());
+}
+
+TEST(Unique, IsIn) {
+    int vals[] = {5, 1, 7, 3, 1};
+    int64_t lookup[] = {1, 3, 100};
+    nd::array r = nd::isin(vals, lookup);
+    EXPECT_EQ(ndt::type("strided * bool"), r.get_type());
+    ASSERT_EQ(5, r.get_dim_size());
+    EXPECT_FALSE(r(0).as<bool>());
+    EXPECT_TRUE(r(1).as<bool>());
+    EXPECT_FALSE(r(2).as<bool>());
+    EXPECT_TRUE(r(3).as<bool>());
+    EXPECT_TRUE(r(4).as<bool>());
+
+    const char *svals[] = {"x", "y", "z"};
+    const char *slookup[] = {"z", "x"};
+    r = nd::isin(svals, slookup);
+    EXPECT_TRUE(r(0).as<bool>());
+    EXPECT_FALSE(r(1).as<bool>());
+    EXPECT_TRUE(r(2).as<bool>());
+}
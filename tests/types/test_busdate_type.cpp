@@ -0,0 +1,185 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/types/busdate_type.hpp>
+#include <dynd/types/date_type.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/json_formatter.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(BusDateDType, Create) {
+    ndt::type d = ndt::make_busdate();
+    const busdate_type *bd = static_cast<const busdate_type *>(d.extended());
+    EXPECT_EQ(busdate_type_id, d.get_type_id());
+    EXPECT_TRUE(bd->is_default_workweek());
+    EXPECT_EQ(5, bd->get_busdays_in_weekmask());
+    EXPECT_EQ(0, bd->get_holiday_count());
+
+    // The holidays are sorted, without NA, duplicates or weekend days
+    const char *holidays[] = {"2011-12-26", "2011-07-04", "NA", "2011-12-25", "2011-07-04"};
+    d = ndt::make_busdate(busdate_roll_following, NULL, nd::array(holidays));
+    bd = static_cast<const busdate_type *>(d.extended());
+    ASSERT_EQ(2, bd->get_holiday_count());
+    EXPECT_EQ("[\"2011-07-04\",\"2011-12-26\"]", format_json(bd->get_holidays()).as<string>());
+
+    bool no_days[7] = {false, false, false, false, false, false, false};
+    EXPECT_THROW(ndt::make_busdate(busdate_roll_following, no_days), runtime_error);
+}
+
+TEST(BusDateDType, IsBusDay) {
+    const char *holidays[] = {"2011-07-01", "2011-07-04", "2011-07-17"};
+    ndt::type d = ndt::make_busdate(busdate_roll_following, NULL, nd::array(holidays));
+    const char *dates[] = {"2011-07-01", "2011-07-02", "2011-07-18", "NA", "2011-07-05"};
+    nd::array a = nd::is_busday(nd::array(dates), d).eval();
+    EXPECT_EQ(ndt::make_strided_dim(ndt::make_type<dynd_bool>()), a.get_type());
+    EXPECT_EQ("[false,false,true,false,true]", format_json(a).as<string>());
+
+    // Only Sundays
+    bool sundays[7] = {false, false, false, false, false, false, true};
+    d = ndt::make_busdate(busdate_roll_following, sundays);
+    EXPECT_TRUE(nd::is_busday(nd::array("2012-05-13"), d).as<bool>());
+    EXPECT_FALSE(nd::is_busday(nd::array("2012-05-14"), d).as<bool>());
+}
+
+TEST(BusDateDType, Offset) {
+    nd::array a;
+    // 2011-10-01 is a Saturday
+    EXPECT_EQ("2011-10-03", nd::busday_offset(nd::array("2011-10-01"), 0).as<string>());
+    a = nd::busday_offset(nd::array("2011-03-20"), parse_json("3 * int32", "[-1, 0, 1]"),
+                    ndt::make_busdate(busdate_roll_preceding));
+    EXPECT_EQ("[\"2011-03-17\",\"2011-03-18\",\"2011-03-21\"]", format_json(a).as<string>());
+    EXPECT_EQ("2011-04-01", nd::busday_offset(nd::array("2011-03-21"), 9).as<string>());
+    EXPECT_EQ("2011-02-07", nd::busday_offset(nd::array("2011-03-21"), -30).as<string>());
+
+    // Holidays are skipped over in both directions
+    const char *holidays[] = {"2011-12-23", "2011-12-26", "2012-01-02"};
+    ndt::type d = ndt::make_busdate(busdate_roll_following, NULL, nd::array(holidays));
+    EXPECT_EQ("2011-12-27", nd::busday_offset(nd::array("2011-12-22"), 1, d).as<string>());
+    EXPECT_EQ("2012-01-03", nd::busday_offset(nd::array("2011-12-22"), 5, d).as<string>());
+    EXPECT_EQ("2011-12-22", nd::busday_offset(nd::array("2012-01-03"), -5, d).as<string>());
+    // Rolling forward from a holiday
+    EXPECT_EQ("2011-12-27", nd::busday_offset(nd::array("2011-12-24"), 0, d).as<string>());
+
+    // The roll policies
+    const char *month_end[] = {"2011-04-30", "2011-05-01", "NA"};
+    a = nd::busday_offset(nd::array(month_end), 0, ndt::make_busdate(busdate_roll_modifiedfollowing));
+    EXPECT_EQ("[\"2011-04-29\",\"2011-05-02\",\"NA\"]", format_json(a).as<string>());
+    a = nd::busday_offset(nd::array(month_end), 0, ndt::make_busdate(busdate_roll_modifiedpreceding));
+    EXPECT_EQ("[\"2011-04-29\",\"2011-05-02\",\"NA\"]", format_json(a).as<string>());
+    a = nd::busday_offset(nd::array(month_end), 0, ndt::make_busdate(busdate_roll_nat));
+    EXPECT_EQ("[\"NA\",\"NA\",\"NA\"]", format_json(a).as<string>());
+    EXPECT_THROW(nd::busday_offset(nd::array(month_end), 0,
+                    ndt::make_busdate(busdate_roll_throw)).eval(), runtime_error);
+}
+
+TEST(BusDateDType, Count) {
+    nd::array a;
+    EXPECT_EQ(21, nd::busday_count(nd::array("2011-01-01"), nd::array("2011-02-01")).as<int32_t>());
+    EXPECT_EQ(260, nd::busday_count(nd::array("2011-01-01"), nd::array("2012-01-01")).as<int32_t>());
+    // Backwards, the begin date counts but not the end date
+    EXPECT_EQ(-22, nd::busday_count(nd::array("2011-02-01"), nd::array("2011-01-01")).as<int32_t>());
+    EXPECT_EQ(-1, nd::busday_count(nd::array("2011-01-04"), nd::array("2011-01-03")).as<int32_t>());
+    EXPECT_EQ(0, nd::busday_count(nd::array("2011-01-03"), nd::array("2011-01-03")).as<int32_t>());
+
+    const char *holidays[] = {"2011-12-23", "2011-12-26", "2012-01-02"};
+    ndt::type d = ndt::make_busdate(busdate_roll_following, NULL, nd::array(holidays));
+    const char *begins[] = {"2011-12-19", "2011-12-24", "NA"};
+    a = nd::busday_count(nd::array(begins), nd::array("2012-01-09"), d).eval();
+    EXPECT_EQ(ndt::make_strided_dim(ndt::make_type<int32_t>()), a.get_type());
+    EXPECT_EQ(12, a(0).as<int32_t>());
+    EXPECT_EQ(8, a(1).as<int32_t>());
+    EXPECT_EQ(DYND_DATE_NA, a(2).as<int32_t>());
+    // An NA end date also gives the NA count
+    const char *ends[] = {"NA", "2011-12-19"};
+    a = nd::busday_count(nd::array("2011-12-12"), nd::array(ends), d).eval();
+    EXPECT_EQ(DYND_DATE_NA, a(0).as<int32_t>());
+    EXPECT_EQ(5, a(1).as<int32_t>());
+}
+
+namespace {
+    // A straightforward day by day calendar to check the kernels against
+    struct reference_calendar {
+        bool weekmask[7];
+        vector<int32_t> holidays;
+
+        bool is_busday(int32_t days) const {
+            return weekmask[date_ymd::days_to_weekday(days)] &&
+                            !binary_search(holidays.begin(), holidays.end(), days);
+        }
+
+        int32_t offset(int32_t days, int32_t n) const {
+            while (!is_busday(days)) {
+                ++days;
+            }
+            for (; n > 0; --n) {
+                do ++days; while (!is_busday(days));
+            }
+            for (; n < 0; ++n) {
+                do --days; while (!is_busday(days));
+            }
+            return days;
+        }
+
+        int32_t count(int32_t begin, int32_t end) const {
+            int32_t result = 0;
+            for (int32_t d = begin; d < end; ++d) {
+                result += is_busday(d);
+            }
+            for (int32_t d = end + 1; d <= begin; ++d) {
+                result -= is_busday(d);
+            }
+            return result;
+        }
+    };
+} // anonymous namespace
+
+TEST(BusDateDType, AgainstReference) {
+    reference_calendar ref;
+    bool weekmask[7] = {true, false, true, true, true, true, false};
+    memcpy(ref.weekmask, weekmask, sizeof(weekmask));
+    // Holidays spread over two years from 2011-01-01, some on days off
+    vector<int32_t> holidays;
+    for (int i = 0; i < 60; ++i) {
+        holidays.push_back(14975 + (i * 37) % 730);
+    }
+    for (size_t i = 0; i < holidays.size(); ++i) {
+        if (weekmask[date_ymd::days_to_weekday(holidays[i])]) {
+            ref.holidays.push_back(holidays[i]);
+        }
+    }
+    sort(ref.holidays.begin(), ref.holidays.end());
+    ref.holidays.erase(unique(ref.holidays.begin(), ref.holidays.end()), ref.holidays.end());
+    ndt::type d = ndt::make_busdate(busdate_roll_following, weekmask,
+                    nd::array(holidays).view_scalars(ndt::make_date()));
+
+    // Dates around and across the holidays, in order and not
+    const int count = 500;
+    vector<int32_t> dates(count), ends(count), offsets(count);
+    for (int i = 0; i < count; ++i) {
+        dates[i] = 14900 + (i < count / 2 ? i : (i * 7919) % 900);
+        ends[i] = 14900 + (i * 104729) % 900;
+        offsets[i] = (i * 31) % 121 - 60;
+    }
+    nd::array a = nd::array(dates).view_scalars(ndt::make_date());
+    nd::array b = nd::array(ends).view_scalars(ndt::make_date());
+    nd::array is_bd = nd::is_busday(a, d).eval();
+    nd::array off = nd::busday_offset(a, nd::array(offsets), d).eval().view_scalars(ndt::make_type<int32_t>());
+    nd::array cnt = nd::busday_count(a, b, d).eval();
+    for (int i = 0; i < count; ++i) {
+        EXPECT_EQ(ref.is_busday(dates[i]), is_bd(i).as<bool>());
+        EXPECT_EQ(ref.offset(dates[i], offsets[i]), off(i).as<int32_t>());
+        EXPECT_EQ(ref.count(dates[i], ends[i]), cnt(i).as<int32_t>());
+    }
+}
@@ -12,6 +12,9 @@
 #include <dynd/types/byteswap_type.hpp>
 #include <dynd/types/convert_type.hpp>
 #include <dynd/types/fixedbytes_type.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+#include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/kernels/byteswap_kernels.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -78,3 +81,141 @@ TEST(ByteswapDType, CanonicalDType) {
     // The canonical type of a byteswap type is always the non-swapped version
     EXPECT_EQ((ndt::make_type<float>()), (ndt::make_byteswap<float>().get_canonical_type()));
 }
+
+template<class T>
+static T swapped(T value)
+{
+    T result;
+    const char *src = reinterpret_cast<const char *>(&value);
+    char *dst = reinterpret_cast<char *>(&result);
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        dst[i] = src[sizeof(T) - 1 - i];
+    }
+    return result;
+}
+
+template<class T>
+static void check_strided_byteswap(int count)
+{
+    nd::array a = nd::empty(count, ndt::make_strided_dim(ndt::make_type<T>()));
+    T *a_ptr = reinterpret_cast<T *>(a.get_readwrite_originptr());
+    for (int i = 0; i < count; ++i) {
+        a_ptr[i] = static_cast<T>(i * 0x01020305u + 7u);
+    }
+    // Contiguous
+    nd::array b = nd::empty(count, ndt::make_strided_dim(ndt::make_byteswap<T>()));
+    b.val_assign(a);
+    const T *b_ptr = reinterpret_cast<const T *>(b.get_readonly_originptr());
+    for (int i = 0; i < count; ++i) {
+        EXPECT_EQ(swapped(a_ptr[i]), b_ptr[i]) << i;
+    }
+    nd::array c = nd::empty(count, ndt::make_strided_dim(ndt::make_type<T>()));
+    c.val_assign(b);
+    const T *c_ptr = reinterpret_cast<const T *>(c.get_readonly_originptr());
+    for (int i = 0; i < count; ++i) {
+        EXPECT_EQ(a_ptr[i], c_ptr[i]) << i;
+    }
+    // Strided
+    nd::array d = nd::empty((count + 1) / 2, ndt::make_strided_dim(ndt::make_type<T>()));
+    d.val_assign(b(irange().by(2)));
+    for (int i = 0; i < (count + 1) / 2; ++i) {
+        EXPECT_EQ(a_ptr[2 * i], d(i).as<T>()) << i;
+    }
+}
+
+TEST(ByteswapDType, StridedSizes) {
+    // Odd counts, so the vectorized loops also run their remainders
+    for (int count = 1; count < 70; count += 17) {
+        check_strided_byteswap<int16_t>(count);
+        check_strided_byteswap<uint32_t>(count);
+        check_strided_byteswap<int64_t>(count);
+    }
+    check_strided_byteswap<int16_t>(1001);
+    check_strided_byteswap<uint32_t>(1001);
+    check_strided_byteswap<int64_t>(1001);
+}
+
+TEST(ByteswapDType, StridedComplex) {
+    nd::array a = nd::empty(37, "strided * complex[float64]");
+    for (int i = 0; i < 37; ++i) {
+        a(i).vals() = dynd_complex<double>(i * 1.5, -i - 0.25);
+    }
+    nd::array b = nd::empty(37, ndt::make_strided_dim(ndt::make_byteswap<dynd_complex<double> >()));
+    b.val_assign(a);
+    const double *b_ptr = reinterpret_cast<const double *>(b.get_readonly_originptr());
+    for (int i = 0; i < 37; ++i) {
+        EXPECT_EQ(swapped(i * 1.5), b_ptr[2 * i]);
+        EXPECT_EQ(swapped(-i - 0.25), b_ptr[2 * i + 1]);
+    }
+    nd::array c = nd::empty(19, "strided * complex[float64]");
+    c.val_assign(b(irange().by(2)));
+    for (int i = 0; i < 19; ++i) {
+        EXPECT_EQ(dynd_complex<double>(2 * i * 1.5, -2 * i - 0.25), c(i).as<dynd_complex<double> >());
+    }
+
+    nd::array f = nd::empty(37, "strided * complex[float32]");
+    f.val_assign(a);
+    nd::array g = nd::empty(37, ndt::make_strided_dim(ndt::make_byteswap<dynd_complex<float> >()));
+    g.val_assign(f);
+    const float *g_ptr = reinterpret_cast<const float *>(g.get_readonly_originptr());
+    for (int i = 0; i < 37; ++i) {
+        EXPECT_EQ(swapped(i * 1.5f), g_ptr[2 * i]);
+        EXPECT_EQ(swapped(-i - 0.25f), g_ptr[2 * i + 1]);
+    }
+}
+
+TEST(ByteswapDType, ByteswapInPlace) {
+    int32_t vals[37];
+    for (int i = 0; i < 37; ++i) {
+        vals[i] = i * 0x01010101 + 0x10203;
+    }
+    assignment_strided_ckernel_builder ckb;
+    make_byteswap_assignment_function(&ckb, 0, 4, 4, kernel_request_strided);
+    ckb((char *)vals, sizeof(int32_t), (const char *)vals, sizeof(int32_t), 37);
+    for (int i = 0; i < 37; ++i) {
+        EXPECT_EQ(swapped(i * 0x01010101 + 0x10203), vals[i]);
+    }
+
+    int64_t pairs[2 * 9];
+    for (int i = 0; i < 2 * 9; ++i) {
+        pairs[i] = i * 0x0101010101010101LL;
+    }
+    assignment_strided_ckernel_builder ckb_pairs;
+    make_pairwise_byteswap_assignment_function(&ckb_pairs, 0, 16, 8, kernel_request_strided);
+    ckb_pairs((char *)pairs, 16, (const char *)pairs, 16, 9);
+    for (int i = 0; i < 2 * 9; ++i) {
+        EXPECT_EQ(swapped(i * 0x0101010101010101LL), pairs[i]);
+    }
+}
+
+TEST(ByteswapDType, FusedConvert) {
+    nd::array a = nd::empty(1001, ndt::make_strided_dim(ndt::make_byteswap<int32_t>()));
+    int32_t *a_ptr = reinterpret_cast<int32_t *>(a.get_readwrite_originptr());
+    for (int i = 0; i < 1001; ++i) {
+        a_ptr[i] = swapped(i * 1000 - 500000);
+    }
+    // Lossless, so this uses the fused kernel in the default error mode
+    nd::array b = nd::empty(1001, "strided * float64");
+    b.val_assign(a);
+    for (int i = 0; i < 1001; ++i) {
+        EXPECT_EQ(i * 1000 - 500000, b(i).as<double>());
+    }
+    nd::array c = nd::empty(501, "strided * int64");
+    c.val_assign(a(irange().by(2)), assign_error_none);
+    for (int i = 0; i < 501; ++i) {
+        EXPECT_EQ(2 * i * 1000 - 500000, c(i).as<int64_t>());
+    }
+    // A checked conversion goes through the buffered path and still raises errors
+    nd::array d = nd::empty(1001, "strided * int16");
+    EXPECT_THROW(d.val_assign(a, assign_error_overflow), overflow_error);
+    d.val_assign(a, assign_error_none);
+    EXPECT_EQ((int16_t)(1000 * 1000 - 500000), d(1000).as<int16_t>());
+
+    nd::array f = nd::empty(1001, ndt::make_strided_dim(ndt::make_byteswap<double>()));
+    f.val_assign(b);
+    nd::array g = nd::empty(1001, "strided * float32");
+    g.val_assign(f, assign_error_none);
+    for (int i = 0; i < 1001; i += 7) {
+        EXPECT_EQ((float)(i * 1000 - 500000), g(i).as<float>());
+    }
+}
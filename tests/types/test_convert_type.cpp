@@ -8,9 +8,12 @@
 #include <stdexcept>
 #include "inc_gtest.hpp"
 
+#include <dynd/array.hpp>
 #include <dynd/typed_data_assign.hpp>
 #include <dynd/types/byteswap_type.hpp>
 #include <dynd/types/convert_type.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+#include <dynd/kernels/assignment_kernels.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -28,3 +31,39 @@ TEST(ConvertDType, CanonicalDType) {
     EXPECT_EQ((ndt::make_type<float>()), (ndt::make_convert<float, int>().get_canonical_type()));
 }
 
+
+TEST(ConvertDType, BufferedChain) {
+    nd::array a = nd::empty(1001, "strided * int32");
+    for (int i = 0; i < 1001; ++i) {
+        a(i).vals() = i * 7 - 3000;
+    }
+    // A chain of conversions is evaluated through a buffer, a chunk at a time
+    nd::array b = a.ucast<double>().ucast<int64_t>();
+    EXPECT_TRUE(b.get_dtype().operand_type().is_expression());
+    nd::array c = nd::empty(1001, "strided * int64");
+    eval::eval_context ectx;
+    for (size_t buffer_max_mem = 1; buffer_max_mem <= 65536; buffer_max_mem *= 16) {
+        ectx.buffer_max_mem = buffer_max_mem;
+        c.vals() = 0;
+        c.val_assign(b, assign_error_default, &ectx);
+        for (int i = 0; i < 1001; ++i) {
+            EXPECT_EQ(i * 7 - 3000, c(i).as<int64_t>()) << i << ", " << buffer_max_mem;
+        }
+    }
+    // Including with a non-contiguous source
+    nd::array d = nd::empty(501, "strided * int64");
+    d.val_assign(a(irange().by(2)).ucast<double>().ucast<int64_t>());
+    for (int i = 0; i < 501; ++i) {
+        EXPECT_EQ(i * 14 - 3000, d(i).as<int64_t>()) << i;
+    }
+}
+
+TEST(ConvertDType, BufferElementCount) {
+    eval::eval_context ectx;
+    ectx.buffer_max_mem = 4096;
+    EXPECT_EQ(4096u, get_buffer_element_count(1, &ectx));
+    EXPECT_EQ(512u, get_buffer_element_count(8, &ectx));
+    EXPECT_EQ(1u, get_buffer_element_count(10000, &ectx));
+    EXPECT_EQ(1u, get_buffer_element_count(0, &ectx));
+    EXPECT_EQ(eval::default_eval_context.buffer_max_mem / 4, get_buffer_element_count(4, NULL));
+}
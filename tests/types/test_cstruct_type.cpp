@@ -15,6 +15,7 @@
 #include <dynd/types/string_type.hpp>
 #include <dynd/types/convert_type.hpp>
 #include <dynd/types/byteswap_type.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -301,6 +302,59 @@ TEST(CStructDType, FromStructAssign) {
     EXPECT_EQ(8,    b(1,1).as<short>());
 }
 
+TEST(CStructDType, ColumnarLayout) {
+    const int n = 100;
+    ndt::type dt = ndt::make_cstruct(ndt::make_type<int>(), "x", ndt::make_type<double>(), "y", ndt::make_string(), "s");
+    nd::array a = nd::make_strided_array(n, dt);
+    for (int i = 0; i < n; ++i) {
+        a(i,0).vals() = i;
+        a(i,1).vals() = i * 0.5;
+        stringstream ss;
+        ss << "s" << i;
+        a(i,2).vals() = ss.str();
+    }
+
+    ndt::type ct = ndt::make_columnar_cstruct(n, dt);
+    EXPECT_EQ(ndt::make_cstruct(ndt::make_fixed_dim(n, ndt::make_type<int>()), "x",
+                    ndt::make_fixed_dim(n, ndt::make_type<double>()), "y",
+                    ndt::make_fixed_dim(n, ndt::make_string()), "s"), ct);
+    nd::array c = nd::empty(ct);
+    c.val_assign(a);
+    // Each field is a contiguous column
+    nd::array x = c.p("x");
+    EXPECT_EQ(ndt::make_fixed_dim(n, ndt::make_type<int>()), x.get_type());
+    EXPECT_EQ(c.get_readonly_originptr(), x.get_readonly_originptr());
+    for (int i = 0; i < n; i += 9) {
+        stringstream ss;
+        ss << "s" << i;
+        EXPECT_EQ(i, x(i).as<int>());
+        EXPECT_EQ(i * 0.5, c.p("y")(i).as<double>());
+        EXPECT_EQ(ss.str(), c.p("s")(i).as<string>());
+    }
+
+    // Elementwise operations on the columns
+    nd::array sum = (c.p("y") + c.p("y")).eval();
+    EXPECT_EQ(99.0, sum(99).as<double>());
+
+    // Back to an array of structs, with the fields in a different order
+    x(3).vals() = 1000;
+    ndt::type dt2 = ndt::make_cstruct(ndt::make_string(), "s", ndt::make_type<float>(), "y", ndt::make_type<int64_t>(), "x");
+    nd::array b = nd::make_strided_array(n, dt2);
+    b.val_assign(c);
+    for (int i = 0; i < n; i += 9) {
+        stringstream ss;
+        ss << "s" << i;
+        EXPECT_EQ(ss.str(), b(i,0).as<string>());
+        EXPECT_EQ(i * 0.5, b(i,1).as<float>());
+        EXPECT_EQ(i == 3 ? 1000 : i, b(i,2).as<int64_t>());
+    }
+
+    // The sizes must match
+    nd::array d = nd::make_strided_array(n - 1, dt);
+    EXPECT_THROW(d.val_assign(c), broadcast_error);
+    EXPECT_THROW(c.val_assign(d), broadcast_error);
+}
+
 TEST(CStructDType, SingleCompare) {
     nd::array a, b;
     ndt::type sdt = ndt::make_cstruct(ndt::make_type<int32_t>(), "a",
@@ -458,3 +458,72 @@ TEST(DataShapeParser, KivaLoanDataShape) {
     ndt::type d = type_from_datashape(klds);
     EXPECT_EQ(cstruct_type_id, d.get_type_id());
 }
+
+TEST(DataShapeParser, Keywords) {
+    // Names which are close to keywords are free dimensions or unknown types
+    EXPECT_EQ(ndt::make_strided_dim(ndt::make_type<int32_t>()), type_from_datashape("int * int32"));
+    EXPECT_EQ(ndt::make_strided_dim(ndt::make_type<int32_t>()), type_from_datashape("var2 * int32"));
+    EXPECT_EQ(ndt::make_strided_dim(ndt::make_type<int32_t>()), type_from_datashape("strings * int32"));
+    EXPECT_THROW(type_from_datashape("int32x"), runtime_error);
+    EXPECT_THROW(type_from_datashape("dat"), runtime_error);
+    // Keywords can't be used as dimension names
+    const char *keywords[] = {"int32", "datetime", "string", "char", "bytes", "pointer",
+                    "cuda_device", "ckernel_deferred", "type", "json"};
+    for (size_t i = 0; i < sizeof(keywords) / sizeof(keywords[0]); ++i) {
+        EXPECT_THROW(type_from_datashape(string(keywords[i]) + " * int32"), runtime_error);
+    }
+    // Builtin types can't be redefined, but the parameterized names can be
+    EXPECT_THROW(type_from_datashape("type date = int32\ndate"), runtime_error);
+    EXPECT_THROW(type_from_datashape("type bytes = int32\nbytes"), runtime_error);
+    EXPECT_EQ(ndt::make_type<int32_t>(), type_from_datashape("type X = int32\nX"));
+}
+
+TEST(DataShapeParser, Cache) {
+    clear_datashape_cache();
+    ndt::type a = type_from_datashape("3 * var * {x: int32, y: string}");
+    ndt::type b = type_from_datashape("3 * var * {x: int32, y: string}");
+    // The second parse returns the cached type itself
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.extended(), b.extended());
+    datashape_cache_stats st = get_datashape_cache_stats();
+    EXPECT_EQ(1u, st.hits);
+    EXPECT_EQ(1u, st.misses);
+    EXPECT_EQ(1u, st.size);
+
+    // The constructor from a string goes through the cache
+    EXPECT_EQ(a.extended(), ndt::type("3 * var * {x: int32, y: string}").extended());
+    EXPECT_EQ(2u, get_datashape_cache_stats().hits);
+
+    // Errors are not cached
+    EXPECT_THROW(type_from_datashape("3 * blah"), runtime_error);
+    EXPECT_THROW(type_from_datashape("3 * blah"), runtime_error);
+    EXPECT_EQ(1u, get_datashape_cache_stats().size);
+
+    // The least recently used types are evicted beyond the capacity
+    set_datashape_cache_capacity(2);
+    type_from_datashape("int32");
+    type_from_datashape("float64");
+    st = get_datashape_cache_stats();
+    EXPECT_EQ(2u, st.size);
+    EXPECT_EQ(1u, st.evictions);
+    type_from_datashape("int32");
+    EXPECT_EQ(3u, get_datashape_cache_stats().hits);
+    type_from_datashape("3 * var * {x: int32, y: string}");
+    EXPECT_EQ(3u, get_datashape_cache_stats().hits);
+
+    // Long datashapes bypass the cache
+    string big = "{";
+    for (int i = 0; i < 500; ++i) {
+        stringstream ss;
+        ss << "field" << i << ": int32, ";
+        big += ss.str();
+    }
+    big += "}";
+    ndt::type big_tp = type_from_datashape(big);
+    EXPECT_EQ(500u, static_cast<const base_struct_type *>(big_tp.extended())->get_field_count());
+    EXPECT_EQ(1u, get_datashape_cache_stats().bypasses);
+
+    set_datashape_cache_capacity(1024);
+    clear_datashape_cache();
+    EXPECT_EQ(0u, get_datashape_cache_stats().size);
+}
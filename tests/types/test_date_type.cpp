@@ -6,6 +6,9 @@
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
+#include <cstring>
+#include <limits>
+#include <time.h>
 #include "inc_gtest.hpp"
 
 #include <dynd/array.hpp>
@@ -158,6 +161,192 @@ TEST(DateDType, DateProperties) {
     EXPECT_EQ(25, a.p("day")(2).as<int32_t>());
 }
 
+TEST(DateDType, StridedDateProperties) {
+    ndt::type d = ndt::make_date();
+    nd::array a, b;
+
+    const char *strs[] = {"1931-12-12", "NA", "2013-05-14", "1600-02-29", "0001-01-01", "2100-03-01"};
+    a = nd::array(strs).ucast(d).eval();
+    b = a.p("year").eval();
+    EXPECT_EQ(1931, b(0).as<int32_t>());
+    EXPECT_EQ(0, b(1).as<int32_t>());
+    EXPECT_EQ(2013, b(2).as<int32_t>());
+    EXPECT_EQ(1600, b(3).as<int32_t>());
+    EXPECT_EQ(1, b(4).as<int32_t>());
+    EXPECT_EQ(2100, b(5).as<int32_t>());
+    b = a.p("month").eval();
+    EXPECT_EQ(12, b(0).as<int32_t>());
+    EXPECT_EQ(-128, b(1).as<int32_t>());
+    EXPECT_EQ(5, b(2).as<int32_t>());
+    EXPECT_EQ(2, b(3).as<int32_t>());
+    EXPECT_EQ(1, b(4).as<int32_t>());
+    EXPECT_EQ(3, b(5).as<int32_t>());
+    b = a.p("day").eval();
+    EXPECT_EQ(12, b(0).as<int32_t>());
+    EXPECT_EQ(0, b(1).as<int32_t>());
+    EXPECT_EQ(14, b(2).as<int32_t>());
+    EXPECT_EQ(29, b(3).as<int32_t>());
+    EXPECT_EQ(1, b(4).as<int32_t>());
+    EXPECT_EQ(1, b(5).as<int32_t>());
+    b = a.f("weekday").eval();
+    EXPECT_EQ(5, b(0).as<int32_t>());
+    EXPECT_EQ(1, b(2).as<int32_t>());
+    EXPECT_EQ(0, b(5).as<int32_t>());
+
+    // A non-contiguous view
+    b = a(irange().by(2)).p("year").eval();
+    EXPECT_EQ(3, b.get_dim_size());
+    EXPECT_EQ(1931, b(0).as<int32_t>());
+    EXPECT_EQ(2013, b(1).as<int32_t>());
+    EXPECT_EQ(1, b(2).as<int32_t>());
+}
+
+TEST(DateDType, Arithmetic) {
+    ndt::type d = ndt::make_date();
+    nd::array a, b, c;
+
+    const char *strs[] = {"2012-02-28", "NA", "1969-12-31"};
+    a = nd::array(strs).ucast(d).eval();
+    b = (a + 2).eval();
+    EXPECT_EQ(ndt::make_strided_dim(d), b.get_type());
+    EXPECT_EQ("2012-03-01", b(0).as<string>());
+    EXPECT_EQ("NA", b(1).as<string>());
+    EXPECT_EQ("1970-01-02", b(2).as<string>());
+    b = (nd::array(365LL) + a).eval();
+    EXPECT_EQ("2013-02-27", b(0).as<string>());
+    b = (a - 59).eval();
+    EXPECT_EQ("2011-12-31", b(0).as<string>());
+    EXPECT_EQ("NA", b(1).as<string>());
+
+    // The difference of two dates is a number of days
+    c = (b - a).eval();
+    EXPECT_EQ(ndt::make_strided_dim(ndt::make_type<int32_t>()), c.get_type());
+    EXPECT_EQ(-59, c(0).as<int32_t>());
+    EXPECT_EQ(DYND_DATE_NA, c(1).as<int32_t>());
+    EXPECT_EQ(-59, c(2).as<int32_t>());
+    c = (a - nd::array("2000-01-01").ucast(d).eval()).eval();
+    EXPECT_EQ(4441, c(0).as<int32_t>());
+    EXPECT_EQ(-10958, c(2).as<int32_t>());
+}
+
+TEST(DateDType, ArithmeticOutOfRange) {
+    ndt::type d = ndt::make_date();
+    int32_t int32_max = numeric_limits<int32_t>::max();
+    int32_t int32_min = numeric_limits<int32_t>::min();
+    nd::array a, b, c;
+
+    // Results which don't fit in int32 days are NA, rather than wrapping
+    const char *strs[] = {"2000-01-01", "1969-12-31", "1970-01-01"};
+    a = nd::array(strs).ucast(d).eval();
+    b = (a + int32_max).eval().view_scalars(ndt::make_type<int32_t>());
+    EXPECT_EQ(DYND_DATE_NA, b(0).as<int32_t>());
+    EXPECT_EQ(int32_max - 1, b(1).as<int32_t>());
+    EXPECT_EQ(int32_max, b(2).as<int32_t>());
+    b = (a - int32_min).eval().view_scalars(ndt::make_type<int32_t>());
+    EXPECT_EQ(DYND_DATE_NA, b(0).as<int32_t>());
+    EXPECT_EQ(int32_max, b(1).as<int32_t>());
+    EXPECT_EQ(DYND_DATE_NA, b(2).as<int32_t>());
+    b = (a + int32_min).eval().view_scalars(ndt::make_type<int32_t>());
+    EXPECT_EQ(int32_min + 10957, b(0).as<int32_t>());
+    EXPECT_EQ(DYND_DATE_NA, b(1).as<int32_t>());
+    EXPECT_EQ(DYND_DATE_NA, b(2).as<int32_t>());
+    // 1969-12-31 minus INT32_MAX days lands exactly on the NA value
+    b = (a - int32_max).eval().view_scalars(ndt::make_type<int32_t>());
+    EXPECT_EQ(10957 - int32_max, b(0).as<int32_t>());
+    EXPECT_EQ(DYND_DATE_NA, b(1).as<int32_t>());
+    EXPECT_EQ(-int32_max, b(2).as<int32_t>());
+
+    // Differences which don't fit in int32 are NA
+    int32_t days[] = {int32_max, int32_min + 1, 0};
+    a = nd::array(days).view_scalars(d);
+    c = (a - a(1)).eval();
+    EXPECT_EQ(DYND_DATE_NA, c(0).as<int32_t>());
+    EXPECT_EQ(0, c(1).as<int32_t>());
+    EXPECT_EQ(int32_max, c(2).as<int32_t>());
+    c = (a - a(0)).eval();
+    EXPECT_EQ(0, c(0).as<int32_t>());
+    EXPECT_EQ(DYND_DATE_NA, c(1).as<int32_t>());
+    EXPECT_EQ(-int32_max, c(2).as<int32_t>());
+}
+
+TEST(DateDType, FixedFormatParse) {
+    ndt::type d = ndt::make_date();
+    nd::array a, b;
+
+    // The ISO 8601 fast path, checked against the general parser via UTF-16
+    const char *strs[] = {"2013-05-14", "NA", "1600-02-29", "0001-01-01", "9999-12-31",
+                    "1969-12-31", "2000-02-29", "Jan 3, 2004", "May 14, 2013", "2014/02/03"};
+    a = nd::array(strs).ucast(d).eval();
+    b = nd::array(strs).ucast(ndt::make_string(string_encoding_utf_16)).eval().ucast(d).eval();
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(b(i).as<string>(), a(i).as<string>());
+    }
+    EXPECT_EQ("2013-05-14", a(0).as<string>());
+    EXPECT_EQ("NA", a(1).as<string>());
+    EXPECT_EQ("9999-12-31", a(4).as<string>());
+    EXPECT_EQ("2004-01-03", a(7).as<string>());
+    EXPECT_EQ("2013-05-14", a(8).as<string>());
+    EXPECT_EQ("2014-02-03", a(9).as<string>());
+    EXPECT_EQ(-1, a(5).view_scalars(ndt::make_type<int32_t>()).as<int32_t>());
+
+    // Strings that look ISO 8601 but aren't valid dates
+    const char *bad_strs[] = {"2013-02-29", "2013-13-01", "2013-00-10", "2013-01-32", "20a3-01-01"};
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_THROW(nd::array(bad_strs[i]).ucast(d).eval(), invalid_argument);
+    }
+}
+
+TEST(DateDType, LockDateFormat) {
+    ndt::type d = ndt::make_date();
+    eval::eval_context ectx;
+    ectx.lock_date_format = true;
+    nd::array a;
+
+    // The first string is ISO 8601, so the rest must be too
+    const char *iso_strs[] = {"NA", "2013-05-14", "NA", "1600-02-29"};
+    a = nd::array(iso_strs).ucast(d).eval(&ectx);
+    EXPECT_EQ("2013-05-14", a(1).as<string>());
+    EXPECT_EQ("1600-02-29", a(3).as<string>());
+    const char *mixed_strs[] = {"2013-05-14", "Jan 3, 2004"};
+    EXPECT_THROW(nd::array(mixed_strs).ucast(d).eval(&ectx), invalid_argument);
+    // Without the lock, the general parser handles them
+    a = nd::array(mixed_strs).ucast(d).eval();
+    EXPECT_EQ("2004-01-03", a(1).as<string>());
+
+    // The first string is another format, so everything uses the general parser
+    const char *general_strs[] = {"Jan 3, 2004", "2013-05-14"};
+    a = nd::array(general_strs).ucast(d).eval(&ectx);
+    EXPECT_EQ("2004-01-03", a(0).as<string>());
+    EXPECT_EQ("2013-05-14", a(1).as<string>());
+}
+
+TEST(DateDType, LockDateFormatFixedString) {
+    // Fixed-size strings don't refer to memory blocks, so their
+    // conversion kernels can come from the ckernel cache
+    ndt::type d = ndt::make_date();
+    ndt::type fs = ndt::make_fixedstring(16, string_encoding_utf_8);
+    eval::eval_context ectx;
+    ectx.lock_date_format = true;
+    nd::array a;
+
+    const char *iso_strs[] = {"2013-05-14", "1600-02-29"};
+    a = nd::array(iso_strs).ucast(fs).eval().ucast(d).eval(&ectx);
+    EXPECT_EQ("1600-02-29", a(1).as<string>());
+    // A locked conversion doesn't change later unlocked ones
+    const char *mixed_strs[] = {"2013-05-14", "Jan 3, 2004"};
+    nd::array mixed = nd::array(mixed_strs).ucast(fs).eval();
+    a = mixed.ucast(d).eval();
+    EXPECT_EQ("2004-01-03", a(1).as<string>());
+    eval::eval_context fresh_ectx;
+    a = mixed.ucast(d).eval(&fresh_ectx);
+    EXPECT_EQ("2004-01-03", a(1).as<string>());
+    // Each locked conversion detects the format afresh
+    const char *general_strs[] = {"Jan 3, 2004", "2013-05-14"};
+    a = nd::array(general_strs).ucast(fs).eval().ucast(d).eval(&ectx);
+    EXPECT_EQ("2013-05-14", a(1).as<string>());
+    EXPECT_THROW(mixed.ucast(d).eval(&ectx), invalid_argument);
+}
+
 TEST(DateDType, DatePropertyConvertOfString) {
     nd::array a, b, c;
     const char *strs[] = {"1931-12-12", "2013-05-14", "2012-12-25"};
@@ -308,6 +497,49 @@ TEST(DateDType, StrFTime) {
     EXPECT_EQ("2012-12-25 360 52 2 52", b(2).as<string>());
 }
 
+TEST(DateDType, StrFTimeCompiled) {
+    ndt::type d = ndt::make_date();
+    nd::array a, b;
+
+    // The compiled format against the C library strftime
+    const char *format = "%Y-%m-%d|%F|%j|%U|%W|%w|%u|%e|%y|%C|%%|%n%t";
+    nd::array days = nd::empty(1000, ndt::make_strided_dim(ndt::make_type<int32_t>()));
+    int32_t *days_data = reinterpret_cast<int32_t *>(days.get_readwrite_originptr());
+    for (int i = 0; i < 1000; ++i) {
+        // 1000-01-01 to 9999-12-31
+        days_data[i] = static_cast<int32_t>(-354285 + (i * 2924831LL) % 3287181);
+    }
+    a = days.view_scalars(d);
+    b = a.f("strftime", nd::array(format)).eval();
+    for (int i = 0; i < 1000; ++i) {
+        date_ymd ymd;
+        ymd.set_from_days(days_data[i]);
+        struct tm tm_val;
+        memset(&tm_val, 0, sizeof(tm_val));
+        tm_val.tm_year = ymd.year - 1900;
+        tm_val.tm_mon = ymd.month - 1;
+        tm_val.tm_mday = ymd.day;
+        tm_val.tm_yday = ymd.get_day_of_year();
+        tm_val.tm_wday = (ymd.get_weekday() + 1) % 7;
+        char buf[128];
+        size_t len = strftime(buf, sizeof(buf), format, &tm_val);
+        EXPECT_EQ(string(buf, len), b(i).as<string>());
+    }
+
+    // NA, and years outside 0001 to 9999
+    const char *strs[] = {"NA", "0005-01-09", "-000012-12-31", "+012345-06-07"};
+    a = nd::array(strs).ucast(d).eval();
+    b = a.f("strftime", "%Y %y %C %j").eval();
+    EXPECT_EQ("NA", b(0).as<string>());
+    EXPECT_EQ("5 05 00 009", b(1).as<string>());
+    EXPECT_EQ("-12 88 -1 366", b(2).as<string>());
+    EXPECT_EQ("12345 45 123 158", b(3).as<string>());
+
+    // Directives which depend on the locale still use the C library
+    a = nd::array("1955-03-13").ucast(d).eval();
+    EXPECT_EQ("Mar 13 1955", a.f("strftime", "%b %d %Y").as<string>());
+}
+
 TEST(DateDType, StrFTimeOfConvert) {
     // First create a date array which is still a convert expression type
     const char *vals[] = {"1920-03-12", "2013-01-01", "2000-12-25"};
@@ -669,6 +901,42 @@ TEST(DateYMD, SetFromDays) {
     EXPECT_EQ(1, d.day);
 }
 
+TEST(DateYMD, DaysToYMDAgainstCalendar) {
+    // Walk the calendar a day at a time, comparing with days_to_ymd,
+    // to_days and get_weekday
+    int32_t year = -2200, month = 1, day = 1;
+    int32_t days = date_ymd::to_days(year, month, day);
+    EXPECT_EQ(-1523061, days);
+    for (int i = 0; i < 1700000; ++i, ++days) {
+        int32_t y, m, d;
+        date_ymd::days_to_ymd(days, y, m, d);
+        ASSERT_EQ(year, y);
+        ASSERT_EQ(month, m);
+        ASSERT_EQ(day, d);
+        ASSERT_EQ(days, date_ymd::to_days(year, month, day));
+        ASSERT_EQ(((days - 4) % 7 + 7) % 7, date_ymd::days_to_weekday(days));
+        if (++day > date_ymd::get_month_length(year, month)) {
+            day = 1;
+            if (++month > 12) {
+                month = 1;
+                ++year;
+            }
+        }
+    }
+    EXPECT_EQ(2454, year);
+
+    // The ends of the documented range
+    int32_t y, m, d;
+    date_ymd::days_to_ymd(-731204468, y, m, d);
+    EXPECT_EQ(-2000000, y);
+    EXPECT_EQ(3, m);
+    EXPECT_EQ(1, d);
+    date_ymd::days_to_ymd(342537355, y, m, d);
+    EXPECT_EQ(939805, y);
+    EXPECT_EQ(6, m);
+    EXPECT_EQ(5, d);
+}
+
 TEST(DateYMD, ToStr) {
     date_ymd d;
 
@@ -10,6 +10,8 @@
 
 #include <dynd/array.hpp>
 #include <dynd/types/datetime_type.hpp>
+#include <dynd/types/tzdata.hpp>
+#include <dynd/types/date_util.hpp>
 #include <dynd/types/property_type.hpp>
 #include <dynd/types/strided_dim_type.hpp>
 #include <dynd/types/fixedstring_type.hpp>
@@ -147,3 +149,177 @@ TEST(DateTimeDType, Properties) {
     EXPECT_EQ(14, n.p("second").as<int32_t>());
     EXPECT_EQ(1236540, n.p("tick").as<int32_t>());
 }
+
+TEST(DateTimeDType, StridedProperties) {
+    nd::array a, b;
+
+    const char *strs[] = {"1963-02-28T16:12:14.123654", "1969-12-31T23:59:58.5", "2000-03-01T00:00:00"};
+    a = nd::array(strs).ucast(ndt::type("datetime")).eval();
+    b = a.p("year").eval();
+    EXPECT_EQ(1963, b(0).as<int32_t>());
+    EXPECT_EQ(1969, b(1).as<int32_t>());
+    EXPECT_EQ(2000, b(2).as<int32_t>());
+    b = a.p("month").eval();
+    EXPECT_EQ(2, b(0).as<int32_t>());
+    EXPECT_EQ(12, b(1).as<int32_t>());
+    EXPECT_EQ(3, b(2).as<int32_t>());
+    b = a.p("day").eval();
+    EXPECT_EQ(28, b(0).as<int32_t>());
+    EXPECT_EQ(31, b(1).as<int32_t>());
+    EXPECT_EQ(1, b(2).as<int32_t>());
+    b = a.p("hour").eval();
+    EXPECT_EQ(16, b(0).as<int32_t>());
+    EXPECT_EQ(23, b(1).as<int32_t>());
+    EXPECT_EQ(0, b(2).as<int32_t>());
+    b = a.p("minute").eval();
+    EXPECT_EQ(12, b(0).as<int32_t>());
+    EXPECT_EQ(59, b(1).as<int32_t>());
+    b = a.p("second").eval();
+    EXPECT_EQ(14, b(0).as<int32_t>());
+    EXPECT_EQ(58, b(1).as<int32_t>());
+    b = a.p("tick").eval();
+    EXPECT_EQ(1236540, b(0).as<int32_t>());
+    EXPECT_EQ(5000000, b(1).as<int32_t>());
+    EXPECT_EQ(0, b(2).as<int32_t>());
+}
+
+TEST(DateTimeDType, FixedFormatParse) {
+    ndt::type d = ndt::type("datetime"), du = ndt::type("datetime[tz='UTC']");
+    ndt::type di = ndt::make_type<int64_t>();
+    nd::array a, b;
+
+    // The ISO 8601 fast path, checked against the general parser via UTF-16
+    const char *strs[] = {"2013-02-16T12:13:19.0123456", "1969-12-31T23:59:59.9", "NA",
+                    "1600-01-01 15:45", "2013-02-16T12:13:19", "2013-02-16T12:13:19.012",
+                    "2013-02-16T12", "2013-02-16", "2013-02-16T23:59:59.99", "2000-02-29T00:00"};
+    a = nd::array(strs).ucast(d).eval();
+    b = nd::array(strs).ucast(ndt::make_string(string_encoding_utf_16)).eval().ucast(d).eval();
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(b(i).view_scalars(di).as<int64_t>(), a(i).view_scalars(di).as<int64_t>());
+    }
+    EXPECT_EQ("2013-02-16T12:13:19.0123456", a(0).as<string>());
+    EXPECT_EQ(-1000000, a(1).view_scalars(di).as<int64_t>());
+    EXPECT_EQ("1600-01-01T15:45", a(3).as<string>());
+
+    // With 'Z' into a UTC datetime
+    const char *utc_strs[] = {"2013-02-16T12:13:19Z", "1599-01-01T04:16Z", "2013-02-16T12:13:19.012345Z"};
+    a = nd::array(utc_strs).ucast(du).eval();
+    b = nd::array(utc_strs).ucast(ndt::make_string(string_encoding_utf_16)).eval().ucast(du).eval();
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(b(i).view_scalars(di).as<int64_t>(), a(i).view_scalars(di).as<int64_t>());
+    }
+    EXPECT_EQ("2013-02-16T12:13:19.012345Z", a(2).as<string>());
+
+    // The timezone still has to match, and the fields have to be in range
+    EXPECT_THROW(nd::array("2000-01-01T03:00Z").ucast(d).eval(), runtime_error);
+    EXPECT_EQ(nd::array("2000-01-01T03:00").ucast(d).view_scalars(di).as<int64_t>(),
+                    nd::array("2000-01-01T03:00Z").ucast(d, 0, assign_error_none).view_scalars(di).as<int64_t>());
+    EXPECT_THROW(nd::array("2000-01-01T25:00").ucast(d).eval(), runtime_error);
+    EXPECT_THROW(nd::array("2000-02-30T03:00").ucast(d).eval(), runtime_error);
+}
+
+TEST(DateTimeDType, LockDateFormat) {
+    ndt::type d = ndt::type("datetime");
+    eval::eval_context ectx;
+    ectx.lock_date_format = true;
+    nd::array a;
+
+    const char *iso_strs[] = {"NA", "2013-02-16T12:13:19", "2013-02-16 12:13"};
+    a = nd::array(iso_strs).ucast(d).eval(&ectx);
+    EXPECT_EQ("2013-02-16T12:13:19", a(1).as<string>());
+    EXPECT_EQ("2013-02-16T12:13", a(2).as<string>());
+    const char *mixed_strs[] = {"2013-02-16T12:13:19", "2013-02-16T12"};
+    EXPECT_THROW(nd::array(mixed_strs).ucast(d).eval(&ectx), runtime_error);
+    a = nd::array(mixed_strs).ucast(d).eval();
+    EXPECT_EQ("2013-02-16T12:00", a(1).as<string>());
+
+    const char *general_strs[] = {"2013-02-16T12", "2013-02-16T12:13:19"};
+    a = nd::array(general_strs).ucast(d).eval(&ectx);
+    EXPECT_EQ("2013-02-16T12:00", a(0).as<string>());
+    EXPECT_EQ("2013-02-16T12:13:19", a(1).as<string>());
+}
+
+static bool has_tzdata()
+{
+    try {
+        get_tz_transitions("America/New_York");
+        get_tz_transitions("Europe/London");
+        return true;
+    } catch (const runtime_error&) {
+        return false;
+    }
+}
+
+TEST(DateTimeDType, TimeZoneConvert) {
+    if (!has_tzdata()) {
+        // No time zone database on this system
+        return;
+    }
+    // Around the 2014 daylight time changes in New York
+    const char *utc[] = {"2014-03-09T06:59Z", "2014-03-09T07:00Z", "2014-11-02T05:30Z",
+                    "2014-11-02T06:30Z", "NA"};
+    nd::array a = nd::tz_convert(nd::array(utc), "America/New_York").eval();
+    EXPECT_EQ(ndt::make_strided_dim(ndt::make_datetime(tz_abstract)), a.get_type());
+    EXPECT_EQ("2014-03-09T01:59", a(0).as<string>());
+    EXPECT_EQ("2014-03-09T03:00", a(1).as<string>());
+    EXPECT_EQ("2014-11-02T01:30", a(2).as<string>());
+    EXPECT_EQ("2014-11-02T01:30", a(3).as<string>());
+    EXPECT_EQ("NA", a(4).as<string>());
+
+    // Past the transitions in the file, from the POSIX rule in its footer
+    EXPECT_EQ("2100-07-04T08:00",
+                    nd::tz_convert(nd::array("2100-07-04T12:00Z"), "America/New_York").as<string>());
+    EXPECT_EQ("2100-12-25T07:00",
+                    nd::tz_convert(nd::array("2100-12-25T12:00Z"), "America/New_York").as<string>());
+    EXPECT_EQ("2300-07-04T13:00",
+                    nd::tz_convert(nd::array("2300-07-04T12:00Z"), "Europe/London").as<string>());
+
+    EXPECT_THROW(nd::tz_convert(nd::array("2014-01-01T00:00Z"), "Not/A_Zone"), runtime_error);
+    EXPECT_THROW(nd::tz_convert(nd::array("2014-01-01T00:00Z"), "../zoneinfo/UTC"), runtime_error);
+}
+
+TEST(DateTimeDType, TimeZoneLocalize) {
+    if (!has_tzdata()) {
+        return;
+    }
+    const char *local[] = {"2014-07-01T12:00", "2014-12-01T12:00", "NA",
+                    // Skipped when the clocks went forward, and twice when they went back
+                    "2014-03-09T02:30", "2014-11-02T01:30"};
+    nd::array a = nd::tz_localize(nd::array(local), "America/New_York").eval();
+    EXPECT_EQ(ndt::make_strided_dim(ndt::make_datetime(tz_utc)), a.get_type());
+    EXPECT_EQ("2014-07-01T16:00Z", a(0).as<string>());
+    EXPECT_EQ("2014-12-01T17:00Z", a(1).as<string>());
+    EXPECT_EQ("NA", a(2).as<string>());
+    // Both use the offset from before the change
+    EXPECT_EQ("2014-03-09T07:30Z", a(3).as<string>());
+    EXPECT_EQ("2014-11-02T05:30Z", a(4).as<string>());
+
+    EXPECT_EQ("2014-07-01T11:00Z",
+                    nd::tz_localize(nd::array("2014-07-01T12:00"), "Europe/London").as<string>());
+}
+
+TEST(DateTimeDType, TimeZoneColumns) {
+    if (!has_tzdata()) {
+        return;
+    }
+    const tz_transitions& tz = get_tz_transitions("America/New_York");
+    // Hourly over two years in order, then jumping around 1900 to 2100
+    const int count = 40000;
+    vector<int64_t> times(count);
+    for (int i = 0; i < count; ++i) {
+        if (i < count / 2) {
+            times[i] = 16000 * DYND_TICKS_PER_DAY + i * (DYND_TICKS_PER_DAY / 24);
+        } else {
+            times[i] = (-25567 + (i * 7919LL) % 73049) * DYND_TICKS_PER_DAY + (i * 104729LL) % DYND_TICKS_PER_DAY;
+        }
+    }
+    nd::array utc = nd::array(times).view_scalars(ndt::make_datetime(tz_utc));
+    nd::array local = nd::tz_convert(utc, "America/New_York").eval();
+    nd::array back = nd::tz_localize(local, "America/New_York").eval();
+    const int64_t *local_data = reinterpret_cast<const int64_t *>(local.get_readonly_originptr());
+    const int64_t *back_data = reinterpret_cast<const int64_t *>(back.get_readonly_originptr());
+    for (int i = 0; i < count; ++i) {
+        ASSERT_EQ(tz.utc_to_local(times[i]), local_data[i]);
+        ASSERT_EQ(tz.local_to_utc(local_data[i]), back_data[i]);
+    }
+}
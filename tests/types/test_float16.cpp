@@ -0,0 +1,150 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <cmath>
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/types/dynd_float16.hpp>
+
+using namespace std;
+using namespace dynd;
+
+static uint32_t float_bits(float f)
+{
+    union { float f; uint32_t bits; } conv;
+    conv.f = f;
+    return conv.bits;
+}
+
+static uint64_t double_bits(double d)
+{
+    union { double d; uint64_t bits; } conv;
+    conv.d = d;
+    return conv.bits;
+}
+
+static bool halfbits_isnan(uint16_t h)
+{
+    return (h & 0x7c00u) == 0x7c00u && (h & 0x03ffu) != 0;
+}
+
+TEST(Float16, StridedToFloat) {
+    // Every float16 value converts exactly
+    nd::array a = nd::empty(65536, "strided * float16");
+    uint16_t *a_bits = reinterpret_cast<uint16_t *>(a.get_readwrite_originptr());
+    for (int i = 0; i < 65536; ++i) {
+        a_bits[i] = (uint16_t)i;
+    }
+    nd::array f = nd::empty(65536, "strided * float32");
+    f.val_assign(a, assign_error_none);
+    nd::array d = nd::empty(65536, "strided * float64");
+    d.val_assign(a, assign_error_inexact);
+    const float *f_ptr = reinterpret_cast<const float *>(f.get_readonly_originptr());
+    const double *d_ptr = reinterpret_cast<const double *>(d.get_readonly_originptr());
+    for (int i = 0; i < 65536; ++i) {
+        float expected = halfbits_to_float((uint16_t)i);
+        if (DYND_ISNAN(expected)) {
+            EXPECT_TRUE(DYND_ISNAN(f_ptr[i])) << i;
+            EXPECT_TRUE(DYND_ISNAN(d_ptr[i])) << i;
+        } else {
+            EXPECT_EQ(float_bits(expected), float_bits(f_ptr[i])) << i;
+            EXPECT_EQ(double_bits(expected), double_bits(d_ptr[i])) << i;
+        }
+    }
+
+    // A non-contiguous source
+    nd::array g = nd::empty(32768, "strided * float32");
+    g.val_assign(a(irange().by(2)), assign_error_none);
+    for (int i = 0; i < 32768; i += 97) {
+        float expected = halfbits_to_float((uint16_t)(2 * i));
+        if (!DYND_ISNAN(expected)) {
+            EXPECT_EQ(expected, g(i).as<float>());
+        }
+    }
+}
+
+TEST(Float16, StridedFromFloat) {
+    // A spread of float32 bit patterns, including subnormals, ties and overflows
+    const int n = 65537;
+    nd::array f = nd::empty(n, "strided * float32");
+    float *f_ptr = reinterpret_cast<float *>(f.get_readwrite_originptr());
+    for (int i = 0; i < n; ++i) {
+        union { uint32_t bits; float f; } conv;
+        conv.bits = (uint32_t)i * 65535u + ((uint32_t)i & 0x1fffu);
+        f_ptr[i] = conv.f;
+    }
+    f_ptr[0] = 65519.0f;
+    f_ptr[1] = 65520.0f;
+    f_ptr[2] = 2.0009765625f;
+    f_ptr[3] = -5.9604645e-08f;
+    nd::array a = nd::empty(n, "strided * float16");
+    a.val_assign(f, assign_error_none);
+    const uint16_t *a_bits = reinterpret_cast<const uint16_t *>(a.get_readonly_originptr());
+    for (int i = 0; i < n; ++i) {
+        uint16_t expected = float_to_halfbits(f_ptr[i], assign_error_none);
+        if (halfbits_isnan(expected)) {
+            EXPECT_TRUE(halfbits_isnan(a_bits[i])) << i;
+        } else {
+            EXPECT_EQ(expected, a_bits[i]) << i << " " << f_ptr[i];
+        }
+    }
+
+    // Float64, including values where rounding through float32 would round twice
+    nd::array d = nd::empty(n, "strided * float64");
+    double *d_ptr = reinterpret_cast<double *>(d.get_readwrite_originptr());
+    for (int i = 0; i < n; ++i) {
+        d_ptr[i] = ldexp((double)(i % 4096) + 0.5 + 1e-12, (i / 4096) - 20) * (i % 3 == 0 ? -1 : 1);
+    }
+    d_ptr[0] = 65519.999999;
+    d_ptr[1] = 1.0 + 1.0 / 2048 + 1.0 / (1 << 30);
+    a.val_assign(d, assign_error_none);
+    for (int i = 0; i < n; ++i) {
+        EXPECT_EQ(double_to_halfbits(d_ptr[i], assign_error_none), a_bits[i]) << i << " " << d_ptr[i];
+    }
+    EXPECT_EQ(0x7bffu, a_bits[0]);
+    EXPECT_EQ(0x3c01u, a_bits[1]);
+
+    // A non-contiguous destination
+    nd::array b = nd::empty(2 * n, "strided * float16");
+    b(irange().by(2)).val_assign(f, assign_error_none);
+    for (int i = 4; i < n; i += 101) {
+        if (!DYND_ISNAN(f_ptr[i])) {
+            EXPECT_EQ(float_to_halfbits(f_ptr[i], assign_error_none),
+                            b(2 * i).as<dynd_float16>().bits()) << i;
+        }
+    }
+}
+
+TEST(Float16, StridedFromFloatErrors) {
+    nd::array f = nd::empty(1000, "strided * float32");
+    float *f_ptr = reinterpret_cast<float *>(f.get_readwrite_originptr());
+    for (int i = 0; i < 1000; ++i) {
+        f_ptr[i] = i * 0.5f;
+    }
+    nd::array a = nd::empty(1000, "strided * float16");
+    a.val_assign(f, assign_error_overflow);
+    EXPECT_EQ(499.5f, a(999).as<float>());
+    a.val_assign(f, assign_error_fractional);
+    EXPECT_EQ(499.5f, a(999).as<float>());
+    // Infinities aren't overflows
+    f_ptr[10] = numeric_limits<float>::infinity();
+    a.val_assign(f, assign_error_overflow);
+    EXPECT_EQ(numeric_limits<float>::infinity(), a(10).as<float>());
+    f_ptr[500] = 70000.0f;
+    EXPECT_THROW(a.val_assign(f, assign_error_overflow), overflow_error);
+    EXPECT_THROW(a.val_assign(f, assign_error_fractional), overflow_error);
+    f_ptr[500] = 1e-10f;
+    EXPECT_THROW(a.val_assign(f, assign_error_inexact), runtime_error);
+
+    nd::array d = nd::empty(1000, "strided * float64");
+    d.val_assign(f, assign_error_none);
+    a.val_assign(d, assign_error_overflow);
+    EXPECT_EQ(0.0f, a(500).as<float>());
+    d(700).vals() = -1e6;
+    EXPECT_THROW(a.val_assign(d, assign_error_overflow), overflow_error);
+}
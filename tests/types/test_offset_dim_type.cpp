@@ -0,0 +1,140 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/types/offset_dim_type.hpp>
+#include <dynd/types/var_dim_type.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/json_formatter.hpp>
+#include <dynd/exceptions.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(OffsetDimDType, Basic) {
+    ndt::type d = ndt::make_offset_dim(ndt::make_type<int32_t>());
+
+    EXPECT_EQ(offset_dim_type_id, d.get_type_id());
+    EXPECT_EQ(uniform_dim_kind, d.get_kind());
+    EXPECT_EQ(sizeof(int64_t), d.get_data_size());
+    EXPECT_EQ(1, d.get_ndim());
+    EXPECT_EQ(ndt::make_type<int32_t>(), d.at(0));
+    EXPECT_EQ("offset * int32", d.str());
+    EXPECT_EQ(d, ndt::make_offset_dim(ndt::make_type<int32_t>()));
+    EXPECT_NE(d, ndt::make_var_dim(ndt::make_type<int32_t>()));
+    // The offsets of the rows can't come from a default constructor
+    EXPECT_THROW(nd::empty(3, d), runtime_error);
+    // Iteration over the ragged dimension isn't supported
+    EXPECT_THROW(d.extended()->get_iterdata_size(1), type_error);
+}
+
+TEST(OffsetDimDType, FromOffsetsAndValues) {
+    int64_t offsets_vals[] = {0, 2, 2, 5};
+    double values_vals[] = {1, 2, 3, 4, 5};
+    nd::array offsets = offsets_vals, values = values_vals;
+    nd::array a = nd::make_offset_dim_array(offsets, values);
+
+    EXPECT_EQ(ndt::make_strided_dim(ndt::make_offset_dim(ndt::make_type<double>())), a.get_type());
+    EXPECT_EQ(3, a.get_dim_size());
+    EXPECT_EQ("[[1,2],[],[3,4,5]]", format_json(a).as<string>());
+    EXPECT_EQ(2, a(0).get_dim_size());
+    EXPECT_EQ(0, a(1).get_dim_size());
+    EXPECT_EQ(3, a(2).get_dim_size());
+    EXPECT_EQ(4, a(2, 1).as<double>());
+    EXPECT_EQ("[4,5]", format_json(a(2, 1 <= irange())).as<string>());
+    EXPECT_THROW(a(1, 0), index_out_of_bounds);
+    // The rows view the values without copying
+    EXPECT_EQ(values.get_readonly_originptr() + 2 * sizeof(double), a(2, 0).get_readonly_originptr());
+    values_vals[0] = 0;
+    EXPECT_EQ(1, a(0, 0).as<double>());
+    values(0).vals() = 10;
+    EXPECT_EQ(10, a(0, 0).as<double>());
+
+    // Slicing the rows keeps the offsets they need
+    EXPECT_EQ("[[],[3,4,5]]", format_json(a(1 <= irange())).as<string>());
+    EXPECT_EQ("[[3,4,5],[],[10,2]]", format_json(a(irange().by(-1))).as<string>());
+
+    // All the values, in order
+    nd::array v = nd::get_offset_dim_values(a);
+    EXPECT_EQ("[10,2,3,4,5]", format_json(v).as<string>());
+    v = nd::get_offset_dim_values(a(1 <= irange()));
+    EXPECT_EQ("[3,4,5]", format_json(v).as<string>());
+
+    // Invalid offsets
+    int64_t bad_order[] = {0, 3, 2, 5};
+    EXPECT_THROW(nd::make_offset_dim_array(bad_order, values), runtime_error);
+    int64_t bad_end[] = {0, 2, 6};
+    EXPECT_THROW(nd::make_offset_dim_array(bad_end, values), runtime_error);
+    int32_t bad_type[] = {0, 2, 5};
+    EXPECT_THROW(nd::make_offset_dim_array(bad_type, values), runtime_error);
+}
+
+TEST(OffsetDimDType, FromRows) {
+    nd::array b, a, c;
+
+    b = parse_json("4 * var * int32", "[[1, 2], [], [3], [4, 5, 6]]");
+    a = nd::make_offset_dim_array(b);
+    EXPECT_EQ(ndt::make_strided_dim(ndt::make_offset_dim(ndt::make_type<int32_t>())), a.get_type());
+    EXPECT_EQ("[[1,2],[],[3],[4,5,6]]", format_json(a).as<string>());
+    // The values are contiguous
+    const int64_t *offsets = reinterpret_cast<const int64_t *>(a.get_readonly_originptr());
+    EXPECT_EQ(0, offsets[0]);
+    EXPECT_EQ(2, offsets[1]);
+    EXPECT_EQ(2, offsets[2]);
+    EXPECT_EQ(3, offsets[3]);
+    EXPECT_EQ(6, offsets[4]);
+    EXPECT_EQ("[1,2,3,4,5,6]", format_json(nd::get_offset_dim_values(a)).as<string>());
+
+    // From strided rows, with strings
+    b = parse_json("2 * 2 * string", "[[\"a\", \"bc\"], [\"d\", \"\"]]");
+    a = nd::make_offset_dim_array(b);
+    EXPECT_EQ("[[\"a\",\"bc\"],[\"d\",\"\"]]", format_json(a).as<string>());
+    EXPECT_EQ("bc", a(0, 1).as<string>());
+}
+
+TEST(OffsetDimDType, Assign) {
+    nd::array a, b, c;
+
+    a = nd::make_offset_dim_array(parse_json("3 * var * int32", "[[1, 2], [], [3, 4, 5]]"));
+    // To var_dim, allocating the rows
+    c = nd::empty("3 * var * int64");
+    c.val_assign(a);
+    EXPECT_EQ("[[1,2],[],[3,4,5]]", format_json(c).as<string>());
+    // To var_dim, into existing rows
+    c = nd::empty("3 * var * float64");
+    parse_json(c, "[[0, 0], [], [0, 0, 0]]");
+    c.val_assign(a);
+    EXPECT_EQ("[[1,2],[],[3,4,5]]", format_json(c).as<string>());
+    c = nd::empty("3 * var * float64");
+    parse_json(c, "[[0, 0], [0], [0, 0, 0]]");
+    EXPECT_THROW(c.val_assign(a), broadcast_error);
+
+    // To strided dims, where the rows have to match
+    b = nd::make_offset_dim_array(parse_json("2 * var * int32", "[[1, 2], [3, 4]]"));
+    c = nd::empty("2 * 2 * int32");
+    c.val_assign(b);
+    EXPECT_EQ("[[1,2],[3,4]]", format_json(c).as<string>());
+    c = nd::empty("2 * 3 * int32");
+    EXPECT_THROW(c.val_assign(b), broadcast_error);
+    c = nd::empty("2 * int32");
+    EXPECT_THROW(c.val_assign(b), broadcast_error);
+
+    // Into an offset_dim, whose rows already have their sizes
+    b = parse_json("3 * var * int32", "[[10, 20], [], [30, 40, 50]]");
+    a.val_assign(b);
+    EXPECT_EQ("[[10,20],[],[30,40,50]]", format_json(a).as<string>());
+    a.val_assign(nd::make_offset_dim_array(parse_json("3 * var * int32", "[[1], [], [2]]")));
+    EXPECT_EQ("[[1,1],[],[2,2,2]]", format_json(a).as<string>());
+    a.val_assign(7);
+    EXPECT_EQ("[7,7,7,7,7]", format_json(nd::get_offset_dim_values(a)).as<string>());
+    b = parse_json("3 * var * int32", "[[1, 2], [3, 4], [4, 5, 6]]");
+    EXPECT_THROW(a.val_assign(b), broadcast_error);
+}
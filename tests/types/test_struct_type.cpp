@@ -210,6 +210,25 @@ TEST(StructDType, DifferentDTypeAssign) {
     EXPECT_EQ(8,    b(1,1).as<short>());
 }
 
+TEST(StructDType, EmptyStructAssign) {
+    // A struct with no fields is not POD, so assigning it builds
+    // a struct kernel with no field runs
+    ndt::type dt = ndt::make_struct(vector<ndt::type>(), vector<string>());
+    EXPECT_EQ(0u, static_cast<const struct_type *>(dt.extended())->get_field_count());
+    EXPECT_FALSE(dt.is_pod());
+    nd::array a = nd::empty(dt);
+    nd::array b = nd::empty(dt);
+    b.val_assign(a);
+
+    a = nd::make_strided_array(3, dt);
+    b = nd::make_strided_array(3, dt);
+    b.val_assign(a);
+    EXPECT_EQ(3, b.get_dim_size());
+
+    // Assigning from an empty cstruct matches up zero fields
+    b.val_assign(nd::make_strided_array(3, ndt::make_cstruct(0, NULL, NULL)));
+}
+
 TEST(StructDType, FromCStructAssign) {
     ndt::type dt = ndt::make_cstruct(ndt::make_type<int>(), "x", ndt::make_type<double>(), "y", ndt::make_type<short>(), "z");
     nd::array a = nd::make_strided_array(2, dt);
@@ -231,6 +250,68 @@ TEST(StructDType, FromCStructAssign) {
     EXPECT_EQ(8,    b(1,1).as<short>());
 }
 
+TEST(StructDType, StridedAssignFieldRuns) {
+    // Enough elements for the strided kernel to work in several chunks,
+    // with runs of identical POD fields around a string field
+    const int n = 1000;
+    ndt::type dt("{a: int32, b: int32, s: string, c: int64, d: float64}");
+    nd::array a = nd::make_strided_array(n, dt);
+    for (int i = 0; i < n; ++i) {
+        a(i,0).vals() = i;
+        a(i,1).vals() = -i;
+        stringstream ss;
+        ss << "s" << i;
+        a(i,2).vals() = ss.str();
+        a(i,3).vals() = 3 * i;
+        a(i,4).vals() = i + 0.5;
+    }
+
+    nd::array b = nd::make_strided_array(n, dt);
+    b.val_assign(a);
+    // A reversed source
+    nd::array c = nd::make_strided_array(n, dt);
+    c.val_assign(a(irange().by(-1)));
+    for (int i = 0; i < n; i += 7) {
+        stringstream ss;
+        ss << "s" << i;
+        EXPECT_EQ(i, b(i,0).as<int>());
+        EXPECT_EQ(-i, b(i,1).as<int>());
+        EXPECT_EQ(ss.str(), b(i,2).as<string>());
+        EXPECT_EQ(3 * i, b(i,3).as<int64_t>());
+        EXPECT_EQ(i + 0.5, b(i,4).as<double>());
+        EXPECT_EQ(n - 1 - i, c(i,0).as<int>());
+        EXPECT_EQ(i + 1 - n, c(i,1).as<int>());
+        EXPECT_EQ(3 * (n - 1 - i), c(i,3).as<int64_t>());
+    }
+
+    // Reordered and converted fields, the "a" and "b" fields are
+    // adjacent in both, but in the opposite order
+    vector<ndt::type> fields;
+    vector<string> field_names;
+    fields.push_back(ndt::make_type<double>());
+    field_names.push_back("d");
+    fields.push_back(ndt::make_type<int32_t>());
+    field_names.push_back("b");
+    fields.push_back(ndt::make_type<int32_t>());
+    field_names.push_back("a");
+    fields.push_back(ndt::make_type<float>());
+    field_names.push_back("c");
+    fields.push_back(ndt::make_string());
+    field_names.push_back("s");
+    ndt::type dt2 = ndt::make_struct(fields, field_names);
+    nd::array d = nd::make_strided_array(n, dt2);
+    d.val_assign(a);
+    for (int i = 0; i < n; i += 7) {
+        stringstream ss;
+        ss << "s" << i;
+        EXPECT_EQ(i + 0.5, d(i,0).as<double>());
+        EXPECT_EQ(-i, d(i,1).as<int>());
+        EXPECT_EQ(i, d(i,2).as<int>());
+        EXPECT_EQ(3 * i, d(i,3).as<float>());
+        EXPECT_EQ(ss.str(), d(i,4).as<string>());
+    }
+}
+
 TEST(StructDType, SingleCompare) {
     nd::array a, b;
     ndt::type sdt = ndt::make_struct(ndt::make_type<int32_t>(), "a",
@@ -15,6 +15,7 @@
 #include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
 #include <dynd/json_parser.hpp>
+#include <dynd/json_formatter.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -522,6 +523,52 @@ TEST(VarArrayDType, AssignVarFixedKernel) {
     k.reset();
 }
 
+TEST(VarArrayDType, AssignStridedRows) {
+    nd::array a, b, c;
+
+    // Uninitialized rows get one allocation for all of them
+    b = parse_json("4 * var * float64", "[[1, 2], [], [3], [4, 5, 6]]");
+    a = nd::empty("4 * var * float64");
+    a.val_assign(b);
+    const var_dim_type_data *a_d = reinterpret_cast<const var_dim_type_data *>(a.get_readonly_originptr());
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(a_d[i].begin + a_d[i].size * sizeof(double), a_d[i + 1].begin);
+    }
+    EXPECT_EQ("[[1,2],[],[3],[4,5,6]]", format_json(a).as<string>());
+    // With a conversion instead of a memcpy
+    c = nd::empty("4 * var * int64");
+    c.val_assign(b);
+    EXPECT_EQ("[[1,2],[],[3],[4,5,6]]", format_json(c).as<string>());
+
+    // Initialized rows, including broadcasting
+    b = parse_json("4 * var * float64", "[[7, 8], [], [9], [10]]");
+    c = nd::empty("4 * var * int64");
+    parse_json(c, "[[0, 0], [], [0], [0, 0, 0]]");
+    c.val_assign(b);
+    EXPECT_EQ("[[7,8],[],[9],[10,10,10]]", format_json(c).as<string>());
+    b = parse_json("2 * var * float64", "[[1, 2], [3, 4, 5]]");
+    c = nd::empty("2 * var * int64");
+    parse_json(c, "[[0, 0], [0, 0]]");
+    EXPECT_THROW(c.val_assign(b), broadcast_error);
+
+    // Object elements, in an objectarray memory block
+    b = parse_json("3 * var * string", "[[\"a\", \"bc\"], [\"d\"], []]");
+    a = nd::empty("3 * var * string");
+    a.val_assign(b);
+    EXPECT_EQ("[[\"a\",\"bc\"],[\"d\"],[]]", format_json(a).as<string>());
+
+    // Strided rows to var rows
+    b = parse_json("3 * 2 * int32", "[[1, 2], [3, 4], [5, 6]]");
+    a = nd::empty("3 * var * int32");
+    a.val_assign(b);
+    a_d = reinterpret_cast<const var_dim_type_data *>(a.get_readonly_originptr());
+    EXPECT_EQ(a_d[0].begin + 2 * sizeof(int32_t), a_d[1].begin);
+    EXPECT_EQ("[[1,2],[3,4],[5,6]]", format_json(a).as<string>());
+    c = nd::empty("3 * var * float64");
+    c.val_assign(b(irange(), irange().by(-1)));
+    EXPECT_EQ("[[2,1],[4,3],[6,5]]", format_json(c).as<string>());
+}
+
 TEST(VarDimDType, IsTypeSubarray) {
     EXPECT_TRUE(ndt::type("var * int32").is_type_subarray(ndt::type("var * int32")));
     EXPECT_TRUE(ndt::type("3 * var * int32").is_type_subarray(ndt::type("var * int32")));